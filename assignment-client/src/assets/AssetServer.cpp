@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -113,11 +114,20 @@ QString getBakeMapping(const AssetUtils::AssetHash& hash, const QString& relativ
 
 const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
+// per-mesh bake results shared by all the bakes of this asset server
+static const QString MESH_BAKE_CACHE_SUBDIR = "bake-cache";
+static const uint64_t DEFAULT_MESH_BAKE_CACHE_SIZE_LIMIT_MB = 1024;
+static const uint64_t BYTES_PER_MEGABYTE = 1000 * 1000;
+
 void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
-        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
+        QString meshCacheDirectory;
+        if (_meshBakeCacheSizeLimit > 0) {
+            meshCacheDirectory = _resourcesDirectory.absoluteFilePath(MESH_BAKE_CACHE_SUBDIR);
+        }
+        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath, meshCacheDirectory);
         task->setAutoDelete(false);
         _pendingBakes[assetHash] = task;
 
@@ -295,7 +305,8 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _transferTaskPool(this),
     _bakingTaskPool(this),
-    _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
+    _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE),
+    _meshBakeCacheSizeLimit(DEFAULT_MESH_BAKE_CACHE_SIZE_LIMIT_MB * BYTES_PER_MEGABYTE)
 {
     BAKEABLE_TEXTURE_EXTENSIONS = image::getSupportedFormats();
     qDebug() << "Supported baking texture formats:" << BAKEABLE_MODEL_EXTENSIONS;
@@ -459,6 +470,13 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size limit of the per-mesh bake cache, 0 keeps no cache at all
+    static const QString MESH_BAKE_CACHE_SIZE_LIMIT_OPTION = "mesh_bake_cache_size_limit";
+    auto meshBakeCacheSizeLimitJSONValue = assetServerObject[MESH_BAKE_CACHE_SIZE_LIMIT_OPTION];
+    auto meshBakeCacheSizeLimit = meshBakeCacheSizeLimitJSONValue.toInt((int)DEFAULT_MESH_BAKE_CACHE_SIZE_LIMIT_MB);
+    _meshBakeCacheSizeLimit = (uint64_t)std::max(meshBakeCacheSizeLimit, 0) * BYTES_PER_MEGABYTE;
+    cleanupMeshBakeCache();
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -587,6 +605,39 @@ void AssetServer::cleanupBakedFilesForDeletedAssets() {
     }
 }
 
+void AssetServer::cleanupMeshBakeCache() {
+    QDir cacheDirectory { _resourcesDirectory.absoluteFilePath(MESH_BAKE_CACHE_SUBDIR) };
+    if (!cacheDirectory.exists()) {
+        return;
+    }
+
+    // the oven touches an entry whenever it uses it, so the oldest modification times are the least recently used
+    // entries; only entry names are considered, which leaves the temporary files of bakes in progress alone
+    QRegExp entryRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+    auto entries = cacheDirectory.entryInfoList(QDir::Files, QDir::Time);
+
+    uint64_t cacheSize = 0;
+    int removedEntries = 0;
+    uint64_t removedBytes = 0;
+    for (const auto& entry : entries) {
+        if (!entryRegex.exactMatch(entry.fileName())) {
+            continue;
+        }
+        uint64_t entrySize = (uint64_t)entry.size();
+        if (cacheSize + entrySize <= _meshBakeCacheSizeLimit) {
+            cacheSize += entrySize;
+        } else if (QFile::remove(entry.absoluteFilePath())) {
+            removedEntries++;
+            removedBytes += entrySize;
+        }
+    }
+
+    if (removedEntries > 0) {
+        qCInfo(asset_server) << "Removed" << removedEntries << "least recently used entries (" << removedBytes
+            << "bytes) from the mesh bake cache, which now holds" << cacheSize << "bytes";
+    }
+}
+
 void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     using AssetMappingOperationType = AssetUtils::AssetMappingOperationType;
 
@@ -1318,6 +1369,8 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
     writeMetaFile(originalAssetHash, meta);
 
     _pendingBakes.remove(originalAssetHash);
+
+    cleanupMeshBakeCache();
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1341,6 +1394,8 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
         writeMetaFile(originalAssetHash, meta);
 
         _pendingBakes.remove(originalAssetHash);
+
+        cleanupMeshBakeCache();
     };
 
     bool errorCompletingBake { false };
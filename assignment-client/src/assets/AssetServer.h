@@ -126,6 +126,9 @@ private:
     /// Delete any baked files for assets removed from the local asset directory
     void cleanupBakedFilesForDeletedAssets();
 
+    /// Delete the least recently used per-mesh bake results until the bake cache fits its size limit
+    void cleanupMeshBakeCache();
+
     QString getPathToAssetHash(const AssetUtils::AssetHash& assetHash);
 
     std::pair<AssetUtils::BakingStatus, QString> getAssetStatus(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash);
@@ -166,6 +169,7 @@ private:
     RequestQueue _queuedRequests;
 
     uint64_t _filesizeLimit;
+    uint64_t _meshBakeCacheSizeLimit;
 };
 
 #endif
@@ -24,10 +24,12 @@ static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 std::once_flag registerMetaTypesFlag;
 
-BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
+BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                             const QString& meshCacheDirectory) :
     _assetHash(assetHash),
     _assetPath(assetPath),
-    _filePath(filePath)
+    _filePath(filePath),
+    _meshCacheDirectory(meshCacheDirectory)
 {
 
     std::call_once(registerMetaTypesFlag, []() {
@@ -71,6 +73,10 @@ void BakeAssetTask::run() {
         "-o", tempOutputDir,
         "-t", extension,
     };
+    if (!_meshCacheDirectory.isEmpty()) {
+        // re-bakes of a model only encode the meshes that changed
+        args << "--mesh-cache" << _meshCacheDirectory;
+    }
 
     _ovenProcess.reset(new QProcess());
 
@@ -256,122 +256,122 @@ void AudioMixer::removeHRTFsForFinishedInjector(const QUuid& streamID) {
     }
 }
 
-QString AudioMixer::percentageForMixStats(int counter) {
+void AudioMixer::addMixPercentage(BinaryStatsWriter& stats, const char* key, int counter) {
     if (_stats.totalMixes > 0) {
+        char percentage[32];
         float mixPercentage = (float(counter) / _stats.totalMixes) * 100.0f;
-        return QString::number(mixPercentage, 'f', 2);
+        snprintf(percentage, sizeof(percentage), "%.2f", mixPercentage);
+        stats.add(key, (const char*)percentage);
     } else {
-        return QString("0.0");
+        stats.add(key, "0.0");
     }
 }
 
 void AudioMixer::sendStatsPacket() {
-    QJsonObject statsObject;
-
     if (_numStatFrames == 0) {
         return;
     }
 
-#ifdef DEBUG_EVENT_QUEUE
-    QJsonObject qtStats;
+    BinaryStatsWriter& stats = beginStatsPacket();
 
-    _slavePool.queueStats(qtStats);
-    statsObject["audio_thread_event_queue"] = qtStats;
+#ifdef DEBUG_EVENT_QUEUE
+    stats.beginObject("audio_thread_event_queue");
+    _slavePool.queueStats(stats);
+    stats.end();
 #endif
 
     // general stats
-    statsObject["useDynamicJitterBuffers"] = _numStaticJitterFrames == DISABLE_STATIC_JITTER_FRAMES;
+    stats.add("useDynamicJitterBuffers", _numStaticJitterFrames == DISABLE_STATIC_JITTER_FRAMES);
 
-    statsObject["threads"] = _slavePool.numThreads();
+    stats.add("threads", _slavePool.numThreads());
 
-    statsObject["trailing_mix_ratio"] = _trailingMixRatio;
-    statsObject["throttling_ratio"] = _throttlingRatio;
+    stats.add("trailing_mix_ratio", _trailingMixRatio);
+    stats.add("throttling_ratio", _throttlingRatio);
 
-    statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
-    statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
-    statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
+    stats.add("avg_streams_per_frame", (float)_stats.sumStreams / (float)_numStatFrames);
+    stats.add("avg_listeners_per_frame", (float)_stats.sumListeners / (float)_numStatFrames);
+    stats.add("avg_listeners_(silent)_per_frame", (float)_stats.sumListenersSilent / (float)_numStatFrames);
 
-    statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
+    stats.add("silent_packets_per_frame", (float)_numSilentPackets / (float)_numStatFrames);
 
-    // timing stats
-    QJsonObject timingStats;
+    // timing stats, call it "avg_..." to keep it higher in the display, sorted alphabetically
+    stats.beginObject("avg_timing_stats");
 
-    auto addTiming = [&](Timer& timer, string name) {
+    auto addTiming = [&](Timer& timer, const char* name, const char* trailingName) {
         uint64_t timing, trailing;
         timer.get(timing, trailing);
-        timingStats[("us_per_" + name).c_str()] = (qint64)(timing / _numStatFrames);
-        timingStats[("us_per_" + name + "_trailing").c_str()] = (qint64)(trailing / _numStatFrames);
+        stats.add(name, (qint64)(timing / _numStatFrames));
+        stats.add(trailingName, (qint64)(trailing / _numStatFrames));
     };
 
-    addTiming(_ticTiming, "tic");
-    addTiming(_checkTimeTiming, "check_time");
-    addTiming(_sleepTiming, "sleep");
-    addTiming(_frameTiming, "frame");
-    addTiming(_packetsTiming, "packets");
-    addTiming(_mixTiming, "mix");
-    addTiming(_eventsTiming, "events");
+    addTiming(_ticTiming, "us_per_tic", "us_per_tic_trailing");
+    addTiming(_checkTimeTiming, "us_per_check_time", "us_per_check_time_trailing");
+    addTiming(_sleepTiming, "us_per_sleep", "us_per_sleep_trailing");
+    addTiming(_frameTiming, "us_per_frame", "us_per_frame_trailing");
+    addTiming(_packetsTiming, "us_per_packets", "us_per_packets_trailing");
+    addTiming(_mixTiming, "us_per_mix", "us_per_mix_trailing");
+    addTiming(_eventsTiming, "us_per_events", "us_per_events_trailing");
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
-    timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
+    stats.add("ns_per_mix", (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0.0f);
 #endif
 
-    // call it "avg_..." to keep it higher in the display, sorted alphabetically
-    statsObject["avg_timing_stats"] = timingStats;
+    stats.end();
 
     // mix stats
-    QJsonObject mixStats;
+    stats.beginObject("mix_stats");
 
-    mixStats["%_hrtf_mixes"] = percentageForMixStats(_stats.hrtfRenders);
-    mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_stats.manualStereoMixes);
-    mixStats["%_manual_echo_mixes"] = percentageForMixStats(_stats.manualEchoMixes);
+    addMixPercentage(stats, "%_hrtf_mixes", _stats.hrtfRenders);
+    addMixPercentage(stats, "%_manual_stereo_mixes", _stats.manualStereoMixes);
+    addMixPercentage(stats, "%_manual_echo_mixes", _stats.manualEchoMixes);
 
-    mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
-    mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
-    mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    stats.add("1_hrtf_renders", (int)(_stats.hrtfRenders / (float)_numStatFrames));
+    stats.add("1_hrtf_resets", (int)(_stats.hrtfResets / (float)_numStatFrames));
+    stats.add("1_hrtf_updates", (int)(_stats.hrtfUpdates / (float)_numStatFrames));
 
-    mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
-    mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
-    mixStats["2_active_streams"] = (int)(_stats.active / (float)_numStatFrames);
+    stats.add("2_skipped_streams", (int)(_stats.skipped / (float)_numStatFrames));
+    stats.add("2_inactive_streams", (int)(_stats.inactive / (float)_numStatFrames));
+    stats.add("2_active_streams", (int)(_stats.active / (float)_numStatFrames));
 
-    mixStats["3_skippped_to_active"] = (int)(_stats.skippedToActive / (float)_numStatFrames);
-    mixStats["3_skippped_to_inactive"] = (int)(_stats.skippedToInactive / (float)_numStatFrames);
-    mixStats["3_inactive_to_skippped"] = (int)(_stats.inactiveToSkipped / (float)_numStatFrames);
-    mixStats["3_inactive_to_active"] = (int)(_stats.inactiveToActive / (float)_numStatFrames);
-    mixStats["3_active_to_skippped"] = (int)(_stats.activeToSkipped / (float)_numStatFrames);
-    mixStats["3_active_to_inactive"] = (int)(_stats.activeToInactive / (float)_numStatFrames);
+    stats.add("3_skippped_to_active", (int)(_stats.skippedToActive / (float)_numStatFrames));
+    stats.add("3_skippped_to_inactive", (int)(_stats.skippedToInactive / (float)_numStatFrames));
+    stats.add("3_inactive_to_skippped", (int)(_stats.inactiveToSkipped / (float)_numStatFrames));
+    stats.add("3_inactive_to_active", (int)(_stats.inactiveToActive / (float)_numStatFrames));
+    stats.add("3_active_to_skippped", (int)(_stats.activeToSkipped / (float)_numStatFrames));
+    stats.add("3_active_to_inactive", (int)(_stats.activeToInactive / (float)_numStatFrames));
 
-    mixStats["total_mixes"] = _stats.totalMixes;
-    mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
+    stats.add("total_mixes", _stats.totalMixes);
+    stats.add("avg_mixes_per_block", _stats.totalMixes / _numStatFrames);
 
-    statsObject["mix_stats"] = mixStats;
+    stats.end();
 
     _numStatFrames = _numSilentPackets = 0;
     _stats.reset();
 
-    // add stats for each listerner
+    // add stats for each listener, keyed by their node UUID
     auto nodeList = DependencyManager::get<NodeList>();
-    QJsonObject listenerStats;
+    stats.beginObject("z_listeners");
 
     nodeList->eachNode([&](const SharedNodePointer& node) {
         AudioMixerClientData* clientData = static_cast<AudioMixerClientData*>(node->getLinkedData());
         if (clientData) {
-            QJsonObject nodeStats;
-            QString uuidString = uuidStringWithoutCurlyBraces(node->getUUID());
+            stats.beginObject(node->getUUID());
 
-            nodeStats["outbound_kbps"] = node->getOutboundKbps();
-            nodeStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuidString;
+            stats.add("outbound_kbps", node->getOutboundKbps());
+            stats.add(USERNAME_UUID_REPLACEMENT_STATS_KEY, node->getUUID());
 
-            nodeStats["jitter"] = clientData->getAudioStreamStats();
+            stats.beginObject("jitter");
+            clientData->writeAudioStreamStats(stats);
+            stats.end();
 
-            listenerStats[uuidString] = nodeStats;
+            stats.end();
         }
     });
 
-    // add the listeners object to the root object
-    statsObject["z_listeners"] = listenerStats;
+    stats.end();
 
     // send off the stats packets
-    ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
+    finishStatsPacket();
 }
 
 void AudioMixer::run() {
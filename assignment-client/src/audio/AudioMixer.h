@@ -91,7 +91,7 @@ private:
 
     AudioMixerClientData* getOrCreateClientData(Node* node);
 
-    QString percentageForMixStats(int counter);
+    void addMixPercentage(BinaryStatsWriter& stats, const char* key, int counter);
 
     void parseSettingsObject(const QJsonObject& settingsObject);
     void clearDomainSettings();
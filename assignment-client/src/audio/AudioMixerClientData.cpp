@@ -16,8 +16,8 @@
 #include <glm/common.hpp>
 
 #include <QtCore/QDebug>
-#include <QtCore/QJsonArray>
 
+#include <BinaryStats.h>
 #include <udt/PacketHeaders.h>
 #include <UUID.h>
 
@@ -648,109 +648,66 @@ void AudioMixerClientData::sendAudioStreamStatsPackets(const SharedNodePointer&
     }
 }
 
-QJsonObject AudioMixerClientData::getAudioStreamStats() {
-    QJsonObject result;
-
-    QJsonObject downstreamStats;
-    AudioStreamStats streamStats = _downstreamAudioStreamStats;
-    downstreamStats["desired"] = streamStats._desiredJitterBufferFrames;
-    downstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
-    downstreamStats["available"] = (double) streamStats._framesAvailable;
-    downstreamStats["unplayed"] = (double) streamStats._unplayedMs;
-    downstreamStats["starves"] = (double) streamStats._starveCount;
-    downstreamStats["not_mixed"] = (double) streamStats._consecutiveNotMixedCount;
-    downstreamStats["overflows"] = (double) streamStats._overflowCount;
-    downstreamStats["lost%"] = streamStats._packetStreamStats.getLostRate() * 100.0f;
-    downstreamStats["lost%_30s"] = streamStats._packetStreamWindowStats.getLostRate() * 100.0f;
-    downstreamStats["min_gap"] = formatUsecTime(streamStats._timeGapMin);
-    downstreamStats["max_gap"] = formatUsecTime(streamStats._timeGapMax);
-    downstreamStats["avg_gap"] = formatUsecTime(streamStats._timeGapAverage);
-    downstreamStats["min_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMin);
-    downstreamStats["max_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMax);
-    downstreamStats["avg_gap_30s"] = formatUsecTime(streamStats._timeGapWindowAverage);
-    downstreamStats["min_gap_usecs"] = static_cast<double>(streamStats._timeGapMin);
-    downstreamStats["max_gap_usecs"] = static_cast<double>(streamStats._timeGapMax);
-    downstreamStats["avg_gap_usecs"] = static_cast<double>(streamStats._timeGapAverage);
-    downstreamStats["min_gap_30s_usecs"] = static_cast<double>(streamStats._timeGapWindowMin);
-    downstreamStats["max_gap_30s_usecs"] = static_cast<double>(streamStats._timeGapWindowMax);
-    downstreamStats["avg_gap_30s_usecs"] = static_cast<double>(streamStats._timeGapWindowAverage);
-
-    result["downstream"] = downstreamStats;
+static void writeStreamStats(BinaryStatsWriter& stats, const AudioStreamStats& streamStats) {
+    stats.add("available_avg_10s", streamStats._framesAvailableAverage);
+    stats.add("available", (double) streamStats._framesAvailable);
+    stats.add("unplayed", (double) streamStats._unplayedMs);
+    stats.add("starves", (double) streamStats._starveCount);
+    stats.add("not_mixed", (double) streamStats._consecutiveNotMixedCount);
+    stats.add("overflows", (double) streamStats._overflowCount);
+    stats.add("lost%", streamStats._packetStreamStats.getLostRate() * 100.0f);
+    stats.add("lost%_30s", streamStats._packetStreamWindowStats.getLostRate() * 100.0f);
+    stats.addUsecTime("min_gap", streamStats._timeGapMin);
+    stats.addUsecTime("max_gap", streamStats._timeGapMax);
+    stats.addUsecTime("avg_gap", streamStats._timeGapAverage);
+    stats.addUsecTime("min_gap_30s", streamStats._timeGapWindowMin);
+    stats.addUsecTime("max_gap_30s", streamStats._timeGapWindowMax);
+    stats.addUsecTime("avg_gap_30s", streamStats._timeGapWindowAverage);
+
+    stats.add("min_gap_usecs", static_cast<double>(streamStats._timeGapMin));
+    stats.add("max_gap_usecs", static_cast<double>(streamStats._timeGapMax));
+    stats.add("avg_gap_usecs", static_cast<double>(streamStats._timeGapAverage));
+    stats.add("min_gap_30s_usecs", static_cast<double>(streamStats._timeGapWindowMin));
+    stats.add("max_gap_30s_usecs", static_cast<double>(streamStats._timeGapWindowMax));
+    stats.add("avg_gap_30s_usecs", static_cast<double>(streamStats._timeGapWindowAverage));
+}
+
+void AudioMixerClientData::writeAudioStreamStats(BinaryStatsWriter& stats) {
+    stats.beginObject("downstream");
+    stats.add("desired", _downstreamAudioStreamStats._desiredJitterBufferFrames);
+    writeStreamStats(stats, _downstreamAudioStreamStats);
+    stats.end();
 
     AvatarAudioStream* avatarAudioStream = getAvatarAudioStream();
 
     if (avatarAudioStream) {
-        QJsonObject upstreamStats;
-
         AudioStreamStats streamStats = avatarAudioStream->getAudioStreamStats();
-        upstreamStats["mic.desired"] = streamStats._desiredJitterBufferFrames;
-        upstreamStats["desired_calc"] = avatarAudioStream->getCalculatedJitterBufferFrames();
-        upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
-        upstreamStats["available"] = (double) streamStats._framesAvailable;
-        upstreamStats["unplayed"] = (double) streamStats._unplayedMs;
-        upstreamStats["starves"] = (double) streamStats._starveCount;
-        upstreamStats["not_mixed"] = (double) streamStats._consecutiveNotMixedCount;
-        upstreamStats["overflows"] = (double) streamStats._overflowCount;
-        upstreamStats["silents_dropped"] = (double) streamStats._framesDropped;
-        upstreamStats["lost%"] = streamStats._packetStreamStats.getLostRate() * 100.0f;
-        upstreamStats["lost%_30s"] = streamStats._packetStreamWindowStats.getLostRate() * 100.0f;
-        upstreamStats["min_gap"] = formatUsecTime(streamStats._timeGapMin);
-        upstreamStats["max_gap"] = formatUsecTime(streamStats._timeGapMax);
-        upstreamStats["avg_gap"] = formatUsecTime(streamStats._timeGapAverage);
-        upstreamStats["min_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMin);
-        upstreamStats["max_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMax);
-        upstreamStats["avg_gap_30s"] = formatUsecTime(streamStats._timeGapWindowAverage);
-
-        upstreamStats["min_gap_usecs"] = static_cast<double>(streamStats._timeGapMin);
-        upstreamStats["max_gap_usecs"] = static_cast<double>(streamStats._timeGapMax);
-        upstreamStats["avg_gap_usecs"] = static_cast<double>(streamStats._timeGapAverage);
-        upstreamStats["min_gap_30s_usecs"] = static_cast<double>(streamStats._timeGapWindowMin);
-        upstreamStats["max_gap_30s_usecs"] = static_cast<double>(streamStats._timeGapWindowMax);
-        upstreamStats["avg_gap_30s_usecs"] = static_cast<double>(streamStats._timeGapWindowAverage);
-
-        result["upstream"] = upstreamStats;
+
+        stats.beginObject("upstream");
+        stats.add("mic.desired", streamStats._desiredJitterBufferFrames);
+        stats.add("desired_calc", avatarAudioStream->getCalculatedJitterBufferFrames());
+        stats.add("silents_dropped", (double) streamStats._framesDropped);
+        writeStreamStats(stats, streamStats);
+        stats.end();
     } else {
-        result["upstream"] = "mic unknown";
+        stats.add("upstream", "mic unknown");
     }
 
-    QJsonArray injectorArray;
+    stats.beginArray("injectors");
     auto streamsCopy = getAudioStreams();
     for (auto& injectorPair : streamsCopy) {
         if (injectorPair->getType() == PositionalAudioStream::Injector) {
-            QJsonObject upstreamStats;
-
             AudioStreamStats streamStats = injectorPair->getAudioStreamStats();
-            upstreamStats["inj.desired"]  = streamStats._desiredJitterBufferFrames;
-            upstreamStats["desired_calc"] = injectorPair->getCalculatedJitterBufferFrames();
-            upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
-            upstreamStats["available"] = (double) streamStats._framesAvailable;
-            upstreamStats["unplayed"] = (double) streamStats._unplayedMs;
-            upstreamStats["starves"] = (double) streamStats._starveCount;
-            upstreamStats["not_mixed"] = (double) streamStats._consecutiveNotMixedCount;
-            upstreamStats["overflows"] = (double) streamStats._overflowCount;
-            upstreamStats["silents_dropped"] = (double) streamStats._framesDropped;
-            upstreamStats["lost%"] = streamStats._packetStreamStats.getLostRate() * 100.0f;
-            upstreamStats["lost%_30s"] = streamStats._packetStreamWindowStats.getLostRate() * 100.0f;
-            upstreamStats["min_gap"] = formatUsecTime(streamStats._timeGapMin);
-            upstreamStats["max_gap"] = formatUsecTime(streamStats._timeGapMax);
-            upstreamStats["avg_gap"] = formatUsecTime(streamStats._timeGapAverage);
-            upstreamStats["min_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMin);
-            upstreamStats["max_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMax);
-            upstreamStats["avg_gap_30s"] = formatUsecTime(streamStats._timeGapWindowAverage);
-
-            upstreamStats["min_gap_usecs"] = static_cast<double>(streamStats._timeGapMin);
-            upstreamStats["max_gap_usecs"] = static_cast<double>(streamStats._timeGapMax);
-            upstreamStats["avg_gap_usecs"] = static_cast<double>(streamStats._timeGapAverage);
-            upstreamStats["min_gap_30s_usecs"] = static_cast<double>(streamStats._timeGapWindowMin);
-            upstreamStats["max_gap_30s_usecs"] = static_cast<double>(streamStats._timeGapWindowMax);
-            upstreamStats["avg_gap_30s_usecs"] = static_cast<double>(streamStats._timeGapWindowAverage);
-            injectorArray.push_back(upstreamStats);
+
+            stats.beginObject(nullptr);
+            stats.add("inj.desired", streamStats._desiredJitterBufferFrames);
+            stats.add("desired_calc", injectorPair->getCalculatedJitterBufferFrames());
+            stats.add("silents_dropped", (double) streamStats._framesDropped);
+            writeStreamStats(stats, streamStats);
+            stats.end();
         }
     }
-
-    result["injectors"] = injectorArray;
-
-    return result;
+    stats.end();
 }
 
 void AudioMixerClientData::handleMismatchAudioFormat(SharedNodePointer node, const QString& currentCodec, const QString& recievedCodec) {
@@ -764,16 +721,14 @@ void AudioMixerClientData::sendSelectAudioFormat(SharedNodePointer node, const Q
     nodeList->sendPacket(std::move(replyPacket), *node);
 }
 
-void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
-    static QByteArray zeros(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+int AudioMixerClientData::encodeFrameOfZeros() {
+    static const char zeros[AudioConstants::NETWORK_FRAME_BYTES_STEREO] = { 0 };
+    int encodedSize = 0;
     if (_shouldFlushEncoder) {
-        if (_encoder) {
-            _encoder->encode(zeros, encodedZeros);
-        } else {
-            encodedZeros = zeros;
-        }
+        encodedSize = encode(zeros, AudioConstants::NETWORK_FRAME_BYTES_STEREO);
     }
     _shouldFlushEncoder = false;
+    return encodedSize;
 }
 
 void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& codecName) {
@@ -13,6 +13,7 @@
 #define hifi_AudioMixerClientData_h
 
 #include <queue>
+#include <vector>
 
 #if !defined(Q_MOC_RUN)
 // Work around https://bugreports.qt.io/browse/QTBUG-80990
@@ -33,6 +34,8 @@
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
 
+class BinaryStatsWriter;
+
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
 public:
@@ -76,7 +79,7 @@ public:
     // attempt to pop a frame from each audio stream, and return the number of streams from this client
     int checkBuffersBeforeFrameSend();
 
-    QJsonObject getAudioStreamStats();
+    void writeAudioStreamStats(BinaryStatsWriter& stats);
 
     void sendAudioStreamStatsPackets(const SharedNodePointer& destinationNode);
 
@@ -95,17 +98,28 @@ public:
 
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
-    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
+    // encode a frame of mixed audio into the encoded buffer, returns the number of encoded bytes
+    int encode(const char* decodedBuffer, int decodedSize) {
+        // sized here rather than in setupCodec(), so that only the slave thread mixing for this listener touches the
+        // buffer; it grows once per codec at most
+        int maxEncodedSize = _encoder ? _encoder->getMaxEncodedSize(decodedSize) : decodedSize;
+        if ((int)_encodedBuffer.size() < maxEncodedSize) {
+            _encodedBuffer.resize(maxEncodedSize);
+        }
+        int encodedSize;
         if (_encoder) {
-            _encoder->encode(decodedBuffer, encodedBuffer);
+            encodedSize = _encoder->encode(decodedBuffer, decodedSize, _encodedBuffer.data(), (int)_encodedBuffer.size());
         } else {
-            encodedBuffer = decodedBuffer;
+            encodedSize = std::min(decodedSize, (int)_encodedBuffer.size());
+            memcpy(_encodedBuffer.data(), decodedBuffer, encodedSize);
         }
         // once you have encoded, you need to flush eventually.
         _shouldFlushEncoder = true;
+        return encodedSize;
     }
-    void encodeFrameOfZeros(QByteArray& encodedZeros);
+    int encodeFrameOfZeros();
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
+    const char* getEncodedBuffer() const { return _encodedBuffer.data(); }
 
     QString getCodecName() { return _selectedCodecName; }
 
@@ -203,6 +217,7 @@ private:
     Decoder* _decoder{ nullptr }; // for mic stream
 
     bool _shouldFlushEncoder { false };
+    std::vector<char> _encodedBuffer = std::vector<char>(AudioConstants::NETWORK_FRAME_BYTES_STEREO); // reused every frame
 
     bool _shouldMuteClient { false };
     bool _requestsDomainListData { false };
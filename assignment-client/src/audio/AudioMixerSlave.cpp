@@ -43,7 +43,7 @@ using MixableStreamsVector = AudioMixerClientData::MixableStreamsVector;
 
 // packet helpers
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
+void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, const char* buffer, int size);
 void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData&);
 void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
@@ -101,17 +101,16 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
 
         // send audio packet
         if (mixHasAudio || data->shouldFlushEncoder()) {
-            QByteArray encodedBuffer;
+            int encodedSize;
             if (mixHasAudio) {
                 // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
+                encodedSize = data->encode(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
             } else {
                 // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
+                encodedSize = data->encodeFrameOfZeros();
             }
 
-            sendMixPacket(node, *data, encodedBuffer);
+            sendMixPacket(node, *data, data->getEncodedBuffer(), encodedSize);
         } else {
             ++stats.sumListenersSilent;
             sendSilentPacket(node, *data);
@@ -608,7 +607,7 @@ std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 s
     return audioPacket;
 }
 
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer) {
+void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, const char* buffer, int size) {
     const int MIX_PACKET_SIZE =
         sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
     quint16 sequence = data.getOutgoingSequenceNumber();
@@ -616,7 +615,7 @@ void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QB
     auto mixPacket = createAudioPacket(PacketType::MixedAudio, MIX_PACKET_SIZE, sequence, codec);
 
     // pack samples
-    mixPacket->write(buffer.constData(), buffer.size());
+    mixPacket->write(buffer, size);
 
     // send packet
     DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
@@ -16,6 +16,7 @@
 #include <assert.h>
 #include <algorithm>
 
+#include <BinaryStats.h>
 #include <ThreadHelpers.h>
 
 void AudioMixerSlaveThread::run() {
@@ -118,12 +119,12 @@ void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> funct
 }
 
 #ifdef DEBUG_EVENT_QUEUE
-void AudioMixerSlavePool::queueStats(QJsonObject& stats) {
+void AudioMixerSlavePool::queueStats(BinaryStatsWriter& stats) {
     unsigned i = 0;
     for (auto& slave : _slaves) {
         int queueSize = ::hifi::qt::getEventQueueSize(slave.get());
         QString queueName = QString("audio_thread_event_queue_%1").arg(i);
-        stats[queueName] = queueSize;
+        stats.add(queueName, queueSize);
 
         i++;
     }
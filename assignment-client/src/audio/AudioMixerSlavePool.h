@@ -23,6 +23,7 @@
 #include "AudioMixerSlave.h"
 
 class AudioMixerSlavePool;
+class BinaryStatsWriter;
 
 class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
     Q_OBJECT
@@ -73,7 +74,7 @@ public:
     void each(std::function<void(AudioMixerSlave& slave)> functor);
 
 #ifdef DEBUG_EVENT_QUEUE
-    void queueStats(QJsonObject& stats);
+    void queueStats(BinaryStatsWriter& stats);
 #endif
 
     void setNumThreads(int numThreads);
@@ -763,104 +763,100 @@ void AvatarMixer::sendStatsPacket() {
 
     auto start = usecTimestampNow();
 
-    QJsonObject statsObject;
+    BinaryStatsWriter& stats = beginStatsPacket();
 
-    statsObject["broadcast_loop_rate"] = _loopRate.rate();
-    statsObject["threads"] = _slavePool.numThreads();
-    statsObject["trailing_mix_ratio"] = _trailingMixRatio;
-    statsObject["throttling_ratio"] = _throttlingRatio;
+    stats.add("broadcast_loop_rate", _loopRate.rate());
+    stats.add("threads", _slavePool.numThreads());
+    stats.add("trailing_mix_ratio", _trailingMixRatio);
+    stats.add("throttling_ratio", _throttlingRatio);
 
 #ifdef DEBUG_EVENT_QUEUE
-    QJsonObject qtStats;
-
-    _slavePool.queueStats(qtStats);
-    statsObject["avatar_thread_event_queue"] = qtStats;
+    stats.beginObject("avatar_thread_event_queue");
+    _slavePool.queueStats(stats);
+    stats.end();
 #endif
 
     // this things all occur on the frequency of the tight loop
     int tightLoopFrames = _numTightLoopFrames;
     int tenTimesPerFrame = tightLoopFrames * 10;
-    #define TIGHT_LOOP_STAT(x) (x > tenTimesPerFrame) ? x / tightLoopFrames : ((float)x / (float)tightLoopFrames);
-    #define TIGHT_LOOP_STAT_UINT64(x) (x > (quint64)tenTimesPerFrame) ? x / tightLoopFrames : ((float)x / (float)tightLoopFrames);
-
-    statsObject["average_listeners_last_second"] = TIGHT_LOOP_STAT(_sumListeners);
-
-    QJsonObject singleCoreTasks;
-    singleCoreTasks["processEvents"] = TIGHT_LOOP_STAT_UINT64(_processEventsElapsedTime);
-    singleCoreTasks["queueIncomingPacket"] = TIGHT_LOOP_STAT_UINT64(_queueIncomingPacketElapsedTime);
+    #define TIGHT_LOOP_STAT(x) (x > tenTimesPerFrame) ? x / tightLoopFrames : ((float)x / (float)tightLoopFrames)
+    #define TIGHT_LOOP_STAT_UINT64(x) (x > (quint64)tenTimesPerFrame) ? x / tightLoopFrames : ((float)x / (float)tightLoopFrames)
 
-    QJsonObject incomingPacketStats;
-    incomingPacketStats["handleAvatarIdentityPacket"] = TIGHT_LOOP_STAT_UINT64(_handleAvatarIdentityPacketElapsedTime);
-    incomingPacketStats["handleKillAvatarPacket"] = TIGHT_LOOP_STAT_UINT64(_handleKillAvatarPacketElapsedTime);
-    incomingPacketStats["handleNodeIgnoreRequestPacket"] = TIGHT_LOOP_STAT_UINT64(_handleNodeIgnoreRequestPacketElapsedTime);
-    incomingPacketStats["handleRadiusIgnoreRequestPacket"] = TIGHT_LOOP_STAT_UINT64(_handleRadiusIgnoreRequestPacketElapsedTime);
-    incomingPacketStats["handleRequestsDomainListDataPacket"] = TIGHT_LOOP_STAT_UINT64(_handleRequestsDomainListDataPacketElapsedTime);
-    incomingPacketStats["handleAvatarQueryPacket"] = TIGHT_LOOP_STAT_UINT64(_handleViewFrustumPacketElapsedTime);
+    stats.add("average_listeners_last_second", TIGHT_LOOP_STAT(_sumListeners));
 
-    singleCoreTasks["incoming_packets"] = incomingPacketStats;
-    singleCoreTasks["sendStats"] = (float)_sendStatsElapsedTime;
+    stats.beginObject("singleCoreTasks");
+    stats.add("processEvents", TIGHT_LOOP_STAT_UINT64(_processEventsElapsedTime));
+    stats.add("queueIncomingPacket", TIGHT_LOOP_STAT_UINT64(_queueIncomingPacketElapsedTime));
 
-    statsObject["singleCoreTasks"] = singleCoreTasks;
+    stats.beginObject("incoming_packets");
+    stats.add("handleAvatarIdentityPacket", TIGHT_LOOP_STAT_UINT64(_handleAvatarIdentityPacketElapsedTime));
+    stats.add("handleKillAvatarPacket", TIGHT_LOOP_STAT_UINT64(_handleKillAvatarPacketElapsedTime));
+    stats.add("handleNodeIgnoreRequestPacket", TIGHT_LOOP_STAT_UINT64(_handleNodeIgnoreRequestPacketElapsedTime));
+    stats.add("handleRadiusIgnoreRequestPacket", TIGHT_LOOP_STAT_UINT64(_handleRadiusIgnoreRequestPacketElapsedTime));
+    stats.add("handleRequestsDomainListDataPacket", TIGHT_LOOP_STAT_UINT64(_handleRequestsDomainListDataPacketElapsedTime));
+    stats.add("handleAvatarQueryPacket", TIGHT_LOOP_STAT_UINT64(_handleViewFrustumPacketElapsedTime));
+    stats.end();
 
-    QJsonObject parallelTasks;
+    stats.add("sendStats", (float)_sendStatsElapsedTime);
+    stats.end();
 
-    QJsonObject processQueuedAvatarDataPacketsStats;
-    processQueuedAvatarDataPacketsStats["1_total"] = TIGHT_LOOP_STAT_UINT64(_processQueuedAvatarDataPacketsElapsedTime);
-    processQueuedAvatarDataPacketsStats["2_lockWait"] = TIGHT_LOOP_STAT_UINT64(_processQueuedAvatarDataPacketsLockWaitElapsedTime);
-    parallelTasks["processQueuedAvatarDataPackets"] = processQueuedAvatarDataPacketsStats;
+    stats.beginObject("parallelTasks");
 
-    QJsonObject broadcastAvatarDataStats;
+    stats.beginObject("processQueuedAvatarDataPackets");
+    stats.add("1_total", TIGHT_LOOP_STAT_UINT64(_processQueuedAvatarDataPacketsElapsedTime));
+    stats.add("2_lockWait", TIGHT_LOOP_STAT_UINT64(_processQueuedAvatarDataPacketsLockWaitElapsedTime));
+    stats.end();
 
-    broadcastAvatarDataStats["1_total"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataElapsedTime);
-    broadcastAvatarDataStats["2_innner"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataInner);
-    broadcastAvatarDataStats["3_lockWait"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataLockWait);
-    broadcastAvatarDataStats["4_NodeTransform"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeTransform);
-    broadcastAvatarDataStats["5_Functor"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeFunctor);
+    stats.beginObject("broadcastAvatarData");
+    stats.add("1_total", TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataElapsedTime));
+    stats.add("2_innner", TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataInner));
+    stats.add("3_lockWait", TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataLockWait));
+    stats.add("4_NodeTransform", TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeTransform));
+    stats.add("5_Functor", TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeFunctor));
+    stats.end();
 
-    parallelTasks["broadcastAvatarData"] = broadcastAvatarDataStats;
+    stats.beginObject("displayNameManagement");
+    stats.add("1_total", TIGHT_LOOP_STAT_UINT64(_displayNameManagementElapsedTime));
+    stats.end();
 
-    QJsonObject displayNameManagementStats;
-    displayNameManagementStats["1_total"] = TIGHT_LOOP_STAT_UINT64(_displayNameManagementElapsedTime);
-    parallelTasks["displayNameManagement"] = displayNameManagementStats;
-
-    statsObject["parallelTasks"] = parallelTasks;
+    stats.end();
 
 
     AvatarMixerSlaveStats aggregateStats;
 
     // gather stats
     _slavePool.each([&](AvatarMixerSlave& slave) {
-        AvatarMixerSlaveStats stats;
-        slave.harvestStats(stats);
-        aggregateStats += stats;
+        AvatarMixerSlaveStats slaveStats;
+        slave.harvestStats(slaveStats);
+        aggregateStats += slaveStats;
     });
 
-    QJsonObject slavesAggregatObject;
+    stats.beginObject("slaves_aggregate (per frame)");
 
-    slavesAggregatObject["received_1_nodesProcessed"] = TIGHT_LOOP_STAT(aggregateStats.nodesProcessed);
+    stats.add("received_1_nodesProcessed", TIGHT_LOOP_STAT(aggregateStats.nodesProcessed));
 
-    slavesAggregatObject["sent_1_nodesBroadcastedTo"] = TIGHT_LOOP_STAT(aggregateStats.nodesBroadcastedTo);
+    stats.add("sent_1_nodesBroadcastedTo", TIGHT_LOOP_STAT(aggregateStats.nodesBroadcastedTo));
 
     float averageNodes = ((float)aggregateStats.nodesBroadcastedTo / (float)tightLoopFrames);
 
     float averageOthersIncluded = averageNodes ? aggregateStats.numOthersIncluded / averageNodes : 0.0f;
-    slavesAggregatObject["sent_2_averageOthersIncluded"] = TIGHT_LOOP_STAT(averageOthersIncluded);
+    stats.add("sent_2_averageOthersIncluded", TIGHT_LOOP_STAT(averageOthersIncluded));
 
     float averageOverBudgetAvatars = averageNodes ? aggregateStats.overBudgetAvatars / averageNodes : 0.0f;
-    slavesAggregatObject["sent_3_averageOverBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverBudgetAvatars);
-    slavesAggregatObject["sent_4_averageDataBytes"] = TIGHT_LOOP_STAT(aggregateStats.numDataBytesSent);
-    slavesAggregatObject["sent_5_averageTraitsBytes"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent);
-    slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
-    slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
+    stats.add("sent_3_averageOverBudgetAvatars", TIGHT_LOOP_STAT(averageOverBudgetAvatars));
+    stats.add("sent_4_averageDataBytes", TIGHT_LOOP_STAT(aggregateStats.numDataBytesSent));
+    stats.add("sent_5_averageTraitsBytes", TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent));
+    stats.add("sent_6_averageIdentityBytes", TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent));
+    stats.add("sent_7_averageHeroAvatars", TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded));
 
-    slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
-    slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
-    slavesAggregatObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayElapsedTime);
-    slavesAggregatObject["timing_4_avatarDataPacking"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.avatarDataPackingElapsedTime);
-    slavesAggregatObject["timing_5_packetSending"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.packetSendingElapsedTime);
-    slavesAggregatObject["timing_6_jobElapsedTime"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.jobElapsedTime);
+    stats.add("timing_1_processIncomingPackets", TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime));
+    stats.add("timing_2_ignoreCalculation", TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime));
+    stats.add("timing_3_toByteArray", TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayElapsedTime));
+    stats.add("timing_4_avatarDataPacking", TIGHT_LOOP_STAT_UINT64(aggregateStats.avatarDataPackingElapsedTime));
+    stats.add("timing_5_packetSending", TIGHT_LOOP_STAT_UINT64(aggregateStats.packetSendingElapsedTime));
+    stats.add("timing_6_jobElapsedTime", TIGHT_LOOP_STAT_UINT64(aggregateStats.jobElapsedTime));
 
-    statsObject["slaves_aggregate (per frame)"] = slavesAggregatObject;
+    stats.end();
 
     _handleViewFrustumPacketElapsedTime = 0;
     _handleAvatarIdentityPacketElapsedTime = 0;
@@ -873,46 +869,43 @@ void AvatarMixer::sendStatsPacket() {
     _processQueuedAvatarDataPacketsElapsedTime = 0;
     _processQueuedAvatarDataPacketsLockWaitElapsedTime = 0;
 
-    QJsonObject avatarsObject;
+    stats.beginObject("z_avatars");
     auto nodeList = DependencyManager::get<NodeList>();
-    // add stats for each listener
+    // add stats for each listener, keyed by their node UUID
     nodeList->eachNode([&](const SharedNodePointer& node) {
-        QJsonObject avatarStats;
-
-        const QString NODE_OUTBOUND_KBPS_STAT_KEY = "outbound_kbps";
-        const QString NODE_INBOUND_KBPS_STAT_KEY = "inbound_kbps";
+        stats.beginObject(node->getUUID());
 
         // add the key to ask the domain-server for a username replacement, if it has it
-        avatarStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuidStringWithoutCurlyBraces(node->getUUID());
+        stats.add(USERNAME_UUID_REPLACEMENT_STATS_KEY, node->getUUID());
 
         float outboundAvatarDataKbps = node->getOutboundKbps();
-        avatarStats[NODE_OUTBOUND_KBPS_STAT_KEY] = outboundAvatarDataKbps;
-        avatarStats[NODE_INBOUND_KBPS_STAT_KEY] = node->getInboundKbps();
+        stats.add("outbound_kbps", outboundAvatarDataKbps);
+        stats.add("inbound_kbps", node->getInboundKbps());
 
         AvatarMixerClientData* clientData = static_cast<AvatarMixerClientData*>(node->getLinkedData());
         if (clientData) {
             MutexTryLocker lock(clientData->getMutex());
             if (lock.isLocked()) {
-                clientData->loadJSONStats(avatarStats);
+                clientData->writeStats(stats);
 
                 // add the diff between the full outbound bandwidth and the measured bandwidth for AvatarData send only
-                avatarStats["delta_full_vs_avatar_data_kbps"] =
-                    (double)outboundAvatarDataKbps - avatarStats[OUTBOUND_AVATAR_DATA_STATS_KEY].toDouble();
+                stats.add("delta_full_vs_avatar_data_kbps",
+                          (double)outboundAvatarDataKbps - (double)clientData->getOutboundAvatarDataKbps());
             }
 
             if (node->getType() != NodeType::Agent) {  // Nodes that aren't avatars
-                const QString displayName
-                    { node->getType() == NodeType::EntityScriptServer ? "ENTITY SCRIPT SERVER" : "ENTITY SERVER" };
-                avatarStats["display_name"] = displayName;
+                // replaces the display name written by writeStats
+                stats.add("display_name", node->getType() == NodeType::EntityScriptServer ?
+                                          "ENTITY SCRIPT SERVER" : "ENTITY SERVER");
             }
         }
 
-        avatarsObject[uuidStringWithoutCurlyBraces(node->getUUID())] = avatarStats;
+        stats.end();
     });
 
-    statsObject["z_avatars"] = avatarsObject;
+    stats.end();
 
-    ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
+    finishStatsPacket();
 
     _sumListeners = 0;
     _sumIdentityPackets = 0;
@@ -12,6 +12,7 @@
 #include "AvatarMixerClientData.h"
 
 #include <algorithm>
+#include <BinaryStats.h>
 #include <udt/PacketHeaders.h>
 
 #include <DependencyManager.h>
@@ -507,20 +508,20 @@ bool AvatarMixerClientData::otherAvatarInView(const AABox& otherAvatarBox) {
                        [&](const ConicalViewFrustum& viewFrustum) { return viewFrustum.intersects(otherAvatarBox); });
 }
 
-void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
-    jsonObject["display_name"] = _avatar->getDisplayName();
-    jsonObject["num_avs_sent_last_frame"] = _numAvatarsSentLastFrame;
-    jsonObject["avg_other_av_starves_per_second"] = getAvgNumOtherAvatarStarvesPerSecond();
-    jsonObject["avg_other_av_skips_per_second"] = getAvgNumOtherAvatarSkipsPerSecond();
-    jsonObject["total_num_out_of_order_sends"] = _numOutOfOrderSends;
+void AvatarMixerClientData::writeStats(BinaryStatsWriter& stats) const {
+    stats.add("display_name", _avatar->getDisplayName());
+    stats.add("num_avs_sent_last_frame", _numAvatarsSentLastFrame);
+    stats.add("avg_other_av_starves_per_second", getAvgNumOtherAvatarStarvesPerSecond());
+    stats.add("avg_other_av_skips_per_second", getAvgNumOtherAvatarSkipsPerSecond());
+    stats.add("total_num_out_of_order_sends", _numOutOfOrderSends);
 
-    jsonObject[OUTBOUND_AVATAR_DATA_STATS_KEY] = getOutboundAvatarDataKbps();
-    jsonObject[OUTBOUND_AVATAR_TRAITS_STATS_KEY] = getOutboundAvatarTraitsKbps();
-    jsonObject[INBOUND_AVATAR_DATA_STATS_KEY] = _avatar->getAverageBytesReceivedPerSecond() / (float)BYTES_PER_KILOBIT;
+    stats.add(OUTBOUND_AVATAR_DATA_STATS_KEY, getOutboundAvatarDataKbps());
+    stats.add(OUTBOUND_AVATAR_TRAITS_STATS_KEY, getOutboundAvatarTraitsKbps());
+    stats.add(INBOUND_AVATAR_DATA_STATS_KEY, _avatar->getAverageBytesReceivedPerSecond() / (float)BYTES_PER_KILOBIT);
 
-    jsonObject["av_data_receive_rate"] = _avatar->getReceiveRate();
-    jsonObject["recent_other_av_in_view"] = _recentOtherAvatarsInView;
-    jsonObject["recent_other_av_out_of_view"] = _recentOtherAvatarsOutOfView;
+    stats.add("av_data_receive_rate", _avatar->getReceiveRate());
+    stats.add("recent_other_av_in_view", _recentOtherAvatarsInView);
+    stats.add("recent_other_av_out_of_view", _recentOtherAvatarsOutOfView);
 }
 
 AvatarMixerClientData::TraitsCheckTimestamp AvatarMixerClientData::getLastOtherAvatarTraitsSendPoint(
@@ -38,6 +38,8 @@ const QString INBOUND_AVATAR_DATA_STATS_KEY = "inbound_av_data_kbps";
 
 struct SlaveSharedData;
 
+class BinaryStatsWriter;
+
 class AvatarMixerClientData : public NodeData {
     Q_OBJECT
 public:
@@ -99,7 +101,7 @@ public:
     float getOutboundAvatarTraitsKbps() const
         { return _avgOtherAvatarTraitsRate.getAverageSampleValuePerSecond() / BYTES_PER_KILOBIT; }
 
-    void loadJSONStats(QJsonObject& jsonObject) const;
+    void writeStats(BinaryStatsWriter& stats) const;
 
     glm::vec3 getPosition() const { return _avatar ? _avatar->getClientGlobalPosition() : glm::vec3(0); }
     bool isRadiusIgnoring(const QUuid& other) const;
@@ -14,6 +14,8 @@
 #include <assert.h>
 #include <algorithm>
 
+#include <BinaryStats.h>
+
 void AvatarMixerSlaveThread::run() {
     while (true) {
         wait();
@@ -118,12 +120,12 @@ void AvatarMixerSlavePool::each(std::function<void(AvatarMixerSlave& slave)> fun
 }
 
 #ifdef DEBUG_EVENT_QUEUE
-void AvatarMixerSlavePool::queueStats(QJsonObject& stats) {
+void AvatarMixerSlavePool::queueStats(BinaryStatsWriter& stats) {
     unsigned i = 0;
     for (auto& slave : _slaves) {
         int queueSize = ::hifi::qt::getEventQueueSize(slave.get());
         QString queueName = QString("avatar_thread_event_queue_%1").arg(i);
-        stats[queueName] = queueSize;
+        stats.add(queueName, queueSize);
 
         i++;
     }
@@ -26,6 +26,7 @@
 
 
 class AvatarMixerSlavePool;
+class BinaryStatsWriter;
 
 class AvatarMixerSlaveThread : public QThread, public AvatarMixerSlave {
     Q_OBJECT
@@ -75,7 +76,7 @@ public:
     void each(std::function<void(AvatarMixerSlave& slave)> functor);
 
 #ifdef DEBUG_EVENT_QUEUE
-    void queueStats(QJsonObject& stats);
+    void queueStats(BinaryStatsWriter& stats);
 #endif
 
     void setNumThreads(int numThreads);
@@ -11,8 +11,12 @@
 
 #include "EntityScriptServer.h"
 
+#include <algorithm>
 #include <mutex>
 
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
 #include <AudioConstants.h>
 #include <AudioInjectorManager.h>
 #include <ClientServerUtils.h>
@@ -54,6 +58,36 @@ void messageHandler(QtMsgType type, const QMessageLogContext& context, const QSt
 
 int EntityScriptServer::_entitiesScriptEngineCount = 0;
 
+static const int MAX_ENTITIES_SCRIPT_ENGINES = 32;
+
+// Picks the engine of an entity script.  The hash of the entity ID spreads the scripts evenly and never moves one
+// while the number of engines is unchanged.
+static size_t entitiesScriptEngineIndex(const EntityItemID& entityID, size_t numEngines) {
+    return qHash(entityID) % numEngines;
+}
+
+// Routes the calls the EntityScriptingInterface makes into entity scripts to the engine running them.
+class ShardedEntitiesScriptEngineProvider : public EntitiesScriptEngineProvider {
+public:
+    ShardedEntitiesScriptEngineProvider(const std::vector<ScriptEnginePointer>& engines) : _engines(engines) {}
+
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params, const QUuid& remoteCallerID) override {
+        getEngine(entityID)->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    }
+
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override {
+        return getEngine(entityID)->getLocalEntityScriptDetails(entityID);
+    }
+
+private:
+    const ScriptEnginePointer& getEngine(const EntityItemID& entityID) const {
+        return _engines[entitiesScriptEngineIndex(entityID, _engines.size())];
+    }
+
+    const std::vector<ScriptEnginePointer> _engines;
+};
+
 EntityScriptServer::EntityScriptServer(ReceivedMessage& message) : ThreadedAssignment(message) {
     qInstallMessageHandler(messageHandler);
 
@@ -130,7 +164,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        auto engine = getEntitiesScriptEngine(entityID);
+        if (engine && engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -159,6 +194,28 @@ void EntityScriptServer::handleSettings() {
 
     auto entityScriptServerSettings = settingsObject[ENTITY_SCRIPT_SERVER_SETTINGS_KEY].toObject();
 
+    const QString AUTO_THREADS = "auto_threads";
+    const QString NUM_THREADS = "num_threads";
+    int numEngines = 1;
+    if (entityScriptServerSettings[AUTO_THREADS].toBool()) {
+        numEngines = QThread::idealThreadCount();
+    } else if (entityScriptServerSettings.contains(NUM_THREADS)) {
+        bool ok;
+        numEngines = entityScriptServerSettings[NUM_THREADS].toString().toInt(&ok);
+        if (!ok) {
+            qCWarning(entity_script_server) << "Error reading the number of script engine threads. Using 1 thread.";
+            numEngines = 1;
+        }
+    }
+    numEngines = std::max(1, std::min(numEngines, MAX_ENTITIES_SCRIPT_ENGINES));
+    qCDebug(entity_script_server) << "Entity scripts run on" << numEngines << "script engine threads";
+    if (numEngines != _numEntitiesScriptEngines) {
+        _numEntitiesScriptEngines = numEngines;
+        if (!_entitiesScriptEngines.empty() && !_shuttingDown) {
+            restartEntitiesScriptEngines();
+        }
+    }
+
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
 
@@ -174,8 +231,16 @@ void EntityScriptServer::handleSettings() {
                 .arg(_maxEntityPPS).arg(_entityPPSPerScript);
 }
 
+int EntityScriptServer::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (const auto& engine : _entitiesScriptEngines) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
+}
+
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = getNumRunningEntityScripts();
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -236,7 +301,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (!_entitiesScriptEngines.empty() && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -250,7 +315,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        getEntitiesScriptEngine(entityID)->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -281,8 +346,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
@@ -319,6 +384,22 @@ void EntityScriptServer::run() {
     connect(tree, &EntityTree::deletingEntity, this, &EntityScriptServer::deletingEntity, Qt::QueuedConnection);
     connect(tree, &EntityTree::addingEntity, this, &EntityScriptServer::addingEntity, Qt::QueuedConnection);
     connect(tree, &EntityTree::entityServerScriptChanging, this, &EntityScriptServer::entityServerScriptChanging, Qt::QueuedConnection);
+
+    // the tree is updated here rather than by one of the engines, so it keeps up however busy the engines are
+    auto treeUpdateTimer = new QTimer(this);
+    treeUpdateTimer->setTimerType(Qt::PreciseTimer);
+    treeUpdateTimer->setInterval(MSECS_PER_SECOND / SCRIPT_FPS);
+    connect(treeUpdateTimer, &QTimer::timeout, this, &EntityScriptServer::updateEntityTree);
+    treeUpdateTimer->start();
+}
+
+void EntityScriptServer::updateEntityTree() {
+    if (_shuttingDown || !_entityViewer.getTree()) {
+        return;
+    }
+    _entityViewer.queryOctree();
+    _entityViewer.getTree()->preUpdate();
+    _entityViewer.getTree()->update();
 }
 
 void EntityScriptServer::cleanupOldKilledListeners() {
@@ -444,7 +525,7 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+ScriptEnginePointer EntityScriptServer::createEntitiesScriptEngine() {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
 
@@ -461,50 +542,94 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->preUpdate();
-        _entityViewer.getTree()->update();
-    });
+    connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
 
     scriptEngines->runScriptInitializers(newEngine);
     newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
+    return newEngine;
+}
+
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    for (auto& engine : _entitiesScriptEngines) {
+        disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+    }
+
+    std::vector<ScriptEnginePointer> newEngines;
+    for (int i = 0; i < _numEntitiesScriptEngines; i++) {
+        newEngines.push_back(createEntitiesScriptEngine());
+    }
+
     // On the entity script server, these are the same
-    DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(newEngineSP);
-    DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(newEngineSP);
+    auto provider = QSharedPointer<EntitiesScriptEngineProvider>(new ShardedEntitiesScriptEngineProvider(newEngines));
+    DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(provider);
+    DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(provider);
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
+    _entitiesScriptEngines.swap(newEngines);
+    _lastExecutionTimesSample = usecTimestampNow();
+}
+
+ScriptEnginePointer EntityScriptServer::getEntitiesScriptEngine(const EntityItemID& entityID) const {
+    if (_entitiesScriptEngines.empty()) {
+        return ScriptEnginePointer();
     }
+    return _entitiesScriptEngines[entitiesScriptEngineIndex(entityID, _entitiesScriptEngines.size())];
+}
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+static bool findServerScriptEntities(const OctreeElementPointer& element, void* extraData) {
+    auto entityIDs = static_cast<std::vector<EntityItemID>*>(extraData);
+    std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](const EntityItemPointer& entity) {
+        if (!entity->getServerScripts().isEmpty()) {
+            entityIDs->push_back(entity->getEntityItemID());
+        }
+    });
+    return true;
 }
 
+void EntityScriptServer::restartEntitiesScriptEngines() {
+    stopEntitiesScriptEngines();
+    resetEntitiesScriptEngines();
+
+    // The tree is kept: the entity server only sends us the entities again when our query connection changes, so the
+    // scripts of the entities we already have are loaded on the new engines here.
+    std::vector<EntityItemID> entityIDs;
+    auto tree = _entityViewer.getTree();
+    if (tree) {
+        tree->withReadLock([&] {
+            tree->recurseTreeWithOperation(findServerScriptEntities, &entityIDs);
+        });
+    }
+    qCDebug(entity_script_server) << "Reloading" << entityIDs.size() << "entity scripts on the new script engines";
+    for (const auto& entityID : entityIDs) {
+        checkAndCallPreload(entityID);
+    }
+}
 
-void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
+void EntityScriptServer::stopEntitiesScriptEngines() {
+    // unload and stop the engines, letting them wind down in parallel
+    for (auto& engine : _entitiesScriptEngines) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
+        engine->unloadAllEntityScripts();
+        engine->stop();
+    }
+    for (auto& engine : _entitiesScriptEngines) {
+        engine->waitTillDoneRunning();
     }
+}
+
+void EntityScriptServer::clear() {
+    stopEntitiesScriptEngines();
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (auto& engine : _entitiesScriptEngines) {
+        engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
@@ -513,7 +638,7 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
+    _entitiesScriptEngines.clear();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -531,8 +656,9 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    auto engine = getEntitiesScriptEngine(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && engine) {
+        engine->unloadEntityScript(entityID, true);
     }
 }
 
@@ -543,20 +669,21 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    auto engine = getEntitiesScriptEngine(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && engine) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        bool isRunning = engine->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             if (isRunning) {
-                _entitiesScriptEngine->unloadEntityScript(entityID, true);
+                engine->unloadEntityScript(entityID, true);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                engine->loadEntityScript(entityID, scriptUrl, forceRedownload);
             }
         }
     }
@@ -571,13 +698,9 @@ void EntityScriptServer::sendStatsPacket() {
     octreeStats["leafElementCount"] = (double)OctreeElement::getLeafNodeCount();
     statsObject["octree_stats"] = octreeStats;
 
-    QJsonObject scriptEngineStats;
-    int numberRunningScripts = 0;
-    const auto scriptEngine = _entitiesScriptEngine;
-    if (scriptEngine) {
-        numberRunningScripts = scriptEngine->getNumRunningEntityScripts();
-    }
-    scriptEngineStats["number_running_scripts"] = numberRunningScripts;
+    QJsonObject scriptEngineStats = sampleEntityScriptExecutionTimes();
+    scriptEngineStats["number_running_scripts"] = getNumRunningEntityScripts();
+    scriptEngineStats["number_engines"] = (int)_entitiesScriptEngines.size();
     statsObject["script_engine_stats"] = scriptEngineStats;
     
 
@@ -610,6 +733,76 @@ void EntityScriptServer::sendStatsPacket() {
     addPacketStatsAndSendStatsPacket(statsObject);
 }
 
+// Collects the execution time of every entity script since the previous sample.  Returns the busiest engine and
+// scripts, and logs the scripts using a noticeable share of their engine to the subscribed log clients.
+QJsonObject EntityScriptServer::sampleEntityScriptExecutionTimes() {
+    struct ScriptTime {
+        EntityItemID entityID;
+        int engine;
+        std::chrono::microseconds time;
+    };
+    std::vector<ScriptTime> scriptTimes;
+    QJsonObject engineStats;
+
+    quint64 now = usecTimestampNow();
+    float sampleSeconds = (float)(now - _lastExecutionTimesSample) / (float)USECS_PER_SECOND;
+    _lastExecutionTimesSample = now;
+    if (sampleSeconds <= 0.0f) {
+        return QJsonObject();
+    }
+
+    float busiestEngineMsPerSecond = 0.0f;
+    for (int i = 0; i < (int)_entitiesScriptEngines.size(); i++) {
+        auto times = _entitiesScriptEngines[i]->takeEntityScriptExecutionTimes();
+        std::chrono::microseconds engineTime { 0 };
+        for (auto it = times.cbegin(); it != times.cend(); ++it) {
+            scriptTimes.push_back({ it.key(), i, it.value() });
+            engineTime += it.value();
+        }
+        float msPerSecond = (float)engineTime.count() / (float)USECS_PER_MSEC / sampleSeconds;
+        busiestEngineMsPerSecond = std::max(busiestEngineMsPerSecond, msPerSecond);
+
+        QJsonObject stats;
+        stats["running_scripts"] = _entitiesScriptEngines[i]->getNumRunningEntityScripts();
+        stats["execution_ms_per_s"] = msPerSecond;
+        engineStats[QString("engine_%1").arg(i)] = stats;
+    }
+
+    static const size_t MAX_REPORTED_SCRIPTS = 10;
+    size_t numReported = std::min(scriptTimes.size(), MAX_REPORTED_SCRIPTS);
+    std::partial_sort(scriptTimes.begin(), scriptTimes.begin() + numReported, scriptTimes.end(),
+        [](const ScriptTime& a, const ScriptTime& b) { return a.time > b.time; });
+
+    // a script taking this much of its engine's time is worth pointing out to the people following the logs
+    static const float LOGGED_SCRIPT_MS_PER_SECOND = 50.0f;
+
+    QJsonObject slowestScripts;
+    for (size_t i = 0; i < numReported; i++) {
+        const auto& scriptTime = scriptTimes[i];
+        float msPerSecond = (float)scriptTime.time.count() / (float)USECS_PER_MSEC / sampleSeconds;
+
+        EntityScriptDetails details;
+        _entitiesScriptEngines[scriptTime.engine]->getEntityScriptDetails(scriptTime.entityID, details);
+
+        QJsonObject stats;
+        stats["engine"] = scriptTime.engine;
+        stats["execution_ms_per_s"] = msPerSecond;
+        stats["script"] = details.scriptText;
+        slowestScripts[uuidStringWithoutCurlyBraces(scriptTime.entityID)] = stats;
+
+        if (msPerSecond >= LOGGED_SCRIPT_MS_PER_SECOND && !_logListeners.empty()) {
+            qCInfo(entity_script_server) << "Entity script" << scriptTime.entityID << details.scriptText << "on engine"
+                << scriptTime.engine << "is taking" << msPerSecond << "ms per second";
+        }
+    }
+
+    QJsonObject stats;
+    stats["busiest_engine_ms_per_s"] = busiestEngineMsPerSecond;
+    stats["engines"] = engineStats;
+    stats["slowest_scripts"] = slowestScripts;
+    return stats;
+}
+
 void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto packetType = message->getType();
 
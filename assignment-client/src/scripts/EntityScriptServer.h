@@ -15,6 +15,7 @@
 #include <set>
 #include <vector>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QUuid>
@@ -62,7 +63,15 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    void resetEntitiesScriptEngines();
+    // restarts every script on a new set of engines, for a new number of engines
+    void restartEntitiesScriptEngines();
+    void stopEntitiesScriptEngines();
+    ScriptEnginePointer createEntitiesScriptEngine();
+    ScriptEnginePointer getEntitiesScriptEngine(const EntityItemID& entityID) const;
+    int getNumRunningEntityScripts() const;
+    void updateEntityTree();
+    QJsonObject sampleEntityScriptExecutionTimes();
     void clear();
     void shutdownScriptEngine();
 
@@ -76,7 +85,13 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+
+    // Entity scripts are sharded by entity ID over several engines, each running on its own thread, so a slow
+    // script only holds up the scripts of its own engine.  The engines share the entity tree.
+    std::vector<ScriptEnginePointer> _entitiesScriptEngines;
+    int _numEntitiesScriptEngines { 1 };
+    quint64 _lastExecutionTimesSample { 0 };
+
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
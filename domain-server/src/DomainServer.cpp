@@ -874,6 +874,8 @@ void DomainServer::setupNodeListAndAssignments() {
         PacketReceiver::makeUnsourcedListenerReference<DomainServer>(this, &DomainServer::processPathQueryPacket));
     packetReceiver.registerListener(PacketType::NodeJsonStats,
         PacketReceiver::makeSourcedListenerReference<DomainServer>(this, &DomainServer::processNodeJSONStatsPacket));
+    packetReceiver.registerListener(PacketType::NodeBinaryStats,
+        PacketReceiver::makeSourcedListenerReference<DomainServer>(this, &DomainServer::processNodeBinaryStatsPacket));
     packetReceiver.registerListener(PacketType::DomainDisconnectRequest,
         PacketReceiver::makeUnsourcedListenerReference<DomainServer>(this, &DomainServer::processNodeDisconnectRequestPacket));
     packetReceiver.registerListener(PacketType::AvatarZonePresence,
@@ -2127,6 +2129,13 @@ void DomainServer::processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> pa
     }
 }
 
+void DomainServer::processNodeBinaryStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
+    auto nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
+    if (nodeData) {
+        nodeData->updateBinaryStats(packetList->getMessage());
+    }
+}
+
 QJsonObject DomainServer::jsonForSocket(const SockAddr& socket) {
     QJsonObject socketJSON;
 
@@ -2532,7 +2541,32 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             }
         }
     } else if (connection->requestOperation() == QNetworkAccessManager::PostOperation) {
-        if (url.path() == URI_ASSIGNMENT) {
+        const QString NODE_TRACE_REGEX_STRING = QString("\\%1\\/(%2)\\/trace\\/?$").arg(URI_NODES).arg(UUID_REGEX_STRING);
+        QRegExp nodeTraceRegex(NODE_TRACE_REGEX_STRING);
+
+        if (nodeTraceRegex.indexIn(url.path()) != -1) {
+            // this is a request to capture a trace on a running assignment client
+            SharedNodePointer matchingNode = nodeList->nodeWithUUID(QUuid(nodeTraceRegex.cap(1)));
+            if (!matchingNode) {
+                connection->respond(HTTPConnection::StatusCode404);
+                return true;
+            }
+
+            const QString TRACE_SECONDS_QUERY_KEY = "seconds";
+            const quint32 DEFAULT_TRACE_SECONDS = 10;
+            bool ok = false;
+            quint32 traceSeconds = QUrlQuery(url).queryItemValue(TRACE_SECONDS_QUERY_KEY).toUInt(&ok);
+            if (!ok || traceSeconds == 0) {
+                traceSeconds = DEFAULT_TRACE_SECONDS;
+            }
+
+            auto tracingPacket = NLPacket::create(PacketType::NodeTracingRequest, sizeof(quint32), true);
+            tracingPacket->writePrimitive(traceSeconds * (quint32)MSECS_PER_SECOND);
+            nodeList->sendPacket(std::move(tracingPacket), *matchingNode);
+
+            connection->respond(HTTPConnection::StatusCode200);
+            return true;
+        } else if (url.path() == URI_ASSIGNMENT) {
             // this is a script upload - ask the HTTPConnection to parse the form data
             QList<FormData> formData = connection->parseFormData();
 
@@ -3386,11 +3420,14 @@ void DomainServer::initializeMetadataExporter() {
 void DomainServer::updateReplicatedNodes() {
     // Make sure we have downstream nodes in our list
     static const QString REPLICATED_USERS_KEY = "users";
+    static const QString REPLICATE_ALL_USERS_KEY = "broadcast_all_users";
     _replicatedUsernames.clear();
+    _replicateAllUsers = false;
 
     auto replicationVariant = _settingsManager.valueForKeyPath(BROADCASTING_SETTINGS_KEY);
     if (replicationVariant.isValid()) {
         auto replicationSettings = replicationVariant.toMap();
+        _replicateAllUsers = replicationSettings.value(REPLICATE_ALL_USERS_KEY, false).toBool();
         if (replicationSettings.contains(REPLICATED_USERS_KEY)) {
             auto usersSettings = replicationSettings.value(REPLICATED_USERS_KEY).toList();
             for (auto& username : usersSettings) {
@@ -3419,6 +3456,12 @@ void DomainServer::updateReplicatedNodes() {
 
 bool DomainServer::shouldReplicateNode(const Node& node) {
     if (node.getType() == NodeType::Agent) {
+        if (_replicateAllUsers) {
+            // every agent's raw streams are forwarded once to each downstream mixer,
+            // which then mixes for its own subset of listeners
+            return true;
+        }
+
         QString verifiedUsername = node.getPermissions().getVerifiedUserName();
 
         // Both the verified username and usernames in _replicatedUsernames are lowercase, so
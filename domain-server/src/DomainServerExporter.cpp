@@ -201,6 +201,8 @@ static const QMap<QString, DomainServerExporter::MetricType> TYPE_MAP {
     { "entity_script_server_octree_stats_element_count"                                           , DomainServerExporter::MetricType::Gauge },
     { "entity_script_server_octree_stats_internal_element_count"                                  , DomainServerExporter::MetricType::Gauge },
     { "entity_script_server_octree_stats_leaf_element_count"                                      , DomainServerExporter::MetricType::Gauge },
+    { "entity_script_server_script_engine_stats_busiest_engine_ms_per_s"                          , DomainServerExporter::MetricType::Gauge },
+    { "entity_script_server_script_engine_stats_number_engines"                                   , DomainServerExporter::MetricType::Gauge },
     { "entity_script_server_script_engine_stats_number_running_scripts"                           , DomainServerExporter::MetricType::Gauge },
     { "entity_server_assignment_stats_num_queued_check_ins"                                       , DomainServerExporter::MetricType::Gauge },
     { "entity_server_entity_server_inbound_data_packet_queue"                                     , DomainServerExporter::MetricType::Gauge },
@@ -17,18 +17,47 @@
 #include <QtCore/QJsonObject>
 #include <QtCore/QVariant>
 
+#include <BinaryStats.h>
 #include <udt/PacketHeaders.h>
 
 DomainServerNodeData::StringPairHash DomainServerNodeData::_overrideHash;
+quint32 DomainServerNodeData::_overrideGeneration { 0 };
 
 DomainServerNodeData::DomainServerNodeData() {
     _paymentIntervalTimer.start();
 }
 
 void DomainServerNodeData::updateJSONStats(QByteArray statsByteArray) {
-    auto document = QJsonDocument::fromBinaryData(statsByteArray);
-    Q_ASSERT(document.isObject());
-    _statsJSONObject = overrideValuesIfNeeded(document.object());
+    // assignment clients send stats every second but they are rarely looked at,
+    // so hold on to the binary data and defer decoding until getStatsJSONObject is called
+    _statsByteArray = statsByteArray;
+    _statsAreBinaryStats = false;
+    _statsJSONObjectDirty = true;
+}
+
+void DomainServerNodeData::updateBinaryStats(QByteArray statsByteArray) {
+    _statsByteArray = statsByteArray;
+    _statsAreBinaryStats = true;
+    _statsJSONObjectDirty = true;
+}
+
+const QJsonObject& DomainServerNodeData::getStatsJSONObject() const {
+    if (_statsJSONObjectDirty || _statsJSONOverrideGeneration != _overrideGeneration) {
+        if (!_statsByteArray.isEmpty()) {
+            QJsonObject stats;
+            if (_statsAreBinaryStats) {
+                stats = binaryStatsToJSON(_statsByteArray);
+            } else {
+                auto document = QJsonDocument::fromBinaryData(_statsByteArray);
+                Q_ASSERT(document.isObject());
+                stats = document.object();
+            }
+            _statsJSONObject = _overrideHash.isEmpty() ? stats : overrideValuesIfNeeded(stats);
+        }
+        _statsJSONObjectDirty = false;
+        _statsJSONOverrideGeneration = _overrideGeneration;
+    }
+    return _statsJSONObject;
 }
 
 QJsonObject DomainServerNodeData::overrideValuesIfNeeded(const QJsonObject& newStats) {
@@ -70,9 +99,11 @@ void DomainServerNodeData::addOverrideForKey(const QString& key, const QString&
                                              const QString& overrideValue) {
     // Insert override value
     _overrideHash.insert({key, value}, overrideValue);
+    ++_overrideGeneration;
 }
 
 void DomainServerNodeData::removeOverrideForKey(const QString& key, const QString& value) {
     // Remove override value
     _overrideHash.remove({key, value});
+    ++_overrideGeneration;
 }
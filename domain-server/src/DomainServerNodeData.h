@@ -28,9 +28,11 @@ class DomainServerNodeData : public NodeData {
 public:
     DomainServerNodeData();
 
-    const QJsonObject& getStatsJSONObject() const { return _statsJSONObject; }
+    // the stats are kept in their received binary form and only turned into JSON when someone asks for them
+    const QJsonObject& getStatsJSONObject() const;
 
     void updateJSONStats(QByteArray statsByteArray);
+    void updateBinaryStats(QByteArray statsByteArray);
 
     void setAssignmentUUID(const QUuid& assignmentUUID) { _assignmentUUID = assignmentUUID; }
     const QUuid& getAssignmentUUID() const { return _assignmentUUID; }
@@ -79,8 +81,8 @@ public:
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
     
 private:
-    QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
-    QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats);
+    static QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
+    static QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats);
     
     QHash<QUuid, QUuid> _sessionSecretHash;
     QUuid _assignmentUUID;
@@ -89,8 +91,13 @@ private:
     QElapsedTimer _paymentIntervalTimer;
     
     using StringPairHash = QHash<QPair<QString, QString>, QString>;
-    QJsonObject _statsJSONObject;
+    QByteArray _statsByteArray;
+    bool _statsAreBinaryStats { false }; // written by BinaryStatsWriter rather than QJsonDocument::toBinaryData
+    mutable QJsonObject _statsJSONObject;
+    mutable bool _statsJSONObjectDirty { false };
+    mutable quint32 _statsJSONOverrideGeneration { 0 };
     static StringPairHash _overrideHash;
+    static quint32 _overrideGeneration;
     
     SockAddr _sendingSockAddr;
     bool _isAuthenticated = true;
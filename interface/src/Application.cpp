@@ -2455,6 +2455,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         glm::vec2 pos2D = DependencyManager::get<HMDScriptingInterface>()->overlayFromWorldPoint(intersection);
         return glm::max(MARGIN, glm::min(pos2D, maxPos));
     });
+    DependencyManager::get<PickManager>()->setRayEntityBatchOperator(&RayPick::getEntityIntersections);
 
     // Setup the mouse ray pick and related operators
     {
@@ -256,31 +256,6 @@ void LODManager::setAutomaticLODAdjust(bool value) {
     emit autoLODChanged();
 }
 
-bool LODManager::shouldRender(const RenderArgs* args, const AABox& bounds) {
-    // To decide if the bound should be rendered or not at the specified Args->lodAngle,
-    // we need to compute the apparent angle of the bound from the frustum origin,
-    // and compare it against the lodAngle, if it is greater or equal we should render the content of that bound.
-    // we abstract the bound as a sphere centered on the bound center and of radius half diagonal of the bound.
-
-    // Instead of comparing  angles, we are comparing the tangent of the half angle which are more efficient to compute:
-    // we are comparing the square of the half tangent apparent angle for the bound against the LODAngle Half tangent square
-    // if smaller, the bound is too small and we should NOT render it, return true otherwise.
-
-    // Tangent Adjacent side is eye to bound center vector length
-    auto pos = args->getViewFrustum().getPosition() - bounds.calcCenter();
-    auto halfTanAdjacentSq = glm::dot(pos, pos);
-
-    // Tangent Opposite side is the half length of the dimensions vector of the bound
-    auto dim = bounds.getDimensions();
-    auto halfTanOppositeSq = 0.25f * glm::dot(dim, dim);
-
-    // The test is:
-    // isVisible = halfTanSq >= lodHalfTanSq = (halfTanOppositeSq / halfTanAdjacentSq) >= lodHalfTanSq
-    // which we express as below to avoid division
-    // (halfTanOppositeSq) >= lodHalfTanSq * halfTanAdjacentSq
-    return (halfTanOppositeSq >= args->_lodAngleHalfTanSq * halfTanAdjacentSq);
-};
-
 void LODManager::setOctreeSizeScale(float sizeScale) {
     setVisibilityDistance(sizeScale / TREE_SCALE);
 }
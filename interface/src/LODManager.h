@@ -264,7 +264,6 @@ public:
     float getBatchTime() const { return _batchTime; }
     float getGPUTime() const { return _gpuTime; }
 
-    static bool shouldRender(const RenderArgs* args, const AABox& bounds);
     void setRenderTimes(float presentTime, float engineRunTime, float batchTime, float gpuTime);
     void autoAdjustLOD(float realTimeDelta);
 
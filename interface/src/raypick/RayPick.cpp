@@ -25,19 +25,19 @@ PickRay RayPick::getMathematicalPick() const {
     return PickRay(origin, direction);
 }
 
-PickResultPointer RayPick::getEntityIntersection(const PickRay& pick) {
-    PickFilter searchFilter = getFilter();
+PickFilter RayPick::getEntitySearchFilter(const PickFilter& filter) {
+    PickFilter searchFilter = filter;
     if (DependencyManager::get<PickManager>()->getForceCoarsePicking()) {
         searchFilter.setFlag(PickFilter::COARSE, true);
         searchFilter.setFlag(PickFilter::PRECISE, false);
     }
+    return searchFilter;
+}
 
-    RayToEntityIntersectionResult entityRes =
-        DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVector(pick, searchFilter,
-            getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>());
+PickResultPointer RayPick::makeEntityResult(const PickFilter& filter, const RayToEntityIntersectionResult& entityRes, const PickRay& pick) {
     if (entityRes.intersects) {
         IntersectionType type = IntersectionType::ENTITY;
-        if (getFilter().doesPickLocalEntities()) {
+        if (filter.doesPickLocalEntities()) {
             EntityPropertyFlags desiredProperties;
             desiredProperties += PROP_ENTITY_HOST_TYPE;
             if (DependencyManager::get<EntityScriptingInterface>()->getEntityProperties(entityRes.entityID, desiredProperties).getEntityHostType() == entity::HostType::LOCAL) {
@@ -50,6 +50,36 @@ PickResultPointer RayPick::getEntityIntersection(const PickRay& pick) {
     }
 }
 
+PickResultPointer RayPick::getEntityIntersection(const PickRay& pick) {
+    RayToEntityIntersectionResult entityRes =
+        DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVector(pick, getEntitySearchFilter(getFilter()),
+            getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>());
+    return makeEntityResult(getFilter(), entityRes, pick);
+}
+
+std::vector<PickResultPointer> RayPick::getEntityIntersections(const std::vector<std::shared_ptr<Pick<PickRay>>>& picks,
+        const std::vector<PickRay>& mathPicks) {
+    std::vector<RayPacketQuery> rays(picks.size());
+    for (size_t i = 0; i < picks.size(); i++) {
+        RayPacketQuery& ray = rays[i];
+        ray.origin = mathPicks[i].origin;
+        ray.direction = mathPicks[i].direction;
+        ray.searchFilter = getEntitySearchFilter(picks[i]->getFilter());
+        ray.entityIdsToInclude = picks[i]->getIncludeItemsAs<EntityItemID>();
+        ray.entityIdsToDiscard = picks[i]->getIgnoreItemsAs<EntityItemID>();
+    }
+
+    std::vector<RayToEntityIntersectionResult> entityResults =
+        DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionsVector(rays);
+
+    std::vector<PickResultPointer> results;
+    results.reserve(picks.size());
+    for (size_t i = 0; i < picks.size(); i++) {
+        results.push_back(makeEntityResult(picks[i]->getFilter(), entityResults[i], mathPicks[i]));
+    }
+    return results;
+}
+
 PickResultPointer RayPick::getAvatarIntersection(const PickRay& pick) {
     bool precisionPicking = !(getFilter().isCoarse() || DependencyManager::get<PickManager>()->getForceCoarsePicking());
     RayToAvatarIntersectionResult avatarRes = DependencyManager::get<AvatarManager>()->findRayIntersectionVector(pick, getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>(), precisionPicking);
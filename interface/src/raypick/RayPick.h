@@ -12,6 +12,7 @@
 #include <Pick.h>
 
 class EntityItemID;
+class RayToEntityIntersectionResult;
 
 class RayPickResult : public PickResult {
 public:
@@ -98,6 +99,11 @@ public:
     PickResultPointer getHUDIntersection(const PickRay& pick) override;
     Transform getResultTransform() const override;
 
+    // Traces the entity intersections of many ray picks in one pass over the entity tree, one result per pick.
+    // Used as the PickManager's ray entity batch operator.
+    static std::vector<PickResultPointer> getEntityIntersections(const std::vector<std::shared_ptr<Pick<PickRay>>>& picks,
+        const std::vector<PickRay>& mathPicks);
+
     // These are helper functions for projecting and intersecting rays
     static glm::vec3 intersectRayWithEntityXYPlane(const QUuid& entityID, const glm::vec3& origin, const glm::vec3& direction);
     static glm::vec2 projectOntoEntityXYPlane(const QUuid& entityID, const glm::vec3& worldPos, bool unNormalized = true);
@@ -106,6 +112,9 @@ public:
     static glm::vec2 projectOntoXZPlane(const glm::vec3& worldPos, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& dimensions, const glm::vec3& registrationPoint, bool unNoemalized);
 
 private:
+    static PickFilter getEntitySearchFilter(const PickFilter& filter);
+    static PickResultPointer makeEntityResult(const PickFilter& filter, const RayToEntityIntersectionResult& entityRes, const PickRay& pick);
+
     static glm::vec3 intersectRayWithXYPlane(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& point, const glm::quat& rotation, const glm::vec3& registration);
 };
 
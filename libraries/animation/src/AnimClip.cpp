@@ -263,48 +263,19 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     // poll network anim to see if it's finished loading yet.
     if (_blendType == AnimBlendType_Normal) {
         if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
-
-            // we no longer need the actual animation resource anymore.
-            _networkAnim.reset();
-
-            // mirrorAnim will be re-built on demand, if needed.
-            _mirrorAnim.clear();
-
-            _poses.resize(_skeleton->getNumJoints());
+            retargetAnim();
         }
     } else {
         // an additive blend type
         if (_networkAnim && _networkAnim->isLoaded() && _baseNetworkAnim && _baseNetworkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
-
-            // we no longer need the actual animation resource anymore.
-            _networkAnim.reset();
-
-            // mirrorAnim will be re-built on demand, if needed.
-            // TODO: handle mirrored relative animations.
-            _mirrorAnim.clear();
-
-            _poses.resize(_skeleton->getNumJoints());
-
-            // copy & retarget baseAnim!
-            auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
-
-            if (_blendType == AnimBlendType_AddAbsolute) {
-                bakeAbsoluteDeltaAnim(_anim, baseAnim[(int)_baseFrame], _skeleton);
-            } else {
-                // AnimBlendType_AddRelative
-                bakeRelativeDeltaAnim(_anim, baseAnim[(int)_baseFrame]);
-            }
+            retargetAnim();
         }
     }
 
-    if (_anim.size()) {
+    if (_anim && _anim->getNumFrames() > 0) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
+        if (_mirrorFlag && !_mirrorAnim) {
             buildMirrorAnim();
         }
 
@@ -318,15 +289,17 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _anim->getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        // only the two frames we need are decompressed.
+        const CompressedAnimation& anim = _mirrorFlag ? *_mirrorAnim : *_anim;
+        anim.sampleFrame(prevIndex, _prevPoses);
+        anim.sampleFrame(nextIndex, _nextPoses);
         float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        ::blend(_poses.size(), &_prevPoses[0], &_nextPoses[0], alpha, &_poses[0]);
     }
 
     processOutputJoints(triggersOut);
@@ -341,14 +314,68 @@ void AnimClip::setCurrentFrameInternal(float frame) {
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame + _startFrame, dt, _loopFlag, _id, triggers);
 }
 
-void AnimClip::buildMirrorAnim() {
+AnimationCache::RetargetKey AnimClip::getRetargetKey(bool mirror) const {
+    AnimationCache::RetargetKey key;
+    key.url = _url;
+    key.skeletonHash = _skeleton->getHash();
+    key.mirror = mirror;
+    key.blendType = (int)_blendType;
+    if (_blendType != AnimBlendType_Normal) {
+        // base animation only matters for additive clips
+        key.baseURL = _baseURL;
+        key.baseFrame = _baseFrame;
+    }
+    return key;
+}
+
+void AnimClip::retargetAnim() {
     assert(_skeleton);
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+    // other clips playing this animation on an identical skeleton may have already retargeted it.
+    auto animCache = DependencyManager::get<AnimationCache>();
+    AnimationCache::RetargetKey key = getRetargetKey(false);
+    _anim = animCache->getRetargetedAnimation(key);
+    if (!_anim) {
+        // loading is complete, copy & retarget animation.
+        auto anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+
+        if (_blendType != AnimBlendType_Normal) {
+            // copy & retarget baseAnim!
+            auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
+
+            if (_blendType == AnimBlendType_AddAbsolute) {
+                bakeAbsoluteDeltaAnim(anim, baseAnim[(int)_baseFrame], _skeleton);
+            } else {
+                // AnimBlendType_AddRelative
+                bakeRelativeDeltaAnim(anim, baseAnim[(int)_baseFrame]);
+            }
+        }
+        _anim = animCache->addRetargetedAnimation(key, anim);
+    }
+
+    // we no longer need the actual animation resource anymore.
+    _networkAnim.reset();
+
+    // mirrorAnim will be re-built on demand, if needed.
+    // TODO: handle mirrored relative animations.
+    _mirrorAnim.reset();
+
+    _poses.resize(_skeleton->getNumJoints());
+}
+
+void AnimClip::buildMirrorAnim() {
+    assert(_skeleton && _anim);
+
+    auto animCache = DependencyManager::get<AnimationCache>();
+    AnimationCache::RetargetKey key = getRetargetKey(true);
+    _mirrorAnim = animCache->getRetargetedAnimation(key);
+    if (!_mirrorAnim) {
+        AnimationCache::PoseTrack mirrorAnim(_anim->getNumFrames());
+        for (int frame = 0; frame < _anim->getNumFrames(); frame++) {
+            _anim->sampleFrame(frame, mirrorAnim[frame]);
+            _skeleton->mirrorRelativePoses(mirrorAnim[frame]);
+        }
+        _mirrorAnim = animCache->addRetargetedAnimation(key, mirrorAnim);
     }
 }
 
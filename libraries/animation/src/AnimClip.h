@@ -61,7 +61,9 @@ protected:
 
     virtual void setCurrentFrameInternal(float frame) override;
 
+    void retargetAnim();
     void buildMirrorAnim();
+    AnimationCache::RetargetKey getRetargetKey(bool mirror) const;
 
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
@@ -71,9 +73,13 @@ protected:
 
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // shared with every other clip playing this animation on an identical skeleton.
+    AnimationCache::RetargetedAnimationPointer _anim;
+    AnimationCache::RetargetedAnimationPointer _mirrorAnim;
+
+    // frames sampled from _anim or _mirrorAnim, blended into _poses
+    AnimPoseVec _prevPoses;
+    AnimPoseVec _nextPoses;
 
     QString _url;
     float _startFrame;
@@ -16,6 +16,25 @@
 
 #include "AnimationLogging.h"
 
+static void hashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+static void hashCombine(size_t& seed, const glm::vec3& v) {
+    std::hash<float> hasher;
+    hashCombine(seed, hasher(v.x));
+    hashCombine(seed, hasher(v.y));
+    hashCombine(seed, hasher(v.z));
+}
+
+static void hashCombine(size_t& seed, const glm::quat& q) {
+    std::hash<float> hasher;
+    hashCombine(seed, hasher(q.x));
+    hashCombine(seed, hasher(q.y));
+    hashCombine(seed, hasher(q.z));
+    hashCombine(seed, hasher(q.w));
+}
+
 AnimSkeleton::AnimSkeleton(const HFMModel& hfmModel) {
 
     _geometryOffset = hfmModel.offset;
@@ -294,6 +313,20 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
             _mirrorMap.push_back(i);
         }
     }
+
+    // hash the skeleton, so retargeted animations can be shared between identical skeletons.
+    _hash = 0;
+    for (int i = 0; i < 4; i++) {
+        hashCombine(_hash, glm::vec3(_geometryOffset[i]));
+        hashCombine(_hash, std::hash<float>()(_geometryOffset[i].w));
+    }
+    for (int i = 0; i < _jointsSize; i++) {
+        hashCombine(_hash, (size_t)qHash(_joints[i].name));
+        hashCombine(_hash, (size_t)(_parentIndices[i] + 1));
+        hashCombine(_hash, _relativeDefaultPoses[i].scale());
+        hashCombine(_hash, _relativeDefaultPoses[i].rot());
+        hashCombine(_hash, _relativeDefaultPoses[i].trans());
+    }
 }
 
 void AnimSkeleton::dump(bool verbose) const {
@@ -40,6 +40,10 @@ public:
     const AnimPoseVec& getAbsoluteDefaultPoses() const { return _absoluteDefaultPoses; }
     const glm::mat4& getGeometryOffset() const { return _geometryOffset; }
 
+    // hash of everything animation retargeting depends on: joint names, hierarchy, default poses and geometry offset.
+    // skeletons built from the same model have the same hash.
+    size_t getHash() const { return _hash; }
+
     // get pre transform which should include FBX pre potations
     const AnimPose& getPreRotationPose(int jointIndex) const;
 
@@ -88,6 +92,7 @@ protected:
     QHash<QString, int> _jointIndicesByName;
     std::vector<std::vector<HFMCluster>> _clusterBindMatrixOriginalValues;
     glm::mat4 _geometryOffset;
+    size_t _hash { 0 };
 
     // no copies
     AnimSkeleton(const AnimSkeleton&) = delete;
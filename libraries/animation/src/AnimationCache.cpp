@@ -36,6 +36,67 @@ AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
     return getResource(url).staticCast<Animation>();
 }
 
+bool AnimationCache::RetargetKey::operator==(const RetargetKey& other) const {
+    return url == other.url && skeletonHash == other.skeletonHash && mirror == other.mirror &&
+        blendType == other.blendType && baseURL == other.baseURL && baseFrame == other.baseFrame;
+}
+
+size_t AnimationCache::RetargetKeyHash::operator()(const RetargetKey& key) const {
+    size_t seed = qHash(key.url);
+    seed ^= key.skeletonHash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= (size_t)((key.blendType << 1) | (key.mirror ? 1 : 0)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= (size_t)qHash(key.baseURL) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<float>()(key.baseFrame) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+AnimationCache::RetargetedAnimationPointer AnimationCache::getRetargetedAnimation(const RetargetKey& key) {
+    std::lock_guard<std::mutex> lock(_retargetMutex);
+    auto iter = _retargetedAnimations.find(key);
+    if (iter != _retargetedAnimations.end()) {
+        auto poses = iter->second.lock();
+        if (!poses) {
+            _retargetedAnimations.erase(iter);
+        }
+        return poses;
+    }
+    return RetargetedAnimationPointer();
+}
+
+AnimationCache::RetargetedAnimationPointer AnimationCache::addRetargetedAnimation(const RetargetKey& key, const PoseTrack& poses) {
+    // compress outside of the lock, it is the expensive part.
+    auto animation = std::make_shared<const CompressedAnimation>(poses);
+
+    std::lock_guard<std::mutex> lock(_retargetMutex);
+    auto& entry = _retargetedAnimations[key];
+    auto existing = entry.lock();
+    if (existing) {
+        return existing;
+    }
+    entry = animation;
+
+    // drop entries whose clips have all gone away
+    for (auto iter = _retargetedAnimations.begin(); iter != _retargetedAnimations.end();) {
+        if (iter->second.expired()) {
+            iter = _retargetedAnimations.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    return animation;
+}
+
+int AnimationCache::getNumRetargetedAnimations() {
+    std::lock_guard<std::mutex> lock(_retargetMutex);
+    int count = 0;
+    for (auto& entry : _retargetedAnimations) {
+        if (!entry.second.expired()) {
+            count++;
+        }
+    }
+    return count;
+}
+
 QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url) {
     return QSharedPointer<Animation>(new Animation(url), &Resource::deleter);
 }
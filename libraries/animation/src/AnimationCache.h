@@ -12,6 +12,9 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <mutex>
+#include <unordered_map>
+
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 #include <QtScript/QScriptEngine>
@@ -21,6 +24,9 @@
 #include <hfm/HFM.h>
 #include <ResourceCache.h>
 
+#include "AnimPose.h"
+#include "CompressedAnimation.h"
+
 class Animation;
 
 using AnimationPointer = QSharedPointer<Animation>;
@@ -34,6 +40,32 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    // an animation retargeted onto a skeleton, poses[frame][joint]
+    using PoseTrack = std::vector<AnimPoseVec>;
+    using RetargetedAnimationPointer = std::shared_ptr<const CompressedAnimation>;
+
+    // identifies a retargeted animation.  Clips playing the same animation on identical skeletons
+    // with the same mirror and blend settings share a single immutable CompressedAnimation.
+    struct RetargetKey {
+        QString url;
+        size_t skeletonHash { 0 };
+        bool mirror { false };
+        int blendType { 0 };
+        QString baseURL;
+        float baseFrame { 0.0f };
+
+        bool operator==(const RetargetKey& other) const;
+    };
+
+    // returns nullptr if no live clip holds a retargeted animation for key.
+    RetargetedAnimationPointer getRetargetedAnimation(const RetargetKey& key);
+
+    // compresses poses and shares them with every later lookup of key.  If another thread added the same key first,
+    // its animation is returned instead.
+    RetargetedAnimationPointer addRetargetedAnimation(const RetargetKey& key, const PoseTrack& poses);
+
+    int getNumRetargetedAnimations();
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
@@ -42,6 +74,13 @@ private:
     explicit AnimationCache(QObject* parent = NULL);
     virtual ~AnimationCache() { }
 
+    struct RetargetKeyHash {
+        size_t operator()(const RetargetKey& key) const;
+    };
+
+    // entries are weak, a retargeted animation lives as long as the clips that play it.
+    std::mutex _retargetMutex;
+    std::unordered_map<RetargetKey, std::weak_ptr<const CompressedAnimation>, RetargetKeyHash> _retargetedAnimations;
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
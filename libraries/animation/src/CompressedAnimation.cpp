@@ -0,0 +1,250 @@
+//
+//  CompressedAnimation.cpp
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CompressedAnimation.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include <GLMHelpers.h>
+
+#include "AnimationLogging.h"
+#include "AnimUtil.h"
+
+const float CompressedAnimation::ROTATION_TOLERANCE = 0.002f;
+const float CompressedAnimation::TRANSLATION_TOLERANCE = 0.001f;
+const float CompressedAnimation::SCALE_TOLERANCE = 0.0001f;
+
+// key frames are stored as 16 bit frame numbers.
+static const int MAX_FRAMES = std::numeric_limits<uint16_t>::max() + 1;
+
+// bounds the cost of keyframe reduction, which grows with the square of the distance between keys.
+static const int MAX_KEY_SPACING = 64;
+
+static const int QUANTIZED_COMPONENT_MAX = (1 << 15) - 1;
+
+static float rotationError(const glm::quat& a, const glm::quat& b) {
+    float dot = std::min(fabsf(glm::dot(a, b)), 1.0f);
+    return 2.0f * acosf(dot);
+}
+
+static float vec3Error(const glm::vec3& a, const glm::vec3& b) {
+    return glm::length(a - b);
+}
+
+// Picks the keys of a single track.  candidates are the values that would be stored for each frame and
+// exact are the original values; a frame can be dropped if interpolating the candidates of the surrounding keys
+// stays within tolerance of its exact value.  The first and last frames are always keys, unless the whole track is constant.
+template <typename T, typename LerpFunc, typename ErrorFunc>
+static void reduceKeyFrames(const std::vector<T>& candidates, const std::vector<T>& exact, float tolerance,
+                            LerpFunc lerpFunc, ErrorFunc errorFunc, std::vector<int>& keysOut) {
+    keysOut.clear();
+    int numFrames = (int)exact.size();
+
+    bool isConstant = true;
+    for (int frame = 0; frame < numFrames && isConstant; frame++) {
+        isConstant = errorFunc(candidates[0], exact[frame]) <= tolerance;
+    }
+    keysOut.push_back(0);
+    if (isConstant) {
+        return;
+    }
+
+    auto segmentFits = [&](int start, int end) {
+        for (int frame = start + 1; frame < end; frame++) {
+            float alpha = (float)(frame - start) / (float)(end - start);
+            if (errorFunc(lerpFunc(candidates[start], candidates[end], alpha), exact[frame]) > tolerance) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    int start = 0;
+    int end = 1;
+    while (end < numFrames) {
+        if (end + 1 < numFrames && end + 1 - start <= MAX_KEY_SPACING && segmentFits(start, end + 1)) {
+            end++;
+        } else {
+            keysOut.push_back(end);
+            start = end;
+            end = start + 1;
+        }
+    }
+}
+
+CompressedAnimation::CompressedAnimation(const std::vector<AnimPoseVec>& poses) {
+    _numFrames = (int)poses.size();
+    if (_numFrames > MAX_FRAMES) {
+        qCWarning(animation) << "CompressedAnimation: truncating animation of" << _numFrames << "frames to" << MAX_FRAMES;
+        _numFrames = MAX_FRAMES;
+    }
+    _numJoints = _numFrames > 0 ? (int)poses[0].size() : 0;
+
+    _scaleTracks.resize(_numJoints);
+    _rotationTracks.resize(_numJoints);
+    _translationTracks.resize(_numJoints);
+
+    std::vector<glm::vec3> exactVec3s(_numFrames);
+    std::vector<glm::quat> exactRotations(_numFrames);
+    std::vector<glm::quat> quantizedRotations(_numFrames);
+    std::vector<int> keys;
+    keys.reserve(_numFrames);
+
+    auto addVec3Track = [&](Track& track, std::vector<uint16_t>& keyFrames, std::vector<glm::vec3>& values, float tolerance) {
+        reduceKeyFrames(exactVec3s, exactVec3s, tolerance,
+                        [](const glm::vec3& a, const glm::vec3& b, float alpha) { return lerp(a, b, alpha); },
+                        vec3Error, keys);
+        track.offset = (uint32_t)keyFrames.size();
+        track.numKeys = (uint32_t)keys.size();
+        for (int key : keys) {
+            keyFrames.push_back((uint16_t)key);
+            values.push_back(exactVec3s[key]);
+        }
+    };
+
+    for (int joint = 0; joint < _numJoints; joint++) {
+        for (int frame = 0; frame < _numFrames; frame++) {
+            assert((int)poses[frame].size() == _numJoints);
+            exactVec3s[frame] = poses[frame][joint].scale();
+        }
+        addVec3Track(_scaleTracks[joint], _scaleKeyFrames, _scales, SCALE_TOLERANCE);
+
+        for (int frame = 0; frame < _numFrames; frame++) {
+            exactVec3s[frame] = poses[frame][joint].trans();
+        }
+        addVec3Track(_translationTracks[joint], _translationKeyFrames, _translations, TRANSLATION_TOLERANCE);
+
+        // reduce against the quantized rotations, so the tolerance bounds the error of what is actually stored.
+        for (int frame = 0; frame < _numFrames; frame++) {
+            exactRotations[frame] = poses[frame][joint].rot();
+            quantizedRotations[frame] = dequantize(quantize(exactRotations[frame]));
+        }
+        reduceKeyFrames(quantizedRotations, exactRotations, ROTATION_TOLERANCE, safeLerp, rotationError, keys);
+        Track& track = _rotationTracks[joint];
+        track.offset = (uint32_t)_rotationKeyFrames.size();
+        track.numKeys = (uint32_t)keys.size();
+        for (int key : keys) {
+            _rotationKeyFrames.push_back((uint16_t)key);
+            _rotations.push_back(quantize(exactRotations[key]));
+        }
+    }
+
+    _scaleKeyFrames.shrink_to_fit();
+    _scales.shrink_to_fit();
+    _rotationKeyFrames.shrink_to_fit();
+    _rotations.shrink_to_fit();
+    _translationKeyFrames.shrink_to_fit();
+    _translations.shrink_to_fit();
+}
+
+uint32_t CompressedAnimation::findKey(const Track& track, const std::vector<uint16_t>& keyFrames, int frame, float& alpha) {
+    alpha = 0.0f;
+    if (track.numKeys <= 1) {
+        return track.offset;
+    }
+
+    // last key at or before frame
+    auto begin = keyFrames.begin() + track.offset;
+    auto end = begin + track.numKeys;
+    auto next = std::upper_bound(begin, end, (uint16_t)frame);
+    if (next == begin) {
+        return track.offset;
+    }
+    if (next == end) {
+        return track.offset + track.numKeys - 1;
+    }
+    auto key = next - 1;
+    alpha = (float)(frame - *key) / (float)(*next - *key);
+    return (uint32_t)(key - keyFrames.begin());
+}
+
+glm::vec3 CompressedAnimation::sampleScale(int frame, int joint) const {
+    float alpha;
+    uint32_t key = findKey(_scaleTracks[joint], _scaleKeyFrames, frame, alpha);
+    return alpha > 0.0f ? lerp(_scales[key], _scales[key + 1], alpha) : _scales[key];
+}
+
+glm::quat CompressedAnimation::sampleRotation(int frame, int joint) const {
+    float alpha;
+    uint32_t key = findKey(_rotationTracks[joint], _rotationKeyFrames, frame, alpha);
+    glm::quat rotation = dequantize(_rotations[key]);
+    return alpha > 0.0f ? safeLerp(rotation, dequantize(_rotations[key + 1]), alpha) : rotation;
+}
+
+glm::vec3 CompressedAnimation::sampleTranslation(int frame, int joint) const {
+    float alpha;
+    uint32_t key = findKey(_translationTracks[joint], _translationKeyFrames, frame, alpha);
+    return alpha > 0.0f ? lerp(_translations[key], _translations[key + 1], alpha) : _translations[key];
+}
+
+AnimPose CompressedAnimation::samplePose(int frame, int joint) const {
+    assert(frame >= 0 && frame < _numFrames && joint >= 0 && joint < _numJoints);
+    return AnimPose(sampleScale(frame, joint), sampleRotation(frame, joint), sampleTranslation(frame, joint));
+}
+
+void CompressedAnimation::sampleFrame(int frame, AnimPoseVec& poses) const {
+    assert(frame >= 0 && frame < _numFrames);
+    poses.resize(_numJoints);
+    for (int joint = 0; joint < _numJoints; joint++) {
+        poses[joint] = samplePose(frame, joint);
+    }
+}
+
+size_t CompressedAnimation::getMemorySize() const {
+    size_t tracksSize = (_scaleTracks.size() + _rotationTracks.size() + _translationTracks.size()) * sizeof(Track);
+    size_t keyFramesSize = (_scaleKeyFrames.size() + _rotationKeyFrames.size() + _translationKeyFrames.size()) * sizeof(uint16_t);
+    size_t valuesSize = (_scales.size() + _translations.size()) * sizeof(glm::vec3) + _rotations.size() * sizeof(QuantizedQuat);
+    return tracksSize + keyFramesSize + valuesSize;
+}
+
+// smallest three: drop the largest component, which is recovered from the unit length, and store the other three
+// in 15 bits each.  The index of the dropped component goes in the low bits of the first two words.
+CompressedAnimation::QuantizedQuat CompressedAnimation::quantize(const glm::quat& rotation) {
+    glm::quat q = glm::normalize(rotation);
+    int largest = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabsf(q[i]) > fabsf(q[largest])) {
+            largest = i;
+        }
+    }
+    if (q[largest] < 0.0f) {
+        q = -q;
+    }
+
+    QuantizedQuat quantized;
+    int component = 0;
+    for (int i = 0; i < 4; i++) {
+        if (i != largest) {
+            float normalized = glm::clamp(q[i] / (float)M_SQRT1_2, -1.0f, 1.0f) * 0.5f + 0.5f;
+            uint16_t value = (uint16_t)(normalized * (float)QUANTIZED_COMPONENT_MAX + 0.5f);
+            quantized.data[component] = (uint16_t)(value << 1);
+            component++;
+        }
+    }
+    quantized.data[0] |= (uint16_t)(largest & 1);
+    quantized.data[1] |= (uint16_t)((largest >> 1) & 1);
+    return quantized;
+}
+
+glm::quat CompressedAnimation::dequantize(const QuantizedQuat& quantized) {
+    int largest = (quantized.data[0] & 1) | ((quantized.data[1] & 1) << 1);
+    glm::quat q;
+    float sumSquares = 0.0f;
+    int component = 0;
+    for (int i = 0; i < 4; i++) {
+        if (i != largest) {
+            float normalized = (float)(quantized.data[component] >> 1) / (float)QUANTIZED_COMPONENT_MAX;
+            q[i] = (normalized * 2.0f - 1.0f) * (float)M_SQRT1_2;
+            sumSquares += q[i] * q[i];
+            component++;
+        }
+    }
+    q[largest] = sqrtf(std::max(0.0f, 1.0f - sumSquares));
+    return glm::normalize(q);
+}
@@ -0,0 +1,81 @@
+//
+//  CompressedAnimation.h
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CompressedAnimation_h
+#define hifi_CompressedAnimation_h
+
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "AnimPose.h"
+
+// Immutable, compact storage for an animation that has been retargeted onto a skeleton.
+// The scale, rotation and translation of every joint are stored as separate tracks:
+//   * a track that never changes is stored as a single key,
+//   * other tracks only keep the keyframes that linear interpolation between their neighbors can't reproduce,
+//   * rotations are quantized to 48 bits using the smallest-three encoding.
+// Frames are sampled directly from the tracks, the animation is never decompressed as a whole.
+class CompressedAnimation {
+public:
+    // maximum error introduced by keyframe reduction, on top of rotation quantization.
+    static const float ROTATION_TOLERANCE;    // radians
+    static const float TRANSLATION_TOLERANCE; // geometry units
+    static const float SCALE_TOLERANCE;
+
+    // poses[frame][joint], all frames must have the same number of joints.
+    explicit CompressedAnimation(const std::vector<AnimPoseVec>& poses);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return _numJoints; }
+
+    AnimPose samplePose(int frame, int joint) const;
+
+    // resizes poses to getNumJoints() and fills it with the poses at frame.
+    void sampleFrame(int frame, AnimPoseVec& poses) const;
+
+    // bytes used by the tracks, not counting the object itself.
+    size_t getMemorySize() const;
+
+    struct QuantizedQuat {
+        uint16_t data[3];
+    };
+
+    static QuantizedQuat quantize(const glm::quat& rotation);
+    static glm::quat dequantize(const QuantizedQuat& quantized);
+
+protected:
+    struct Track {
+        uint32_t offset { 0 };  // of the first key in the key frame and value arrays of this channel
+        uint32_t numKeys { 0 };
+    };
+
+    // finds the keys surrounding frame, returns the index of the first one and the blend factor towards the next.
+    static uint32_t findKey(const Track& track, const std::vector<uint16_t>& keyFrames, int frame, float& alpha);
+
+    glm::vec3 sampleScale(int frame, int joint) const;
+    glm::quat sampleRotation(int frame, int joint) const;
+    glm::vec3 sampleTranslation(int frame, int joint) const;
+
+    int _numFrames { 0 };
+    int _numJoints { 0 };
+
+    // one track per joint and channel
+    std::vector<Track> _scaleTracks;
+    std::vector<Track> _rotationTracks;
+    std::vector<Track> _translationTracks;
+
+    // keys of all tracks of a channel, packed together
+    std::vector<uint16_t> _scaleKeyFrames;
+    std::vector<glm::vec3> _scales;
+    std::vector<uint16_t> _rotationKeyFrames;
+    std::vector<QuantizedQuat> _rotations;
+    std::vector<uint16_t> _translationKeyFrames;
+    std::vector<glm::vec3> _translations;
+};
+
+#endif // hifi_CompressedAnimation_h
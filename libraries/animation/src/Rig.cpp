@@ -21,7 +21,9 @@
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 #include <PerfStat.h>
+#include <Profile.h>
 #include <ScriptValueUtils.h>
+#include <TBBHelpers.h>
 #include <shared/NsightHelpers.h>
 
 #include "AnimationLogging.h"
@@ -1679,13 +1681,39 @@ void Rig::updateAnimations(float deltaTime, const glm::mat4& rootTransform, cons
     DETAILED_PERFORMANCE_TIMER("updateAnimations");
 
     setModelOffset(rootTransform);
+    if (_animNode && _enabledAnimations) {
+        updateAnimationStateHandlers();
+    }
+    evaluateAnimations(deltaTime, rigToWorldTransform);
+}
+
+void Rig::updateAnimations(const std::vector<AnimationUpdate>& updates) {
+    PROFILE_RANGE(simulation_animation, "updateAnimations");
+
+    // state handlers call out to script engines, so they stay on this thread.
+    // As in the single rig update, they see the model offset of this frame.
+    for (auto& update : updates) {
+        update.rig->setModelOffset(update.rootTransform);
+        if (update.rig->_animNode && update.rig->_enabledAnimations) {
+            update.rig->updateAnimationStateHandlers();
+        }
+    }
+
+    // rigs share nothing but immutable animation data, so each one is an independent job.
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, updates.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            const AnimationUpdate& update = updates[i];
+            update.rig->evaluateAnimations(update.deltaTime, update.rigToWorldTransform);
+        }
+    });
+}
 
+void Rig::evaluateAnimations(float deltaTime, const glm::mat4& rigToWorldTransform) {
     if (_animNode && _enabledAnimations) {
         DETAILED_PERFORMANCE_TIMER("handleTriggers");
 
         ++_evaluationCount;
 
-        updateAnimationStateHandlers();
         _animVars.setRigToGeometryTransform(_rigToGeometryTransform);
         if (_networkNode) {
             _networkVars.setRigToGeometryTransform(_rigToGeometryTransform);
@@ -197,6 +197,20 @@ public:
     // Regardless of who started the animations or how many, update the joints.
     void updateAnimations(float deltaTime, const glm::mat4& rootTransform, const glm::mat4& rigToWorldTransform);
 
+    struct AnimationUpdate {
+        Rig* rig;
+        float deltaTime;
+        glm::mat4 rootTransform;
+        glm::mat4 rigToWorldTransform;
+    };
+
+    // Batched updateAnimations() for a crowd of independent rigs.  Animation state handlers are called on this thread,
+    // then each rig's anim graph, override poses and flow are evaluated as a separate job in parallel.
+    // Each rig must appear at most once, and no other thread may touch the rigs until this returns.
+    // Nothing in interface or the assignment clients calls this yet: only MyAvatar runs an anim graph there, other
+    // avatars get their joints from the network.
+    static void updateAnimations(const std::vector<AnimationUpdate>& updates);
+
     void updateFromControllerParameters(const ControllerParameters& params, float dt);
     void updateFromEyeParameters(const EyeParameters& params);
 
@@ -270,6 +284,7 @@ signals:
 protected:
     bool isIndexValid(int index) const { return _animSkeleton && index >= 0 && index < _animSkeleton->getNumJoints(); }
     void updateAnimationStateHandlers();
+    void evaluateAnimations(float deltaTime, const glm::mat4& rigToWorldTransform);
     void applyOverridePoses();
 
     void updateHead(bool headEnabled, bool hipsEnabled, const AnimPose& headMatrix);
@@ -61,7 +61,8 @@ InboundAudioStream::InboundAudioStream(int numChannels, int numFrames, int numBl
     _incomingSequenceNumberStats(STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
     _starveHistory(STARVE_HISTORY_CAPACITY),
     _unplayedMs(0, UNPLAYED_MS_WINDOW_SECS),
-    _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS) {}
+    _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
+    _decodedBuffer(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * numChannels) {}
 
 InboundAudioStream::~InboundAudioStream() {
     cleanupCodec();
@@ -245,8 +246,6 @@ int InboundAudioStream::parseStreamProperties(PacketType type, const QByteArray&
 }
 
 int InboundAudioStream::lostAudioData(int numPackets) {
-    QByteArray decodedBuffer;
-
     while (numPackets--) {
         MutexTryLocker lock(_decoderMutex);
         if (!lock.isLocked()) {
@@ -256,32 +255,32 @@ int InboundAudioStream::lostAudioData(int numPackets) {
             qCInfo(audiostream, "Packet currently being unpacked or lost frame already being generated.  Not generating lost frame.");
             return 0;
         }
+        int decodedSize;
         if (_decoder) {
-            _decoder->lostFrame(decodedBuffer);
+            decodedSize = _decoder->lostFrame(_decodedBuffer.data(), (int)_decodedBuffer.size());
         } else {
-            decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * _numChannels);
-            memset(decodedBuffer.data(), 0, decodedBuffer.size());
+            decodedSize = AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * _numChannels;
+            memset(_decodedBuffer.data(), 0, decodedSize);
         }
-        _ringBuffer.writeData(decodedBuffer.data(), decodedBuffer.size());
+        _ringBuffer.writeData(_decodedBuffer.data(), decodedSize);
     }
     return 0;
 }
 
 int InboundAudioStream::parseAudioData(const QByteArray& packetAfterStreamProperties) {
-    QByteArray decodedBuffer;
-
     // may block on the real-time thread, which is acceptible as 
     // parseAudioData is only called by the packet processing
     // thread which, while high performance, is not as sensitive to
     // delays as the real-time thread.
     QMutexLocker lock(&_decoderMutex);
     if (_decoder) {
-        _decoder->decode(packetAfterStreamProperties, decodedBuffer);
+        // decode into the buffer kept by the stream, so there is no allocation per packet
+        int decodedSize = _decoder->decode(packetAfterStreamProperties.constData(), packetAfterStreamProperties.size(),
+                                           _decodedBuffer.data(), (int)_decodedBuffer.size());
+        return _ringBuffer.writeData(_decodedBuffer.data(), decodedSize);
     } else {
-        decodedBuffer = packetAfterStreamProperties;
+        return _ringBuffer.writeData(packetAfterStreamProperties.constData(), packetAfterStreamProperties.size());
     }
-    auto actualSize = decodedBuffer.size();
-    return _ringBuffer.writeData(decodedBuffer.data(), actualSize);
 }
 
 int InboundAudioStream::writeDroppableSilentFrames(int silentFrames) {
@@ -307,8 +306,7 @@ int InboundAudioStream::writeDroppableSilentFrames(int silentFrames) {
             // when it actually reaches silence, and then delete the silent portions
             // of the jitter buffers. Or petentially do a cross fade from the decode
             // output to silence.
-            QByteArray decodedBuffer;
-            _decoder->lostFrame(decodedBuffer);
+            _decoder->lostFrame(_decodedBuffer.data(), (int)_decodedBuffer.size());
         }
     }
 
@@ -574,6 +572,9 @@ void InboundAudioStream::setupCodec(CodecPluginPointer codec, const QString& cod
     if (_codec) {
         QMutexLocker lock(&_decoderMutex);
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, numChannels);
+        if (_decoder && _decoder->getMaxDecodedSize() > (int)_decodedBuffer.size()) {
+            _decodedBuffer.resize(_decoder->getMaxDecodedSize());
+        }
     }
 }
 
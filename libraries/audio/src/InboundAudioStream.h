@@ -12,6 +12,8 @@
 #ifndef hifi_InboundAudioStream_h
 #define hifi_InboundAudioStream_h
 
+#include <vector>
+
 #include <Node.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
@@ -189,6 +191,7 @@ protected:
     QString _selectedCodecName;
     QMutex _decoderMutex;
     Decoder* _decoder { nullptr };
+    std::vector<char> _decodedBuffer; // decoder output, reused for every frame
     int _mismatchedAudioCodecCount { 0 };
 };
 
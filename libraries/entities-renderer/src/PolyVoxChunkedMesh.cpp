@@ -0,0 +1,152 @@
+//
+//  PolyVoxChunkedMesh.cpp
+//  libraries/entities-renderer/src/
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunkedMesh.h"
+
+#include <algorithm>
+
+#include <TBBHelpers.h>
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning( disable : 4267 )
+#endif
+#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
+#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+static glm::ivec3 toIVec3(const PolyVox::Vector3DInt32& v) {
+    return glm::ivec3(v.getX(), v.getY(), v.getZ());
+}
+
+void PolyVoxChunkedMesh::resize(const PolyVox::Region& region) {
+    _region = region;
+    glm::ivec3 lower = toIVec3(region.getLowerCorner());
+    glm::ivec3 upper = toIVec3(region.getUpperCorner());
+
+    // the upper corner is inclusive, a region of N cells spans N + 1 voxels
+    glm::ivec3 numCells = glm::max(upper - lower, glm::ivec3(0));
+    _numChunks = glm::max((numCells + CHUNK_SIZE - 1) / CHUNK_SIZE, glm::ivec3(1));
+
+    _chunks.clear();
+    _chunks.resize(_numChunks.x * _numChunks.y * _numChunks.z);
+    glm::ivec3 chunk;
+    for (chunk.z = 0; chunk.z < _numChunks.z; chunk.z++) {
+        for (chunk.y = 0; chunk.y < _numChunks.y; chunk.y++) {
+            for (chunk.x = 0; chunk.x < _numChunks.x; chunk.x++) {
+                glm::ivec3 chunkLower = lower + chunk * CHUNK_SIZE;
+                glm::ivec3 chunkUpper = glm::min(chunkLower + CHUNK_SIZE, upper);
+                _chunks[getChunkIndex(chunk)].region = PolyVox::Region(
+                    PolyVox::Vector3DInt32(chunkLower.x, chunkLower.y, chunkLower.z),
+                    PolyVox::Vector3DInt32(chunkUpper.x, chunkUpper.y, chunkUpper.z));
+            }
+        }
+    }
+}
+
+void PolyVoxChunkedMesh::markVoxelChanged(const glm::ivec3& voxel) {
+    if (_chunks.empty()) {
+        return;
+    }
+
+    // a chunk reads one voxel beyond its region on every side, marching cubes normals are central differences.
+    glm::ivec3 position = voxel - toIVec3(_region.getLowerCorner());
+    glm::ivec3 first;
+    glm::ivec3 last;
+    for (int axis = 0; axis < 3; axis++) {
+        last[axis] = std::min((position[axis] + 1) / CHUNK_SIZE, _numChunks[axis] - 1);
+        first[axis] = std::max(last[axis] - 1, 0);
+        while (first[axis] <= last[axis] && position[axis] > first[axis] * CHUNK_SIZE + CHUNK_SIZE + 1) {
+            first[axis]++;
+        }
+        if (position[axis] < last[axis] * CHUNK_SIZE - 1) {
+            last[axis]--;
+        }
+    }
+
+    glm::ivec3 chunk;
+    for (chunk.z = first.z; chunk.z <= last.z; chunk.z++) {
+        for (chunk.y = first.y; chunk.y <= last.y; chunk.y++) {
+            for (chunk.x = first.x; chunk.x <= last.x; chunk.x++) {
+                _chunks[getChunkIndex(chunk)].changed = true;
+            }
+        }
+    }
+}
+
+void PolyVoxChunkedMesh::extract(Volume* volume, Extractor extractor) {
+    PolyVox::Region region = volume->getEnclosingRegion();
+    bool sameRegion = region.getLowerCorner() == _region.getLowerCorner() &&
+        region.getUpperCorner() == _region.getUpperCorner();
+    if (_allChanged || !sameRegion || extractor != _extractor || _chunks.empty()) {
+        resize(region);
+        _extractor = extractor;
+        _allChanged = false;
+    }
+
+    std::vector<Chunk*> changedChunks;
+    for (auto& chunk : _chunks) {
+        if (chunk.changed) {
+            changedChunks.push_back(&chunk);
+            chunk.changed = false;
+        }
+    }
+    _numChunksExtracted = (int)changedChunks.size();
+
+    PolyVox::Vector3DInt32 volumeLower = _region.getLowerCorner();
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, changedChunks.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            Chunk& chunk = *changedChunks[i];
+            PolyVox::SurfaceMesh<Vertex> polyVoxMesh;
+            switch (extractor) {
+                case Extractor::MARCHING_CUBES: {
+                    PolyVox::MarchingCubesSurfaceExtractor<Volume> surfaceExtractor(volume, chunk.region, &polyVoxMesh);
+                    surfaceExtractor.execute();
+                    break;
+                }
+                case Extractor::CUBIC: {
+                    PolyVox::CubicSurfaceExtractorWithNormals<Volume> surfaceExtractor(volume, chunk.region, &polyVoxMesh);
+                    surfaceExtractor.execute();
+                    break;
+                }
+            }
+            chunk.vertices = polyVoxMesh.getRawVertexData();
+            chunk.indices = polyVoxMesh.getIndices();
+
+            // the extractors output positions relative to the lower corner of the extracted region
+            PolyVox::Vector3DInt32 chunkOffset = chunk.region.getLowerCorner() - volumeLower;
+            PolyVox::Vector3DFloat offset((float)chunkOffset.getX(), (float)chunkOffset.getY(), (float)chunkOffset.getZ());
+            for (auto& vertex : chunk.vertices) {
+                vertex.setPosition(vertex.getPosition() + offset);
+            }
+        }
+    });
+}
+
+void PolyVoxChunkedMesh::getMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) const {
+    size_t numVertices = 0;
+    size_t numIndices = 0;
+    for (const auto& chunk : _chunks) {
+        numVertices += chunk.vertices.size();
+        numIndices += chunk.indices.size();
+    }
+
+    vertices.clear();
+    indices.clear();
+    vertices.reserve(numVertices);
+    indices.reserve(numIndices);
+    for (const auto& chunk : _chunks) {
+        uint32_t baseVertex = (uint32_t)vertices.size();
+        vertices.insert(vertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+        for (uint32_t index : chunk.indices) {
+            indices.push_back(baseVertex + index);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+//
+//  PolyVoxChunkedMesh.h
+//  libraries/entities-renderer/src/
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunkedMesh_h
+#define hifi_PolyVoxChunkedMesh_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning( disable : 4267 )
+#endif
+#include <PolyVoxCore/SimpleVolume.h>
+#include <PolyVoxCore/SurfaceMesh.h>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+// Extracts the surface of a PolyVox volume in chunks of CHUNK_SIZE voxels along each axis, and keeps the mesh of
+// every chunk so that an edit only re-extracts the chunks that read the changed voxels.  Each chunk region shares its
+// upper layer of voxels with the lower layer of the next chunk, which makes the extractors emit the same cells as they
+// would for the whole volume and the chunk meshes meet without gaps.
+class PolyVoxChunkedMesh {
+public:
+    static const int CHUNK_SIZE = 16;
+
+    enum class Extractor {
+        MARCHING_CUBES,
+        CUBIC
+    };
+
+    using Vertex = PolyVox::PositionMaterialNormal;
+    using Volume = PolyVox::SimpleVolume<uint8_t>;
+
+    // coordinates are in volume space, which is offset from user space for edged volumes.
+    void markVoxelChanged(const glm::ivec3& voxel);
+    void markAllChanged() { _allChanged = true; }
+
+    // re-extracts the changed chunks in parallel.  A different region or extractor re-extracts every chunk.
+    // The volume must not be modified while this runs.
+    void extract(Volume* volume, Extractor extractor);
+
+    // stitches the chunk meshes into a single mesh, with positions in volume space.
+    void getMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) const;
+
+    int getNumChunks() const { return (int)_chunks.size(); }
+    int getNumChunksExtracted() const { return _numChunksExtracted; }  // by the last call to extract
+
+private:
+    struct Chunk {
+        PolyVox::Region region;
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        bool changed { true };
+    };
+
+    void resize(const PolyVox::Region& region);
+    int getChunkIndex(const glm::ivec3& chunk) const { return (chunk.z * _numChunks.y + chunk.y) * _numChunks.x + chunk.x; }
+
+    std::vector<Chunk> _chunks;
+    glm::ivec3 _numChunks { 0 };
+    PolyVox::Region _region;
+    Extractor _extractor { Extractor::MARCHING_CUBES };
+    bool _allChanged { true };
+    int _numChunksExtracted { 0 };
+};
+
+#endif // hifi_PolyVoxChunkedMesh_h
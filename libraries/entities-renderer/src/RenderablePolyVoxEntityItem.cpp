@@ -56,8 +56,6 @@
 #pragma warning(push)
 #pragma warning( disable : 4267 )
 #endif
-#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
-#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
 #include <PolyVoxCore/SurfaceMesh.h>
 #include <PolyVoxCore/SimpleVolume.h>
 #include <PolyVoxCore/Material.h>
@@ -262,27 +260,6 @@ void RenderablePolyVoxEntityItem::forEachVoxelValue(const ivec3& voxelSize, std:
     });
 }
 
-QByteArray RenderablePolyVoxEntityItem::volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const {
-    int totalSize = voxelXSize * voxelYSize * voxelZSize;
-    ivec3 voxelSize{ voxelXSize, voxelYSize, voxelZSize };
-    ivec3 low{ 0 };
-    int index = 0;
-
-    QByteArray result = QByteArray(totalSize, '\0');
-    withReadLock([&] {
-        if (isEdged()) {
-            low += 1;
-            voxelSize += 2;
-        }
-
-        loop3(low, voxelSize, [&](const ivec3& v){
-            result[index++] = _volData->getVoxelAt(v.x, v.y, v.z);
-        });
-    });
-
-    return result;
-}
-
 bool RenderablePolyVoxEntityItem::setAll(uint8_t toValue) {
     bool result = false;
     if (_locked) {
@@ -896,6 +873,9 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(lowCorner, highCorner)));
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+        _chunkedMesh.markAllChanged();
+        ivec3 voxelVolumeSize { _voxelVolumeSize };
+        _uncompressedVoxelData = QByteArray(voxelVolumeSize.x * voxelVolumeSize.y * voxelVolumeSize.z, '\0');
     });
 
     tellNeighborsToRecopyEdges(true);
@@ -948,6 +928,7 @@ uint8_t RenderablePolyVoxEntityItem::getVoxelInternal(const ivec3& v) const {
 
 void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue) {
     _volData->setVoxelAt(x, y, z, toValue);
+    _chunkedMesh.markVoxelChanged({ x, y, z });
     if (x == 0) {
         _neighborXNeedsUpdate = true;
         startUpdates();
@@ -966,6 +947,10 @@ bool RenderablePolyVoxEntityItem::setVoxelInternal(const ivec3& v, uint8_t toVal
     // set a voxel without recompressing the voxel data.  This assumes that the caller has write-locked the entity.
     bool result = updateOnCount(v, toValue);
     if (result) {
+        ivec3 voxelVolumeSize { _voxelVolumeSize };
+        if (glm::all(glm::lessThan(v, voxelVolumeSize))) {
+            _uncompressedVoxelData[(v.z * voxelVolumeSize.y + v.y) * voxelVolumeSize.x + v.x] = toValue;
+        }
         if (isEdged()) {
             setVoxelMarkNeighbors(v.x + 1, v.y + 1, v.z + 1, toValue);
         } else {
@@ -1066,16 +1051,16 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
     quint16 voxelXSize;
     quint16 voxelYSize;
     quint16 voxelZSize;
+    QByteArray uncompressedData;
     withReadLock([&] {
         voxelXSize = _voxelVolumeSize.x;
         voxelYSize = _voxelVolumeSize.y;
         voxelZSize = _voxelVolumeSize.z;
+        // implicitly shared, edits made while compressing detach from this copy
+        uncompressedData = _uncompressedVoxelData;
     });
 
-    QtConcurrent::run([voxelXSize, voxelYSize, voxelZSize, entity] {
-        auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
-        QByteArray uncompressedData = polyVoxEntity->volDataToArray(voxelXSize, voxelYSize, voxelZSize);
-
+    QtConcurrent::run([voxelXSize, voxelYSize, voxelZSize, uncompressedData, entity] {
         QByteArray newVoxelData;
         QDataStream writer(&newVoxelData, QIODevice::WriteOnly | QIODevice::Truncate);
 
@@ -1200,6 +1185,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            _chunkedMesh.markVoxelChanged({ x, y, z });
                             _volDataDirty = true;
                         }
                     }
@@ -1220,6 +1206,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            _chunkedMesh.markVoxelChanged({ x, y, z });
                             _volDataDirty = true;
                         }
                     }
@@ -1240,6 +1227,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            _chunkedMesh.markVoxelChanged({ x, y, z });
                             _volDataDirty = true;
                         }
                     }
@@ -1291,38 +1279,26 @@ void RenderablePolyVoxEntityItem::recomputeMesh() {
     QtConcurrent::run([entity, voxelSurfaceStyle] {
         graphics::MeshPointer mesh(std::make_shared<graphics::Mesh>());
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+        std::vector<uint32_t> vecIndices;
 
         entity->withReadLock([&] {
-            PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
+            // only the chunks containing voxels edited since the last bake are extracted again
+            PolyVoxChunkedMesh::Extractor extractor = PolyVoxChunkedMesh::Extractor::MARCHING_CUBES;
+            if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_CUBIC || voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
+                extractor = PolyVoxChunkedMesh::Extractor::CUBIC;
             }
+            entity->_chunkedMesh.extract(entity->getVolData(), extractor);
+            entity->_chunkedMesh.getMesh(vecVertices, vecIndices);
         });
 
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
@@ -26,6 +26,7 @@
 #include <TextureCache.h>
 #include <PolyVoxEntityItem.h>
 
+#include "PolyVoxChunkedMesh.h"
 #include "RenderableEntityItem.h"
 
 namespace render { namespace entities {
@@ -117,7 +118,6 @@ public:
 
     void setVoxelsFromData(QByteArray uncompressedData, quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize);
     void forEachVoxelValue(const ivec3& voxelSize, std::function<void(const ivec3&, uint8_t)> thunk);
-    QByteArray volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const;
 
     void setMesh(graphics::MeshPointer mesh);
     void setCollisionPoints(ShapeInfo::PointCollection points, AABox box);
@@ -173,6 +173,13 @@ private:
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
     int _onCount; // how many non-zero voxels are in _volData
 
+    // the mesh of _volData, kept per chunk so edits only re-extract the chunks around them.  Voxel edits mark chunks
+    // under the write lock, the mesh baking worker extracts under the read lock and is the only reader.
+    PolyVoxChunkedMesh _chunkedMesh;
+
+    // _volData in the layout of the voxel-data property, updated with every voxel edit so compressing doesn't walk the volume
+    QByteArray _uncompressedVoxelData;
+
     bool _neighborXNeedsUpdate { false };
     bool _neighborYNeedsUpdate { false };
     bool _neighborZNeedsUpdate { false };
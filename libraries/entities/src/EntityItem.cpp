@@ -41,6 +41,7 @@
 #include "EntityTree.h"
 #include "EntitySimulation.h"
 #include "EntityDynamicFactoryInterface.h"
+#include "KinematicIntegrator.h"
 
 //#define WANT_DEBUG
 
@@ -1105,62 +1106,6 @@ void EntityItem::setCollisionSoundURL(const QString& value) {
     }
 }
 
-void EntityItem::simulate(const quint64& now) {
-    DETAILED_PROFILE_RANGE(simulation_physics, "Simulate");
-    if (getLastSimulated() == 0) {
-        setLastSimulated(now);
-    }
-
-    float timeElapsed = (float)(now - getLastSimulated()) / (float)(USECS_PER_SECOND);
-
-    #ifdef WANT_DEBUG
-        qCDebug(entities) << "********** EntityItem::simulate()";
-        qCDebug(entities) << "    entity ID=" << getEntityItemID();
-        qCDebug(entities) << "    simulator ID=" << getSimulatorID();
-        qCDebug(entities) << "    now=" << now;
-        qCDebug(entities) << "    _lastSimulated=" << _lastSimulated;
-        qCDebug(entities) << "    timeElapsed=" << timeElapsed;
-        qCDebug(entities) << "    hasVelocity=" << hasVelocity();
-        qCDebug(entities) << "    hasGravity=" << hasGravity();
-        qCDebug(entities) << "    hasAcceleration=" << hasAcceleration();
-        qCDebug(entities) << "    hasAngularVelocity=" << hasAngularVelocity();
-        qCDebug(entities) << "    getAngularVelocity=" << getLocalAngularVelocity();
-        qCDebug(entities) << "    isMortal=" << isMortal();
-        qCDebug(entities) << "    getAge()=" << getAge();
-        qCDebug(entities) << "    getLifetime()=" << getLifetime();
-
-
-        if (hasVelocity() || hasGravity()) {
-            qCDebug(entities) << "    MOVING...=";
-            qCDebug(entities) << "        hasVelocity=" << hasVelocity();
-            qCDebug(entities) << "        hasGravity=" << hasGravity();
-            qCDebug(entities) << "        hasAcceleration=" << hasAcceleration();
-            qCDebug(entities) << "        hasAngularVelocity=" << hasAngularVelocity();
-            qCDebug(entities) << "        getAngularVelocity=" << getLocalAngularVelocity();
-        }
-        if (hasAngularVelocity()) {
-            qCDebug(entities) << "    CHANGING...=";
-            qCDebug(entities) << "        hasAngularVelocity=" << hasAngularVelocity();
-            qCDebug(entities) << "        getAngularVelocity=" << getLocalAngularVelocity();
-        }
-        if (isMortal()) {
-            qCDebug(entities) << "    MORTAL...=";
-            qCDebug(entities) << "        isMortal=" << isMortal();
-            qCDebug(entities) << "        getAge()=" << getAge();
-            qCDebug(entities) << "        getLifetime()=" << getLifetime();
-        }
-        qCDebug(entities) << "     ********** EntityItem::simulate() .... SETTING _lastSimulated=" << _lastSimulated;
-    #endif
-
-    if (!stepKinematicMotion(timeElapsed)) {
-        // this entity is no longer moving
-        // flag it to transition from KINEMATIC to STATIC
-        markDirtyFlags(Simulation::DIRTY_MOTION_TYPE);
-        setAcceleration(Vectors::ZERO);
-    }
-    setLastSimulated(now);
-}
-
 bool EntityItem::stepKinematicMotion(float timeElapsed) {
     DETAILED_PROFILE_RANGE(simulation_physics, "StepKinematicMotion");
     // get all the data
@@ -1171,102 +1116,31 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
 
     // find out if it is moving
     bool isSpinning = (glm::length2(angularVelocity) > 0.0f);
-    float linearSpeedSquared = glm::length2(linearVelocity);
-    bool isTranslating = linearSpeedSquared > 0.0f;
-    bool moving = isTranslating || isSpinning;
-    if (!moving) {
+    bool isTranslating = glm::length2(linearVelocity) > 0.0f;
+    if (!isTranslating && !isSpinning) {
         return false;
     }
 
-    if (timeElapsed <= 0.0f) {
-        // someone gave us a useless time value so bail early
-        // but return 'true' because it is moving
-        return true;
-    }
-
-    const float MAX_TIME_ELAPSED = 1.0f; // seconds
-    if (timeElapsed > MAX_TIME_ELAPSED) {
-        qCDebug(entities) << "kinematic timestep = " << timeElapsed << " truncated to " << MAX_TIME_ELAPSED;
-    }
-    timeElapsed = glm::min(timeElapsed, MAX_TIME_ELAPSED);
-
-    if (isSpinning) {
-        float angularDamping = getAngularDamping();
-        // angular damping
-        if (angularDamping > 0.0f) {
-            angularVelocity *= powf(1.0f - angularDamping, timeElapsed);
-        }
-
-        const float MIN_KINEMATIC_ANGULAR_SPEED_SQUARED =
-            KINEMATIC_ANGULAR_SPEED_THRESHOLD * KINEMATIC_ANGULAR_SPEED_THRESHOLD;
-        if (glm::length2(angularVelocity) < MIN_KINEMATIC_ANGULAR_SPEED_SQUARED) {
-            angularVelocity = Vectors::ZERO;
-        } else {
-            // for improved agreement with the way Bullet integrates rotations we use an approximation
-            // and break the integration into bullet-sized substeps
-            glm::quat rotation = transform.getRotation();
-            float dt = timeElapsed;
-            while (dt > 0.0f) {
-                glm::quat  dQ = computeBulletRotationStep(angularVelocity, glm::min(dt, PHYSICS_ENGINE_FIXED_SUBSTEP));
-                rotation = glm::normalize(dQ * rotation);
-                dt -= PHYSICS_ENGINE_FIXED_SUBSTEP;
-            }
-            transform.setRotation(rotation);
+    glm::vec3 acceleration = getAcceleration();
+    if (isTranslating && glm::length2(acceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED) {
+        // acceleration is in world-frame but we need it in local-frame
+        bool success;
+        Transform parentTransform = getParentTransform(success);
+        if (success) {
+            acceleration = glm::inverse(parentTransform.getRotation()) * acceleration;
         }
     }
 
-    glm::vec3 position = transform.getTranslation();
-    const float MIN_KINEMATIC_LINEAR_SPEED_SQUARED =
-        KINEMATIC_LINEAR_SPEED_THRESHOLD * KINEMATIC_LINEAR_SPEED_THRESHOLD;
-    if (isTranslating) {
-        glm::vec3 deltaVelocity = Vectors::ZERO;
-
-        // linear damping
-        float damping = getDamping();
-        if (damping > 0.0f) {
-            deltaVelocity = (powf(1.0f - damping, timeElapsed) - 1.0f) * linearVelocity;
-        }
-
-        const float MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED = 1.0e-4f; // 0.01 m/sec^2
-        vec3 acceleration = getAcceleration();
-        if (glm::length2(acceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED) {
-            // yes acceleration
-            // acceleration is in world-frame but we need it in local-frame
-            glm::vec3 linearAcceleration = acceleration;
-            bool success;
-            Transform parentTransform = getParentTransform(success);
-            if (success) {
-                linearAcceleration = glm::inverse(parentTransform.getRotation()) * linearAcceleration;
-            }
-            deltaVelocity += linearAcceleration * timeElapsed;
-
-            if (linearSpeedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED
-                    && glm::length2(deltaVelocity) < MIN_KINEMATIC_LINEAR_SPEED_SQUARED
-                    && glm::length2(linearVelocity + deltaVelocity) < MIN_KINEMATIC_LINEAR_SPEED_SQUARED) {
-                linearVelocity = Vectors::ZERO;
-            } else {
-                // NOTE: we do NOT include the second-order acceleration term (0.5 * a * dt^2)
-                // when computing the displacement because Bullet also ignores that term.  Yes,
-                // this is an approximation and it works best when dt is small.
-                position += timeElapsed * linearVelocity;
-                linearVelocity += deltaVelocity;
-            }
-        } else {
-            // no acceleration
-            if (linearSpeedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED) {
-                linearVelocity = Vectors::ZERO;
-            } else {
-                // NOTE: we don't use second-order acceleration term for linear displacement
-                // because Bullet doesn't use it.
-                position += timeElapsed * linearVelocity;
-                linearVelocity += deltaVelocity;
-            }
-        }
+    // a single row of the integration EntitySimulation runs over all of its simple kinematic entities
+    static thread_local KinematicIntegrator integrator;
+    integrator.clear();
+    integrator.add(transform, linearVelocity, angularVelocity, acceleration, getDamping(), getAngularDamping(), timeElapsed);
+    integrator.integrate();
+    if (integrator.hasChanged(0)) {
+        setLocalTransformAndVelocities(integrator.getTransform(0), integrator.getLinearVelocity(0),
+                                       integrator.getAngularVelocity(0));
     }
 
-    transform.setTranslation(position);
-    setLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
-
     return true;
 }
 
@@ -2743,6 +2617,16 @@ void EntityItem::setLastSimulated(quint64 now) {
     });
 }
 
+void EntityItem::getKinematicParameters(quint64& lastSimulated, glm::vec3& acceleration,
+                                        float& damping, float& angularDamping) const {
+    withReadLock([&] {
+        lastSimulated = _lastSimulated;
+        acceleration = _acceleration;
+        damping = _damping;
+        angularDamping = _angularDamping;
+    });
+}
+
 quint64 EntityItem::getLastEdited() const {
     quint64 result;
     withReadLock([&] {
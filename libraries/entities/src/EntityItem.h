@@ -119,6 +119,8 @@ public:
     void recordCreationTime();    // set _created to 'now'
     quint64 getLastSimulated() const; /// Last simulated time of this entity universal usecs
     void setLastSimulated(quint64 now);
+    // what the simple kinematic integration reads besides the transform and velocities, under one lock
+    void getKinematicParameters(quint64& lastSimulated, glm::vec3& acceleration, float& damping, float& angularDamping) const;
 
      /// Last edited time of this entity universal usecs
     quint64 getLastEdited() const;
@@ -165,8 +167,6 @@ public:
     virtual void update(const quint64& now);
     quint64 getLastUpdated() const;
 
-    // perform linear extrapolation for SimpleEntitySimulation
-    void simulate(const quint64& now);
     bool stepKinematicMotion(float timeElapsed); // return 'true' if moving
 
     virtual bool needsToCallUpdate() const { return false; }
@@ -1287,6 +1287,31 @@ RayToEntityIntersectionResult EntityScriptingInterface::evalRayIntersectionVecto
     return evalRayIntersectionWorker(ray, Octree::Lock, searchFilter, entityIdsToInclude, entityIdsToDiscard);
 }
 
+std::vector<RayToEntityIntersectionResult> EntityScriptingInterface::evalRayIntersectionsVector(std::vector<RayPacketQuery>& rays) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    std::vector<RayToEntityIntersectionResult> results(rays.size());
+    if (_entityTree && !rays.empty()) {
+        bool accurate = true;
+        _entityTree->evalRayIntersections(rays, Octree::Lock, &accurate);
+        for (size_t i = 0; i < rays.size(); i++) {
+            const RayPacketQuery& ray = rays[i];
+            RayToEntityIntersectionResult& result = results[i];
+            result.accurate = accurate;
+            result.entityID = ray.entityID;
+            result.distance = ray.distance;
+            result.face = ray.face;
+            result.surfaceNormal = ray.surfaceNormal;
+            result.extraInfo = ray.extraInfo;
+            result.intersects = !ray.entityID.isNull();
+            if (result.intersects) {
+                result.intersection = ray.origin + (ray.direction * ray.distance);
+            }
+        }
+    }
+    return results;
+}
+
 RayToEntityIntersectionResult EntityScriptingInterface::evalRayIntersectionWorker(const PickRay& ray,
         Octree::lockType lockType, PickFilter searchFilter, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard) const {
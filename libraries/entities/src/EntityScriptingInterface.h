@@ -191,6 +191,9 @@ public:
 
     RayToEntityIntersectionResult evalRayIntersectionVector(const PickRay& ray, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
+    // Traces all the rays in one pass over the tree, see EntityTree::evalRayIntersections().  Each query carries its own
+    // filters, results are returned in the same order as the queries.
+    std::vector<RayToEntityIntersectionResult> evalRayIntersectionsVector(std::vector<RayPacketQuery>& rays);
     ParabolaToEntityIntersectionResult evalParabolaIntersectionVector(const PickParabola& parabola, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
 
@@ -11,20 +11,27 @@
 
 #include "EntitySimulation.h"
 
+#include <glm/gtx/norm.hpp>
+
 #include <AACube.h>
+#include <GLMHelpers.h>
+#include <PhysicsHelpers.h>
 #include <Profile.h>
 
 #include "EntitiesLogging.h"
 #include "MovingEntitiesOperator.h"
 
+// mortal entities are filed by the bucket of their expiry, those of the current bucket are checked every frame
+const uint64_t MORTAL_EXPIRY_BUCKET_USECS = USECS_PER_SECOND / 10;
+
 void EntitySimulation::setEntityTree(EntityTreePointer tree) {
     if (_entityTree && _entityTree != tree) {
         _entitiesToSort.clear();
         _simpleKinematicEntities.clear();
         _changedEntities.clear();
         _entitiesToUpdate.clear();
+        _mortalEntityBuckets.clear();
         _mortalEntities.clear();
-        _nextExpiry = std::numeric_limits<uint64_t>::max();
     }
     _entityTree = tree;
 }
@@ -49,7 +56,7 @@ void EntitySimulation::removeEntityFromInternalLists(EntityItemPointer entity) {
     _simpleKinematicEntities.remove(entity);
     _allEntities.remove(entity);
     _entitiesToUpdate.remove(entity);
-    _mortalEntities.remove(entity);
+    removeMortalEntity(entity);
     entity->setSimulated(false);
 }
 
@@ -66,32 +73,64 @@ void EntitySimulation::prepareEntityForDelete(EntityItemPointer entity) {
     }
 }
 
+// private: _mutex lock is guaranteed
+void EntitySimulation::addMortalEntity(const EntityItemPointer& entity) {
+    uint64_t bucket = entity->getExpiry() / MORTAL_EXPIRY_BUCKET_USECS;
+    auto itr = _mortalEntities.find(entity);
+    if (itr != _mortalEntities.end()) {
+        if (itr.value() == bucket) {
+            return;
+        }
+        removeMortalEntity(entity);
+    }
+    _mortalEntities.insert(entity, bucket);
+    _mortalEntityBuckets[bucket].insert(entity);
+}
+
+// private: _mutex lock is guaranteed
+void EntitySimulation::removeMortalEntity(const EntityItemPointer& entity) {
+    auto itr = _mortalEntities.find(entity);
+    if (itr == _mortalEntities.end()) {
+        return;
+    }
+    auto bucketItr = _mortalEntityBuckets.find(itr.value());
+    if (bucketItr != _mortalEntityBuckets.end()) {
+        bucketItr->second.remove(entity);
+        if (bucketItr->second.empty()) {
+            _mortalEntityBuckets.erase(bucketItr);
+        }
+    }
+    _mortalEntities.erase(itr);
+}
+
 // protected
 void EntitySimulation::expireMortalEntities(uint64_t now) {
-    if (now > _nextExpiry) {
-        PROFILE_RANGE_EX(simulation_physics, "ExpireMortals", 0xffff00ff, (uint64_t)_mortalEntities.size());
-        // only search for expired entities if we expect to find one
-        _nextExpiry = std::numeric_limits<uint64_t>::max();
-        QMutexLocker lock(&_mutex);
-        SetOfEntities::iterator itemItr = _mortalEntities.begin();
-        while (itemItr != _mortalEntities.end()) {
-            EntityItemPointer entity = *itemItr;
-            uint64_t expiry = entity->getExpiry();
-            if (expiry < now) {
-                itemItr = _mortalEntities.erase(itemItr);
+    uint64_t currentBucket = now / MORTAL_EXPIRY_BUCKET_USECS;
+    QMutexLocker lock(&_mutex);
+    if (_mortalEntityBuckets.empty() || _mortalEntityBuckets.begin()->first > currentBucket) {
+        return;
+    }
+
+    PROFILE_RANGE_EX(simulation_physics, "ExpireMortals", 0xffff00ff, (uint64_t)_mortalEntityBuckets.begin()->second.size());
+    std::vector<EntityItemPointer> notYetExpired;
+    while (!_mortalEntityBuckets.empty() && _mortalEntityBuckets.begin()->first <= currentBucket) {
+        SetOfEntities entities;
+        entities.swap(_mortalEntityBuckets.begin()->second);
+        _mortalEntityBuckets.erase(_mortalEntityBuckets.begin());
+        for (auto& entity : entities) {
+            if (entity->getExpiry() < now) {
+                _mortalEntities.remove(entity);
                 entity->die();
                 prepareEntityForDelete(entity);
             } else {
-                if (expiry < _nextExpiry) {
-                    // remember the smallest _nextExpiry so we know when to start the next search
-                    _nextExpiry = expiry;
-                }
-                ++itemItr;
+                // refiled once we are done, as it may well belong to the current bucket again
+                _mortalEntities.remove(entity);
+                notYetExpired.push_back(entity);
             }
         }
-        if (_mortalEntities.size() < 1) {
-            _nextExpiry = -1;
-        }
+    }
+    for (auto& entity : notYetExpired) {
+        addMortalEntity(entity);
     }
 }
 
@@ -147,11 +186,7 @@ void EntitySimulation::sortEntitiesThatMoved() {
 void EntitySimulation::addEntityToInternalLists(EntityItemPointer entity) {
     // protected: _mutex lock is guaranteed
     if (entity->isMortal()) {
-        _mortalEntities.insert(entity);
-        uint64_t expiry = entity->getExpiry();
-        if (expiry < _nextExpiry) {
-            _nextExpiry = expiry;
-        }
+        addMortalEntity(entity);
     }
     if (entity->needsToCallUpdate()) {
         _entitiesToUpdate.insert(entity);
@@ -193,13 +228,9 @@ void EntitySimulation::processChangedEntity(const EntityItemPointer& entity) {
     if (dirtyFlags & (Simulation::DIRTY_LIFETIME | Simulation::DIRTY_UPDATEABLE)) {
         if (dirtyFlags & Simulation::DIRTY_LIFETIME) {
             if (entity->isMortal()) {
-                _mortalEntities.insert(entity);
-                uint64_t expiry = entity->getExpiry();
-                if (expiry < _nextExpiry) {
-                    _nextExpiry = expiry;
-                }
+                addMortalEntity(entity);
             } else {
-                _mortalEntities.remove(entity);
+                removeMortalEntity(entity);
             }
         }
         if (dirtyFlags & Simulation::DIRTY_UPDATEABLE) {
@@ -221,12 +252,18 @@ void EntitySimulation::clearEntities() {
     _allEntities.clear();
     _deadEntitiesToRemoveFromTree.clear();
     _entitiesToUpdate.clear();
+    _mortalEntityBuckets.clear();
     _mortalEntities.clear();
-    _nextExpiry = std::numeric_limits<uint64_t>::max();
 }
 
 void EntitySimulation::moveSimpleKinematics(uint64_t now) {
     PROFILE_RANGE_EX(simulation_physics, "MoveSimples", 0xffff00ff, (uint64_t)_simpleKinematicEntities.size());
+    _kinematicIntegrator.clear();
+    _kinematicIntegrator.reserve(_simpleKinematicEntities.size());
+    _integratedEntities.clear();
+    _integratedEntities.reserve(_simpleKinematicEntities.size());
+
+    // gather the state of the entities that move into the integrator
     SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
     while (itemItr != _simpleKinematicEntities.end()) {
         EntityItemPointer entity = *itemItr;
@@ -239,11 +276,32 @@ void EntitySimulation::moveSimpleKinematics(uint64_t now) {
 
         bool isMoving = entity->isMovingRelativeToParent();
         if (isMoving && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
-            entity->simulate(now);
-            if (ancestryIsKnown && !hasAvatarAncestor) {
-                entity->updateQueryAACube();
+            quint64 lastSimulated;
+            glm::vec3 acceleration;
+            float damping;
+            float angularDamping;
+            entity->getKinematicParameters(lastSimulated, acceleration, damping, angularDamping);
+            if (lastSimulated == 0) {
+                lastSimulated = now;
             }
-            _entitiesToSort.insert(entity);
+
+            Transform transform;
+            glm::vec3 linearVelocity;
+            glm::vec3 angularVelocity;
+            entity->getLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
+
+            if (glm::length2(acceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED && !entity->getParentID().isNull()) {
+                // acceleration is in world-frame but we need it in local-frame
+                bool success;
+                Transform parentTransform = entity->getParentTransform(success);
+                if (success) {
+                    acceleration = glm::inverse(parentTransform.getRotation()) * acceleration;
+                }
+            }
+
+            float timeElapsed = (float)(now - lastSimulated) / (float)(USECS_PER_SECOND);
+            _kinematicIntegrator.add(transform, linearVelocity, angularVelocity, acceleration, damping, angularDamping, timeElapsed);
+            _integratedEntities.push_back(entity);
             ++itemItr;
         } else {
             if (!isMoving && ancestryIsKnown && !hasAvatarAncestor) {
@@ -256,6 +314,26 @@ void EntitySimulation::moveSimpleKinematics(uint64_t now) {
             itemItr = _simpleKinematicEntities.erase(itemItr);
         }
     }
+
+    _kinematicIntegrator.integrate();
+
+    // write back what changed
+    for (int i = 0; i < _integratedEntities.size(); ++i) {
+        const EntityItemPointer& entity = _integratedEntities[i];
+        if (!_kinematicIntegrator.isMoving(i)) {
+            // this entity is no longer moving
+            // flag it to transition from KINEMATIC to STATIC
+            entity->markDirtyFlags(Simulation::DIRTY_MOTION_TYPE);
+            entity->setAcceleration(Vectors::ZERO);
+        } else if (_kinematicIntegrator.hasChanged(i)) {
+            entity->setLocalTransformAndVelocities(_kinematicIntegrator.getTransform(i),
+                _kinematicIntegrator.getLinearVelocity(i), _kinematicIntegrator.getAngularVelocity(i));
+        }
+        entity->setLastSimulated(now);
+        entity->updateQueryAACube();
+        _entitiesToSort.insert(entity);
+    }
+    _integratedEntities.clear();
 }
 
 void EntitySimulation::processDeadEntities() {
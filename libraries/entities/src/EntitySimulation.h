@@ -13,6 +13,7 @@
 #define hifi_EntitySimulation_h
 
 #include <limits>
+#include <map>
 #include <unordered_set>
 
 #include <QtCore/QObject>
@@ -22,6 +23,7 @@
 
 #include "EntityItem.h"
 #include "EntityTree.h"
+#include "KinematicIntegrator.h"
 
 using EntitySimulationPointer = std::shared_ptr<EntitySimulation>;
 using VectorOfEntities = QVector<EntityItemPointer>;
@@ -44,7 +46,7 @@ const int DIRTY_SIMULATION_FLAGS =
 
 class EntitySimulation : public QObject, public std::enable_shared_from_this<EntitySimulation> {
 public:
-    EntitySimulation() : _mutex(), _nextExpiry(std::numeric_limits<uint64_t>::max()), _entityTree(nullptr) { }
+    EntitySimulation() : _mutex(), _entityTree(nullptr) { }
     virtual ~EntitySimulation() { setEntityTree(nullptr); }
 
     inline EntitySimulationPointer getThisPointer() const {
@@ -98,14 +100,22 @@ protected:
 
 private:
     void moveSimpleKinematics();
+    void addMortalEntity(const EntityItemPointer& entity);
+    void removeMortalEntity(const EntityItemPointer& entity);
 
     // We maintain multiple lists, each for its distinct purpose.
     // An entity may be in more than one list.
     std::unordered_set<EntityItemPointer> _changedEntities; // all changes this frame
     SetOfEntities _allEntities; // tracks all entities added the simulation
     SetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
-    SetOfEntities _mortalEntities; // entities that have an expiry
-    uint64_t _nextExpiry;
+
+    // Entities that have an expiry, filed by the time bucket of their expiry, so expireMortalEntities() only visits
+    // the entities that are due or about to be.  _mortalEntities remembers the bucket of each of them.
+    std::map<uint64_t, SetOfEntities> _mortalEntityBuckets;
+    QHash<EntityItemPointer, uint64_t> _mortalEntities;
+
+    KinematicIntegrator _kinematicIntegrator;
+    VectorOfEntities _integratedEntities; // the entity of each row of _kinematicIntegrator
 
     // back pointer to EntityTree structure
     EntityTreePointer _entityTree;
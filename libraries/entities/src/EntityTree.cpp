@@ -876,6 +876,161 @@ EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm:
     return args.entityID;
 }
 
+// Rays are grouped into packets of this many after sorting them by direction octant and origin, so that the rays of
+// a packet mostly descend into the same elements.
+const size_t RAY_PACKET_SIZE = 32;
+const float RAY_PACKET_ORIGIN_CELL_SIZE = 1.0f; // meters
+
+// The rays of a packet that reach an element, as their index and the distance at which they enter the element.
+using RayPacketEntry = std::pair<uint32_t, float>;
+
+class RayPacketArgs {
+public:
+    std::vector<RayPacketQuery>& rays;
+    std::vector<glm::vec3> invDirections;
+    glm::vec3 viewFrustumPos;
+};
+
+class RayPacketChild {
+public:
+    float distance { FLT_MAX };
+    EntityTreeElementPointer element;
+    std::vector<RayPacketEntry> entries;
+};
+
+static uint64_t spreadBits16(uint64_t x) {
+    x &= 0xffff;
+    x = (x | (x << 16)) & 0x0000ff0000ff;
+    x = (x | (x << 8)) & 0x00f00f00f00f;
+    x = (x | (x << 4)) & 0x0c30c30c30c3;
+    x = (x | (x << 2)) & 0x249249249249;
+    return x;
+}
+
+// direction octant in the high bits, then the morton code of the origin cell
+static uint64_t rayCoherenceKey(const RayPacketQuery& ray) {
+    uint64_t octant = (ray.direction.x < 0.0f ? 1 : 0) | (ray.direction.y < 0.0f ? 2 : 0) | (ray.direction.z < 0.0f ? 4 : 0);
+    glm::vec3 cell = glm::floor(ray.origin / RAY_PACKET_ORIGIN_CELL_SIZE) + glm::vec3(32768.0f);
+    cell = glm::clamp(cell, glm::vec3(0.0f), glm::vec3(65535.0f));
+    return (octant << 48) | spreadBits16((uint64_t)cell.x) | (spreadBits16((uint64_t)cell.y) << 1) |
+        (spreadBits16((uint64_t)cell.z) << 2);
+}
+
+static void evalRayPacketIntersections(const EntityTreeElementPointer& element, const std::vector<RayPacketEntry>& entries,
+        RayPacketArgs& args, int recursionCount) {
+    if (recursionCount > DANGEROUSLY_DEEP_RECURSION) {
+        return;
+    }
+
+    // a ray that found a hit in an earlier sibling may no longer need this element
+    std::vector<uint32_t> active;
+    active.reserve(entries.size());
+    for (const auto& entry : entries) {
+        if (entry.second < args.rays[entry.first].distance) {
+            active.push_back(entry.first);
+        }
+    }
+    if (active.empty()) {
+        return;
+    }
+
+    // most elements hold no entities, only the cube tests of their children are needed then
+    if (element->canPickIntersect()) {
+        for (uint32_t index : active) {
+            RayPacketQuery& ray = args.rays[index];
+            EntityItemID entityID = element->evalRayIntersection(ray.origin, ray.direction, args.viewFrustumPos,
+                ray.element, ray.distance, ray.face, ray.surfaceNormal, ray.entityIdsToInclude,
+                ray.entityIdsToDiscard, ray.searchFilter, ray.extraInfo);
+            if (!entityID.isNull()) {
+                ray.entityID = entityID;
+            }
+        }
+    }
+
+    std::vector<RayPacketChild> children;
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        EntityTreeElementPointer child = element->getChildAtIndex(i);
+        if (!child) {
+            continue;
+        }
+        const AACube& cube = child->getAACube();
+        RayPacketChild packetChild;
+        for (uint32_t index : active) {
+            const RayPacketQuery& ray = args.rays[index];
+            float boundDistance = FLT_MAX;
+            if (cube.contains(ray.origin)) {
+                boundDistance = 0.0f;
+            } else {
+                BoxFace face;
+                glm::vec3 surfaceNormal;
+                if (!cube.findRayIntersection(ray.origin, ray.direction, args.invDirections[index], boundDistance, face, surfaceNormal)) {
+                    continue;
+                }
+            }
+            if (boundDistance < ray.distance) {
+                packetChild.entries.emplace_back(index, boundDistance);
+                packetChild.distance = std::min(packetChild.distance, boundDistance);
+            }
+        }
+        if (!packetChild.entries.empty()) {
+            packetChild.element = child;
+            children.push_back(std::move(packetChild));
+        }
+    }
+
+    if (children.size() > 1) {
+        std::sort(children.begin(), children.end(), [](const RayPacketChild& left, const RayPacketChild& right) {
+            return left.distance < right.distance;
+        });
+    }
+    for (const auto& child : children) {
+        evalRayPacketIntersections(child.element, child.entries, args, recursionCount + 1);
+    }
+}
+
+void EntityTree::evalRayIntersections(std::vector<RayPacketQuery>& rays, Octree::lockType lockType, bool* accurateResult) {
+    RayPacketArgs args { rays, std::vector<glm::vec3>(), BillboardModeHelpers::getPrimaryViewFrustumPosition() };
+    args.invDirections.reserve(rays.size());
+    std::vector<std::pair<uint64_t, uint32_t>> order;
+    order.reserve(rays.size());
+    for (uint32_t i = 0; i < (uint32_t)rays.size(); i++) {
+        RayPacketQuery& ray = rays[i];
+        ray.element.reset();
+        ray.distance = FLT_MAX;
+        ray.face = UNKNOWN_FACE;
+        ray.extraInfo.clear();
+        ray.entityID = EntityItemID();
+        // calculate dirReciprocal like this rather than with glm's scalar / vec3 template to avoid NaNs.
+        args.invDirections.emplace_back(ray.direction.x == 0.0f ? 0.0f : 1.0f / ray.direction.x,
+                                        ray.direction.y == 0.0f ? 0.0f : 1.0f / ray.direction.y,
+                                        ray.direction.z == 0.0f ? 0.0f : 1.0f / ray.direction.z);
+        order.emplace_back(rayCoherenceKey(ray), i);
+    }
+    std::sort(order.begin(), order.end());
+
+    bool requireLock = lockType == Octree::Lock;
+    bool lockResult = withReadLock([&]{
+        EntityTreeElementPointer root = std::static_pointer_cast<EntityTreeElement>(_rootElement);
+        if (!root) {
+            return;
+        }
+        std::vector<RayPacketEntry> entries;
+        for (size_t first = 0; first < order.size(); first += RAY_PACKET_SIZE) {
+            size_t last = std::min(first + RAY_PACKET_SIZE, order.size());
+            entries.clear();
+            for (size_t i = first; i < last; i++) {
+                // the root is always visited, like recurseTreeWithOperationSorted() does
+                entries.emplace_back(order[i].second, 0.0f);
+            }
+            evalRayPacketIntersections(root, entries, args, 0);
+        }
+    }, requireLock);
+
+    if (accurateResult) {
+        *accurateResult = lockResult;
+    }
+}
+
 class ParabolaArgs {
 public:
     // Inputs
@@ -46,6 +46,25 @@ public:
     QHash<EntityItemID, EntityItemID>* map;
 };
 
+// One ray of a packet traced by EntityTree::evalRayIntersections(), with its own filters and result.
+class RayPacketQuery {
+public:
+    // Inputs
+    glm::vec3 origin;
+    glm::vec3 direction;
+    QVector<EntityItemID> entityIdsToInclude;
+    QVector<EntityItemID> entityIdsToDiscard;
+    PickFilter searchFilter;
+
+    // Outputs
+    OctreeElementPointer element;
+    float distance { FLT_MAX };
+    BoxFace face { UNKNOWN_FACE };
+    glm::vec3 surfaceNormal;
+    QVariantMap extraInfo;
+    EntityItemID entityID;
+};
+
 class EntityTree : public Octree, public SpatialParentTree {
     Q_OBJECT
 public:
@@ -100,6 +119,12 @@ public:
         BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo,
         Octree::lockType lockType = Octree::TryLock, bool* accurateResult = NULL);
 
+    // Traces many rays under a single lock.  Rays are sorted into coherent packets, and each packet walks the tree
+    // once: an element's cube is tested against all the rays of the packet that can still hit something closer than
+    // their best hit so far, and the children are visited nearest first.
+    void evalRayIntersections(std::vector<RayPacketQuery>& rays, Octree::lockType lockType = Octree::TryLock,
+        bool* accurateResult = NULL);
+
     virtual EntityItemID evalParabolaIntersection(const PickParabola& parabola,
         QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
         PickFilter searchFilter, OctreeElementPointer& element, glm::vec3& intersection,
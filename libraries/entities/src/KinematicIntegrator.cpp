@@ -0,0 +1,194 @@
+//
+//  KinematicIntegrator.cpp
+//  libraries/entities/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "KinematicIntegrator.h"
+
+#include <glm/gtx/norm.hpp>
+
+#include <GLMHelpers.h>
+#include <PhysicsHelpers.h>
+
+#include "EntitiesLogging.h"
+
+void KinematicIntegrator::clear() {
+    _transforms.clear();
+    _timeElapsed.clear();
+    _positionX.clear();
+    _positionY.clear();
+    _positionZ.clear();
+    _velocityX.clear();
+    _velocityY.clear();
+    _velocityZ.clear();
+    _accelerationX.clear();
+    _accelerationY.clear();
+    _accelerationZ.clear();
+    _dampingFactor.clear();
+    _rotations.clear();
+    _angularVelocities.clear();
+    _angularDampingFactor.clear();
+    _isMoving.clear();
+    _hasChanged.clear();
+}
+
+void KinematicIntegrator::reserve(size_t size) {
+    _transforms.reserve(size);
+    _timeElapsed.reserve(size);
+    _positionX.reserve(size);
+    _positionY.reserve(size);
+    _positionZ.reserve(size);
+    _velocityX.reserve(size);
+    _velocityY.reserve(size);
+    _velocityZ.reserve(size);
+    _accelerationX.reserve(size);
+    _accelerationY.reserve(size);
+    _accelerationZ.reserve(size);
+    _dampingFactor.reserve(size);
+    _rotations.reserve(size);
+    _angularVelocities.reserve(size);
+    _angularDampingFactor.reserve(size);
+    _isMoving.reserve(size);
+    _hasChanged.reserve(size);
+}
+
+size_t KinematicIntegrator::add(const Transform& localTransform, const glm::vec3& linearVelocity,
+                                const glm::vec3& angularVelocity, const glm::vec3& acceleration,
+                                float damping, float angularDamping, float timeElapsed) {
+    bool isMoving = glm::length2(linearVelocity) > 0.0f || glm::length2(angularVelocity) > 0.0f;
+    if (!isMoving || timeElapsed <= 0.0f) {
+        // nothing to do, but a useless time value still counts as moving
+        timeElapsed = 0.0f;
+    }
+
+    const float MAX_TIME_ELAPSED = 1.0f; // seconds
+    if (timeElapsed > MAX_TIME_ELAPSED) {
+        qCDebug(entities) << "kinematic timestep = " << timeElapsed << " truncated to " << MAX_TIME_ELAPSED;
+        timeElapsed = MAX_TIME_ELAPSED;
+    }
+
+    _transforms.push_back(localTransform);
+    _timeElapsed.push_back(timeElapsed);
+    const glm::vec3& position = localTransform.getTranslation();
+    _positionX.push_back(position.x);
+    _positionY.push_back(position.y);
+    _positionZ.push_back(position.z);
+    _velocityX.push_back(linearVelocity.x);
+    _velocityY.push_back(linearVelocity.y);
+    _velocityZ.push_back(linearVelocity.z);
+    glm::vec3 effectiveAcceleration = glm::length2(acceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED ?
+        acceleration : glm::vec3(0.0f);
+    _accelerationX.push_back(effectiveAcceleration.x);
+    _accelerationY.push_back(effectiveAcceleration.y);
+    _accelerationZ.push_back(effectiveAcceleration.z);
+    _dampingFactor.push_back(damping > 0.0f ? powf(1.0f - damping, timeElapsed) - 1.0f : 0.0f);
+    _rotations.push_back(localTransform.getRotation());
+    _angularVelocities.push_back(angularVelocity);
+    _angularDampingFactor.push_back(angularDamping > 0.0f ? powf(1.0f - angularDamping, timeElapsed) : 1.0f);
+    _isMoving.push_back(isMoving ? 1 : 0);
+    _hasChanged.push_back(0);
+    return _transforms.size() - 1;
+}
+
+void KinematicIntegrator::integrate() {
+    integrateLinear();
+    integrateAngular();
+}
+
+void KinematicIntegrator::integrateLinear() {
+    const float MIN_KINEMATIC_LINEAR_SPEED_SQUARED =
+        KINEMATIC_LINEAR_SPEED_THRESHOLD * KINEMATIC_LINEAR_SPEED_THRESHOLD;
+
+    const size_t numRows = size();
+    const float* timeElapsed = _timeElapsed.data();
+    const float* accelerationX = _accelerationX.data();
+    const float* accelerationY = _accelerationY.data();
+    const float* accelerationZ = _accelerationZ.data();
+    const float* dampingFactor = _dampingFactor.data();
+    float* positionX = _positionX.data();
+    float* positionY = _positionY.data();
+    float* positionZ = _positionZ.data();
+    float* velocityX = _velocityX.data();
+    float* velocityY = _velocityY.data();
+    float* velocityZ = _velocityZ.data();
+    uint8_t* hasChanged = _hasChanged.data();
+
+    // Without acceleration the damping can only slow an entity down, so the three thresholds of the accelerated
+    // case reduce to the one on the current speed and both cases share the same branch free code.
+    // NOTE: like Bullet we do NOT include the second-order acceleration term (0.5 * a * dt^2) in the displacement.
+    for (size_t i = 0; i < numRows; ++i) {
+        float dt = timeElapsed[i];
+        float vx = velocityX[i];
+        float vy = velocityY[i];
+        float vz = velocityZ[i];
+        float dvx = dampingFactor[i] * vx + accelerationX[i] * dt;
+        float dvy = dampingFactor[i] * vy + accelerationY[i] * dt;
+        float dvz = dampingFactor[i] * vz + accelerationZ[i] * dt;
+        float nvx = vx + dvx;
+        float nvy = vy + dvy;
+        float nvz = vz + dvz;
+
+        float speedSquared = vx * vx + vy * vy + vz * vz;
+        bool isTranslating = dt > 0.0f && speedSquared > 0.0f;
+        bool stops = speedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED &&
+            dvx * dvx + dvy * dvy + dvz * dvz < MIN_KINEMATIC_LINEAR_SPEED_SQUARED &&
+            nvx * nvx + nvy * nvy + nvz * nvz < MIN_KINEMATIC_LINEAR_SPEED_SQUARED;
+        float step = (isTranslating && !stops) ? dt : 0.0f;
+
+        positionX[i] += step * vx;
+        positionY[i] += step * vy;
+        positionZ[i] += step * vz;
+        velocityX[i] = isTranslating ? (stops ? 0.0f : nvx) : vx;
+        velocityY[i] = isTranslating ? (stops ? 0.0f : nvy) : vy;
+        velocityZ[i] = isTranslating ? (stops ? 0.0f : nvz) : vz;
+        hasChanged[i] = isTranslating ? 1 : 0;
+    }
+}
+
+void KinematicIntegrator::integrateAngular() {
+    const float MIN_KINEMATIC_ANGULAR_SPEED_SQUARED =
+        KINEMATIC_ANGULAR_SPEED_THRESHOLD * KINEMATIC_ANGULAR_SPEED_THRESHOLD;
+
+    const size_t numRows = size();
+    for (size_t i = 0; i < numRows; ++i) {
+        glm::vec3& angularVelocity = _angularVelocities[i];
+        float dt = _timeElapsed[i];
+        if (dt <= 0.0f || glm::length2(angularVelocity) <= 0.0f) {
+            continue;
+        }
+        _hasChanged[i] = 1;
+
+        angularVelocity *= _angularDampingFactor[i];
+        if (glm::length2(angularVelocity) < MIN_KINEMATIC_ANGULAR_SPEED_SQUARED) {
+            angularVelocity = Vectors::ZERO;
+        } else {
+            // for improved agreement with the way Bullet integrates rotations we use an approximation
+            // and break the integration into bullet-sized substeps
+            glm::quat rotation = _rotations[i];
+            while (dt > 0.0f) {
+                glm::quat dQ = computeBulletRotationStep(angularVelocity, glm::min(dt, PHYSICS_ENGINE_FIXED_SUBSTEP));
+                rotation = glm::normalize(dQ * rotation);
+                dt -= PHYSICS_ENGINE_FIXED_SUBSTEP;
+            }
+            _rotations[i] = rotation;
+        }
+    }
+}
+
+Transform KinematicIntegrator::getTransform(size_t index) const {
+    Transform transform = _transforms[index];
+    transform.setTranslation(glm::vec3(_positionX[index], _positionY[index], _positionZ[index]));
+    transform.setRotation(_rotations[index]);
+    return transform;
+}
+
+glm::vec3 KinematicIntegrator::getLinearVelocity(size_t index) const {
+    return glm::vec3(_velocityX[index], _velocityY[index], _velocityZ[index]);
+}
+
+glm::vec3 KinematicIntegrator::getAngularVelocity(size_t index) const {
+    return _angularVelocities[index];
+}
@@ -0,0 +1,66 @@
+//
+//  KinematicIntegrator.h
+//  libraries/entities/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_KinematicIntegrator_h
+#define hifi_KinematicIntegrator_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <Transform.h>
+
+// Steps the non-colliding kinematic motion of many entities at once.  EntityItem::stepKinematicMotion() runs a single
+// entity through it, so both step the same way.  The state of the entities is copied into a structure of arrays so the
+// linear part of the integration runs as one branch free pass the compiler can vectorize, and so the owner only needs
+// to touch the entities again to write back the ones that changed.
+class KinematicIntegrator {
+public:
+    void clear();
+    void reserve(size_t size);
+    size_t size() const { return _transforms.size(); }
+
+    // acceleration is in the local frame.  Returns the index of the new row.
+    size_t add(const Transform& localTransform, const glm::vec3& linearVelocity, const glm::vec3& angularVelocity,
+               const glm::vec3& acceleration, float damping, float angularDamping, float timeElapsed);
+
+    void integrate();
+
+    // false if the row had neither linear nor angular velocity to begin with
+    bool isMoving(size_t index) const { return _isMoving[index] != 0; }
+    bool hasChanged(size_t index) const { return _hasChanged[index] != 0; }
+
+    Transform getTransform(size_t index) const;
+    glm::vec3 getLinearVelocity(size_t index) const;
+    glm::vec3 getAngularVelocity(size_t index) const;
+
+private:
+    void integrateLinear();
+    void integrateAngular();
+
+    std::vector<Transform> _transforms;     // only their scale is used, translation and rotation live below
+    std::vector<float> _timeElapsed;        // 0 for the rows that must not move
+    std::vector<float> _positionX;
+    std::vector<float> _positionY;
+    std::vector<float> _positionZ;
+    std::vector<float> _velocityX;
+    std::vector<float> _velocityY;
+    std::vector<float> _velocityZ;
+    std::vector<float> _accelerationX;
+    std::vector<float> _accelerationY;
+    std::vector<float> _accelerationZ;
+    std::vector<float> _dampingFactor;      // the change of velocity due to damping, relative to the velocity
+    std::vector<glm::quat> _rotations;
+    std::vector<glm::vec3> _angularVelocities;
+    std::vector<float> _angularDampingFactor;
+    std::vector<uint8_t> _isMoving;
+    std::vector<uint8_t> _hasChanged;
+};
+
+#endif // hifi_KinematicIntegrator_h
@@ -691,6 +691,8 @@ void ModelEntityItem::setModelScale(const glm::vec3& modelScale) {
     withWriteLock([&] {
         _modelScale = modelScale;
     });
+    // children are relative to the scaled transform
+    worldTransformChanged();
 }
 
 QString ModelEntityItem::getBlendshapeCoefficients() const {
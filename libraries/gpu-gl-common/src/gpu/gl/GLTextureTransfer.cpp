@@ -444,7 +444,6 @@ bool GLTextureTransferEngineDefault::processActiveBufferQueue() {
         _activeTransferQueue.splice(_activeTransferQueue.end(), activeBufferQueue);
     }
 
-    Texture::KtxStorage::releaseOpenKtxFiles();
     return true;
 }
 
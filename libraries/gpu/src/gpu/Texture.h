@@ -346,6 +346,7 @@ public:
         KtxStorage(const storage::StoragePointer& storage);
         KtxStorage(const std::string& filename);
         KtxStorage(const cache::FilePointer& file);
+        ~KtxStorage();
         PixelsPointer getMipFace(uint16 level, uint8 face = 0) const override;
         Size getMipFaceSize(uint16 level, uint8 face = 0) const override;
         bool isMipAvailable(uint16 level, uint8 face = 0) const override;
@@ -355,17 +356,38 @@ public:
 
         void reset() override { }
 
-        // Don't keep files open forever.  We close them at the beginning of each frame (GLBackend::recycle)
-        static void releaseOpenKtxFiles();
+        // KTX files stay mapped once opened, until the mapped files go over the budget of address space or the
+        // maximum count of open files and the least recently used ones are unmapped.  Mip faces are views into the
+        // mapping, which keep it alive while they are in use even when the file was unmapped from the table.
+        static void setMappedKtxFilesBudget(size_t budget);
+        static size_t getMappedKtxFilesBudget();
+        static size_t getMappedKtxFilesSize();
+        static size_t getMappedKtxFilesCount();
 
     protected:
-        std::shared_ptr<storage::FileStorage> maybeOpenFile() const;
-
-        mutable std::shared_ptr<std::mutex> _cacheFileMutex { std::make_shared<std::mutex>() };
-        mutable std::weak_ptr<storage::FileStorage> _cacheFile;
+        struct MappedFile {
+            std::shared_ptr<storage::FileStorage> file; // only accessed through std::atomic_load and std::atomic_store
+            std::atomic<uint64_t> lastAccess { 0 };
+            size_t size { 0 }; // guarded by _mappedFilesMutex
+            bool mapped { false }; // guarded by _mappedFilesMutex
+        };
 
-        static std::vector<std::pair<std::shared_ptr<storage::FileStorage>, std::shared_ptr<std::mutex>>> _cachedKtxFiles;
-        static std::mutex _cachedKtxFilesMutex;
+        // Lock free when the file is mapped already, only mapping a file takes the lock of the table
+        std::shared_ptr<storage::FileStorage> getMappedFile() const;
+        // Should be called with _mappedFilesMutex held
+        static void addMappedFile(const std::shared_ptr<MappedFile>& mappedFile, const std::shared_ptr<storage::FileStorage>& file);
+        static void removeMappedFile(MappedFile& mappedFile);
+        static void evictMappedFiles();
+
+        std::shared_ptr<MappedFile> _mappedFile { std::make_shared<MappedFile>() };
+        std::mutex _assignMipMutex;
+
+        // Never destroyed, so that storages released during static destruction still find it
+        static std::vector<std::shared_ptr<MappedFile>>& getMappedFiles();
+        static std::mutex _mappedFilesMutex;
+        static std::atomic<uint64_t> _mappedFilesClock;
+        static std::atomic<size_t> _mappedFilesSize;
+        static std::atomic<size_t> _mappedFilesBudget;
 
         storage::StoragePointer _storage;
         std::string _filename;
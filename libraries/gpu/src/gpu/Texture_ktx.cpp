@@ -12,6 +12,8 @@
 
 #include "Texture.h"
 
+#include <algorithm>
+
 #include <QtCore/QByteArray>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -24,8 +26,14 @@ using namespace gpu;
 using PixelsPointer = Texture::PixelsPointer;
 using KtxStorage = Texture::KtxStorage;
 
-std::vector<std::pair<std::shared_ptr<storage::FileStorage>, std::shared_ptr<std::mutex>>> KtxStorage::_cachedKtxFiles;
-std::mutex KtxStorage::_cachedKtxFilesMutex;
+// Mapping costs address space and an open file handle, but no memory until the pages are touched
+static const size_t DEFAULT_MAPPED_KTX_FILES_BUDGET = (size_t)(sizeof(void*) == 8 ? 4096 : 512) * 1024 * 1024;
+static const size_t MAX_MAPPED_KTX_FILES = 512;
+
+std::mutex KtxStorage::_mappedFilesMutex;
+std::atomic<uint64_t> KtxStorage::_mappedFilesClock { 0 };
+std::atomic<size_t> KtxStorage::_mappedFilesSize { 0 };
+std::atomic<size_t> KtxStorage::_mappedFilesBudget { DEFAULT_MAPPED_KTX_FILES_BUDGET };
 
 struct GPUKTXPayload {
     using Version = uint8;
@@ -195,7 +203,8 @@ KtxStorage::KtxStorage(const cache::FilePointer& cacheEntry) : KtxStorage(cacheE
 KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
     {
         // We are doing a lot of work here just to get descriptor data
-        ktx::StoragePointer storage{ new storage::FileStorage(_filename.c_str()) };
+        auto file = std::make_shared<storage::FileStorage>(_filename.c_str());
+        ktx::StoragePointer storage { file };
         auto ktxPointer = ktx::KTX::create(storage);
         _ktxDescriptor.reset(new ktx::KTXDescriptor(ktxPointer->toDescriptor()));
         if (_ktxDescriptor->images.size() < _ktxDescriptor->header.numberOfMipmapLevels) {
@@ -210,6 +219,13 @@ KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
             // Assume all mip levels are available
             _minMipLevelAvailable = 0;
         }
+
+        // The file is about to be streamed, keep it mapped rather than opening it again on the first mip
+        if (*file) {
+            std::lock_guard<std::mutex> lock(_mappedFilesMutex);
+            addMappedFile(_mappedFile, file);
+            evictMappedFiles();
+        }
     }
 
 
@@ -221,37 +237,106 @@ KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
     }
 }
 
-// maybeOpenFile should be called with _cacheFileMutex already held to avoid modifying the file from multiple threads
-std::shared_ptr<storage::FileStorage> KtxStorage::maybeOpenFile() const {
-    // Try to get the shared_ptr
-    std::shared_ptr<storage::FileStorage> file = _cacheFile.lock();
-    if (file) {
-        return file;
-    }
+std::vector<std::shared_ptr<KtxStorage::MappedFile>>& KtxStorage::getMappedFiles() {
+    static auto* mappedFiles = new std::vector<std::shared_ptr<MappedFile>>();
+    return *mappedFiles;
+}
 
-    // If the file isn't open, create it and save a weak_ptr to it
-    file = std::make_shared<storage::FileStorage>(_filename.c_str());
-    _cacheFile = file;
+KtxStorage::~KtxStorage() {
+    std::lock_guard<std::mutex> lock(_mappedFilesMutex);
+    removeMappedFile(*_mappedFile);
+}
 
-    {
-        // Add the shared_ptr to the global list of open KTX files, to be released at the beginning of the next present thread frame
-        std::lock_guard<std::mutex> lock(_cachedKtxFilesMutex);
-        _cachedKtxFiles.emplace_back(file, _cacheFileMutex);
+void KtxStorage::setMappedKtxFilesBudget(size_t budget) {
+    _mappedFilesBudget = budget > 0 ? budget : DEFAULT_MAPPED_KTX_FILES_BUDGET;
+    std::lock_guard<std::mutex> lock(_mappedFilesMutex);
+    evictMappedFiles();
+}
+
+size_t KtxStorage::getMappedKtxFilesBudget() {
+    return _mappedFilesBudget;
+}
+
+size_t KtxStorage::getMappedKtxFilesSize() {
+    return _mappedFilesSize;
+}
+
+size_t KtxStorage::getMappedKtxFilesCount() {
+    std::lock_guard<std::mutex> lock(_mappedFilesMutex);
+    return getMappedFiles().size();
+}
+
+void KtxStorage::addMappedFile(const std::shared_ptr<MappedFile>& mappedFile, const std::shared_ptr<storage::FileStorage>& file) {
+    removeMappedFile(*mappedFile);
+    mappedFile->size = file->size();
+    mappedFile->mapped = true;
+    mappedFile->lastAccess.store(++_mappedFilesClock, std::memory_order_relaxed);
+    std::atomic_store(&mappedFile->file, file);
+    getMappedFiles().push_back(mappedFile);
+    _mappedFilesSize += mappedFile->size;
+}
+
+void KtxStorage::removeMappedFile(MappedFile& mappedFile) {
+    if (!mappedFile.mapped) {
+        return;
     }
+    auto& mappedFiles = getMappedFiles();
+    auto itr = std::find_if(mappedFiles.begin(), mappedFiles.end(), [&](const std::shared_ptr<MappedFile>& entry) {
+        return entry.get() == &mappedFile;
+    });
+    if (itr != mappedFiles.end()) {
+        std::swap(*itr, mappedFiles.back());
+        mappedFiles.pop_back();
+    }
+    _mappedFilesSize -= mappedFile.size;
+    mappedFile.mapped = false;
+    mappedFile.size = 0;
+    // Views handed out by getMipFace still hold the file, it is unmapped once the last of them is released
+    std::atomic_store(&mappedFile.file, std::shared_ptr<storage::FileStorage>());
+}
 
-    return file;
+void KtxStorage::evictMappedFiles() {
+    size_t budget = _mappedFilesBudget;
+    if (_mappedFilesSize <= budget && getMappedFiles().size() <= MAX_MAPPED_KTX_FILES) {
+        return;
+    }
+
+    // Never evict the most recently mapped file, it is about to be used
+    std::vector<std::shared_ptr<MappedFile>> byAge = getMappedFiles();
+    std::sort(byAge.begin(), byAge.end(), [](const std::shared_ptr<MappedFile>& a, const std::shared_ptr<MappedFile>& b) {
+        return a->lastAccess.load(std::memory_order_relaxed) < b->lastAccess.load(std::memory_order_relaxed);
+    });
+    for (size_t i = 0; i + 1 < byAge.size(); ++i) {
+        if (_mappedFilesSize <= budget && getMappedFiles().size() <= MAX_MAPPED_KTX_FILES) {
+            break;
+        }
+        removeMappedFile(*byAge[i]);
+    }
 }
 
-void KtxStorage::releaseOpenKtxFiles() {
-    std::vector<std::pair<std::shared_ptr<storage::FileStorage>, std::shared_ptr<std::mutex>>> localKtxFiles;
-    {
-        std::lock_guard<std::mutex> lock(_cachedKtxFilesMutex);
-        localKtxFiles.swap(_cachedKtxFiles);
+std::shared_ptr<storage::FileStorage> KtxStorage::getMappedFile() const {
+    // Hits only stamp the file with the current clock, which only moves when files get mapped, so that concurrent
+    // lookups of different textures don't write to a shared cache line
+    std::shared_ptr<storage::FileStorage> file = std::atomic_load(&_mappedFile->file);
+    if (file) {
+        _mappedFile->lastAccess.store(_mappedFilesClock.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return file;
+    }
+
+    std::lock_guard<std::mutex> lock(_mappedFilesMutex);
+    // Another thread may have mapped it while we waited
+    file = std::atomic_load(&_mappedFile->file);
+    if (file) {
+        return file;
     }
-    for (auto& cacheFileAndMutex : localKtxFiles) {
-        std::lock_guard<std::mutex> lock(*(cacheFileAndMutex.second));
-        cacheFileAndMutex.first.reset();
+
+    file = std::make_shared<storage::FileStorage>(_filename.c_str());
+    if (!(*file)) {
+        return std::shared_ptr<storage::FileStorage>();
     }
+    addMappedFile(_mappedFile, file);
+    evictMappedFiles();
+    return file;
 }
 
 PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
@@ -262,12 +347,11 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
         if (_storage) {
             storageView = _storage->createView(faceSize, faceOffset);
         } else {
-            std::lock_guard<std::mutex> lock(*_cacheFileMutex);
-            auto file = maybeOpenFile();
+            auto file = getMappedFile();
             if (file) {
                 storageView = file->createView(faceSize, faceOffset);
             } else {
-                qWarning() << "Failed to get a valid file out of maybeOpenFile " << QString::fromStdString(_filename);
+                qWarning() << "Failed to get a valid file out of getMappedFile " << QString::fromStdString(_filename);
             }
         }
     }
@@ -275,7 +359,8 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
         qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset
                     << "out of valid file " << QString::fromStdString(_filename);
     }
-    return storageView->toMemoryStorage();
+    // No copy, the view points straight into the mapped file and keeps it mapped
+    return storageView;
 }
 
 Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
@@ -307,8 +392,8 @@ void KtxStorage::assignMipData(uint16 level, const storage::StoragePointer& stor
         return;
     }
 
-    std::lock_guard<std::mutex> lock(*_cacheFileMutex);
-    auto file = maybeOpenFile();
+    std::lock_guard<std::mutex> lock(_assignMipMutex);
+    auto file = getMappedFile();
     if (!file) {
         qWarning() << "Failed to open file to assign mip data ";
         return;
@@ -13,7 +13,11 @@
 
 #include <glm/gtc/packing.hpp>
 
+#include <condition_variable>
+#include <mutex>
+
 #include <QtCore/QtGlobal>
+#include <QThread>
 #include <QUrl>
 #include <QRgb>
 #include <QBuffer>
@@ -23,6 +27,8 @@
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
+#include <tbb/task_arena.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -420,40 +426,83 @@ Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
     return localCopy;
 }
 
+// 0 uses one thread per core.  The arena is rebuilt on the next use when the budget changes.
+static std::mutex processingArenaMutex;
+static std::shared_ptr<tbb::task_arena> processingArena;
+static int processingThreadBudget { 0 };
+
+void setProcessingThreadBudget(int numThreads) {
+    std::lock_guard<std::mutex> lock(processingArenaMutex);
+    numThreads = std::max(numThreads, 0);
+    if (numThreads != processingThreadBudget) {
+        processingThreadBudget = numThreads;
+        processingArena.reset();
+    }
+}
+
+int getProcessingThreadBudget() {
+    std::lock_guard<std::mutex> lock(processingArenaMutex);
+    return processingThreadBudget > 0 ? processingThreadBudget : std::max(QThread::idealThreadCount(), 1);
+}
+
+// All the texture processing runs in one arena, so the images processed concurrently by different threads share the
+// budget instead of each of them spawning one worker per core.
+template <typename F>
+static void runInProcessingArena(const F& function) {
+    std::shared_ptr<tbb::task_arena> arena;
+    {
+        std::lock_guard<std::mutex> lock(processingArenaMutex);
+        if (!processingArena) {
+            int numThreads = processingThreadBudget > 0 ? processingThreadBudget : std::max(QThread::idealThreadCount(), 1);
+            processingArena = std::make_shared<tbb::task_arena>(numThreads);
+        }
+        arena = processingArena;
+    }
+    arena->execute(function);
+}
+
+// The storage of gpu::Texture isn't thread safe, faces and mips processed in parallel are assigned one at a time.
+static std::mutex textureAssignMutex;
+
 #if defined(NVTT_API)
+// Keeps the compressed images until assignToTexture() so that mips compressed in parallel can be assigned in order.
 struct OutputHandler : public nvtt::OutputHandler {
     OutputHandler(gpu::Texture* texture, int face) : _texture(texture), _face(face) {}
 
     virtual void beginImage(int size, int width, int height, int depth, int face, int miplevel) override {
-        _size = size;
-        _miplevel = miplevel;
-
-        _data = static_cast<gpu::Byte*>(malloc(size));
-        _current = _data;
+        _images.emplace_back(miplevel, std::vector<gpu::Byte>(size));
+        _current = _images.back().second.data();
+        _end = _current + size;
     }
 
     virtual bool writeData(const void* data, int size) override {
-        assert(_current + size <= _data + _size);
+        assert(_current + size <= _end);
         memcpy(_current, data, size);
         _current += size;
         return true;
     }
 
     virtual void endImage() override {
-        if (_face >= 0) {
-            _texture->assignStoredMipFace(_miplevel, _face, _size, static_cast<const gpu::Byte*>(_data));
-        } else {
-            _texture->assignStoredMip(_miplevel, _size, static_cast<const gpu::Byte*>(_data));
+        _current = nullptr;
+        _end = nullptr;
+    }
+
+    void assignToTexture() {
+        std::lock_guard<std::mutex> lock(textureAssignMutex);
+        for (const auto& image : _images) {
+            if (_face >= 0) {
+                _texture->assignStoredMipFace(image.first, _face, image.second.size(), image.second.data());
+            } else {
+                _texture->assignStoredMip(image.first, image.second.size(), image.second.data());
+            }
         }
-        free(_data);
-        _data = nullptr;
+        _images.clear();
     }
 
-    gpu::Byte* _data{ nullptr };
+    std::vector<std::pair<int, std::vector<gpu::Byte>>> _images;
     gpu::Byte* _current{ nullptr };
+    gpu::Byte* _end{ nullptr };
     gpu::Texture* _texture{ nullptr };
-    int _miplevel = 0;
-    int _size = 0;
     int _face = -1;
 };
 
@@ -500,25 +549,71 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
     }
 };
 
-#if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+// Runs the compression tasks of nvtt, one per block row, in the processing arena
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
+        tbb::parallel_for(0, count, [&](int i) {
             if (!_abortProcessing.load()) {
                 task(context, i);
-            } else {
-                break;
             }
-        }
+        });
     }
 };
-#endif
+
+// Box filtering each mip from the previous one is cheap next to the compression, so the whole chain is built first
+// and the levels are then compressed in parallel.
+static std::vector<nvtt::Surface> buildMipChain(const nvtt::Surface& surface, bool buildMips, const std::atomic<bool>& abortProcessing) {
+    std::vector<nvtt::Surface> mips { surface };
+    if (buildMips) {
+        while (mips.back().canMakeNextMipmap() && !abortProcessing.load()) {
+            nvtt::Surface mip = mips.back();
+            mip.buildNextMipmap(nvtt::MipmapFilter_Box);
+            mips.push_back(std::move(mip));
+        }
+    }
+    return mips;
+}
+
+static void compressMipChain(const std::vector<nvtt::Surface>& mips, int face, int baseMipLevel,
+                             const nvtt::CompressionOptions& compressionOptions,
+                             const std::function<OutputHandler*()>& createOutputHandler,
+                             const std::atomic<bool>& abortProcessing) {
+    std::vector<std::unique_ptr<OutputHandler>> outputHandlers(mips.size());
+    runInProcessingArena([&] {
+        tbb::parallel_for(0, (int)mips.size(), [&](int i) {
+            if (abortProcessing.load()) {
+                return;
+            }
+            outputHandlers[i].reset(createOutputHandler());
+            if (!outputHandlers[i]) {
+                return;
+            }
+
+            nvtt::OutputOptions outputOptions;
+            outputOptions.setOutputHeader(false);
+            outputOptions.setOutputHandler(outputHandlers[i].get());
+            MyErrorHandler errorHandler;
+            outputOptions.setErrorHandler(&errorHandler);
+
+            ParallelTaskDispatcher dispatcher(abortProcessing);
+            nvtt::Context context;
+            context.setTaskDispatcher(&dispatcher);
+            context.compress(mips[i], face, baseMipLevel + i, compressionOptions, outputOptions);
+        });
+    });
+
+    for (auto& outputHandler : outputHandlers) {
+        if (outputHandler) {
+            outputHandler->assignToTexture();
+        }
+    }
+}
 
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
                               glm::vec4* output, size_t outputLinePixelStride) {
@@ -560,9 +655,10 @@ void convertToPackedFromFloat(unsigned char* output, int width, int height, size
     }
 }
 
-nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture, int face, nvtt::CompressionOptions& compressionOptions) {
-    auto outputFormat = outputTexture->getStoredMipFormat();
-    bool useNVTT = false;
+// Sets up the compression of HDR mips into the stored format of the texture.  useNVTT is false for the packed float
+// formats, which are written by PackedFloatOutputHandler.  Returns false for formats it can't produce.
+static bool setupHDRCompressionOptions(gpu::Element outputFormat, nvtt::CompressionOptions& compressionOptions, bool& useNVTT) {
+    useNVTT = false;
 
     compressionOptions.setQuality(nvtt::Quality_Production);
 
@@ -585,15 +681,9 @@ nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture
     } else {
         qCWarning(imagelogging) << "Unknown mip format";
         Q_UNREACHABLE();
-        return nullptr;
-    }
-
-    if (!useNVTT) {
-        // Don't use NVTT (at least version 2.1) as it outputs wrong RGB9E5 and R11G11B10F values from floats
-        return new PackedFloatOutputHandler(outputTexture, face, outputFormat);
-    } else {
-        return new OutputHandler(outputTexture, face);
+        return false;
     }
+    return true;
 }
 
 void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
@@ -604,35 +694,53 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     const int width = localCopy.getWidth();
     const int height = localCopy.getHeight();
 
-    nvtt::OutputOptions outputOptions;
-    outputOptions.setOutputHeader(false);
-
+    auto outputFormat = texture->getStoredMipFormat();
     nvtt::CompressionOptions compressionOptions;
-    std::unique_ptr<nvtt::OutputHandler> outputHandler{ getNVTTCompressionOutputHandler(texture, face, compressionOptions) };
-
-    MyErrorHandler errorHandler;
-    outputOptions.setErrorHandler(&errorHandler);
-    nvtt::Context context;
-    int mipLevel = baseMipLevel;
-
-    outputOptions.setOutputHandler(outputHandler.get());
+    bool useNVTT;
+    if (!setupHDRCompressionOptions(outputFormat, compressionOptions, useNVTT)) {
+        return;
+    }
 
     nvtt::Surface surface;
     surface.setImage(nvtt::InputFormat_RGBA_32F, width, height, 1, localCopy.getBits());
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
+    localCopy = Image();
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
-    context.setTaskDispatcher(&dispatcher);
-
-    context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-    if (buildMips) {
-        while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-            surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-            context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
+    auto mips = buildMipChain(surface, buildMips, abortProcessing);
+    compressMipChain(mips, face, baseMipLevel, compressionOptions, [&]() -> OutputHandler* {
+        if (!useNVTT) {
+            // Don't use NVTT (at least version 2.1) as it outputs wrong RGB9E5 and R11G11B10F values from floats
+            return new PackedFloatOutputHandler(texture, face, outputFormat);
         }
+        return new OutputHandler(texture, face);
+    }, abortProcessing);
+}
+
+// Etc2comp runs its own threads instead of TBB tasks, so the arena doesn't bound them.  The encodes running at the
+// same time share a pool of as many threads as the processing budget, and wait for one to free up when it is empty.
+static std::mutex etcEncodeThreadsMutex;
+static std::condition_variable etcEncodeThreadsReleased;
+static int etcEncodeThreadsInUse { 0 };
+
+static int acquireEtcEncodeThreads() {
+    std::unique_lock<std::mutex> lock(etcEncodeThreadsMutex);
+    int budget = 0;
+    etcEncodeThreadsReleased.wait(lock, [&] {
+        budget = getProcessingThreadBudget();
+        return etcEncodeThreadsInUse < budget;
+    });
+    int numThreads = budget - etcEncodeThreadsInUse;
+    etcEncodeThreadsInUse += numThreads;
+    return numThreads;
+}
+
+static void releaseEtcEncodeThreads(int numThreads) {
+    {
+        std::lock_guard<std::mutex> lock(etcEncodeThreadsMutex);
+        etcEncodeThreadsInUse -= numThreads;
     }
+    etcEncodeThreadsReleased.notify_all();
 }
 
 void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
@@ -642,7 +750,6 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
     const int width = localCopy.getWidth(), height = localCopy.getHeight();
     auto mipFormat = texture->getStoredMipFormat();
-    int mipLevel = baseMipLevel;
 
     if (target != BackendTarget::GLES32) {
         if (localCopy.getFormat() != Image::Format_ARGB32) {
@@ -752,23 +859,10 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             return;
         }
 
-        nvtt::OutputOptions outputOptions;
-        outputOptions.setOutputHeader(false);
-        OutputHandler outputHandler(texture, face);
-        outputOptions.setOutputHandler(&outputHandler);
-        MyErrorHandler errorHandler;
-        outputOptions.setErrorHandler(&errorHandler);
-
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
-
-        context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        if (buildMips) {
-            while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-                surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-                context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-            }
-        }
+        auto mips = buildMipChain(surface, buildMips, abortProcessing);
+        compressMipChain(mips, face, baseMipLevel, compressionOptions, [&] {
+            return new OutputHandler(texture, face);
+        }, abortProcessing);
     } else {
         int numMips = 1;
     
@@ -807,13 +901,13 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
         const Etc::ErrorMetric errorMetric = Etc::ErrorMetric::RGBA;
         const float effort = 1.0f;
-        const int numEncodeThreads = 4;
         int encodingTime;
 
         if (localCopy.getFormat() != Image::Format_RGBAF) {
             localCopy = localCopy.getConvertedToFormat(Image::Format_RGBAF);
         }
 
+        const int numEncodeThreads = acquireEtcEncodeThreads();
         Etc::EncodeMipmaps(
             (float *)localCopy.editBits(), width, height,
             etcFormat, errorMetric, effort,
@@ -821,7 +915,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             numMips, Etc::FILTER_WRAP_NONE,
             mipMaps, &encodingTime
         );
+        releaseEtcEncodeThreads(numEncodeThreads);
 
+        std::lock_guard<std::mutex> lock(textureAssignMutex);
         for (int i = 0; i < numMips; i++) {
             if (mipMaps[i].paucEncodingBits.get()) {
                 if (face >= 0) {
@@ -1491,11 +1587,14 @@ void convolveForGGX(const std::vector<Image>& faces, gpu::Texture* texture, Back
         output.applyGamma(1.0f/2.2f);
     }
 
-    for (int face = 0; face < 6; face++) {
-        for (gpu::uint16 mipLevel = 0; mipLevel < output.getMipCount(); mipLevel++) {
+    const int mipCount = output.getMipCount();
+    runInProcessingArena([&] {
+        tbb::parallel_for(0, 6 * mipCount, [&](int index) {
+            int face = index / mipCount;
+            gpu::uint16 mipLevel = (gpu::uint16)(index % mipCount);
             convertToTexture(texture, output.getFaceImage(mipLevel, face), target, abortProcessing, face, mipLevel);
-        }
-    }
+        });
+    });
 }
 
 gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcImage, const std::string& srcImageName,
@@ -1601,10 +1700,11 @@ gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcIm
             convolveForGGX(faces, theTexture.get(), target, abortProcessing);
         } else {
             // Create mip maps and compress to final format in one go
-            for (uint8 face = 0; face < faces.size(); ++face) {
-                // Force building the mip maps right now on CPU if we are convolving for GGX later on
-                convertToTextureWithMips(theTexture.get(), std::move(faces[face]), target, abortProcessing, face);
-            }
+            runInProcessingArena([&] {
+                tbb::parallel_for(0, (int)faces.size(), [&](int face) {
+                    convertToTextureWithMips(theTexture.get(), std::move(faces[face]), target, abortProcessing, face);
+                });
+            });
         }
     }
 
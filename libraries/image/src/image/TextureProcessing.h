@@ -127,6 +127,11 @@ std::pair<gpu::TexturePointer, glm::ivec2> processImage(std::shared_ptr<QIODevic
                                                         int maxNumPixels, TextureUsage::Type textureType,
                                                         bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false);
 
+// Mip levels, cube faces and compression blocks are processed in parallel, by at most this many threads across all
+// the callers together (ImageReader, TextureBaker and the oven).  0, the default, uses one thread per core.
+void setProcessingThreadBudget(int numThreads);
+int getProcessingThreadBudget();
+
 void convertToTextureWithMips(gpu::Texture* texture, Image&& image, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false, int face = -1);
 void convertToTexture(gpu::Texture* texture, Image&& image, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false, int face = -1, int mipLevel = 0);
 
@@ -43,6 +43,9 @@
 #include <Finally.h>
 #include <Profile.h>
 
+#include <AssetClient.h>
+#include <AssetUtils.h>
+#include <MappingRequest.h>
 #include <NetworkLogging.h>
 #include "MaterialNetworkingLogging.h"
 #include <NetworkingConstants.h>
@@ -271,13 +274,55 @@ NetworkTexturePointer TextureCache::getTexture(const QUrl& url, image::TextureUs
     return ResourceCache::getResource(modifiedUrl, QUrl(), &extra, std::hash<TextureExtra>()(extra)).staticCast<NetworkTexture>();
 }
 
+// The asset hash of "atp:HASH[.ext]" URLs, empty for ATP paths and other schemes
+static QString getUrlAssetHash(const QUrl& url) {
+    if (url.scheme() != URL_SCHEME_ATP || url.path().contains('/')) {
+        return QString();
+    }
+    auto assetHash = QFileInfo(url.path()).baseName();
+    return AssetUtils::isValidHash(assetHash) ? assetHash.toLower() : QString();
+}
+
+static std::string getUrlContentKey(const QUrl& url, size_t extraHash) {
+    auto assetHash = getUrlAssetHash(url);
+    QString key = assetHash.isEmpty() ? url.toString(QUrl::RemoveFragment) : URL_SCHEME_ATP + ":" + assetHash;
+    return key.toStdString() + "/" + std::to_string(extraHash);
+}
+
+std::string TextureCache::getSourceHashForUrl(const QUrl& url, size_t extraHash) {
+    std::unique_lock<std::mutex> lock(_sourceHashesByUrlMutex);
+    auto found = _sourceHashesByUrl.find(getUrlContentKey(url, extraHash));
+    return found != _sourceHashesByUrl.end() ? found->second : std::string();
+}
+
+void TextureCache::setSourceHashForUrl(const QUrl& url, size_t extraHash, const std::string& sourceHash) {
+    // what an ATP path maps to can change, only its asset hash identifies the content
+    if (url.scheme() == URL_SCHEME_ATP && getUrlAssetHash(url).isEmpty()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_sourceHashesByUrlMutex);
+    if (sourceHash.empty()) {
+        _sourceHashesByUrl.erase(getUrlContentKey(url, extraHash));
+    } else {
+        _sourceHashesByUrl[getUrlContentKey(url, extraHash)] = sourceHash;
+    }
+}
+
+std::pair<gpu::TexturePointer, glm::ivec2> TextureCache::findTextureByHash(const std::string& hash) {
+    std::unique_lock<std::mutex> lock(_texturesByHashesMutex);
+    auto found = _texturesByHashes.find(hash);
+    if (found == _texturesByHashes.end()) {
+        return { gpu::TexturePointer(), glm::ivec2() };
+    }
+    return { found->second.first.lock(), found->second.second };
+}
+
 std::pair<gpu::TexturePointer, glm::ivec2> TextureCache::getTextureByHash(const std::string& hash) {
-    std::pair<gpu::TextureWeakPointer, glm::ivec2> weakPointer;
-    {
-        std::unique_lock<std::mutex> lock(_texturesByHashesMutex);
-        weakPointer = _texturesByHashes[hash];
+    auto textureAndSize = findTextureByHash(hash);
+    if (textureAndSize.first) {
+        _numDuplicateImages++;
     }
-    return { weakPointer.first.lock(), weakPointer.second };
+    return textureAndSize;
 }
 
 std::pair<gpu::TexturePointer, glm::ivec2> TextureCache::cacheTextureByHash(const std::string& hash, const std::pair<gpu::TexturePointer, glm::ivec2>& textureAndSize) {
@@ -287,8 +332,16 @@ std::pair<gpu::TexturePointer, glm::ivec2> TextureCache::cacheTextureByHash(cons
         auto& value = _texturesByHashes[hash];
         result = { value.first.lock(), value.second };
         if (!result.first) {
-            _texturesByHashes[hash] = textureAndSize;
+            // Textures unserialized from KTX files don't carry their source hash, which identifies their content.
+            // Set it before publishing the texture, other threads only ever see it with its hash.
+            if (textureAndSize.first && textureAndSize.first->sourceHash().empty()) {
+                textureAndSize.first->setSourceHash(hash);
+            }
+            value = textureAndSize;
             result = textureAndSize;
+        } else if (result.first != textureAndSize.first) {
+            // lost the race against a concurrent load of the same image
+            _numDuplicateImages++;
         }
     }
     return result;
@@ -474,6 +527,13 @@ void NetworkTexture::setImage(gpu::TexturePointer texture, int originalWidth,
         _width = texture->getWidth();
         _height = texture->getHeight();
         setSize(texture->getStoredSize());
+        // remember what the URL serves, so the next texture requested from it needn't download it again
+        if (_currentlyLoadingResourceType == ResourceType::ORIGINAL && _content.isEmpty() && !texture->sourceHash().empty()) {
+            auto textureCache = DependencyManager::get<TextureCache>();
+            if (textureCache) {
+                textureCache->setSourceHashForUrl(_activeUrl, _extraHash, texture->sourceHash());
+            }
+        }
         finishedLoading(true);
     } else {
         _width = _height = 0;
@@ -513,6 +573,12 @@ private:
 };
 
 NetworkTexture::~NetworkTexture() {
+    if (_assetMappingRequest) {
+        _assetMappingRequest->disconnect(this);
+        _assetMappingRequest->deleteLater();
+        _assetMappingRequest = nullptr;
+        TextureCache::requestCompleted(_self);
+    }
     if (_ktxHeaderRequest || _ktxMipRequest) {
         if (_ktxHeaderRequest) {
             _ktxHeaderRequest->disconnect(this);
@@ -530,6 +596,10 @@ NetworkTexture::~NetworkTexture() {
 
 const uint16_t NetworkTexture::NULL_MIP_LEVEL = std::numeric_limits<uint16_t>::max();
 void NetworkTexture::makeRequest() {
+    if (_currentlyLoadingResourceType == ResourceType::ORIGINAL) {
+        makeOriginalRequest();
+        return;
+    }
     if (_currentlyLoadingResourceType != ResourceType::KTX) {
         Resource::makeRequest();
         return;
@@ -598,6 +668,60 @@ void NetworkTexture::makeRequest() {
     }
 }
 
+void NetworkTexture::makeOriginalRequest() {
+    if (loadKnownContent()) {
+        return;
+    }
+    if (_activeUrl.scheme() != URL_SCHEME_ATP || !getUrlAssetHash(_activeUrl).isEmpty() || !_content.isEmpty()) {
+        Resource::makeRequest();
+        return;
+    }
+
+    // An ATP path is resolved to its asset hash first, which identifies the image before it is downloaded.  The image
+    // is then requested by hash, so the path isn't mapped twice.
+    auto path = _activeUrl.path() + (_activeUrl.hasQuery() ? "?" + _activeUrl.query() : "");
+    _assetMappingRequest = DependencyManager::get<AssetClient>()->createGetMappingRequest(path);
+    connect(_assetMappingRequest, &GetMappingRequest::finished, this, [this](GetMappingRequest* request) {
+        _assetMappingRequest->deleteLater();
+        _assetMappingRequest = nullptr;
+
+        // errors and redirects are reported by the regular request of the path
+        if (request->getError() != MappingRequest::NoError || request->wasRedirected()) {
+            Resource::makeRequest();
+            return;
+        }
+        _activeUrl = QUrl(URL_SCHEME_ATP + ":" + request->getHash());
+        if (!loadKnownContent()) {
+            Resource::makeRequest();
+        }
+    });
+    _assetMappingRequest->start();
+}
+
+bool NetworkTexture::loadKnownContent() {
+    auto textureCache = DependencyManager::get<TextureCache>();
+    if (!textureCache || !_content.isEmpty()) {
+        return false;
+    }
+    auto sourceHash = textureCache->getSourceHashForUrl(_activeUrl, _extraHash);
+    if (sourceHash.empty()) {
+        return false;
+    }
+    auto textureAndSize = textureCache->findTextureByHash(sourceHash);
+    if (!textureAndSize.first) {
+        return false;
+    }
+
+    textureCache->_numDuplicateUrls++;
+    // queued, the same as when the image is read, rather than starting the next requests from within this one
+    QMetaObject::invokeMethod(this, "handleLocalRequestCompleted", Qt::QueuedConnection);
+    QMetaObject::invokeMethod(this, "setImage", Qt::QueuedConnection,
+                              Q_ARG(gpu::TexturePointer, textureAndSize.first),
+                              Q_ARG(int, textureAndSize.second.x),
+                              Q_ARG(int, textureAndSize.second.y));
+    return true;
+}
+
 void NetworkTexture::handleLocalRequestCompleted() {
     TextureCache::requestCompleted(_self);
 }
@@ -1160,6 +1284,19 @@ void NetworkTexture::refresh() {
         TextureCache::requestCompleted(_self);
     }
 
+    if (_assetMappingRequest) {
+        _assetMappingRequest->disconnect(this);
+        _assetMappingRequest->deleteLater();
+        _assetMappingRequest = nullptr;
+        TextureCache::requestCompleted(_self);
+    }
+
+    // a refresh downloads the URL again, whatever it served before
+    auto textureCache = DependencyManager::get<TextureCache>();
+    if (textureCache) {
+        textureCache->setSourceHashForUrl(_activeUrl, _extraHash, std::string());
+    }
+
     _ktxResourceState = PENDING_INITIAL_LOAD;
     Resource::refresh();
 }
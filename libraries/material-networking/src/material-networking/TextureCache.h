@@ -35,6 +35,8 @@ namespace gpu {
 class Batch;
 }
 
+class GetMappingRequest;
+
 /// A simple object wrapper for an OpenGL texture.
 class Texture {
 public:
@@ -83,6 +85,9 @@ public slots:
 protected:
     void makeRequest() override;
     void makeLocalRequest();
+    void makeOriginalRequest();
+    // Uses the texture in memory with the content the URL served last time, instead of downloading it again
+    bool loadKnownContent();
     Q_INVOKABLE void handleLocalRequestCompleted();
 
     Q_INVOKABLE virtual void downloadFinished(const QByteArray& data) override;
@@ -149,6 +154,8 @@ private:
     int _maxNumPixels { ABSOLUTE_MAX_TEXTURE_NUM_PIXELS };
     QByteArray _content;
 
+    GetMappingRequest* _assetMappingRequest { nullptr };
+
     friend class TextureCache;
 };
 
@@ -192,6 +199,12 @@ public:
     std::pair<gpu::TexturePointer, glm::ivec2> getTextureByHash(const std::string& hash);
     std::pair<gpu::TexturePointer, glm::ivec2> cacheTextureByHash(const std::string& hash, const std::pair<gpu::TexturePointer, glm::ivec2>& textureAndSize);
 
+    /// Number of textures requested from a URL and served, without downloading, by the texture in memory with the content
+    /// that URL served before.
+    size_t getNumDuplicateUrls() const { return _numDuplicateUrls; }
+    /// Number of textures whose downloaded content matched a texture already in memory, so were neither decoded nor uploaded.
+    size_t getNumDuplicateImages() const { return _numDuplicateImages; }
+
     NetworkTexturePointer getResourceTexture(const QUrl& resourceTextureUrl);
     const gpu::FramebufferPointer& getHmdPreviewFramebuffer(int width, int height);
     const gpu::FramebufferPointer& getSpectatorCameraFramebuffer();
@@ -226,6 +239,12 @@ private:
     TextureCache();
     virtual ~TextureCache();
 
+    // getTextureByHash() without counting a duplicate image
+    std::pair<gpu::TexturePointer, glm::ivec2> findTextureByHash(const std::string& hash);
+    // The source hash of the image a URL served, empty if it hasn't been loaded.  Setting an empty hash forgets it.
+    std::string getSourceHashForUrl(const QUrl& url, size_t extraHash);
+    void setSourceHashForUrl(const QUrl& url, size_t extraHash, const std::string& sourceHash);
+
     static const std::string KTX_DIRNAME;
     static const std::string KTX_EXT;
 
@@ -237,6 +256,16 @@ private:
     std::unordered_map<std::string, std::pair<std::weak_ptr<gpu::Texture>, glm::ivec2>> _texturesByHashes;
     std::mutex _texturesByHashesMutex;
 
+    // Source hash of the image each URL served, by URL and extra hash, so that a NetworkTexture requested from a URL
+    // whose image is still in memory shares it without downloading it.  ATP hash URLs are keyed by their asset hash,
+    // which identifies their content whatever their extension, ATP paths are resolved to it before downloading.  The
+    // map only grows, by a few bytes per URL.
+    std::unordered_map<std::string, std::string> _sourceHashesByUrl;
+    std::mutex _sourceHashesByUrlMutex;
+
+    std::atomic<size_t> _numDuplicateUrls { 0 };
+    std::atomic<size_t> _numDuplicateImages { 0 };
+
     gpu::TexturePointer _permutationNormalTexture;
     gpu::TexturePointer _whiteTexture;
     gpu::TexturePointer _grayTexture;
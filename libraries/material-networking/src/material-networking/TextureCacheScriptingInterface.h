@@ -22,6 +22,9 @@
 class TextureCacheScriptingInterface : public ScriptableResourceCache, public Dependency {
     Q_OBJECT
 
+    Q_PROPERTY(size_t numDuplicateUrls READ getNumDuplicateUrls NOTIFY dirty)
+    Q_PROPERTY(size_t numDuplicateImages READ getNumDuplicateImages NOTIFY dirty)
+
     // Properties are copied over from ResourceCache (see ResourceCache.h for reason).
 
     /*@jsdoc
@@ -41,6 +44,10 @@ class TextureCacheScriptingInterface : public ScriptableResourceCache, public De
      *     <em>Read-only.</em>
      * @property {number} numGlobalQueriesLoading - Total number of global queries loading (across all resource cache managers).
      *     <em>Read-only.</em>
+     * @property {number} numDuplicateUrls - Number of textures requested from a URL and served, without downloading, by a
+     *     texture in memory with the content that URL (or ATP asset hash) served before. <em>Read-only.</em>
+     * @property {number} numDuplicateImages - Number of downloaded images which were already loaded, so were neither decoded
+     *     nor uploaded again. <em>Read-only.</em>
      *
      * @borrows ResourceCache.getResourceList as getResourceList
      * @borrows ResourceCache.updateTotalSize as updateTotalSize
@@ -63,6 +70,9 @@ public:
      */
     Q_INVOKABLE ScriptableResource* prefetch(const QUrl& url, int type, int maxNumPixels = ABSOLUTE_MAX_TEXTURE_NUM_PIXELS);
 
+    size_t getNumDuplicateUrls() const { return DependencyManager::get<TextureCache>()->getNumDuplicateUrls(); }
+    size_t getNumDuplicateImages() const { return DependencyManager::get<TextureCache>()->getNumDuplicateImages(); }
+
 signals:
     /*@jsdoc
      * @function TextureCache.spectatorCameraFramebufferReset
@@ -134,6 +134,9 @@ namespace baker {
             const auto& mapping = input.getN<Input>(1);
             const auto& materialMappingBaseURL = input.getN<Input>(2);
 
+            // The baker jobs only communicate through their Varyings, so let independent ones run concurrently
+            model.setParallel(true);
+
             // Split up the inputs from hfm::Model
             const auto modelPartsIn = model.addJob<GetModelPartsTask>("GetModelParts", hfmModelIn);
             const auto meshesIn = modelPartsIn.getN<GetModelPartsTask::Output>(0);
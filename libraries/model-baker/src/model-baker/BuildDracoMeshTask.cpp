@@ -35,6 +35,9 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <TBBHelpers.h>
+
+#include "MeshBakeCache.h"
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
@@ -221,38 +224,61 @@ void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Inp
     auto& dracoErrorsPerMesh = output.edit1();
     auto& materialLists = output.edit2();
 
-    dracoBytesPerMesh.reserve(meshes.size());
+    dracoBytesPerMesh.resize(meshes.size());
+    materialLists.resize(meshes.size());
     // vector<bool> is an exception to the std::vector conventions as it is a bit field
-    // So a bool reference to an element doesn't work
-    dracoErrorsPerMesh.resize(meshes.size());
-    materialLists.reserve(meshes.size());
-    for (size_t i = 0; i < meshes.size(); i++) {
-        const auto& mesh = meshes[i];
-        const auto& normals = baker::safeGet(normalsPerMesh, i);
-        const auto& tangents = baker::safeGet(tangentsPerMesh, i);
-        dracoBytesPerMesh.emplace_back();
-        auto& dracoBytes = dracoBytesPerMesh.back();
-        materialLists.push_back(createMaterialList(mesh));
-        const auto& materialList = materialLists.back();
-
-        bool dracoError;
-        std::unique_ptr<draco::Mesh> dracoMesh;
-        std::tie(dracoMesh, dracoError) = createDracoMesh(mesh, normals, tangents, materialList);
-        dracoErrorsPerMesh[i] = dracoError;
-
-        if (dracoMesh) {
-            draco::Encoder encoder;
-
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
-            encoder.SetSpeedOptions(_encodeSpeed, _decodeSpeed);
-
-            draco::EncoderBuffer buffer;
-            encoder.EncodeMeshToBuffer(*dracoMesh, &buffer);
-
-            dracoBytes = hifi::ByteArray(buffer.data(), (int)buffer.size());
+    // So its elements can't be written from different threads
+    std::vector<uint8_t> dracoErrors(meshes.size(), 0);
+
+    // meshes are independent, each one is encoded on its own thread
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, meshes.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            const auto& mesh = meshes[i];
+            const auto& normals = baker::safeGet(normalsPerMesh, i);
+            const auto& tangents = baker::safeGet(tangentsPerMesh, i);
+            auto& dracoBytes = dracoBytesPerMesh[i];
+            materialLists[i] = createMaterialList(mesh);
+            const auto& materialList = materialLists[i];
+
+            baker::MeshBakeCacheKey key("draco");
+            if (baker::MeshBakeCache::isEnabled()) {
+                key.add(_encodeSpeed).add(_decodeSpeed);
+                key.add(mesh.vertices).add(normals).add(mesh.colors).add(mesh.texCoords).add(mesh.texCoords1);
+                key.add(mesh.originalIndices).add((int)mesh.clusterIndices.empty()).add((int)mesh.blendshapes.empty());
+                for (const auto& part : mesh.parts) {
+                    key.add(part.quadTrianglesIndices).add(part.triangleIndices).add(part.materialID);
+                }
+                if (baker::MeshBakeCache::load(key, dracoBytes)) {
+                    continue;
+                }
+            }
+
+            bool dracoError;
+            std::unique_ptr<draco::Mesh> dracoMesh;
+            std::tie(dracoMesh, dracoError) = createDracoMesh(mesh, normals, tangents, materialList);
+            dracoErrors[i] = dracoError;
+
+            if (dracoMesh) {
+                draco::Encoder encoder;
+
+                encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+                encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+                encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+                encoder.SetSpeedOptions(_encodeSpeed, _decodeSpeed);
+
+                draco::EncoderBuffer buffer;
+                encoder.EncodeMeshToBuffer(*dracoMesh, &buffer);
+
+                dracoBytes = hifi::ByteArray(buffer.data(), (int)buffer.size());
+            }
+
+            // meshes without triangles legitimately encode to nothing, but failures are retried on the next bake
+            if (!dracoError && baker::MeshBakeCache::isEnabled()) {
+                baker::MeshBakeCache::store(key, dracoBytes);
+            }
         }
-    }
+    });
+
+    dracoErrorsPerMesh.assign(dracoErrors.begin(), dracoErrors.end());
 #endif // not Q_OS_ANDROID
 }
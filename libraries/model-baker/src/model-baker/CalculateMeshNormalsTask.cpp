@@ -11,30 +11,34 @@
 
 #include "CalculateMeshNormalsTask.h"
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateMeshNormalsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
     const auto& meshes = input;
     auto& normalsPerMeshOut = output;
 
-    normalsPerMeshOut.reserve(meshes.size());
-    for (int i = 0; i < (int)meshes.size(); i++) {
-        const auto& mesh = meshes[i];
-        normalsPerMeshOut.emplace_back();
-        auto& normalsOut = normalsPerMeshOut[normalsPerMeshOut.size()-1];
-        // Only calculate normals if this mesh doesn't already have them
-        if (!mesh.normals.empty()) {
-            normalsOut = std::vector<glm::vec3>(mesh.normals.begin(), mesh.normals.end());
-        } else {
-            normalsOut.resize(mesh.vertices.size());
-            baker::calculateNormals(mesh,
-                [&normalsOut](int normalIndex) /* NormalAccessor */ {
-                    return &normalsOut[normalIndex];
-                },
-                [&mesh](int vertexIndex, glm::vec3& outVertex) /* VertexSetter */ {
-                    outVertex = baker::safeGet(mesh.vertices, vertexIndex);
-                }
-            );
+    // meshes are independent, each one is calculated on its own thread
+    normalsPerMeshOut.resize(meshes.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, meshes.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            const auto& mesh = meshes[i];
+            auto& normalsOut = normalsPerMeshOut[i];
+            // Only calculate normals if this mesh doesn't already have them
+            if (!mesh.normals.empty()) {
+                normalsOut = std::vector<glm::vec3>(mesh.normals.begin(), mesh.normals.end());
+            } else {
+                normalsOut.resize(mesh.vertices.size());
+                baker::calculateNormals(mesh,
+                    [&normalsOut](int normalIndex) /* NormalAccessor */ {
+                        return &normalsOut[normalIndex];
+                    },
+                    [&mesh](int vertexIndex, glm::vec3& outVertex) /* VertexSetter */ {
+                        outVertex = baker::safeGet(mesh.vertices, vertexIndex);
+                    }
+                );
+            }
         }
-    }
+    });
 }
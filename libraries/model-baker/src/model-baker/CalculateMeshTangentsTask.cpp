@@ -11,6 +11,9 @@
 
 #include "CalculateMeshTangentsTask.h"
 
+#include <TBBHelpers.h>
+
+#include "MeshBakeCache.h"
 #include "ModelMath.h"
 
 void CalculateMeshTangentsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -18,29 +21,49 @@ void CalculateMeshTangentsTask::run(const baker::BakeContextPointer& context, co
     const std::vector<hfm::Mesh>& meshes = input.get1();
     auto& tangentsPerMeshOut = output;
 
-    tangentsPerMeshOut.reserve(meshes.size());
-    for (int i = 0; i < (int)meshes.size(); i++) {
-        const auto& mesh = meshes[i];
-        const auto& tangentsIn = mesh.tangents;
-        const auto& normals = baker::safeGet(normalsPerMesh, i);
-        tangentsPerMeshOut.emplace_back();
-        auto& tangentsOut = tangentsPerMeshOut[tangentsPerMeshOut.size()-1];
-
-        // Check if we already have tangents and therefore do not need to do any calculation
-        // Otherwise confirm if we have the normals and texcoords needed
-        if (!tangentsIn.empty()) {
-            tangentsOut = std::vector<glm::vec3>(tangentsIn.begin(), tangentsIn.end());
-        } else if (!normals.empty() && mesh.vertices.size() == mesh.texCoords.size()) {
-            tangentsOut.resize(normals.size());
-            baker::calculateTangents(mesh,
-            [&mesh, &normals, &tangentsOut](int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal) {
-                outVertices[0] = mesh.vertices[firstIndex];
-                outVertices[1] = mesh.vertices[secondIndex];
-                outNormal = normals[firstIndex];
-                outTexCoords[0] = mesh.texCoords[firstIndex];
-                outTexCoords[1] = mesh.texCoords[secondIndex];
-                return &(tangentsOut[firstIndex]);
-            });
+    // meshes are independent, each one is calculated on its own thread
+    tangentsPerMeshOut.resize(meshes.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, meshes.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            const auto& mesh = meshes[i];
+            const auto& tangentsIn = mesh.tangents;
+            const auto& normals = baker::safeGet(normalsPerMesh, i);
+            auto& tangentsOut = tangentsPerMeshOut[i];
+
+            // Check if we already have tangents and therefore do not need to do any calculation
+            // Otherwise confirm if we have the normals and texcoords needed
+            if (!tangentsIn.empty()) {
+                tangentsOut = std::vector<glm::vec3>(tangentsIn.begin(), tangentsIn.end());
+            } else if (!normals.empty() && mesh.vertices.size() == mesh.texCoords.size()) {
+                baker::MeshBakeCacheKey key("tangents");
+                if (baker::MeshBakeCache::isEnabled()) {
+                    key.add(mesh.vertices).add(mesh.texCoords).add(normals);
+                    for (const auto& part : mesh.parts) {
+                        key.add(part.quadIndices).add(part.quadTrianglesIndices).add(part.triangleIndices);
+                    }
+                    hifi::ByteArray cached;
+                    if (baker::MeshBakeCache::load(key, cached) && cached.size() == (int)(normals.size() * sizeof(glm::vec3))) {
+                        tangentsOut.resize(normals.size());
+                        memcpy(tangentsOut.data(), cached.constData(), cached.size());
+                        continue;
+                    }
+                }
+
+                tangentsOut.resize(normals.size());
+                baker::calculateTangents(mesh,
+                [&mesh, &normals, &tangentsOut](int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal) {
+                    outVertices[0] = mesh.vertices[firstIndex];
+                    outVertices[1] = mesh.vertices[secondIndex];
+                    outNormal = normals[firstIndex];
+                    outTexCoords[0] = mesh.texCoords[firstIndex];
+                    outTexCoords[1] = mesh.texCoords[secondIndex];
+                    return &(tangentsOut[firstIndex]);
+                });
+
+                if (baker::MeshBakeCache::isEnabled()) {
+                    baker::MeshBakeCache::store(key, hifi::ByteArray((const char*)tangentsOut.data(), (int)(tangentsOut.size() * sizeof(glm::vec3))));
+                }
+            }
         }
-    }
+    });
 }
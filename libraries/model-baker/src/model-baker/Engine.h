@@ -18,7 +18,8 @@ namespace baker {
 
     class BakeContext : public task::JobContext {
     public:
-        // No context settings yet for model prep
+        // No context settings yet for model prep, so the baker jobs can run concurrently on copies of it
+        std::shared_ptr<task::JobContext> fork() const override { return std::make_shared<BakeContext>(*this); }
     };
     using BakeContextPointer = std::shared_ptr<BakeContext>;
 
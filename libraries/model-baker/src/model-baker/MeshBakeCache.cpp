@@ -0,0 +1,90 @@
+//
+//  MeshBakeCache.cpp
+//  model-baker/src/model-baker
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshBakeCache.h"
+
+#include <mutex>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+#include "ModelBakerLogging.h"
+
+// bump whenever the output of a cached step changes for the same input
+static const int MESH_BAKE_CACHE_VERSION = 1;
+
+static std::mutex directoryMutex;
+static QString cacheDirectory;
+
+using namespace baker;
+
+MeshBakeCacheKey::MeshBakeCacheKey(const char* step) {
+    add(MESH_BAKE_CACHE_VERSION);
+    add(QString(step));
+}
+
+MeshBakeCacheKey& MeshBakeCacheKey::add(int value) {
+    addData(&value, sizeof(value));
+    return *this;
+}
+
+MeshBakeCacheKey& MeshBakeCacheKey::add(const QString& value) {
+    QByteArray utf8 = value.toUtf8();
+    addData(utf8.constData(), (size_t)utf8.size());
+    return *this;
+}
+
+void MeshBakeCacheKey::addData(const void* data, size_t size) {
+    quint64 size64 = size;
+    _hash.addData((const char*)&size64, sizeof(size64));
+    if (size > 0) {
+        _hash.addData((const char*)data, (int)size);
+    }
+}
+
+void MeshBakeCache::setDirectory(const QString& directory) {
+    if (!directory.isEmpty() && !QDir().mkpath(directory)) {
+        qCWarning(model_baker) << "Could not create the mesh bake cache directory" << directory;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(directoryMutex);
+    cacheDirectory = directory;
+}
+
+QString MeshBakeCache::getDirectory() {
+    std::lock_guard<std::mutex> lock(directoryMutex);
+    return cacheDirectory;
+}
+
+bool MeshBakeCache::load(const MeshBakeCacheKey& key, hifi::ByteArray& data) {
+    QString directory = getDirectory();
+    if (directory.isEmpty()) {
+        return false;
+    }
+    QFile file(QDir(directory).absoluteFilePath(key.toString()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    data = file.readAll();
+    // keeps the entry's modification time at its last use, which is what the asset server prunes the cache by
+    file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    return true;
+}
+
+void MeshBakeCache::store(const MeshBakeCacheKey& key, const hifi::ByteArray& data) {
+    QString directory = getDirectory();
+    if (directory.isEmpty()) {
+        return;
+    }
+    QSaveFile file(QDir(directory).absoluteFilePath(key.toString()));
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(model_baker) << "Could not write" << file.fileName() << "to the mesh bake cache";
+    }
+}
@@ -0,0 +1,63 @@
+//
+//  MeshBakeCache.h
+//  model-baker/src/model-baker
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshBakeCache_h
+#define hifi_MeshBakeCache_h
+
+#include <vector>
+
+#include <QCryptographicHash>
+#include <QString>
+#include <QVector>
+
+#include <shared/HifiTypes.h>
+
+namespace baker {
+    // Hashes everything a per-mesh bake step reads into the key of its result in the MeshBakeCache.
+    // Each value is prefixed with its size, so different splits of the same bytes never collide.
+    class MeshBakeCacheKey {
+    public:
+        explicit MeshBakeCacheKey(const char* step);
+
+        template <typename T>
+        MeshBakeCacheKey& add(const QVector<T>& values) {
+            addData(values.constData(), (size_t)values.size() * sizeof(T));
+            return *this;
+        }
+        template <typename T>
+        MeshBakeCacheKey& add(const std::vector<T>& values) {
+            addData(values.data(), values.size() * sizeof(T));
+            return *this;
+        }
+        MeshBakeCacheKey& add(int value);
+        MeshBakeCacheKey& add(const QString& value);
+
+        QString toString() const { return _hash.result().toHex(); }
+
+    private:
+        void addData(const void* data, size_t size);
+
+        QCryptographicHash _hash { QCryptographicHash::Sha256 };
+    };
+
+    // Content addressed on-disk cache of per-mesh bake results, so re-baking a model skips the meshes that did
+    // not change.  The cache is disabled until a directory is set.  Entries are written to a temporary file that
+    // is renamed into place, so ovens sharing a directory never read a partial entry.  Loading an entry touches it, so
+    // whoever owns the directory can prune it by modification time, least recently used first.
+    class MeshBakeCache {
+    public:
+        static void setDirectory(const QString& directory);
+        static QString getDirectory();
+        static bool isEnabled() { return !getDirectory().isEmpty(); }
+
+        static bool load(const MeshBakeCacheKey& key, hifi::ByteArray& data);
+        static void store(const MeshBakeCacheKey& key, const hifi::ByteArray& data);
+    };
+};
+
+#endif // hifi_MeshBakeCache_h
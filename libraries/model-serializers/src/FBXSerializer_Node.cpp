@@ -13,197 +13,160 @@
 
 #include <iostream>
 #include <QtCore/QBuffer>
-#include <QtCore/QDataStream>
 #include <QtCore/QIODevice>
 #include <QtCore/QStringList>
 #include <QtCore/QTextStream>
 #include <QtCore/QDebug>
 #include <QtCore/QtEndian>
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include <zlib.h>
+
 #include <shared/NsightHelpers.h>
 #include <hfm/ModelFormatLogging.h>
 
-template<class T>
-int streamSize() {
-    return sizeof(T);
-}
+// Reads binary FBX straight out of memory.  Every value is decoded in place, and arrays are copied or inflated
+// directly into the QVector that ends up in the node, without the intermediate buffers of a QDataStream.
+class FBXBinaryReader {
+public:
+    FBXBinaryReader(const char* data, qint64 size) : _data(data), _size(size) { }
 
-template<bool>
-int streamSize() {
-    return 1;
-}
+    qint64 getPosition() const { return _position; }
+    qint64 getRemaining() const { return _size - _position; }
 
-template<class T>
-QVariant readBinaryArray(QDataStream& in, int& position) {
-    quint32 arrayLength;
-    quint32 encoding;
-    quint32 compressedLength;
+    void skip(qint64 size) { require(size); }
 
-    in >> arrayLength;
+    template<class T>
+    T readValue() {
+        T value;
+        memcpy(&value, require(sizeof(T)), sizeof(T));
+        if (QSysInfo::ByteOrder == QSysInfo::BigEndian) {
+            std::reverse((char*)&value, (char*)&value + sizeof(T));
+        }
+        return value;
+    }
+
+    FBXNode readNode(bool has64BitPositions);
+
+private:
+    // answers the data at the current position and moves past it
+    const char* require(qint64 size) {
+        if (size < 0 || size > _size - _position) {
+            throw QString("FBX file most likely corrupt: unexpected end of data");
+        }
+        const char* result = _data + _position;
+        _position += size;
+        return result;
+    }
+
+    template<class T>
+    QVector<T> readArray();
+    QVariant readProperty();
+
+    const char* _data;
+    qint64 _size;
+    qint64 _position { 0 };
+};
+
+template<class T>
+QVector<T> FBXBinaryReader::readArray() {
+    quint32 arrayLength = readValue<quint32>();
     if (arrayLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: binary data exceeds data limits");
     }
-    in >> encoding;
-    in >> compressedLength;
+    quint32 encoding = readValue<quint32>();
+    quint32 compressedLength = readValue<quint32>();
     if (compressedLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: compressed binary data exceeds data limits");
     }
-    position += sizeof(quint32) * 3;
-
-    QVector<T> values;
-    if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
-        values.resize(arrayLength);
-        hifi::ByteArray arrayData;
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
+
+    QVector<T> values(arrayLength);
+    uLongf arraySize = (uLongf)(arrayLength * sizeof(T));
+    if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        const char* compressed = require(compressedLength);
+        if (arrayLength > 0) {
+            uLongf uncompressedSize = arraySize;
+            int result = uncompress((Bytef*)values.data(), &uncompressedSize, (const Bytef*)compressed, compressedLength);
+            if (result != Z_OK || uncompressedSize != arraySize) {
                 throw QString("corrupt fbx file");
             }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
         }
+    } else if (arrayLength > 0) {
+        memcpy(values.data(), require(arraySize), arraySize);
+    }
 
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
-        }
-    } else {
-        values.reserve(arrayLength);
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            hifi::ByteArray uncompressed = qUncompress(compressed);
-            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-            QDataStream uncompressedIn(uncompressed);
-            uncompressedIn.setByteOrder(QDataStream::LittleEndian);
-            uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                uncompressedIn >> value;
-                values.append(value);
-            }
-        } else {
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                in >> value;
-                position += streamSize<T>();
-                values.append(value);
-            }
+    if (QSysInfo::ByteOrder == QSysInfo::BigEndian && sizeof(T) > 1) {
+        for (T& value : values) {
+            std::reverse((char*)&value, (char*)&value + sizeof(T));
         }
     }
-    return QVariant::fromValue(values);
+    return values;
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
-    char ch;
-    in.device()->getChar(&ch);
-    position++;
+QVariant FBXBinaryReader::readProperty() {
+    char ch = readValue<char>();
     switch (ch) {
-        case 'Y': {
-            qint16 value;
-            in >> value;
-            position += sizeof(qint16);
-            return QVariant::fromValue(value);
-        }
-        case 'C': {
-            bool value;
-            in >> value;
-            position++;
-            return QVariant::fromValue(value);
-        }
-        case 'I': {
-            qint32 value;
-            in >> value;
-            position += sizeof(qint32);
-            return QVariant::fromValue(value);
-        }
-        case 'F': {
-            float value;
-            in >> value;
-            position += sizeof(float);
-            return QVariant::fromValue(value);
-        }
-        case 'D': {
-            double value;
-            in >> value;
-            position += sizeof(double);
-            return QVariant::fromValue(value);
-        }
-        case 'L': {
-            qint64 value;
-            in >> value;
-            position += sizeof(qint64);
-            return QVariant::fromValue(value);
-        }
-        case 'f': {
-            return readBinaryArray<float>(in, position);
-        }
-        case 'd': {
-            return readBinaryArray<double>(in, position);
-        }
-        case 'l': {
-            return readBinaryArray<qint64>(in, position);
-        }
-        case 'i': {
-            return readBinaryArray<qint32>(in, position);
-        }
+        case 'Y':
+            return QVariant::fromValue(readValue<qint16>());
+        case 'C':
+            return QVariant::fromValue(readValue<quint8>() != 0);
+        case 'I':
+            return QVariant::fromValue(readValue<qint32>());
+        case 'F':
+            return QVariant::fromValue(readValue<float>());
+        case 'D':
+            return QVariant::fromValue(readValue<double>());
+        case 'L':
+            return QVariant::fromValue(readValue<qint64>());
+        case 'f':
+            return QVariant::fromValue(readArray<float>());
+        case 'd':
+            return QVariant::fromValue(readArray<double>());
+        case 'l':
+            return QVariant::fromValue(readArray<qint64>());
+        case 'i':
+            return QVariant::fromValue(readArray<qint32>());
         case 'b': {
-            return readBinaryArray<bool>(in, position);
+            // booleans are stored as one byte each
+            QVector<quint8> bytes = readArray<quint8>();
+            QVector<bool> values(bytes.size());
+            for (int i = 0; i < bytes.size(); i++) {
+                values[i] = bytes[i] != 0;
+            }
+            return QVariant::fromValue(values);
         }
         case 'S':
         case 'R': {
-            quint32 length;
-            in >> length;
-            position += sizeof(quint32) + length;
-            return QVariant::fromValue(in.device()->read(length));
+            quint32 length = readValue<quint32>();
+            return QVariant::fromValue(hifi::ByteArray(require(length), length));
         }
         default:
             throw QString("Unknown property type: ") + ch;
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+FBXNode FBXBinaryReader::readNode(bool has64BitPositions) {
     qint64 endOffset;
     quint64 propertyCount;
-    quint64 propertyListLength;
-    quint8 nameLength;
 
     // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
     // our code generally doesn't care about the size that much, so we will use 64bit values
-    // from here on out, but if the file is an older format we read the stream into temp 32bit
-    // values and then assign to our actual 64bit values.
+    // from here on out, but if the file is an older format we read the 32bit values and widen them.
     if (has64BitPositions) {
-        in >> endOffset;
-        in >> propertyCount;
-        in >> propertyListLength;
-        position += sizeof(quint64) * 3;
+        endOffset = readValue<qint64>();
+        propertyCount = readValue<quint64>();
+        readValue<quint64>(); // property list length
     } else {
-        qint32 tempEndOffset;
-        quint32 tempPropertyCount;
-        quint32 tempPropertyListLength;
-        in >> tempEndOffset;
-        in >> tempPropertyCount;
-        in >> tempPropertyListLength;
-        position += sizeof(quint32) * 3;
-        endOffset = tempEndOffset;
-        propertyCount = tempPropertyCount;
-        propertyListLength = tempPropertyListLength;
-    }
-    in >> nameLength;
-    position += sizeof(quint8);
+        endOffset = readValue<qint32>();
+        propertyCount = readValue<quint32>();
+        readValue<quint32>(); // property list length
+    }
+    quint8 nameLength = readValue<quint8>();
 
     FBXNode node;
     const int MIN_VALID_OFFSET = 40;
@@ -211,15 +174,17 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
         // use a null name to indicate a null node
         return node;
     }
-    node.name = in.device()->read(nameLength);
-    position += nameLength;
+    if (endOffset > _size) {
+        throw QString("FBX file most likely corrupt: node extends past the end of the data");
+    }
+    node.name = hifi::ByteArray(require(nameLength), nameLength);
 
-    for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(readProperty());
     }
 
-    while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (endOffset > _position) {
+        FBXNode child = readNode(has64BitPositions);
         if (!child.name.isNull()) {
             node.children.append(child);
         }
@@ -369,9 +334,34 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
         }
         return top;
     }
-    QDataStream in(device);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
+    // Parse straight out of memory: in place for buffers, memory mapped for files, and only read into memory for
+    // other devices.
+    qint64 start = device->pos();
+    const char* data = nullptr;
+    qint64 size = 0;
+    hifi::ByteArray readData;
+    std::unique_ptr<uchar, std::function<void(uchar*)>> mappedData;
+    QBuffer* buffer = qobject_cast<QBuffer*>(device);
+    QFile* file = qobject_cast<QFile*>(device);
+    if (buffer) {
+        data = buffer->data().constData() + start;
+        size = buffer->data().size() - start;
+    } else if (file && file->size() > start) {
+        uchar* mapped = file->map(start, file->size() - start);
+        if (mapped) {
+            mappedData = std::unique_ptr<uchar, std::function<void(uchar*)>>(mapped, [file](uchar* address) {
+                file->unmap(address);
+            });
+            data = (const char*)mapped;
+            size = file->size() - start;
+        }
+    }
+    if (!data) {
+        readData = device->readAll();
+        data = readData.constData();
+        size = readData.size();
+    }
+    FBXBinaryReader in(data, size);
 
     // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
     // of the FBX binary format
@@ -380,24 +370,24 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
     //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
     //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
     //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
-    in.skipRawData(FBX_HEADER_BYTES_BEFORE_VERSION);
-    int position = FBX_HEADER_BYTES_BEFORE_VERSION;
-    quint32 fileVersion;
-    in >> fileVersion;
-    position += sizeof(fileVersion);
+    in.skip(FBX_HEADER_BYTES_BEFORE_VERSION);
+    quint32 fileVersion = in.readValue<quint32>();
     bool has64BitPositions = (fileVersion >= FBX_VERSION_2016);
 
-    // parse the top-level node
+    // parse the top-level node, the footer that may follow the null node that ends it is too short for a node header
+    const qint64 NODE_HEADER_SIZE = has64BitPositions ? 3 * sizeof(quint64) + 1 : 3 * sizeof(quint32) + 1;
     FBXNode top;
-    while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (in.getRemaining() >= NODE_HEADER_SIZE) {
+        FBXNode next = in.readNode(has64BitPositions);
         if (next.name.isNull()) {
-            return top;
-
+            break;
         } else {
             top.children.append(next);
         }
     }
+    if (!device->isSequential()) {
+        device->seek(start + in.getPosition());
+    }
 
     return top;
 }
@@ -408,29 +398,24 @@ glm::vec3 FBXSerializer::getVec3(const QVariantList& properties, int index) {
         properties.at(index + 2).value<double>());
 }
 
+// The arrays are decoded once, straight into the QVector<double> the node keeps; these convert them into the mesh
+// attributes in a single pass over that buffer, writing into a vector sized up front.
 QVector<glm::vec4> FBXSerializer::createVec4Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec4> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        float w = *it++;
-        values.append(glm::vec4(x, y, z, w));
+    QVector<glm::vec4> values(doubleVector.size() / 4);
+    const double* it = doubleVector.constData();
+    for (glm::vec4* value = values.data(), *end = value + values.size(); value != end; ++value, it += 4) {
+        *value = glm::vec4(it[0], it[1], it[2], it[3]);
     }
     return values;
 }
 
 
 QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& doubleVector, glm::vec4& average) {
-    QVector<glm::vec4> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        float w = *it++;
-        auto val = glm::vec4(x, y, z, w);
-        values.append(val);
-        average += val;
+    QVector<glm::vec4> values(doubleVector.size() / 4);
+    const double* it = doubleVector.constData();
+    for (glm::vec4* value = values.data(), *end = value + values.size(); value != end; ++value, it += 4) {
+        *value = glm::vec4(it[0], it[1], it[2], it[3]);
+        average += *value;
     }
     if (!values.isEmpty()) {
         average *= (1.0f / float(values.size()));
@@ -439,22 +424,19 @@ QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& do
 }
 
 QVector<glm::vec3> FBXSerializer::createVec3Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec3> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 3) * 3); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        values.append(glm::vec3(x, y, z));
+    QVector<glm::vec3> values(doubleVector.size() / 3);
+    const double* it = doubleVector.constData();
+    for (glm::vec3* value = values.data(), *end = value + values.size(); value != end; ++value, it += 3) {
+        *value = glm::vec3(it[0], it[1], it[2]);
     }
     return values;
 }
 
 QVector<glm::vec2> FBXSerializer::createVec2Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec2> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 2) * 2); it != end; ) {
-        float s = *it++;
-        float t = *it++;
-        values.append(glm::vec2(s, -t));
+    QVector<glm::vec2> values(doubleVector.size() / 2);
+    const double* it = doubleVector.constData();
+    for (glm::vec2* value = values.data(), *end = value + values.size(); value != end; ++value, it += 2) {
+        *value = glm::vec2(it[0], -it[1]);
     }
     return values;
 }
@@ -27,12 +27,15 @@
 #include <qfile.h>
 #include <qfileinfo.h>
 
+#include <type_traits>
+
 #include <shared/NsightHelpers.h>
 #include <NetworkAccessManager.h>
 #include <ResourceManager.h>
 #include <PathUtils.h>
 #include <image/ColorChannel.h>
 #include <BlendshapeConstants.h>
+#include <TBBHelpers.h>
 
 #include "FBXSerializer.h"
 
@@ -148,26 +151,33 @@ bool GLTFSerializer::getObjectArrayVal(const QJsonObject& object, const QString&
 }
 
 hifi::ByteArray GLTFSerializer::setGLBChunks(const hifi::ByteArray& data) {
-    int byte = 4;
-    int jsonStart = data.indexOf("JSON", Qt::CaseSensitive);
-    int binStart = data.indexOf("BIN", Qt::CaseSensitive);
-    int jsonLength, binLength;
-    hifi::ByteArray jsonLengthChunk, binLengthChunk;
-
-    jsonLengthChunk = data.mid(jsonStart - byte, byte);
-    QDataStream tempJsonLen(jsonLengthChunk);
-    tempJsonLen.setByteOrder(QDataStream::LittleEndian);
-    tempJsonLen >> jsonLength;
-    hifi::ByteArray jsonChunk = data.mid(jsonStart + byte, jsonLength);
-
-    if (binStart != -1) {
-        binLengthChunk = data.mid(binStart - byte, byte);
-
-        QDataStream tempBinLen(binLengthChunk);
-        tempBinLen.setByteOrder(QDataStream::LittleEndian);
-        tempBinLen >> binLength;
+    // a 12 byte header (magic, version, total length) followed by chunks, each one made of its length, its type and
+    // its data.  Walking the chunk headers finds the BIN chunk without scanning the JSON for a "BIN" string.
+    static const int GLB_HEADER_SIZE = 12;
+    static const int GLB_CHUNK_HEADER_SIZE = 8;
+    static const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;  // "JSON"
+    static const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;   // "BIN\0"
+
+    hifi::ByteArray jsonChunk;
+    int offset = GLB_HEADER_SIZE;
+    while (offset + GLB_CHUNK_HEADER_SIZE <= data.size()) {
+        quint32 chunkLength;
+        quint32 chunkType;
+        memcpy(&chunkLength, data.constData() + offset, sizeof(chunkLength));
+        memcpy(&chunkType, data.constData() + offset + sizeof(chunkLength), sizeof(chunkType));
+        offset += GLB_CHUNK_HEADER_SIZE;
+        if (chunkLength > (quint32)(data.size() - offset)) {
+            qWarning(modelformat) << "Truncated GLB chunk for model " << _url;
+            break;
+        }
 
-        _glbBinary = data.mid(binStart + byte, binLength);
+        if (chunkType == GLB_CHUNK_TYPE_JSON && jsonChunk.isEmpty()) {
+            // only parsed while data is alive, no need for a copy
+            jsonChunk = hifi::ByteArray::fromRawData(data.constData() + offset, (int)chunkLength);
+        } else if (chunkType == GLB_CHUNK_TYPE_BIN && _glbBinary.isEmpty()) {
+            _glbBinary = data.mid(offset, (int)chunkLength);
+        }
+        offset += (int)chunkLength;
     }
     return jsonChunk;
 }
@@ -405,11 +415,12 @@ bool GLTFSerializer::addBuffer(const QJsonObject& object) {
             return false;
         }
     }
-    if (getStringVal(object, "uri", buffer.uri, buffer.defined)) {
+    if (getStringVal(object, "uri", buffer.uri, buffer.defined) && isEmbeddedData(buffer.uri)) {
         if (!readBinary(buffer.uri, buffer.blob)) {
             return false;
         }
     }
+    // external buffers are all requested together by requestBuffers()
     _file.buffers.push_back(buffer);
 
     return true;
@@ -691,6 +702,7 @@ bool GLTFSerializer::parseGLTF(const hifi::ByteArray& data) {
                     success = success && addBuffer(bufVal.toObject());
                 }
             }
+            success = success && requestBuffers();
         }
 
         QJsonArray cameras;
@@ -820,9 +832,8 @@ void GLTFSerializer::getSkinInverseBindMatrices(std::vector<std::vector<float>>&
 }
 
 void GLTFSerializer::generateTargetData(int index, float weight, QVector<glm::vec3>& returnVector) {
-    GLTFAccessor& accessor = _file.accessors[index];
     QVector<float> storedValues;
-    addArrayFromAccessor(accessor, storedValues);
+    getDecodedAccessor(index, _decodedFloats, storedValues);
     for (int n = 0; n + 2 < storedValues.size(); n = n + 3) {
         returnVector.push_back(glm::vec3(weight * storedValues[n], weight * storedValues[n + 1], weight * storedValues[n + 2]));
     }
@@ -831,6 +842,8 @@ void GLTFSerializer::generateTargetData(int index, float weight, QVector<glm::ve
 bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& url) {
     hfmModel.originalURL = url.toString();
 
+    decodeMeshAccessors();
+
     int numNodes = _file.nodes.size();
 
     //Build dependencies
@@ -1066,8 +1079,6 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                     continue;
                 }
 
-                GLTFAccessor& indicesAccessor = _file.accessors[indicesAccessorIdx];
-
                 // Buffers
                 QVector<int> indices;
                 QVector<float> vertices;
@@ -1087,7 +1098,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                 QVector<float> weights;
                 int weightStride = 4;
 
-                bool success = addArrayFromAccessor(indicesAccessor, indices);
+                bool success = getDecodedAccessor(indicesAccessorIdx, _decodedIndices, indices);
 
                 if (!success) {
                     qWarning(modelformat) << "There was a problem reading glTF INDICES data for model " << _url;
@@ -1117,7 +1128,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                             continue;
                         }
 
-                        success = addArrayFromAccessor(accessor, vertices);
+                        success = getDecodedAccessor(accessorIdx, _decodedFloats, vertices);
                         if (!success) {
                             qWarning(modelformat) << "There was a problem reading glTF POSITION data for model " << _url;
                             continue;
@@ -1128,7 +1139,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                             continue;
                         }
 
-                        success = addArrayFromAccessor(accessor, normals);
+                        success = getDecodedAccessor(accessorIdx, _decodedFloats, normals);
                         if (!success) {
                             qWarning(modelformat) << "There was a problem reading glTF NORMAL data for model " << _url;
                             continue;
@@ -1143,14 +1154,14 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                             continue;
                         }
 
-                        success = addArrayFromAccessor(accessor, tangents);
+                        success = getDecodedAccessor(accessorIdx, _decodedFloats, tangents);
                         if (!success) {
                             qWarning(modelformat) << "There was a problem reading glTF TANGENT data for model " << _url;
                             tangentStride = 0;
                             continue;
                         }
                     } else if (key == "TEXCOORD_0") {
-                        success = addArrayFromAccessor(accessor, texcoords);
+                        success = getDecodedAccessor(accessorIdx, _decodedFloats, texcoords);
                         if (!success) {
                             qWarning(modelformat) << "There was a problem reading glTF TEXCOORD_0 data for model " << _url;
                             continue;
@@ -1161,7 +1172,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                             continue;
                         }
                     } else if (key == "TEXCOORD_1") {
-                        success = addArrayFromAccessor(accessor, texcoords2);
+                        success = getDecodedAccessor(accessorIdx, _decodedFloats, texcoords2);
                         if (!success) {
                             qWarning(modelformat) << "There was a problem reading glTF TEXCOORD_1 data for model " << _url;
                             continue;
@@ -1181,7 +1192,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                             continue;
                         }
 
-                        success = addArrayFromAccessor(accessor, colors);
+                        success = getDecodedAccessor(accessorIdx, _decodedFloats, colors);
                         if (!success) {
                             qWarning(modelformat) << "There was a problem reading glTF COLOR_0 data for model " << _url;
                             continue;
@@ -1200,7 +1211,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                             continue;
                         }
 
-                        success = addArrayFromAccessor(accessor, joints);
+                        success = getDecodedAccessor(accessorIdx, _decodedJoints, joints);
                         if (!success) {
                             qWarning(modelformat) << "There was a problem reading glTF JOINTS_0 data for model " << _url;
                             continue;
@@ -1219,7 +1230,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                             continue;
                         }
 
-                        success = addArrayFromAccessor(accessor, weights);
+                        success = getDecodedAccessor(accessorIdx, _decodedFloats, weights);
                         if (!success) {
                             qWarning(modelformat) << "There was a problem reading glTF WEIGHTS_0 data for model " << _url;
                             continue;
@@ -1718,10 +1729,14 @@ HFMModel::Pointer GLTFSerializer::read(const hifi::ByteArray& data, const hifi::
     return nullptr;
 }
 
+bool GLTFSerializer::isEmbeddedData(const QString& url) {
+    return url.contains("data:application/octet-stream;base64,");
+}
+
 bool GLTFSerializer::readBinary(const QString& url, hifi::ByteArray& outdata) {
     bool success;
 
-    if (url.contains("data:application/octet-stream;base64,")) {
+    if (isEmbeddedData(url)) {
         outdata = requestEmbeddedData(url);
         success = !outdata.isEmpty();
     } else {
@@ -1760,6 +1775,54 @@ std::tuple<bool, hifi::ByteArray> GLTFSerializer::requestData(hifi::URL& url) {
     }
 }
 
+bool GLTFSerializer::requestBuffers() {
+    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xffff0000, nullptr);
+
+    // Send the requests of all the external buffers before waiting for any of them, so a scene split over many .bin
+    // files waits for the slowest download rather than for the sum of them.
+    std::vector<std::pair<int, ResourceRequest*>> requests;
+    QEventLoop loop;
+    int pending = 0;
+    bool success = true;
+    for (int i = 0; i < _file.buffers.size(); ++i) {
+        const GLTFBuffer& buffer = _file.buffers[i];
+        if (!buffer.defined.value("uri") || isEmbeddedData(buffer.uri)) {
+            continue;
+        }
+        hifi::URL binaryUrl = _url.resolved(buffer.uri);
+        auto request = DependencyManager::get<ResourceManager>()->createResourceRequest(
+            nullptr, binaryUrl, true, -1, "GLTFSerializer::requestBuffers");
+        if (!request) {
+            success = false;
+            break;
+        }
+        QObject::connect(request, &ResourceRequest::finished, &loop, [&] {
+            if (--pending == 0) {
+                loop.quit();
+            }
+        });
+        requests.push_back({ i, request });
+        ++pending;
+    }
+
+    for (auto& request : requests) {
+        request.second->send();
+    }
+    if (pending > 0) {
+        loop.exec();
+    }
+
+    for (auto& request : requests) {
+        if (request.second->getResult() == ResourceRequest::Success) {
+            _file.buffers[request.first].blob = request.second->getData();
+        } else {
+            success = false;
+        }
+        request.second->deleteLater();
+    }
+    return success;
+}
+
 hifi::ByteArray GLTFSerializer::requestEmbeddedData(const QString& url) {
     QString binaryUrl = url.split(",")[1];
     return binaryUrl.isEmpty() ? hifi::ByteArray() : QByteArray::fromBase64(binaryUrl.toUtf8());
@@ -1895,12 +1958,6 @@ template<typename T, typename L>
 bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count,
                            QVector<L>& outarray, int accessorType, bool normalized) {
 
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
-
     int bufferCount = 0;
     switch (accessorType) {
     case GLTFAccessorType::SCALAR:
@@ -1926,33 +1983,39 @@ bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int c
         break;
     default:
         qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-        blobstream.setDevice(nullptr);
         return false;
     }
 
+    // glTF buffers are little endian and tightly packed, so the values are read in place rather than through a stream
+    qint64 valueCount = (qint64)count * bufferCount;
+    if (byteOffset < 0 || count < 0 || (qint64)byteOffset + valueCount * (qint64)sizeof(T) > (qint64)bin.size()) {
+        return false;
+    }
+
+    const char* source = bin.constData() + byteOffset;
+    int start = outarray.size();
+    outarray.resize(start + (int)valueCount);
+    L* destination = outarray.data() + start;
+
+    if (std::is_same<T, L>::value && !normalized) {
+        memcpy(destination, source, valueCount * sizeof(T));
+        return true;
+    }
+
     float scale = 1.0f;  // Normalized output values should always be floats.
     if (normalized) {
         scale = (float)(std::numeric_limits<T>::max)();
     }
 
-    for (int i = 0; i < count; ++i) {
-        for (int j = 0; j < bufferCount; ++j) {
-            if (!blobstream.atEnd()) {
-                T value;
-                blobstream >> value;
-                if (normalized) {
-                    outarray.push_back(std::max((float)value / scale, -1.0f));
-                } else {
-                    outarray.push_back(value);
-                }
-            } else {
-                blobstream.setDevice(nullptr);
-                return false;
-            }
+    for (qint64 i = 0; i < valueCount; ++i) {
+        T value;
+        memcpy(&value, source + i * sizeof(T), sizeof(T));
+        if (normalized) {
+            destination[i] = std::max((float)value / scale, -1.0f);
+        } else {
+            destination[i] = value;
         }
     }
-
-    blobstream.setDevice(nullptr);
     return true;
 }
 template<typename T>
@@ -1981,12 +2044,13 @@ bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset,
 }
 
 template <typename T>
-bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& outarray) {
+bool GLTFSerializer::addArrayFromAccessor(const GLTFAccessor& accessor, QVector<T>& outarray) {
+    // only reads the parsed file, so decodeMeshAccessors() can call it from several threads
     bool success = true;
 
     if (accessor.defined["bufferView"]) {
-        GLTFBufferView& bufferview = _file.bufferviews[accessor.bufferView];
-        GLTFBuffer& buffer = _file.buffers[bufferview.buffer];
+        const GLTFBufferView& bufferview = _file.bufferviews.at(accessor.bufferView);
+        const GLTFBuffer& buffer = _file.buffers.at(bufferview.buffer);
 
         int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
 
@@ -2004,8 +2068,8 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
         if (accessor.defined["sparse"]) {
             QVector<int> out_sparse_indices_array;
 
-            GLTFBufferView& sparseIndicesBufferview = _file.bufferviews[accessor.sparse.indices.bufferView];
-            GLTFBuffer& sparseIndicesBuffer = _file.buffers[sparseIndicesBufferview.buffer];
+            const GLTFBufferView& sparseIndicesBufferview = _file.bufferviews.at(accessor.sparse.indices.bufferView);
+            const GLTFBuffer& sparseIndicesBuffer = _file.buffers.at(sparseIndicesBufferview.buffer);
 
             int accSIBoffset = accessor.sparse.indices.defined["byteOffset"] ? accessor.sparse.indices.byteOffset : 0;
 
@@ -2015,8 +2079,8 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
             if (success) {
                 QVector<T> out_sparse_values_array;
 
-                GLTFBufferView& sparseValuesBufferview = _file.bufferviews[accessor.sparse.values.bufferView];
-                GLTFBuffer& sparseValuesBuffer = _file.buffers[sparseValuesBufferview.buffer];
+                const GLTFBufferView& sparseValuesBufferview = _file.bufferviews.at(accessor.sparse.values.bufferView);
+                const GLTFBuffer& sparseValuesBuffer = _file.buffers.at(sparseValuesBufferview.buffer);
 
                 int accSVBoffset = accessor.sparse.values.defined["byteOffset"] ? accessor.sparse.values.byteOffset : 0;
 
@@ -2048,6 +2112,91 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
     return success;
 }
 
+void GLTFSerializer::decodeMeshAccessors() {
+    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xffff0000, nullptr);
+
+    // Each accessor is decoded once, in parallel, into the type buildGeometry() reads it as: indices as ints,
+    // joints as uint16_t and every other attribute and morph target as floats.
+    enum AccessorKind : uint8_t { INDICES = 1, JOINTS = 2, FLOATS = 4 };
+    int numAccessors = _file.accessors.size();
+    std::vector<uint8_t> kinds(numAccessors, 0);
+    auto use = [&](int accessorIdx, AccessorKind kind) {
+        if (accessorIdx >= 0 && accessorIdx < numAccessors) {
+            kinds[accessorIdx] |= kind;
+        }
+    };
+    foreach(auto& mesh, _file.meshes) {
+        foreach(auto& primitive, mesh.primitives) {
+            use(primitive.indices, INDICES);
+            for (auto it = primitive.attributes.values.cbegin(); it != primitive.attributes.values.cend(); ++it) {
+                use(it.value(), it.key() == "JOINTS_0" ? JOINTS : FLOATS);
+            }
+            foreach(auto& target, primitive.targets) {
+                for (auto it = target.values.cbegin(); it != target.values.cend(); ++it) {
+                    use(it.value(), FLOATS);
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<int, AccessorKind>> jobs;
+    for (int i = 0; i < numAccessors; ++i) {
+        for (AccessorKind kind : { INDICES, JOINTS, FLOATS }) {
+            if (kinds[i] & kind) {
+                jobs.push_back({ i, kind });
+            }
+        }
+    }
+
+    auto prepare = [&](auto& decoded) {
+        decoded.arrays.clear();
+        decoded.arrays.resize(numAccessors);
+        decoded.states.assign(numAccessors, (uint8_t)decoded.NOT_DECODED);
+    };
+    prepare(_decodedIndices);
+    prepare(_decodedFloats);
+    prepare(_decodedJoints);
+
+    // addArrayFromAccessor() only reads _file, and every job writes its own slot
+    auto decode = [&](int accessorIdx, auto& decoded) {
+        bool success = addArrayFromAccessor(_file.accessors.at(accessorIdx), decoded.arrays[accessorIdx]);
+        decoded.states[accessorIdx] = success ? decoded.DECODED : decoded.FAILED;
+    };
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, jobs.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            int accessorIdx = jobs[i].first;
+            switch (jobs[i].second) {
+                case INDICES:
+                    decode(accessorIdx, _decodedIndices);
+                    break;
+                case JOINTS:
+                    decode(accessorIdx, _decodedJoints);
+                    break;
+                case FLOATS:
+                    decode(accessorIdx, _decodedFloats);
+                    break;
+            }
+        }
+    });
+}
+
+template <typename T>
+bool GLTFSerializer::getDecodedAccessor(int accessorIdx, const DecodedAccessors<T>& decoded, QVector<T>& outarray) {
+    if (accessorIdx < 0 || accessorIdx >= (int)decoded.states.size()) {
+        return false;
+    }
+    switch (decoded.states[accessorIdx]) {
+        case DecodedAccessors<T>::DECODED:
+            // implicitly shared, primitives referencing the same accessor don't copy it
+            outarray = decoded.arrays[accessorIdx];
+            return true;
+        case DecodedAccessors<T>::FAILED:
+            return false;
+        default:
+            return addArrayFromAccessor(_file.accessors.at(accessorIdx), outarray);
+    }
+}
+
 void GLTFSerializer::retriangulate(const QVector<int>& inIndices, const QVector<glm::vec3>& in_vertices,
                                const QVector<glm::vec3>& in_normals, QVector<int>& outIndices,
                                QVector<glm::vec3>& out_vertices, QVector<glm::vec3>& out_normals) {
@@ -13,6 +13,7 @@
 #define hifi_GLTFSerializer_h
 
 #include <memory.h>
+#include <vector>
 #include <QtNetwork/QNetworkReply>
 #include <hfm/ModelFormatLogging.h>
 #include <hfm/HFMSerializer.h>
@@ -772,6 +773,17 @@ private:
     hifi::URL _url;
     hifi::ByteArray _glbBinary;
 
+    // Arrays of the accessors used by mesh primitives, decoded up front by decodeMeshAccessors().  Indexed by accessor.
+    template <typename T>
+    struct DecodedAccessors {
+        enum State : uint8_t { NOT_DECODED = 0, DECODED, FAILED };
+        std::vector<QVector<T>> arrays;
+        std::vector<uint8_t> states;
+    };
+    DecodedAccessors<int> _decodedIndices;
+    DecodedAccessors<float> _decodedFloats;
+    DecodedAccessors<uint16_t> _decodedJoints;
+
     glm::mat4 getModelTransform(const GLTFNode& node);
     void getSkinInverseBindMatrices(std::vector<std::vector<float>>& inverseBindMatrixValues);
     void generateTargetData(int index, float weight, QVector<glm::vec3>& returnVector);
@@ -828,7 +840,9 @@ private:
     bool addSkin(const QJsonObject& object);
     bool addTexture(const QJsonObject& object);
 
+    bool isEmbeddedData(const QString& url);
     bool readBinary(const QString& url, hifi::ByteArray& outdata);
+    bool requestBuffers();
 
     template<typename T, typename L>
     bool readArray(const hifi::ByteArray& bin, int byteOffset, int count,
@@ -839,7 +853,11 @@ private:
                         QVector<T>& outarray, int accessorType, int componentType, bool normalized);
 
     template <typename T>
-    bool addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& outarray);
+    bool addArrayFromAccessor(const GLTFAccessor& accessor, QVector<T>& outarray);
+
+    void decodeMeshAccessors();
+    template <typename T>
+    bool getDecodedAccessor(int accessorIdx, const DecodedAccessors<T>& decoded, QVector<T>& outarray);
 
     void retriangulate(const QVector<int>& in_indices, const QVector<glm::vec3>& in_vertices,
                        const QVector<glm::vec3>& in_normals, QVector<int>& out_indices,
@@ -0,0 +1,465 @@
+//
+//  BinaryStats.cpp
+//  libraries/networking/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BinaryStats.h"
+
+#include <cstring>
+
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonArray>
+
+#include <SharedUtil.h>
+
+static const size_t INITIAL_STRING_TABLE_SIZE = 256;
+static const size_t MAX_STRING_LENGTH = 0xFFFF;
+static const size_t MAX_STRINGS = 0xFFFF;
+static const size_t MAX_ENTRIES = 0xFFFF;
+
+static uint32_t hashBytes(const char* data, size_t length) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ (uint8_t)data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+BinaryStatsWriter::BinaryStatsWriter() {
+    _stringTable.resize(INITIAL_STRING_TABLE_SIZE, -1);
+}
+
+void BinaryStatsWriter::reset() {
+    // clear() keeps the capacity of the vectors
+    _strings.clear();
+    _stringOffsets.clear();
+    std::fill(_stringTable.begin(), _stringTable.end(), -1);
+    _entries.clear();
+    _parents.clear();
+    _overflowed = false;
+}
+
+void BinaryStatsWriter::growStringTable() {
+    _stringTable.assign(_stringTable.size() * 2, -1);
+    size_t mask = _stringTable.size() - 1;
+    for (size_t index = 0; index < _stringOffsets.size(); ++index) {
+        uint32_t offset = _stringOffsets[index];
+        uint16_t length;
+        memcpy(&length, &_strings[offset], sizeof(length));
+        size_t slot = hashBytes(&_strings[offset + sizeof(length)], length) & mask;
+        while (_stringTable[slot] != -1) {
+            slot = (slot + 1) & mask;
+        }
+        _stringTable[slot] = (int32_t)index;
+    }
+}
+
+// The string was just appended at begin, as its length followed by its bytes.  Drop it again if it is already in the
+// table, otherwise add it.
+uint16_t BinaryStatsWriter::internAppended(size_t begin) {
+    size_t length = _strings.size() - begin - sizeof(uint16_t);
+    if (length > MAX_STRING_LENGTH) {
+        length = MAX_STRING_LENGTH;
+        _strings.resize(begin + sizeof(uint16_t) + length);
+    }
+    uint16_t storedLength = (uint16_t)length;
+    memcpy(&_strings[begin], &storedLength, sizeof(storedLength));
+    const char* bytes = &_strings[begin + sizeof(uint16_t)];
+
+    size_t mask = _stringTable.size() - 1;
+    size_t slot = hashBytes(bytes, length) & mask;
+    while (_stringTable[slot] != -1) {
+        uint32_t offset = _stringOffsets[_stringTable[slot]];
+        uint16_t otherLength;
+        memcpy(&otherLength, &_strings[offset], sizeof(otherLength));
+        if (otherLength == length && memcmp(&_strings[offset + sizeof(otherLength)], bytes, length) == 0) {
+            _strings.resize(begin);
+            return (uint16_t)_stringTable[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if (_stringOffsets.size() >= MAX_STRINGS) {
+        _strings.resize(begin);
+        _overflowed = true;
+        return NO_KEY;
+    }
+
+    uint16_t index = (uint16_t)_stringOffsets.size();
+    _stringOffsets.push_back((uint32_t)begin);
+    _stringTable[slot] = index;
+    if (_stringOffsets.size() * 2 > _stringTable.size()) {
+        growStringTable();
+    }
+    return index;
+}
+
+uint16_t BinaryStatsWriter::internLatin1(const char* string, int length) {
+    size_t begin = _strings.size();
+    _strings.resize(begin + sizeof(uint16_t));
+    for (int i = 0; i < length; ++i) {
+        uint8_t c = (uint8_t)string[i];
+        if (c < 0x80) {
+            _strings.push_back((char)c);
+        } else {
+            _strings.push_back((char)(0xC0 | (c >> 6)));
+            _strings.push_back((char)(0x80 | (c & 0x3F)));
+        }
+    }
+    return internAppended(begin);
+}
+
+uint16_t BinaryStatsWriter::internUtf16(const QChar* string, int length) {
+    size_t begin = _strings.size();
+    _strings.resize(begin + sizeof(uint16_t));
+    for (int i = 0; i < length; ++i) {
+        uint32_t c = string[i].unicode();
+        if (QChar::isHighSurrogate(c) && i + 1 < length && string[i + 1].isLowSurrogate()) {
+            c = QChar::surrogateToUcs4((ushort)c, string[++i].unicode());
+        }
+        if (c < 0x80) {
+            _strings.push_back((char)c);
+        } else if (c < 0x800) {
+            _strings.push_back((char)(0xC0 | (c >> 6)));
+            _strings.push_back((char)(0x80 | (c & 0x3F)));
+        } else if (c < 0x10000) {
+            _strings.push_back((char)(0xE0 | (c >> 12)));
+            _strings.push_back((char)(0x80 | ((c >> 6) & 0x3F)));
+            _strings.push_back((char)(0x80 | (c & 0x3F)));
+        } else {
+            _strings.push_back((char)(0xF0 | (c >> 18)));
+            _strings.push_back((char)(0x80 | ((c >> 12) & 0x3F)));
+            _strings.push_back((char)(0x80 | ((c >> 6) & 0x3F)));
+            _strings.push_back((char)(0x80 | (c & 0x3F)));
+        }
+    }
+    return internAppended(begin);
+}
+
+uint16_t BinaryStatsWriter::intern(const BinaryStatsKey& key) {
+    if (key._latin1) {
+        return internLatin1(key._latin1, (int)strlen(key._latin1));
+    } else if (key._string) {
+        return internUtf16(key._string->constData(), key._string->size());
+    } else if (key._uuid) {
+        // same as uuidStringWithoutCurlyBraces, without going through a QString
+        static const char HEX_DIGITS[] = "0123456789abcdef";
+        char buffer[36];
+        const QUuid& uuid = *key._uuid;
+        uint8_t raw[16] = {
+            (uint8_t)(uuid.data1 >> 24), (uint8_t)(uuid.data1 >> 16), (uint8_t)(uuid.data1 >> 8), (uint8_t)uuid.data1,
+            (uint8_t)(uuid.data2 >> 8), (uint8_t)uuid.data2, (uint8_t)(uuid.data3 >> 8), (uint8_t)uuid.data3,
+            uuid.data4[0], uuid.data4[1], uuid.data4[2], uuid.data4[3],
+            uuid.data4[4], uuid.data4[5], uuid.data4[6], uuid.data4[7]
+        };
+        int position = 0;
+        for (int i = 0; i < 16; ++i) {
+            if (i == 4 || i == 6 || i == 8 || i == 10) {
+                buffer[position++] = '-';
+            }
+            buffer[position++] = HEX_DIGITS[raw[i] >> 4];
+            buffer[position++] = HEX_DIGITS[raw[i] & 0xF];
+        }
+        return internLatin1(buffer, position);
+    }
+    return NO_KEY;
+}
+
+BinaryStatsEntry* BinaryStatsWriter::addEntry(const BinaryStatsKey& key, Type type) {
+    if (_entries.size() >= MAX_ENTRIES) {
+        _overflowed = true;
+        return nullptr;
+    }
+    uint16_t parent = _parents.empty() ? NO_PARENT : _parents.back();
+    bool inArray = parent != NO_PARENT && _entries[parent].type == Array;
+
+    BinaryStatsEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.key = inArray ? NO_KEY : intern(key);
+    entry.parent = parent;
+    entry.type = type;
+    if (!inArray && entry.key == NO_KEY) {
+        return nullptr;
+    }
+    _entries.push_back(entry);
+    return &_entries.back();
+}
+
+void BinaryStatsWriter::beginObject(const BinaryStatsKey& key) {
+    auto entry = addEntry(key, Object);
+    // members of a container that couldn't be added end up in its parent, which is still better than losing them
+    _parents.push_back(entry ? (uint16_t)(entry - _entries.data()) : (_parents.empty() ? NO_PARENT : _parents.back()));
+}
+
+void BinaryStatsWriter::beginArray(const BinaryStatsKey& key) {
+    auto entry = addEntry(key, Array);
+    _parents.push_back(entry ? (uint16_t)(entry - _entries.data()) : (_parents.empty() ? NO_PARENT : _parents.back()));
+}
+
+void BinaryStatsWriter::end() {
+    Q_ASSERT(!_parents.empty());
+    if (!_parents.empty()) {
+        _parents.pop_back();
+    }
+}
+
+void BinaryStatsWriter::addInt(const BinaryStatsKey& key, int64_t value) {
+    if (auto entry = addEntry(key, Int)) {
+        memcpy(&entry->value, &value, sizeof(value));
+    }
+}
+
+void BinaryStatsWriter::add(const BinaryStatsKey& key, bool value) {
+    if (auto entry = addEntry(key, Bool)) {
+        entry->value = value ? 1 : 0;
+    }
+}
+
+void BinaryStatsWriter::add(const BinaryStatsKey& key, double value) {
+    if (auto entry = addEntry(key, Double)) {
+        memcpy(&entry->value, &value, sizeof(value));
+    }
+}
+
+void BinaryStatsWriter::addString(const BinaryStatsKey& key, const BinaryStatsKey& value) {
+    // the key goes into the string table before the value, whose index is only known afterwards
+    if (auto entry = addEntry(key, String)) {
+        uint16_t string = intern(value);
+        if (string == NO_KEY) {
+            _entries.pop_back();
+        } else {
+            entry->value = string;
+        }
+    }
+}
+
+void BinaryStatsWriter::add(const BinaryStatsKey& key, const char* value) {
+    addString(key, BinaryStatsKey(value));
+}
+
+void BinaryStatsWriter::add(const BinaryStatsKey& key, const QString& value) {
+    addString(key, BinaryStatsKey(value));
+}
+
+void BinaryStatsWriter::add(const BinaryStatsKey& key, const QUuid& value) {
+    addString(key, BinaryStatsKey(value));
+}
+
+void BinaryStatsWriter::addUsecTime(const BinaryStatsKey& key, quint64 usecs) {
+    if (auto entry = addEntry(key, UsecTime)) {
+        entry->value = usecs;
+    }
+}
+
+void BinaryStatsWriter::addUsecTime(const BinaryStatsKey& key, float usecs) {
+    if (auto entry = addEntry(key, UsecTimeFloat)) {
+        double value = usecs;
+        memcpy(&entry->value, &value, sizeof(value));
+    }
+}
+
+void BinaryStatsWriter::addJSON(const BinaryStatsKey& key, const QJsonValue& value) {
+    switch (value.type()) {
+        case QJsonValue::Object:
+            beginObject(key);
+            addJSON(value.toObject());
+            end();
+            break;
+        case QJsonValue::Array:
+            beginArray(key);
+            for (const auto& element : value.toArray()) {
+                addJSON(key, element);
+            }
+            end();
+            break;
+        case QJsonValue::Bool:
+            add(key, value.toBool());
+            break;
+        case QJsonValue::Double:
+            add(key, value.toDouble());
+            break;
+        case QJsonValue::String:
+            add(key, value.toString());
+            break;
+        case QJsonValue::Null:
+            addEntry(key, Null);
+            break;
+        default:
+            break;
+    }
+}
+
+void BinaryStatsWriter::addJSON(const QJsonObject& members) {
+    for (auto it = members.constBegin(); it != members.constEnd(); ++it) {
+        addJSON(it.key(), it.value());
+    }
+}
+
+int BinaryStatsWriter::getSize() const {
+    return (int)(sizeof(BinaryStatsHeader) + _strings.size() + _entries.size() * sizeof(BinaryStatsEntry));
+}
+
+void BinaryStatsWriter::write(QIODevice& device) const {
+    BinaryStatsHeader header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.numStrings = (uint16_t)_stringOffsets.size();
+    header.numEntries = (uint32_t)_entries.size();
+    header.stringBytes = (uint32_t)_strings.size();
+
+    device.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!_strings.empty()) {
+        device.write(_strings.data(), _strings.size());
+    }
+    if (!_entries.empty()) {
+        device.write(reinterpret_cast<const char*>(_entries.data()), _entries.size() * sizeof(BinaryStatsEntry));
+    }
+}
+
+QByteArray BinaryStatsWriter::toByteArray() const {
+    BinaryStatsHeader header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.numStrings = (uint16_t)_stringOffsets.size();
+    header.numEntries = (uint32_t)_entries.size();
+    header.stringBytes = (uint32_t)_strings.size();
+
+    QByteArray result;
+    result.reserve(getSize());
+    result.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    result.append(_strings.data(), (int)_strings.size());
+    result.append(reinterpret_cast<const char*>(_entries.data()), (int)(_entries.size() * sizeof(BinaryStatsEntry)));
+    return result;
+}
+
+namespace {
+
+struct BinaryStatsReader {
+    std::vector<QString> strings;
+    const BinaryStatsEntry* entries { nullptr };
+    uint32_t numEntries { 0 };
+    std::vector<int32_t> firstChild;
+    std::vector<int32_t> nextSibling;
+
+    QJsonValue valueAt(uint32_t index) const {
+        const BinaryStatsEntry& entry = entries[index];
+        int64_t intValue;
+        double doubleValue;
+        memcpy(&intValue, &entry.value, sizeof(intValue));
+        memcpy(&doubleValue, &entry.value, sizeof(doubleValue));
+
+        switch (entry.type) {
+            case BinaryStatsWriter::Object:
+                return membersOf(index);
+            case BinaryStatsWriter::Array: {
+                QJsonArray array;
+                for (int32_t child = firstChild[index]; child != -1; child = nextSibling[child]) {
+                    array.push_back(valueAt(child));
+                }
+                return array;
+            }
+            case BinaryStatsWriter::Int:
+                return QJsonValue((qint64)intValue);
+            case BinaryStatsWriter::Double:
+                return QJsonValue(doubleValue);
+            case BinaryStatsWriter::Bool:
+                return QJsonValue(entry.value != 0);
+            case BinaryStatsWriter::String:
+                return entry.value < strings.size() ? QJsonValue(strings[entry.value]) : QJsonValue();
+            case BinaryStatsWriter::UsecTime:
+                return QJsonValue(formatUsecTime((quint64)entry.value));
+            case BinaryStatsWriter::UsecTimeFloat:
+                return QJsonValue(formatUsecTime((float)doubleValue));
+            default:
+                return QJsonValue();
+        }
+    }
+
+    // members of the root object for NO_PARENT
+    QJsonObject membersOf(uint32_t index) const {
+        QJsonObject object;
+        int32_t child = index == BinaryStatsWriter::NO_PARENT ? rootFirstChild : firstChild[index];
+        for (; child != -1; child = nextSibling[child]) {
+            uint16_t key = entries[child].key;
+            if (key < strings.size()) {
+                object[strings[key]] = valueAt(child);
+            }
+        }
+        return object;
+    }
+
+    int32_t rootFirstChild { -1 };
+};
+
+}
+
+QJsonObject binaryStatsToJSON(const QByteArray& data) {
+    BinaryStatsHeader header;
+    if (data.size() < (int)sizeof(header)) {
+        return QJsonObject();
+    }
+    memcpy(&header, data.constData(), sizeof(header));
+    if (header.magic != BinaryStatsWriter::MAGIC || header.version != BinaryStatsWriter::VERSION ||
+        (size_t)data.size() != sizeof(header) + header.stringBytes + (size_t)header.numEntries * sizeof(BinaryStatsEntry)) {
+        return QJsonObject();
+    }
+
+    BinaryStatsReader reader;
+    const char* strings = data.constData() + sizeof(header);
+    const char* stringsEnd = strings + header.stringBytes;
+    reader.strings.reserve(header.numStrings);
+    for (uint16_t i = 0; i < header.numStrings; ++i) {
+        uint16_t length;
+        if (strings + sizeof(length) > stringsEnd) {
+            return QJsonObject();
+        }
+        memcpy(&length, strings, sizeof(length));
+        strings += sizeof(length);
+        if (strings + length > stringsEnd) {
+            return QJsonObject();
+        }
+        reader.strings.push_back(QString::fromUtf8(strings, length));
+        strings += length;
+    }
+
+    // entries aren't necessarily aligned in the packet
+    std::vector<BinaryStatsEntry> entries(header.numEntries);
+    if (header.numEntries > 0) {
+        memcpy(entries.data(), stringsEnd, header.numEntries * sizeof(BinaryStatsEntry));
+    }
+    reader.entries = entries.data();
+    reader.numEntries = header.numEntries;
+
+    // link the members of each container in order, parents always come before their members
+    reader.firstChild.assign(header.numEntries, -1);
+    reader.nextSibling.assign(header.numEntries, -1);
+    std::vector<int32_t> lastChild(header.numEntries, -1);
+    int32_t rootLastChild = -1;
+    for (uint32_t i = 0; i < header.numEntries; ++i) {
+        uint16_t parent = entries[i].parent;
+        if (parent == BinaryStatsWriter::NO_PARENT) {
+            if (rootLastChild == -1) {
+                reader.rootFirstChild = i;
+            } else {
+                reader.nextSibling[rootLastChild] = i;
+            }
+            rootLastChild = i;
+        } else if (parent < i && (entries[parent].type == BinaryStatsWriter::Object ||
+                                  entries[parent].type == BinaryStatsWriter::Array)) {
+            if (lastChild[parent] == -1) {
+                reader.firstChild[parent] = i;
+            } else {
+                reader.nextSibling[lastChild[parent]] = i;
+            }
+            lastChild[parent] = i;
+        } else {
+            return QJsonObject();
+        }
+    }
+
+    return reader.membersOf(BinaryStatsWriter::NO_PARENT);
+}
@@ -0,0 +1,140 @@
+//
+//  BinaryStats.h
+//  libraries/networking/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BinaryStats_h
+#define hifi_BinaryStats_h
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+class QIODevice;
+
+// Assignment clients report their stats to the domain-server once per second.  Rather than building a tree of
+// QJsonObjects, they write them as fixed size entries plus a table of the strings used as keys and values:
+//   header     BinaryStatsHeader
+//   strings    numStrings times a uint16 byte length followed by that many UTF-8 bytes, each string appears once
+//   entries    numEntries BinaryStatsEntry, every object or array coming before its members
+// The domain-server keeps the bytes as they are and only renders them as JSON when asked for them over HTTP.
+
+struct BinaryStatsHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t numStrings;
+    uint32_t numEntries;
+    uint32_t stringBytes;
+};
+
+struct BinaryStatsEntry {
+    uint16_t key;      // index in the string table, NO_KEY for the members of arrays
+    uint16_t parent;   // index of the enclosing object or array entry, NO_PARENT at the root
+    uint8_t type;      // BinaryStatsWriter::Type
+    uint8_t padding[3];
+    uint64_t value;    // int64, double, bool or string index, depending on the type
+};
+
+static_assert(sizeof(BinaryStatsHeader) == 16, "BinaryStatsHeader is sent as is");
+static_assert(sizeof(BinaryStatsEntry) == 16, "BinaryStatsEntry is sent as is");
+
+// The key of a stat, which can be a literal, a QString or a node UUID without having to build a QString first.
+class BinaryStatsKey {
+public:
+    BinaryStatsKey(const char* latin1) : _latin1(latin1) {}
+    BinaryStatsKey(const QString& string) : _string(&string) {}
+    BinaryStatsKey(const QUuid& uuid) : _uuid(&uuid) {}
+
+private:
+    friend class BinaryStatsWriter;
+
+    const char* _latin1 { nullptr };
+    const QString* _string { nullptr };
+    const QUuid* _uuid { nullptr };
+};
+
+// Writes one stats packet.  Keep one around and reset() it for each packet: once its buffers have grown to the size
+// of the stats, writing them doesn't allocate anymore.
+// A key added twice to the same object ends up with the last value, the same as assigning it twice in a QJsonObject.
+class BinaryStatsWriter {
+public:
+    static const uint32_t MAGIC = 0x54534648; // "HFST"
+    static const uint16_t VERSION = 1;
+    static const uint16_t NO_KEY = 0xFFFF;
+    static const uint16_t NO_PARENT = 0xFFFF;
+
+    enum Type : uint8_t {
+        Object = 0,
+        Array,
+        Null,
+        Int,
+        Double,
+        Bool,
+        String,
+        UsecTime,       // int64 microseconds, rendered with formatUsecTime
+        UsecTimeFloat   // float microseconds, rendered with formatUsecTime
+    };
+
+    BinaryStatsWriter();
+
+    void reset();
+    bool isEmpty() const { return _entries.empty(); }
+    // true when the stats didn't fit the 16 bit indices and were truncated
+    bool hasOverflowed() const { return _overflowed; }
+
+    // Objects and arrays contain everything added until the matching end().  The keys of array members are ignored.
+    void beginObject(const BinaryStatsKey& key);
+    void beginArray(const BinaryStatsKey& key);
+    void end();
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+    void add(const BinaryStatsKey& key, T value) { addInt(key, (int64_t)value); }
+    void add(const BinaryStatsKey& key, bool value);
+    void add(const BinaryStatsKey& key, float value) { add(key, (double)value); }
+    void add(const BinaryStatsKey& key, double value);
+    void add(const BinaryStatsKey& key, const char* value);
+    void add(const BinaryStatsKey& key, const QString& value);
+    void add(const BinaryStatsKey& key, const QUuid& value);
+
+    // formatted on the domain-server, the way formatUsecTime did on the assignment client
+    void addUsecTime(const BinaryStatsKey& key, quint64 usecs);
+    void addUsecTime(const BinaryStatsKey& key, float usecs);
+
+    // For the stats still gathered as JSON
+    void addJSON(const BinaryStatsKey& key, const QJsonValue& value);
+    void addJSON(const QJsonObject& members);
+
+    int getSize() const;
+    void write(QIODevice& device) const;
+    QByteArray toByteArray() const;
+
+private:
+    void addInt(const BinaryStatsKey& key, int64_t value);
+    void addString(const BinaryStatsKey& key, const BinaryStatsKey& value);
+    BinaryStatsEntry* addEntry(const BinaryStatsKey& key, Type type);
+    uint16_t intern(const BinaryStatsKey& key);
+    uint16_t internLatin1(const char* string, int length);
+    uint16_t internUtf16(const QChar* string, int length);
+    uint16_t internAppended(size_t begin);
+    void growStringTable();
+
+    std::vector<char> _strings;
+    std::vector<uint32_t> _stringOffsets;
+    std::vector<int32_t> _stringTable;    // open addressing, indices in _stringOffsets or -1
+    std::vector<BinaryStatsEntry> _entries;
+    std::vector<uint16_t> _parents;
+    bool _overflowed { false };
+};
+
+// Renders stats written by BinaryStatsWriter.  Returns an empty object if the data isn't valid.
+QJsonObject binaryStatsToJSON(const QByteArray& data);
+
+#endif // hifi_BinaryStats_h
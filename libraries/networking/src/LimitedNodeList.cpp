@@ -409,11 +409,15 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
 }
 
 void LimitedNodeList::fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth) {
+    fillPacketHeader(packet, getSessionLocalID(), _useAuthentication ? hmacAuth : nullptr);
+}
+
+void LimitedNodeList::fillPacketHeader(const NLPacket& packet, Node::LocalID sourceID, HMACAuth* hmacAuth) {
     if (!PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())) {
-        packet.writeSourceID(getSessionLocalID());
+        packet.writeSourceID(sourceID);
     }
 
-    if (_useAuthentication && hmacAuth
+    if (hmacAuth
         && !PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())
         && !PacketTypeEnum::getNonVerifiedPackets().contains(packet.getType())) {
         packet.writeVerificationHash(*hmacAuth);
@@ -836,12 +840,16 @@ void LimitedNodeList::processDelayedAdds() {
 }
 
 std::unique_ptr<NLPacket> LimitedNodeList::constructPingPacket(const QUuid& nodeId, PingType_t pingType) {
+    return constructPingPacket(pingType, _connectionIDs[nodeId]);
+}
+
+std::unique_ptr<NLPacket> LimitedNodeList::constructPingPacket(PingType_t pingType, ConnectionID connectionID) {
     int packetSize = sizeof(PingType_t) + sizeof(quint64) + sizeof(int64_t);
 
     auto pingPacket = NLPacket::create(PacketType::Ping, packetSize);
     pingPacket->writePrimitive(pingType);
     pingPacket->writePrimitive(usecTimestampNow());
-    pingPacket->writePrimitive(_connectionIDs[nodeId]);
+    pingPacket->writePrimitive(connectionID);
 
     return pingPacket;
 }
@@ -186,6 +186,21 @@ public:
                                       bool isUpstream = false, const QUuid& connectionSecret = QUuid(),
                                       const NodePermissions& permissions = DEFAULT_AGENT_PERMISSIONS);
 
+    // a node as the domain-server describes it in DomainList and DomainServerAddedNode packets
+    struct NewNodeInfo {
+        qint8 type;
+        QUuid uuid;
+        SockAddr publicSocket;
+        SockAddr localSocket;
+        NodePermissions permissions;
+        bool isReplicated;
+        Node::LocalID sessionLocalID;
+        QUuid connectionSecretUUID;
+    };
+
+    // writes the source ID of a packet sent by sourceID and, if hmacAuth is given, its verification hash
+    static void fillPacketHeader(const NLPacket& packet, Node::LocalID sourceID, HMACAuth* hmacAuth);
+
     static bool parseSTUNResponse(udt::BasePacket* packet, QHostAddress& newPublicAddress, uint16_t& newPublicPort);
     bool hasCompletedInitialSTUN() const { return _hasCompletedInitialSTUN; }
 
@@ -202,7 +217,8 @@ public:
     SharedNodePointer soloNodeOfType(NodeType_t nodeType);
 
     std::unique_ptr<NLPacket> constructPingPacket(const QUuid& nodeId, PingType_t pingType = PingType::Agnostic);
-    std::unique_ptr<NLPacket> constructPingReplyPacket(ReceivedMessage& message);
+    static std::unique_ptr<NLPacket> constructPingPacket(PingType_t pingType, ConnectionID connectionID);
+    static std::unique_ptr<NLPacket> constructPingReplyPacket(ReceivedMessage& message);
 
     static std::unique_ptr<NLPacket> constructICEPingPacket(PingType_t pingType, const QUuid& iceID);
     static std::unique_ptr<NLPacket> constructICEPingReplyPacket(ReceivedMessage& message, const QUuid& iceID);
@@ -408,17 +424,6 @@ protected slots:
     void processDelayedAdds();
 
 protected:
-    struct NewNodeInfo {
-        qint8 type;
-        QUuid uuid;
-        SockAddr publicSocket;
-        SockAddr localSocket;
-        NodePermissions permissions;
-        bool isReplicated;
-        Node::LocalID sessionLocalID;
-        QUuid connectionSecretUUID;
-    };
-
     LimitedNodeList(int socketListenPort = INVALID_PORT, int dtlsListenPort = INVALID_PORT);
     LimitedNodeList(LimitedNodeList const&) = delete; // Don't implement, needed to avoid copies of singleton
     void operator=(LimitedNodeList const&) = delete; // Don't implement, needed to avoid copies of singleton
@@ -35,6 +35,7 @@
 #include "AddressManager.h"
 #include "Assignment.h"
 #include "AudioHelpers.h"
+#include "BinaryStats.h"
 #include "DomainAccountManager.h"
 #include "SockAddr.h"
 #include "FingerprintUtils.h"
@@ -208,6 +209,13 @@ qint64 NodeList::sendStatsToDomainServer(QJsonObject statsObject) {
     return sendStats(statsObject, _domainHandler.getSockAddr());
 }
 
+qint64 NodeList::sendBinaryStatsToDomainServer(const BinaryStatsWriter& stats) {
+    auto statsPacketList = NLPacketList::create(PacketType::NodeBinaryStats, QByteArray(), true, true);
+    stats.write(*statsPacketList);
+
+    return sendPacketList(std::move(statsPacketList), _domainHandler.getSockAddr());
+}
+
 void NodeList::timePingReply(ReceivedMessage& message, const SharedNodePointer& sendingNode) {
     PingType_t pingType;
 
@@ -725,48 +733,25 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
 
     // parse header information
     QDataStream packetStream(message->getMessage());
+    DomainListHeader header;
+    readDomainListHeader(packetStream, header);
 
-    // grab the domain's ID from the beginning of the packet
-    QUuid domainUUID;
-    packetStream >> domainUUID;
-
-    Node::LocalID domainLocalID;
-    packetStream >> domainLocalID;
-
-    // pull our owner (ie. session) UUID from the packet, it's always the first thing
-    // The short (16 bit) ID comes next.
-    QUuid newUUID;
-    Node::LocalID newLocalID;
-    packetStream >> newUUID;
-    packetStream >> newLocalID;
+    const QUuid& domainUUID = header.domainUUID;
+    const QUuid& newUUID = header.sessionUUID;
+    Node::LocalID newLocalID = header.sessionLocalID;
+    NodePermissions& newPermissions = header.permissions;
+    quint64 connectRequestTimestamp = header.connectRequestTimestamp;
+    quint64 domainServerPingSendTime = header.domainServerPingSendTime;
+    quint64 domainServerCheckinProcessingTime = header.domainServerCheckinProcessingTime;
 
-    // pull the permissions/right/privileges for this node out of the stream
-    NodePermissions newPermissions;
-    packetStream >> newPermissions;
     // FIXME: Can remove this temporary work-around in version 2021.2.0. (New protocol version implies a domain server upgrade.)
     // Adjust our canRezAvatarEntities permissions on older domains that do not have this setting.
     // DomainServerList and DomainSettings packets can come in either order so need to adjust with both occurrences.
     bool adjustedPermissions = adjustCanRezAvatarEntitiesPermissions(_domainHandler.getSettingsObject(), newPermissions, false);
 
-    // Is packet authentication enabled?
-    bool isAuthenticated;
-    packetStream >> isAuthenticated;
-
     qint64 now = qint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
 
-    quint64 connectRequestTimestamp;
-    packetStream >> connectRequestTimestamp;
-
-    quint64 domainServerPingSendTime;
-    packetStream >> domainServerPingSendTime;
-
-    quint64 domainServerCheckinProcessingTime;
-    packetStream >> domainServerCheckinProcessingTime;
-
-    bool newConnection;
-    packetStream >> newConnection;
-
-    if (newConnection) {
+    if (header.newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
     }
@@ -850,7 +835,7 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
 
     // if this was the first domain-server list from this domain, we've now connected
     if (!_domainHandler.isConnected()) {
-        _domainHandler.setLocalID(domainLocalID);
+        _domainHandler.setLocalID(header.domainLocalID);
         _domainHandler.setUUID(domainUUID);
         _domainHandler.setIsConnected(true);
 
@@ -860,7 +845,7 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     }
 
     setPermissions(newPermissions);
-    setAuthenticatePackets(isAuthenticated);
+    setAuthenticatePackets(header.isAuthenticated);
 
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
@@ -884,9 +869,21 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     removeDelayedAdd(nodeUUID);
 }
 
-void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
-    NewNodeInfo info;
+void NodeList::readDomainListHeader(QDataStream& packetStream, DomainListHeader& header) {
+    // the domain's IDs come first, then our owner (ie. session) UUID and its short (16 bit) ID
+    packetStream >> header.domainUUID
+                 >> header.domainLocalID
+                 >> header.sessionUUID
+                 >> header.sessionLocalID
+                 >> header.permissions
+                 >> header.isAuthenticated
+                 >> header.connectRequestTimestamp
+                 >> header.domainServerPingSendTime
+                 >> header.domainServerCheckinProcessingTime
+                 >> header.newConnection;
+}
 
+void NodeList::readNodeFromPacketStream(QDataStream& packetStream, NewNodeInfo& info) {
     SocketType publicSocketType, localSocketType;
     packetStream >> info.type
                  >> info.uuid
@@ -900,6 +897,11 @@ void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
                  >> info.connectionSecretUUID;
     info.publicSocket.setType(publicSocketType);
     info.localSocket.setType(localSocketType);
+}
+
+void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
+    NewNodeInfo info;
+    readNodeFromPacketStream(packetStream, info);
 
     // if the public socket address is 0 then it's reachable at the same IP
     // as the domain server
@@ -49,6 +49,7 @@ using NodeSharedReceivedMessagePair = std::pair<SharedNodePointer, QSharedPointe
 
 class Application;
 class Assignment;
+class BinaryStatsWriter;
 
 class NodeList : public LimitedNodeList {
     Q_OBJECT
@@ -61,6 +62,8 @@ public:
 
     Q_INVOKABLE qint64 sendStats(QJsonObject statsObject, SockAddr destination);
     Q_INVOKABLE qint64 sendStatsToDomainServer(QJsonObject statsObject);
+    // can be called from any thread, the stats are copied into the packet list before returning
+    qint64 sendBinaryStatsToDomainServer(const BinaryStatsWriter& stats);
 
     DomainHandler& getDomainHandler() { return _domainHandler; }
 
@@ -106,6 +109,23 @@ public:
     virtual Node::LocalID getDomainLocalID() const override { return _domainHandler.getLocalID(); }
     virtual SockAddr getDomainSockAddr() const override { return _domainHandler.getSockAddr(); }
 
+    // the fields a DomainList packet starts with, the nodes follow them
+    struct DomainListHeader {
+        QUuid domainUUID;
+        Node::LocalID domainLocalID;
+        QUuid sessionUUID;
+        Node::LocalID sessionLocalID;
+        NodePermissions permissions;
+        bool isAuthenticated;
+        quint64 connectRequestTimestamp;
+        quint64 domainServerPingSendTime;
+        quint64 domainServerCheckinProcessingTime;
+        bool newConnection;
+    };
+
+    static void readDomainListHeader(QDataStream& packetStream, DomainListHeader& header);
+    static void readNodeFromPacketStream(QDataStream& packetStream, NewNodeInfo& info);
+
 public slots:
     void reset(QString reason, bool skipDomainHandlerReset = false);
     void resetFromDomainHandler() { reset("Reset from Domain Handler", true); }
@@ -18,6 +18,8 @@
 #include <QtCore/QTimer>
 
 #include <LogHandler.h>
+#include <NumericalConstants.h>
+#include <Trace.h>
 #include <shared/QtHelpers.h>
 
 #include <platform/Platform.h>
@@ -104,34 +106,91 @@ void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeTy
 
     // stop sending stats if we disconnect
     connect(&nodeList->getDomainHandler(), &DomainHandler::disconnectedFromDomain, &_statsTimer, &QTimer::stop);
+
+    // the domain-server can ask us to capture a trace of a running assignment
+    nodeList->getPacketReceiver().registerListener(PacketType::NodeTracingRequest,
+        PacketReceiver::makeUnsourcedListenerReference<ThreadedAssignment>(this, &ThreadedAssignment::handleTracingRequestPacket));
+}
+
+void ThreadedAssignment::handleTracingRequestPacket(QSharedPointer<ReceivedMessage> message) {
+    static const quint32 MAX_TRACE_DURATION_MSECS = 60 * (quint32)MSECS_PER_SECOND;
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (message->getSenderSockAddr() != nodeList->getDomainHandler().getSockAddr()) {
+        qCDebug(networking) << "Ignoring tracing request that did not come from the domain-server";
+        return;
+    }
+
+    if (!DependencyManager::isSet<tracing::Tracer>()) {
+        return;
+    }
+
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    if (tracer->isEnabled()) {
+        qCDebug(networking) << "Ignoring tracing request, a trace is already being captured";
+        return;
+    }
+
+    quint32 durationMSecs;
+    message->readPrimitive(&durationMSecs);
+    durationMSecs = std::min(durationMSecs, MAX_TRACE_DURATION_MSECS);
+
+    QString traceFile = QString("traces/%1-%2-{DATE}_{TIME}.json.gz")
+        .arg(QString(getTypeName()).toLower().replace(' ', '-'))
+        .arg(QCoreApplication::applicationPid());
+
+    qCDebug(networking) << "Capturing a" << durationMSecs << "ms trace to" << traceFile;
+    tracer->startTracing();
+    QTimer::singleShot(durationMSecs, this, [traceFile] {
+        if (!DependencyManager::isSet<tracing::Tracer>()) {
+            return;
+        }
+        auto tracer = DependencyManager::get<tracing::Tracer>();
+        if (tracer->isEnabled()) {
+            tracer->stopTracing();
+            tracer->serialize(traceFile);
+        }
+    });
 }
 
 void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObject) {
+    beginStatsPacket().addJSON(statsObject);
+    finishStatsPacket();
+}
+
+BinaryStatsWriter& ThreadedAssignment::beginStatsPacket() {
+    _statsWriter.reset();
+    return _statsWriter;
+}
+
+void ThreadedAssignment::finishStatsPacket() {
     auto nodeList = DependencyManager::get<NodeList>();
 
 #ifdef DEBUG_EVENT_QUEUE
-    statsObject["nodelist_event_queue_size"] = ::hifi::qt::getEventQueueSize(nodeList->thread());
+    _statsWriter.add("nodelist_event_queue_size", ::hifi::qt::getEventQueueSize(nodeList->thread()));
 #endif
 
-    QJsonObject ioStats;
-    ioStats["inbound_kbps"] = nodeList->getInboundKbps();
-    ioStats["inbound_pps"] = nodeList->getInboundPPS();
-    ioStats["outbound_kbps"] = nodeList->getOutboundKbps();
-    ioStats["outbound_pps"] = nodeList->getOutboundPPS();
+    _statsWriter.beginObject("io_stats");
+    _statsWriter.add("inbound_kbps", nodeList->getInboundKbps());
+    _statsWriter.add("inbound_pps", nodeList->getInboundPPS());
+    _statsWriter.add("outbound_kbps", nodeList->getOutboundKbps());
+    _statsWriter.add("outbound_pps", nodeList->getOutboundPPS());
+    _statsWriter.end();
 
-    statsObject["io_stats"] = ioStats;
+    _statsWriter.beginObject("assignmentStats");
+    _statsWriter.add("numQueuedCheckIns", _numQueuedCheckIns);
+    _statsWriter.end();
 
-    QJsonObject assignmentStats;
-    assignmentStats["numQueuedCheckIns"] = _numQueuedCheckIns;
-
-    statsObject["assignmentStats"] = assignmentStats;
+    if (_statsWriter.hasOverflowed()) {
+        qCWarning(networking) << "Stats packet exceeded the binary stats limits and was truncated";
+    }
 
-    nodeList->sendStatsToDomainServer(statsObject);
+    nodeList->sendBinaryStatsToDomainServer(_statsWriter);
 }
 
 void ThreadedAssignment::sendStatsPacket() {
-    QJsonObject statsObject;
-    addPacketStatsAndSendStatsPacket(statsObject);
+    beginStatsPacket();
+    finishStatsPacket();
 }
 
 void ThreadedAssignment::checkInWithDomainServerOrExit() {
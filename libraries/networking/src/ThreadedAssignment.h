@@ -17,6 +17,7 @@
 #include "ReceivedMessage.h"
 
 #include "Assignment.h"
+#include "BinaryStats.h"
 
 class ThreadedAssignment : public Assignment {
     Q_OBJECT
@@ -27,6 +28,11 @@ public:
     virtual void aboutToFinish() { };
     void addPacketStatsAndSendStatsPacket(QJsonObject statsObject);
 
+    // Stats packets written directly, without building them as JSON first:
+    // write the stats to the writer returned by beginStatsPacket, then call finishStatsPacket.
+    BinaryStatsWriter& beginStatsPacket();
+    void finishStatsPacket();
+
 public slots:
     /// threaded run of assignment
     virtual void run() = 0;
@@ -48,12 +54,14 @@ protected:
     QTimer _domainServerTimer;
     QTimer _statsTimer;
     int _numQueuedCheckIns { 0 };
+    BinaryStatsWriter _statsWriter;
 
 protected slots:
     void domainSettingsRequestFailed();
 
 private slots:
     void checkInWithDomainServerOrExit();
+    void handleTracingRequestPacket(QSharedPointer<ReceivedMessage> message);
 };
 
 typedef QSharedPointer<ThreadedAssignment> SharedAssignmentPointer;
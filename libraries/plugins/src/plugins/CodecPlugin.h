@@ -12,18 +12,52 @@
 
 #include "Plugin.h"
 
+// Encoders and decoders work on caller-owned buffers, so the per-frame audio path doesn't allocate.
+// The QByteArray versions are kept as adapters for the callers that don't care.
 class Encoder {
 public:
     virtual ~Encoder() { }
-    virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // Encode decodedSize bytes of audio into encodedBuffer, which can hold maxEncodedSize bytes.
+    // Returns the number of bytes written to encodedBuffer.
+    virtual int encode(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) = 0;
+
+    // The encodedBuffer size needed to encode decodedSize bytes of audio
+    virtual int getMaxEncodedSize(int decodedSize) const { return decodedSize; }
+
+    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
+        encodedBuffer.resize(getMaxEncodedSize(decodedBuffer.size()));
+        int encodedSize = encode(decodedBuffer.constData(), decodedBuffer.size(), encodedBuffer.data(), encodedBuffer.size());
+        encodedBuffer.resize(encodedSize);
+    }
 };
 
 class Decoder {
 public:
     virtual ~Decoder() { }
-    virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) = 0;
 
-    virtual void lostFrame(QByteArray& decodedBuffer) = 0;
+    // Decode encodedSize bytes into decodedBuffer, which can hold maxDecodedSize bytes.
+    // Returns the number of bytes written to decodedBuffer.
+    virtual int decode(const char* encodedBuffer, int encodedSize, char* decodedBuffer, int maxDecodedSize) = 0;
+
+    // Generate a frame in place of a lost one into decodedBuffer.
+    // Returns the number of bytes written to decodedBuffer.
+    virtual int lostFrame(char* decodedBuffer, int maxDecodedSize) = 0;
+
+    // The decodedBuffer size needed for a frame
+    virtual int getMaxDecodedSize() const = 0;
+
+    void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) {
+        decodedBuffer.resize(getMaxDecodedSize());
+        int decodedSize = decode(encodedBuffer.constData(), encodedBuffer.size(), decodedBuffer.data(), decodedBuffer.size());
+        decodedBuffer.resize(decodedSize);
+    }
+
+    void lostFrame(QByteArray& decodedBuffer) {
+        decodedBuffer.resize(getMaxDecodedSize());
+        int decodedSize = lostFrame(decodedBuffer.data(), decodedBuffer.size());
+        decodedBuffer.resize(decodedSize);
+    }
 };
 
 class CodecPlugin : public Plugin {
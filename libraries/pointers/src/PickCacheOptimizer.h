@@ -8,6 +8,7 @@
 #ifndef hifi_PickCacheOptimizer_h
 #define hifi_PickCacheOptimizer_h
 
+#include <functional>
 #include <unordered_map>
 
 #include "Pick.h"
@@ -37,14 +38,38 @@ template<typename T>
 class PickCacheOptimizer {
 
 public:
+    // Computes the entity intersections of several picks at once, returning one result per pick in the same order.
+    using EntityBatchOperator = std::function<std::vector<PickResultPointer>(const std::vector<std::shared_ptr<Pick<T>>>&, const std::vector<T>&)>;
+
     QVector3D update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD);
 
+    // When set, the entity intersections are computed through it ENTITY_BATCH_SIZE picks at a time, just before the
+    // update loop gets to them, and the picks then find them in the cache.  Otherwise each pick is evaluated through
+    // Pick::getEntityIntersection().
+    void setEntityBatchOperator(const EntityBatchOperator& entityBatchOperator) { _entityBatchOperator = entityBatchOperator; }
+
 protected:
     typedef std::unordered_map<T, std::unordered_map<PickCacheKey, PickResultPointer>> PickCache;
+    typedef std::unordered_map<uint32_t, std::shared_ptr<PickQuery>> PickMap;
+
+    // the size of the ray packets EntityTree::evalRayIntersections() traces together
+    static const size_t ENTITY_BATCH_SIZE = 32;
+
+    static bool doesPickEntities(const std::shared_ptr<Pick<T>>& pick) {
+        return pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities();
+    }
+
+    // Fills the cache with the entity results of the picks that need them, walking the picks from itr, in the order
+    // the update loop does, until ENTITY_BATCH_SIZE results are computed or maxPicks picks are walked.  Returns the
+    // number of picks walked and adds the number of results computed to numComputed.
+    uint32_t batchEntityIntersections(PickMap& picks, typename PickMap::iterator itr, uint32_t maxPicks, PickCache& cache,
+        int& numComputed);
 
     // Returns true if this pick exists in the cache, and if it does, update res if the cached result is closer
     bool checkAndCompareCachedResults(T& pick, PickCache& cache, PickResultPointer& res, const PickCacheKey& key);
     void cacheResult(const bool intersects, const PickResultPointer& resTemp, const PickCacheKey& key, PickResultPointer& res, T& mathPick, PickCache& cache, const std::shared_ptr<Pick<T>> pick);
+
+    EntityBatchOperator _entityBatchOperator;
 };
 
 template<typename T>
@@ -66,6 +91,53 @@ void PickCacheOptimizer<T>::cacheResult(const bool needToCompareResults, const P
     }
 }
 
+template<typename T>
+uint32_t PickCacheOptimizer<T>::batchEntityIntersections(PickMap& picks, typename PickMap::iterator itr, uint32_t maxPicks,
+        PickCache& cache, int& numComputed) {
+    std::vector<std::shared_ptr<Pick<T>>> batchPicks;
+    std::vector<T> batchMathPicks;
+    std::vector<PickCacheKey> batchKeys;
+    uint32_t numWalked = 0;
+    while (numWalked < maxPicks && batchPicks.size() < ENTITY_BATCH_SIZE) {
+        std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(itr->second);
+        ++numWalked;
+        if (++itr == picks.end()) {
+            itr = picks.begin();
+        }
+        if (!pick->isEnabled() || pick->getMaxDistance() < 0.0f || !doesPickEntities(pick)) {
+            continue;
+        }
+        T mathematicalPick = pick->getMathematicalPick();
+        if (!mathematicalPick) {
+            continue;
+        }
+        // picks sharing a math pick and filters only need one evaluation, reserve its slot in the cache
+        PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+        auto& cached = cache[mathematicalPick];
+        if (cached.find(entityKey) != cached.end()) {
+            continue;
+        }
+        cached[entityKey] = PickResultPointer();
+        batchPicks.push_back(pick);
+        batchMathPicks.push_back(mathematicalPick);
+        batchKeys.push_back(entityKey);
+    }
+    if (batchPicks.empty()) {
+        return numWalked;
+    }
+
+    std::vector<PickResultPointer> entityResults = _entityBatchOperator(batchPicks, batchMathPicks);
+    for (size_t i = 0; i < batchPicks.size(); i++) {
+        PickResultPointer entityRes = i < entityResults.size() ? entityResults[i] : PickResultPointer();
+        if (!entityRes || !entityRes->doesIntersect()) {
+            entityRes = batchPicks[i]->getDefaultResult(batchMathPicks[i].toVariantMap());
+        }
+        cache[batchMathPicks[i]][batchKeys[i]] = entityRes;
+    }
+    numComputed += (int)batchPicks.size();
+    return numWalked;
+}
+
 template<typename T>
 QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks,
         uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD) {
@@ -80,7 +152,15 @@ QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared
         }
     }
     uint32_t numUpdates = 0;
+    uint32_t numBatched = 0;
     while(numUpdates < picks.size()) {
+        // batch the entity intersections of the next picks only once the loop gets to them, so the time budget
+        // bounds the batches as well
+        if (_entityBatchOperator && numUpdates == numBatched) {
+            int numComputed = 0;
+            numBatched += batchEntityIntersections(picks, itr, (uint32_t)picks.size() - numUpdates, results, numComputed);
+            numIntersectionsComputed[0] += numComputed;
+        }
         std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(itr->second);
         T mathematicalPick = pick->getMathematicalPick();
         PickResultPointer res = pick->getDefaultResult(mathematicalPick.toVariantMap());
@@ -88,7 +168,7 @@ QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared
         if (!pick->isEnabled() || pick->getMaxDistance() < 0.0f || !mathematicalPick) {
             pick->setPickResult(res);
         } else {
-            if (pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities()) {
+            if (doesPickEntities(pick)) {
                 PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
                 if (!checkAndCompareCachedResults(mathematicalPick, results, res, entityKey)) {
                     PickResultPointer entityRes = pick->getEntityIntersection(mathematicalPick);
@@ -59,6 +59,9 @@ public:
     void setShouldPickHUDOperator(std::function<bool()> shouldPickHUDOperator) { _shouldPickHUDOperator = shouldPickHUDOperator; }
     void setCalculatePos2DFromHUDOperator(std::function<glm::vec2(const glm::vec3&)> calculatePos2DFromHUDOperator) { _calculatePos2DFromHUDOperator = calculatePos2DFromHUDOperator; }
     glm::vec2 calculatePos2DFromHUD(const glm::vec3& intersection) { return _calculatePos2DFromHUDOperator(intersection); }
+    void setRayEntityBatchOperator(const PickCacheOptimizer<PickRay>::EntityBatchOperator& rayEntityBatchOperator) {
+        _rayPickCacheOptimizer.setEntityBatchOperator(rayEntityBatchOperator);
+    }
 
     static const unsigned int INVALID_PICK_ID { 0 };
 
@@ -8,15 +8,19 @@
 
 #include "Clip.h"
 
+#include <vector>
+
 #include "Frame.h"
 #include "Logging.h"
 
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
+#include "impl/IndexedClipFormat.h"
 
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QBuffer>
+#include <QtCore/QHash>
 #include <QtCore/QDebug>
 
 using namespace recording;
@@ -92,6 +96,13 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
 
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const QString Clip::FORMAT_VERSION = QStringLiteral("version");
+
+template <typename T>
+static bool writeRecords(QIODevice& output, const std::vector<T>& records) {
+    qint64 size = (qint64)(records.size() * sizeof(T));
+    return size == 0 || output.write(reinterpret_cast<const char*>(records.data()), size) == size;
+}
 
 bool Clip::write(QIODevice& output) {
     auto frameTypes = Frame::getFrameTypes();
@@ -102,20 +113,77 @@ bool Clip::write(QIODevice& output) {
 
     QJsonObject rootObject;
     rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
-    // Always mark new files as compressed
-    rootObject.insert(FRAME_COMREPSSION_FLAG, true);
+    // frames are compressed in blocks rather than one by one
+    rootObject.insert(FRAME_COMREPSSION_FLAG, false);
+    rootObject.insert(FORMAT_VERSION, INDEXED_CLIP_VERSION);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
     // Never compress the header frame
     if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
         return false;
     }
 
+    std::vector<IndexedFrameRecord> frameRecords;
+    std::vector<IndexedBlockRecord> blockRecords;
+    frameRecords.reserve(frameCount());
+
+    QByteArray block;
+    QHash<FrameType, QByteArray> previousFrameData;
+    QByteArray encoded;
+
+    auto flushBlock = [&] {
+        if (block.isEmpty()) {
+            return true;
+        }
+        QByteArray compressed = qCompress(block);
+        IndexedBlockRecord blockRecord {};
+        blockRecord.fileOffset = (quint64)output.pos();
+        blockRecord.compressedSize = (uint32_t)compressed.size();
+        blockRecords.push_back(blockRecord);
+        block.clear();
+        previousFrameData.clear();
+        return output.write(compressed) == compressed.size();
+    };
+
     seek(0);
 
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        if (frame->type == Frame::TYPE_INVALID) {
+            qWarning() << "Attempting to write invalid frame";
+            continue;
+        }
+
+        IndexedFrameRecord frameRecord {};
+        frameRecord.type = frame->type;
+        frameRecord.timeOffset = frame->timeOffset;
+        frameRecord.block = (uint32_t)blockRecords.size();
+        frameRecord.blockOffset = (uint32_t)block.size();
+        frameRecord.size = (uint32_t)frame->data.size();
+        frameRecord.encoding = encodeFrameData(previousFrameData.value(frame->type), frame->data, encoded);
+        frameRecords.push_back(frameRecord);
+
+        block.append(encoded);
+        previousFrameData[frame->type] = frame->data;
+
+        if (block.size() >= INDEXED_CLIP_BLOCK_SIZE && !flushBlock()) {
             return false;
         }
     }
-    return true;
+    if (!flushBlock()) {
+        return false;
+    }
+
+    IndexedClipTrailer trailer {};
+    trailer.frameIndexOffset = (quint64)output.pos();
+    if (!writeRecords(output, frameRecords)) {
+        return false;
+    }
+    trailer.blockIndexOffset = (quint64)output.pos();
+    if (!writeRecords(output, blockRecords)) {
+        return false;
+    }
+    trailer.frameCount = (uint32_t)frameRecords.size();
+    trailer.blockCount = (uint32_t)blockRecords.size();
+    trailer.version = INDEXED_CLIP_VERSION;
+    trailer.magic = INDEXED_CLIP_MAGIC;
+    return output.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer)) == sizeof(trailer);
 }
@@ -56,6 +56,7 @@ public:
     
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
+    static const QString FORMAT_VERSION;
 
 protected:
     friend class WrapperClip;
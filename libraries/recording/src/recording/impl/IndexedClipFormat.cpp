@@ -0,0 +1,52 @@
+//
+//  IndexedClipFormat.cpp
+//  libraries/recording/src/recording/impl
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IndexedClipFormat.h"
+
+#include <algorithm>
+
+namespace recording {
+
+IndexedFrameEncoding encodeFrameData(const QByteArray& previous, const QByteArray& data, QByteArray& encoded) {
+    int commonSize = std::min(previous.size(), data.size());
+    if (commonSize == 0) {
+        encoded = data;
+        return IndexedFrameEncoding::Raw;
+    }
+
+    encoded = data;
+    char* out = encoded.data();
+    const char* prev = previous.constData();
+    int rawNonZero = 0;
+    int xorNonZero = 0;
+    for (int i = 0; i < commonSize; i++) {
+        rawNonZero += (out[i] != 0);
+        out[i] ^= prev[i];
+        xorNonZero += (out[i] != 0);
+    }
+
+    if (xorNonZero >= rawNonZero) {
+        encoded = data;
+        return IndexedFrameEncoding::Raw;
+    }
+    return IndexedFrameEncoding::XorPrevious;
+}
+
+void decodeFrameData(IndexedFrameEncoding encoding, const QByteArray& previous, QByteArray& data) {
+    if (encoding != IndexedFrameEncoding::XorPrevious) {
+        return;
+    }
+    int commonSize = std::min(previous.size(), data.size());
+    char* out = data.data();
+    const char* prev = previous.constData();
+    for (int i = 0; i < commonSize; i++) {
+        out[i] ^= prev[i];
+    }
+}
+
+}
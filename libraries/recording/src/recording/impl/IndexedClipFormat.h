@@ -0,0 +1,75 @@
+//
+//  IndexedClipFormat.h
+//  libraries/recording/src/recording/impl
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_IndexedClipFormat_h
+#define hifi_Recording_Impl_IndexedClipFormat_h
+
+#include <QtCore/QByteArray>
+
+#include "../Frame.h"
+
+namespace recording {
+
+// Layout of version 2 clip files:
+//   header frame   same framing as version 1, its JSON carries Clip::FORMAT_VERSION
+//   blocks         each one is the qCompress'ed concatenation of the encoded data of consecutive frames
+//   frame index    one IndexedFrameRecord per frame, in time order
+//   block index    one IndexedBlockRecord per block
+//   trailer        IndexedClipTrailer, at the very end of the file
+// Opening a clip only reads the trailer and the indices, blocks are decompressed when one of their frames is read.
+// Within a block, frame data can be stored as the XOR with the previous frame of the same type, which turns the
+// unchanged parts of consecutive avatar frames into runs of zeros for the block compression.
+
+static const int INDEXED_CLIP_VERSION = 2;
+static const uint32_t INDEXED_CLIP_MAGIC = 0x49524648; // "HFRI"
+
+// blocks are closed once their raw size reaches this, so seeking decompresses at most about this much
+static const int INDEXED_CLIP_BLOCK_SIZE = 64 * 1024;
+
+enum class IndexedFrameEncoding : uint8_t {
+    Raw = 0,
+    XorPrevious = 1  // XOR with the data of the previous frame of the same type in the block, over their common length
+};
+
+struct IndexedFrameRecord {
+    FrameType type;
+    IndexedFrameEncoding encoding;
+    uint8_t padding;
+    Frame::Time timeOffset;
+    uint32_t block;
+    uint32_t blockOffset;  // of the frame data in the uncompressed block
+    uint32_t size;
+};
+
+struct IndexedBlockRecord {
+    quint64 fileOffset;
+    uint32_t compressedSize;
+    uint32_t padding;
+};
+
+struct IndexedClipTrailer {
+    quint64 frameIndexOffset;
+    quint64 blockIndexOffset;
+    uint32_t frameCount;
+    uint32_t blockCount;
+    uint32_t version;
+    uint32_t magic;
+};
+
+static_assert(sizeof(IndexedFrameRecord) == 20, "IndexedFrameRecord is written to disk as is");
+static_assert(sizeof(IndexedBlockRecord) == 16, "IndexedBlockRecord is written to disk as is");
+static_assert(sizeof(IndexedClipTrailer) == 32, "IndexedClipTrailer is written to disk as is");
+
+// picks the smaller of the raw and XOR encodings of data, as estimated by the number of non zero bytes.
+IndexedFrameEncoding encodeFrameData(const QByteArray& previous, const QByteArray& data, QByteArray& encoded);
+void decodeFrameData(IndexedFrameEncoding encoding, const QByteArray& previous, QByteArray& data);
+
+}
+
+#endif
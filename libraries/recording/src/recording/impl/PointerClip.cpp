@@ -11,6 +11,7 @@
 #include <algorithm>
 
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 
@@ -45,32 +46,35 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
 }
 
 
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
+// FIXME move to Frame::readHeader?
+static bool readFrameHeader(uchar* const start, uchar*& current, uchar* const end, PointerFrameHeader& header) {
+    if (end - current < PointerClip::MINIMUM_FRAME_SIZE) {
+        return false;
+    }
+    FrameSize size;
+    memcpy(&(header.type), current, sizeof(FrameType));
+    current += sizeof(FrameType);
+    memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
+    current += sizeof(Frame::Time);
+    memcpy(&size, current, sizeof(FrameSize));
+    current += sizeof(FrameSize);
+    header.size = size;
+    header.fileOffset = current - start;
+    if (end - current < header.size) {
+        return false;
+    }
+    current += header.size;
+    return true;
+}
+
+PointerFrameHeaderList parseFrameHeaders(uchar* const start, uchar* current, uchar* const end) {
     PointerFrameHeaderList results;
-    auto current = start;
-    auto end = current + size;
     // Read all the frame headers
-    // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
-        PointerFrameHeader header;
-        memcpy(&(header.type), current, sizeof(FrameType));
-        current += sizeof(FrameType);
-        memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
-        current += sizeof(Frame::Time);
-        memcpy(&(header.size), current, sizeof(FrameSize));
-        current += sizeof(FrameSize);
-        header.fileOffset = current - start;
-        if (end - current < header.size) {
-            break;
-        }
-        current += header.size;
+    PointerFrameHeader header;
+    while (readFrameHeader(start, current, end, header)) {
         results.push_back(header);
     }
     qDebug(recordingLog) << "Parsed source data into " << results.size() << " frames";
-//    int i = 0;
-//    for (const auto& frameHeader : results) {
-//        qDebug(recordingLog) << "Frame " << i++ << " time " << frameHeader.timeOffset << " Type " << frameHeader.type;
-//    }
     return results;
 }
 
@@ -79,6 +83,9 @@ void PointerClip::reset() {
     _data = nullptr;
     _size = 0;
     _header = QJsonDocument();
+    _blocks.clear();
+    _decodedBlock = PointerFrameHeader::NO_BLOCK;
+    _decodedFrames.clear();
 }
 
 void PointerClip::init(uchar* data, size_t size) {
@@ -87,18 +94,17 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
-    // Verify that at least one frame exists and that the first frame is a header
-    if (0 == parsedFrameHeaders.size()) {
-        qWarning() << "No frames found, invalid file";
-        reset();
-        return;
-    }
+    uchar* current = data;
+    uchar* const end = data + size;
 
-    // Grab the file header
+    // Grab the file header, which is always the first frame
     {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
+        PointerFrameHeader fileHeaderFrameHeader;
+        if (!readFrameHeader(data, current, end, fileHeaderFrameHeader)) {
+            qWarning() << "No frames found, invalid file";
+            reset();
+            return;
+        }
         if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
             qWarning() << "Missing header frame, invalid file";
             reset();
@@ -114,26 +120,124 @@ void PointerClip::init(uchar* data, size_t size) {
         _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
     }
 
-    // Find the type enum translation map and fix up the frame headers
-    {
-        FrameTranslationMap translationMap = parseTranslationMap(_header);
-        if (translationMap.empty()) {
-            qWarning() << "Header missing frame type map, invalid file";
+    // Find the type enum translation map
+    FrameTranslationMap translationMap = parseTranslationMap(_header);
+    if (translationMap.empty()) {
+        qWarning() << "Header missing frame type map, invalid file";
+        reset();
+        return;
+    }
+
+    // Indexed clips read their frame headers from the index at the end of the file
+    if (_header.object()[FORMAT_VERSION].toInt() >= INDEXED_CLIP_VERSION) {
+        if (!initIndexed(translationMap)) {
+            qWarning() << "Invalid clip index, invalid file";
             reset();
-            return;
         }
+        return;
+    }
 
-        // Update the loaded headers with the frame data
-        _frames.reserve(parsedFrameHeaders.size());
-        for (auto& frameHeader : parsedFrameHeaders) {
-            if (!translationMap.contains(frameHeader.type)) {
-                continue;
-            }
-            frameHeader.type = translationMap[frameHeader.type];
-            _frames.push_back(frameHeader);
+    // Older clips have to be scanned for their frame headers
+    auto parsedFrameHeaders = parseFrameHeaders(data, current, end);
+
+    // Update the loaded headers with the frame data
+    _frames.reserve(parsedFrameHeaders.size());
+    for (auto& frameHeader : parsedFrameHeaders) {
+        if (!translationMap.contains(frameHeader.type)) {
+            continue;
         }
+        frameHeader.type = translationMap[frameHeader.type];
+        _frames.push_back(frameHeader);
     }
+}
 
+bool PointerClip::initIndexed(const FrameTranslationMap& translationMap) {
+    if (_size < sizeof(IndexedClipTrailer)) {
+        return false;
+    }
+
+    IndexedClipTrailer trailer;
+    quint64 trailerOffset = _size - sizeof(IndexedClipTrailer);
+    memcpy(&trailer, _data + trailerOffset, sizeof(IndexedClipTrailer));
+    if (trailer.magic != INDEXED_CLIP_MAGIC || trailer.version != INDEXED_CLIP_VERSION) {
+        return false;
+    }
+    if (trailer.frameIndexOffset > trailer.blockIndexOffset || trailer.blockIndexOffset > trailerOffset ||
+        trailer.blockIndexOffset - trailer.frameIndexOffset != (quint64)trailer.frameCount * sizeof(IndexedFrameRecord) ||
+        trailerOffset - trailer.blockIndexOffset != (quint64)trailer.blockCount * sizeof(IndexedBlockRecord)) {
+        return false;
+    }
+
+    _blocks.resize(trailer.blockCount);
+    if (trailer.blockCount > 0) {
+        memcpy(_blocks.data(), _data + trailer.blockIndexOffset, trailer.blockCount * sizeof(IndexedBlockRecord));
+    }
+    for (const auto& block : _blocks) {
+        if (block.fileOffset + block.compressedSize > trailer.frameIndexOffset) {
+            return false;
+        }
+    }
+
+    _frames.reserve(trailer.frameCount);
+    const uchar* record = _data + trailer.frameIndexOffset;
+    for (uint32_t i = 0; i < trailer.frameCount; i++, record += sizeof(IndexedFrameRecord)) {
+        IndexedFrameRecord frameRecord;
+        memcpy(&frameRecord, record, sizeof(IndexedFrameRecord));
+        if (frameRecord.block >= trailer.blockCount) {
+            return false;
+        }
+        if (!translationMap.contains(frameRecord.type)) {
+            continue;
+        }
+        PointerFrameHeader frameHeader;
+        frameHeader.type = translationMap[frameRecord.type];
+        frameHeader.timeOffset = frameRecord.timeOffset;
+        frameHeader.size = frameRecord.size;
+        frameHeader.fileOffset = frameRecord.blockOffset;
+        frameHeader.block = frameRecord.block;
+        frameHeader.encoding = frameRecord.encoding;
+        _frames.push_back(frameHeader);
+    }
+    return true;
+}
+
+// Internal only function, needs no locking
+const QByteArray& PointerClip::readIndexedFrameData(size_t frameIndex) const {
+    const auto& header = _frames[frameIndex];
+    if (header.block != _decodedBlock) {
+        // the frames of a block are contiguous
+        size_t first = frameIndex;
+        while (first > 0 && _frames[first - 1].block == header.block) {
+            --first;
+        }
+        size_t last = frameIndex + 1;
+        while (last < _frames.size() && _frames[last].block == header.block) {
+            ++last;
+        }
+
+        const auto& blockRecord = _blocks[header.block];
+        QByteArray block = qUncompress(_data + blockRecord.fileOffset, (int)blockRecord.compressedSize);
+
+        // XOR encoded frames refer to the previous frame of their type in the same block
+        QHash<FrameType, QByteArray> previousFrameData;
+        _decodedFrames.clear();
+        _decodedFrames.reserve(last - first);
+        for (size_t i = first; i < last; i++) {
+            const auto& frameHeader = _frames[i];
+            QByteArray frameData;
+            if (frameHeader.fileOffset + frameHeader.size <= (quint64)block.size()) {
+                frameData = block.mid((int)frameHeader.fileOffset, (int)frameHeader.size);
+                decodeFrameData(frameHeader.encoding, previousFrameData.value(frameHeader.type), frameData);
+            } else {
+                qCWarning(recordingLog) << "Frame" << i << "lies outside of its block, invalid file";
+            }
+            previousFrameData[frameHeader.type] = frameData;
+            _decodedFrames.push_back(frameData);
+        }
+        _decodedBlock = header.block;
+        _decodedFirstFrame = first;
+    }
+    return _decodedFrames[frameIndex - _decodedFirstFrame];
 }
 
 // Internal only function, needs no locking
@@ -144,7 +248,9 @@ FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
         const auto& header = _frames[frameIndex];
         result->type = header.type;
         result->timeOffset = header.timeOffset;
-        if (header.size) {
+        if (header.block != PointerFrameHeader::NO_BLOCK) {
+            result->data = readIndexedFrameData(frameIndex);
+        } else if (header.size) {
             result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
             if (_compressed) {
                 result->data = qUncompress(result->data);
@@ -13,18 +13,25 @@
 #include "ArrayClip.h"
 
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QJsonDocument>
+#include <QtCore/QMap>
 
 #include "../Frame.h"
+#include "IndexedClipFormat.h"
 
 namespace recording {
 
 struct PointerFrameHeader : public FrameHeader {
+    static const uint32_t NO_BLOCK = 0xFFFFFFFF;
+
     FrameType type;
     Frame::Time timeOffset;
-    uint16_t size;
-    quint64 fileOffset;
+    uint32_t size { 0 };
+    quint64 fileOffset;  // or the offset in the uncompressed block, for frames of indexed clips
+    uint32_t block { NO_BLOCK };
+    IndexedFrameEncoding encoding { IndexedFrameEncoding::Raw };
 };
 
 using PointerFrameHeaderList = std::list<PointerFrameHeader>;
@@ -47,10 +54,20 @@ public:
 protected:
     void reset() override;
     virtual FrameConstPointer readFrame(size_t index) const override;
+    bool initIndexed(const QMap<FrameType, FrameType>& translationMap);
+    const QByteArray& readIndexedFrameData(size_t frameIndex) const;
+
     QJsonDocument _header;
     uchar* _data { nullptr };
     size_t _size { 0 };
     bool _compressed { true };
+
+    // indexed clips only
+    std::vector<IndexedBlockRecord> _blocks;
+    // frames of the last block that was read, decompressed and decoded
+    mutable uint32_t _decodedBlock { PointerFrameHeader::NO_BLOCK };
+    mutable size_t _decodedFirstFrame { 0 };
+    mutable std::vector<QByteArray> _decodedFrames;
 };
 
 }
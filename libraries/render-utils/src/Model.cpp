@@ -819,7 +819,10 @@ void Model::calculateTriangleSets(const HFMModel& hfmModel) {
     int numberOfMeshes = hfmModel.meshes.size();
 
     _triangleSetsValid = true;
-    _modelSpaceMeshTriangleSets.clear();
+    if (_triangleSetsNeedRebuild) {
+        _modelSpaceMeshTriangleSets.clear();
+        _triangleSetsNeedRebuild = false;
+    }
     _modelSpaceMeshTriangleSets.resize(numberOfMeshes);
 
     for (int i = 0; i < numberOfMeshes; i++) {
@@ -842,7 +845,22 @@ void Model::calculateTriangleSets(const HFMModel& hfmModel) {
             int numberOfQuads = part.quadIndices.size() / INDICES_PER_QUAD;
             int numberOfTris = part.triangleIndices.size() / INDICES_PER_TRIANGLE;
             int totalTriangles = (numberOfQuads * TRIANGLES_PER_QUAD) + numberOfTris;
-            partTriangleSet.reserve(totalTriangles);
+
+            // When the part still has as many triangles, as when a script edits the vertices of a mesh, they are
+            // replaced in place and the tree of the set is only refit on the next query rather than rebuilt.
+            bool replaceTriangles = partTriangleSet.size() == (size_t)totalTriangles;
+            if (!replaceTriangles) {
+                partTriangleSet.clear();
+                partTriangleSet.reserve(totalTriangles);
+            }
+            size_t triangleIndex = 0;
+            auto addTriangle = [&](const Triangle& triangle) {
+                if (replaceTriangles) {
+                    partTriangleSet.setTriangle(triangleIndex++, triangle);
+                } else {
+                    partTriangleSet.insert(triangle);
+                }
+            };
 
             auto meshTransform = hfmModel.offset * mesh.modelTransform;
 
@@ -864,8 +882,8 @@ void Model::calculateTriangleSets(const HFMModel& hfmModel) {
 
                     Triangle tri1 = { v0, v1, v3 };
                     Triangle tri2 = { v1, v2, v3 };
-                    partTriangleSet.insert(tri1);
-                    partTriangleSet.insert(tri2);
+                    addTriangle(tri1);
+                    addTriangle(tri2);
                 }
             }
 
@@ -884,7 +902,7 @@ void Model::calculateTriangleSets(const HFMModel& hfmModel) {
                     glm::vec3 v2 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i2], 1.0f));
 
                     Triangle tri = { v0, v1, v2 };
-                    partTriangleSet.insert(tri);
+                    addTriangle(tri);
                 }
             }
         }
@@ -1294,6 +1312,7 @@ void Model::setURL(const QUrl& url) {
     _visualGeometryRequestFailed = false;
     _needsFixupInScene = true;
     invalidCalculatedMeshBoxes();
+    _triangleSetsNeedRebuild = true;
     deleteGeometry();
 
     auto resource = DependencyManager::get<ModelCache>()->getGeometryResource(url);
@@ -1848,33 +1867,46 @@ static void packBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, Blendshape
 static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
 #endif
 
+// Blends the vertices of several models in a single job, see ModelBlender::MAX_BLENDS_PER_BLENDER.
 class Blender : public QRunnable {
 public:
+    struct Blend {
+        ModelPointer model;
+        HFMModel::ConstPointer hfmModel;
+        int blendNumber;
+        QVector<float> blendshapeCoefficients;
+    };
 
-    Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients);
+    void addBlend(Blend blend) { _blends.push_back(std::move(blend)); }
+    int getNumBlends() const { return (int)_blends.size(); }
+    bool isEmpty() const { return _blends.empty(); }
 
     virtual void run() override;
 
 private:
-    ModelPointer _model;
-    HFMModel::ConstPointer _hfmModel;
-    int _blendNumber;
-    QVector<float> _blendshapeCoefficients;
+    void blend(const Blend& blend, const ModelBlender::BlendshapeStreams& streams);
+
+    std::vector<Blend> _blends;
+    QVector<BlendshapeOffsetUnpacked> _unpackedBlendshapeOffsets;  // reused for all meshes of all blends
 };
 
-Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients) :
-    _model(model),
-    _hfmModel(hfmModel),
-    _blendNumber(blendNumber),
-    _blendshapeCoefficients(blendshapeCoefficients) {
+void Blender::run() {
+    auto modelBlender = DependencyManager::get<ModelBlender>();
+    for (const auto& blend : _blends) {
+        this->blend(blend, *modelBlender->getBlendshapeStreams(blend.hfmModel));
+    }
+
+    // let the ModelBlender start another job, after the results above are delivered
+    QMetaObject::invokeMethod(modelBlender.data(), "blenderFinished");
 }
 
-void Blender::run() {
-    DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", _model->getURL().toString() } });
+void Blender::blend(const Blend& blend, const ModelBlender::BlendshapeStreams& streams) {
+    DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", blend.model->getURL().toString() } });
+    const HFMModel::ConstPointer& hfmModel = blend.hfmModel;
     int numBlendshapeOffsets = 0;  // number of offsets required for all meshes.
     int maxBlendshapeOffsets = 0;  // number of offsets in the largest mesh.
     int numMeshes = 0;  // number of meshes in this model.
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
+    for (auto meshIter = hfmModel->meshes.cbegin(); meshIter != hfmModel->meshes.cend(); ++meshIter) {
         numMeshes++;
         if (meshIter->blendshapes.isEmpty()) {
             continue;
@@ -1891,46 +1923,39 @@ void Blender::run() {
     QVector<BlendshapeOffset> packedBlendshapeOffsets;
     packedBlendshapeOffsets.resize(numBlendshapeOffsets);
 
-    QVector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets;
-    unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);    // reuse for all meshes
+    if (_unpackedBlendshapeOffsets.size() < maxBlendshapeOffsets) {
+        _unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);
+    }
 
     int offset = 0;
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
-        if (meshIter->blendshapes.isEmpty()) {
+    for (int meshIndex = 0; meshIndex < numMeshes; meshIndex++) {
+        const HFMMesh& mesh = hfmModel->meshes.at(meshIndex);
+        if (mesh.blendshapes.isEmpty()) {
             blendedMeshSizes.push_back(0);
             continue;
         }
-        int numVertsInMesh = meshIter->vertices.size();
+        int numVertsInMesh = mesh.vertices.size();
         blendedMeshSizes.push_back(numVertsInMesh);
 
         // initialize offsets to zero
-        memset(unpackedBlendshapeOffsets.data(), 0, numVertsInMesh * sizeof(BlendshapeOffsetUnpacked));
+        memset(_unpackedBlendshapeOffsets.data(), 0, numVertsInMesh * sizeof(BlendshapeOffsetUnpacked));
 
         // for each blendshape in this mesh, accumulate the offsets into unpackedBlendshapeOffsets.
         const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-        for (int i = 0, n = qMin(_blendshapeCoefficients.size(), meshIter->blendshapes.size()); i < n; i++) {
-            float vertexCoefficient = _blendshapeCoefficients.at(i);
+        const auto& meshStreams = streams[meshIndex];
+        for (int i = 0, n = qMin(blend.blendshapeCoefficients.size(), (int)meshStreams.size()); i < n; i++) {
+            float vertexCoefficient = blend.blendshapeCoefficients.at(i);
             const float EPSILON = 0.0001f;
             if (vertexCoefficient < EPSILON) {
                 continue;
             }
 
             float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
-            const HFMBlendshape& blendshape = meshIter->blendshapes.at(i);
-            for (int j = 0; j < blendshape.indices.size(); ++j) {
-                int index = blendshape.indices.at(j);
-
-                auto& currentBlendshapeOffset = unpackedBlendshapeOffsets[index];
-                currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
-                currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
-                if (j < blendshape.tangents.size()) {
-                    currentBlendshapeOffset.tangentOffset += blendshape.tangents.at(j) * normalCoefficient;
-                }
-            }
+            accumulateBlendshapeOffsets(_unpackedBlendshapeOffsets.data(), meshStreams[i], vertexCoefficient, normalCoefficient);
         }
 
         // convert unpackedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
-        auto unpacked = unpackedBlendshapeOffsets.data();
+        auto unpacked = _unpackedBlendshapeOffsets.data();
         auto packed = packedBlendshapeOffsets.data() + offset;
         packBlendshapeOffsets(unpacked, packed, numVertsInMesh);
 
@@ -1940,15 +1965,14 @@ void Blender::run() {
 
     // post the result to the ModelBlender, which will dispatch to the model if still alive
     QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
-                              Q_ARG(ModelPointer, _model), Q_ARG(int, _blendNumber),
+                              Q_ARG(ModelPointer, blend.model), Q_ARG(int, blend.blendNumber),
                               Q_ARG(QVector<BlendshapeOffset>, packedBlendshapeOffsets),
                               Q_ARG(QVector<int>, blendedMeshSizes));
 }
 
-bool Model::maybeStartBlender() {
+bool Model::maybeAddToBlender(Blender& blender) {
     if (isLoaded()) {
-        QThreadPool::globalInstance()->start(new Blender(getThisPointer(), getGeometry()->getConstHFMModelPointer(),
-                                                         ++_blendNumber, _blendshapeCoefficients));
+        blender.addBlend({ getThisPointer(), getGeometry()->getConstHFMModelPointer(), ++_blendNumber, _blendshapeCoefficients });
         return true;
     }
     return false;
@@ -1969,17 +1993,28 @@ void ModelBlender::noteRequiresBlend(ModelPointer model) {
     }
 
     if (_pendingBlenders < QThread::idealThreadCount()) {
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                return;
-            }
+        startBlender();
+    }
+}
+
+void ModelBlender::startBlender() {
+    auto blender = new Blender();
+    while (!_modelsRequiringBlendsQueue.empty() && blender->getNumBlends() < MAX_BLENDS_PER_BLENDER) {
+        auto weakPtr = _modelsRequiringBlendsQueue.front();
+        _modelsRequiringBlendsQueue.pop();
+        _modelsRequiringBlendsSet.erase(weakPtr);
+        ModelPointer nextModel = weakPtr.lock();
+        if (nextModel) {
+            nextModel->maybeAddToBlender(*blender);
         }
     }
+
+    if (blender->isEmpty()) {
+        delete blender;
+        return;
+    }
+    _pendingBlenders++;
+    QThreadPool::globalInstance()->start(blender);
 }
 
 void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes) {
@@ -1989,19 +2024,56 @@ void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVect
             blendshapeOperator(blendNumber, blendshapeOffsets, blendedMeshSizes, model->fetchRenderItemIDs());
         }
     }
+}
+
+void ModelBlender::blenderFinished() {
+    Lock lock(_mutex);
+    _pendingBlenders--;
+    startBlender();
+}
 
+std::shared_ptr<const ModelBlender::BlendshapeStreams> ModelBlender::getBlendshapeStreams(const HFMModel::ConstPointer& hfmModel) {
     {
-        Lock lock(_mutex);
-        _pendingBlenders--;
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                break;
+        Lock lock(_streamsMutex);
+        auto iter = _blendshapeStreams.find(hfmModel.get());
+        if (iter != _blendshapeStreams.end() && !iter->second.hfmModel.expired()) {
+            return iter->second.streams;
+        }
+    }
+
+    // build outside of the lock, two blenders may race to build the same model but only one result is kept
+    auto streams = std::make_shared<BlendshapeStreams>(hfmModel->meshes.size());
+    for (int meshIndex = 0; meshIndex < hfmModel->meshes.size(); meshIndex++) {
+        const HFMMesh& mesh = hfmModel->meshes.at(meshIndex);
+        auto& meshStreams = (*streams)[meshIndex];
+        meshStreams.resize(mesh.blendshapes.size());
+        for (int i = 0; i < mesh.blendshapes.size(); i++) {
+            const HFMBlendshape& blendshape = mesh.blendshapes.at(i);
+            auto& stream = meshStreams[i];
+            int numIndices = blendshape.indices.size();
+            stream.indices.assign(blendshape.indices.cbegin(), blendshape.indices.cend());
+            stream.offsets.resize(numIndices);
+            for (int j = 0; j < numIndices; j++) {
+                auto& streamOffset = stream.offsets[j];
+                streamOffset.positionOffset = blendshape.vertices.at(j);
+                streamOffset.normalOffset = blendshape.normals.at(j);
+                streamOffset.tangentOffset = j < blendshape.tangents.size() ? blendshape.tangents.at(j) : glm::vec3(0.0f);
             }
         }
     }
+
+    Lock lock(_streamsMutex);
+    for (auto iter = _blendshapeStreams.begin(); iter != _blendshapeStreams.end();) {
+        if (iter->second.hfmModel.expired()) {
+            iter = _blendshapeStreams.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    auto& entry = _blendshapeStreams[hfmModel.get()];
+    if (!entry.streams) {
+        entry.hfmModel = hfmModel;
+        entry.streams = streams;
+    }
+    return entry.streams;
 }
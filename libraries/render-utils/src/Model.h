@@ -22,6 +22,7 @@
 #include <functional>
 
 #include <AABox.h>
+#include <BlendshapeAccumulation.h>
 #include <DependencyManager.h>
 #include <GeometryUtil.h>
 #include <gpu/Batch.h>
@@ -54,6 +55,7 @@ namespace render {
     class Transaction;
     typedef unsigned int ItemID;
 }
+class Blender;
 class MeshPartPayload;
 class ModelMeshPartPayload;
 class ModelRenderLocations;
@@ -162,7 +164,7 @@ public:
     AABox getRenderableMeshBound() const;
     const render::ItemIDs& fetchRenderItemIDs() const;
 
-    bool maybeStartBlender();
+    bool maybeAddToBlender(Blender& blender);
 
     bool isLoaded() const { return (bool)_renderGeometry && _renderGeometry->isHFMModelLoaded(); }
     bool isAddedToScene() const { return _addedToScene; }
@@ -448,6 +450,7 @@ protected:
 
     bool _overrideModelTransform { false };
     bool _triangleSetsValid { false };
+    bool _triangleSetsNeedRebuild { true }; // set when the geometry changes, so the sets of the old one aren't refit
     void calculateTriangleSets(const HFMModel& hfmModel);
     std::vector<std::vector<TriangleSet>> _modelSpaceMeshTriangleSets; // model space triangles for all sub meshes
 
@@ -531,22 +534,44 @@ public:
 
     bool shouldComputeBlendshapes() { return _computeBlendshapes; }
 
+    /// The blendshapes of every mesh of a model, as streams ready for accumulation: [mesh][blendshape].
+    using BlendshapeStreams = std::vector<std::vector<BlendshapeStream>>;
+
+    /// Returns the streams of the model, building them the first time the model is blended.
+    std::shared_ptr<const BlendshapeStreams> getBlendshapeStreams(const HFMModel::ConstPointer& hfmModel);
+
 public slots:
     void setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes);
     void setComputeBlendshapes(bool computeBlendshapes) { _computeBlendshapes = computeBlendshapes; }
 
+private slots:
+    void blenderFinished();
+
 private:
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
 
+    // models blended by a single job, so crowds of animated faces don't queue one job per model
+    static const int MAX_BLENDS_PER_BLENDER = 16;
+
     ModelBlender();
     virtual ~ModelBlender();
 
+    // takes the next models from the queue, must be called with _mutex held
+    void startBlender();
+
     std::queue<ModelWeakPointer> _modelsRequiringBlendsQueue;
     std::set<ModelWeakPointer, std::owner_less<ModelWeakPointer>> _modelsRequiringBlendsSet;
     int _pendingBlenders;
     Mutex _mutex;
 
+    struct BlendshapeStreamsEntry {
+        std::weak_ptr<const HFMModel> hfmModel;
+        std::shared_ptr<const BlendshapeStreams> streams;
+    };
+    std::unordered_map<const HFMModel*, BlendshapeStreamsEntry> _blendshapeStreams;
+    Mutex _streamsMutex;
+
     bool _computeBlendshapes { true };
 };
 
@@ -0,0 +1,91 @@
+//
+//  CullBatch_avx2.cpp
+//  render/src/avx2
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+// Must match render::CullBatch
+static const int NUM_PLANES = 6;
+static const uint8_t TEST_FRUSTUM = 0x01;
+static const uint8_t TEST_LOD_ANGLE = 0x02;
+static const uint8_t RESULT_OUT_OF_VIEW = 1;
+static const uint8_t RESULT_TOO_SMALL = 2;
+
+// Returns the number of bounds processed, a multiple of 8
+int cullBounds_AVX2(const float (*constants)[4], const float* bounds[6], uint8_t tests, uint8_t* results, int size) {
+
+    const bool testFrustum = (tests & TEST_FRUSTUM) != 0;
+    const bool testLODAngle = (tests & TEST_LOD_ANGLE) != 0;
+
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 quarter = _mm256_set1_ps(0.25f);
+    const __m256 eyeX = _mm256_set1_ps(constants[NUM_PLANES][0]);
+    const __m256 eyeY = _mm256_set1_ps(constants[NUM_PLANES][1]);
+    const __m256 eyeZ = _mm256_set1_ps(constants[NUM_PLANES][2]);
+    const __m256 lodAngle = _mm256_set1_ps(constants[NUM_PLANES][3]);
+
+    int i = 0;
+    for (; i < size - 7; i += 8) {  // blocks of 8
+
+        __m256 corner[3] = { _mm256_loadu_ps(&bounds[0][i]), _mm256_loadu_ps(&bounds[1][i]), _mm256_loadu_ps(&bounds[2][i]) };
+        __m256 scale[3] = { _mm256_loadu_ps(&bounds[3][i]), _mm256_loadu_ps(&bounds[4][i]), _mm256_loadu_ps(&bounds[5][i]) };
+
+        //
+        // frustum: distance to the farthest box point along each plane normal
+        //
+        __m256 outOfView = _mm256_setzero_ps();
+        if (testFrustum) {
+            __m256 farthest[3] = { _mm256_add_ps(corner[0], scale[0]), _mm256_add_ps(corner[1], scale[1]), _mm256_add_ps(corner[2], scale[2]) };
+            for (int p = 0; p < NUM_PLANES; p++) {
+                const float* plane = constants[p];
+                __m256 x = plane[0] > 0.0f ? farthest[0] : corner[0];
+                __m256 y = plane[1] > 0.0f ? farthest[1] : corner[1];
+                __m256 z = plane[2] > 0.0f ? farthest[2] : corner[2];
+
+                __m256 distance = _mm256_mul_ps(_mm256_set1_ps(plane[0]), x);
+                distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane[1]), y));
+                distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane[2]), z));
+                distance = _mm256_add_ps(distance, _mm256_set1_ps(plane[3]));
+
+                outOfView = _mm256_or_ps(outOfView, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_LT_OQ));
+            }
+        }
+
+        //
+        // lod angle: half diagonal of the bound against its distance to the eye
+        //
+        __m256 tooSmall = _mm256_setzero_ps();
+        if (testLODAngle) {
+            __m256 toCenterX = _mm256_sub_ps(eyeX, _mm256_add_ps(corner[0], _mm256_mul_ps(scale[0], half)));
+            __m256 toCenterY = _mm256_sub_ps(eyeY, _mm256_add_ps(corner[1], _mm256_mul_ps(scale[1], half)));
+            __m256 toCenterZ = _mm256_sub_ps(eyeZ, _mm256_add_ps(corner[2], _mm256_mul_ps(scale[2], half)));
+
+            __m256 adjacentSq = _mm256_mul_ps(toCenterX, toCenterX);
+            adjacentSq = _mm256_add_ps(adjacentSq, _mm256_mul_ps(toCenterY, toCenterY));
+            adjacentSq = _mm256_add_ps(adjacentSq, _mm256_mul_ps(toCenterZ, toCenterZ));
+            __m256 oppositeSq = _mm256_mul_ps(scale[0], scale[0]);
+            oppositeSq = _mm256_add_ps(oppositeSq, _mm256_mul_ps(scale[1], scale[1]));
+            oppositeSq = _mm256_add_ps(oppositeSq, _mm256_mul_ps(scale[2], scale[2]));
+
+            tooSmall = _mm256_cmp_ps(_mm256_mul_ps(quarter, oppositeSq), _mm256_mul_ps(lodAngle, adjacentSq), _CMP_LT_OQ);
+        }
+
+        int outOfViewMask = _mm256_movemask_ps(outOfView);
+        int tooSmallMask = _mm256_movemask_ps(tooSmall);
+        for (int j = 0; j < 8; j++) {
+            results[i + j] = ((outOfViewMask >> j) & 1) ? RESULT_OUT_OF_VIEW : (((tooSmallMask >> j) & 1) ? RESULT_TOO_SMALL : 0);
+        }
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+#endif
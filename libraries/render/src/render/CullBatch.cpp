@@ -0,0 +1,133 @@
+//
+//  CullBatch.cpp
+//  render/src/render
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullBatch.h"
+
+#include <Plane.h>
+
+using namespace render;
+
+void BoundsSoA::reserve(size_t size) {
+    cornerX.reserve(size);
+    cornerY.reserve(size);
+    cornerZ.reserve(size);
+    scaleX.reserve(size);
+    scaleY.reserve(size);
+    scaleZ.reserve(size);
+}
+
+void BoundsSoA::clear() {
+    cornerX.clear();
+    cornerY.clear();
+    cornerZ.clear();
+    scaleX.clear();
+    scaleY.clear();
+    scaleZ.clear();
+}
+
+void BoundsSoA::push_back(const AABox& bound) {
+    const glm::vec3& corner = bound.getCorner();
+    const glm::vec3& scale = bound.getScale();
+    cornerX.push_back(corner.x);
+    cornerY.push_back(corner.y);
+    cornerZ.push_back(corner.z);
+    scaleX.push_back(scale.x);
+    scaleY.push_back(scale.y);
+    scaleZ.push_back(scale.z);
+}
+
+CullBatch::CullBatch(const ViewFrustum& frustum, float lodAngleHalfTanSq) {
+    const ::Plane* planes = frustum.getPlanes();
+    for (int i = 0; i < NUM_PLANES; i++) {
+        const glm::vec3& normal = planes[i].getNormal();
+        _constants[i][0] = normal.x;
+        _constants[i][1] = normal.y;
+        _constants[i][2] = normal.z;
+        _constants[i][3] = planes[i].getDCoefficient();
+    }
+    const glm::vec3& eye = frustum.getPosition();
+    _constants[NUM_PLANES][0] = eye.x;
+    _constants[NUM_PLANES][1] = eye.y;
+    _constants[NUM_PLANES][2] = eye.z;
+    _constants[NUM_PLANES][3] = lodAngleHalfTanSq;
+}
+
+// The bounds are the arrays { cornerX, cornerY, cornerZ, scaleX, scaleY, scaleZ },
+// evaluated in the same order as AABox and ViewFrustum do so the results match exactly
+static void cullBounds_ref(const CullBatch::Constants& constants, const float* bounds[6], uint8_t tests,
+                           uint8_t* results, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        const float corner[3] = { bounds[0][i], bounds[1][i], bounds[2][i] };
+        const float scale[3] = { bounds[3][i], bounds[4][i], bounds[5][i] };
+
+        uint8_t result = CullBatch::VISIBLE;
+        if (tests & CullBatch::FRUSTUM) {
+            for (int p = 0; p < CullBatch::NUM_PLANES; p++) {
+                // distance to the farthest box point along the plane normal
+                const float* plane = constants[p];
+                float distance = 0.0f;
+                for (int axis = 0; axis < 3; axis++) {
+                    distance += plane[axis] * (plane[axis] > 0.0f ? corner[axis] + scale[axis] : corner[axis]);
+                }
+                if (distance + plane[3] < 0.0f) {
+                    result = CullBatch::OUT_OF_VIEW;
+                    break;
+                }
+            }
+        }
+        if (result == CullBatch::VISIBLE && (tests & CullBatch::LOD_ANGLE)) {
+            const float* eye = constants[CullBatch::NUM_PLANES];
+            float halfTanAdjacentSq = 0.0f;
+            float halfTanOppositeSq = 0.0f;
+            for (int axis = 0; axis < 3; axis++) {
+                float toCenter = eye[axis] - (corner[axis] + scale[axis] * 0.5f);
+                halfTanAdjacentSq += toCenter * toCenter;
+                halfTanOppositeSq += scale[axis] * scale[axis];
+            }
+            if (0.25f * halfTanOppositeSq < eye[3] * halfTanAdjacentSq) {
+                result = CullBatch::TOO_SMALL;
+            }
+        }
+        results[i] = result;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include <CPUDetect.h>
+
+int cullBounds_AVX2(const float (*constants)[4], const float* bounds[6], uint8_t tests, uint8_t* results, int size);
+
+static void cullBounds(const CullBatch::Constants& constants, const float* bounds[6], uint8_t tests, uint8_t* results, int size) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    int done = 0;
+    if (_cpuSupportsAVX2) {
+        // the kernel handles blocks of 8, the remainder goes through the reference code
+        done = cullBounds_AVX2(constants, bounds, tests, results, size);
+    }
+    cullBounds_ref(constants, bounds, tests, results, done, size);
+}
+
+#else   // portable reference code
+static void cullBounds(const CullBatch::Constants& constants, const float* bounds[6], uint8_t tests, uint8_t* results, int size) {
+    cullBounds_ref(constants, bounds, tests, results, 0, size);
+}
+#endif
+
+void CullBatch::cull(const BoundsSoA& bounds, uint8_t tests, std::vector<uint8_t>& results) const {
+    int size = (int)bounds.size();
+    results.resize(size);
+    if (size == 0) {
+        return;
+    }
+    const float* arrays[6] = { bounds.cornerX.data(), bounds.cornerY.data(), bounds.cornerZ.data(),
+                               bounds.scaleX.data(), bounds.scaleY.data(), bounds.scaleZ.data() };
+    cullBounds(_constants, arrays, tests, results.data(), size);
+}
@@ -0,0 +1,67 @@
+//
+//  CullBatch.h
+//  render/src/render
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_CullBatch_h
+#define hifi_render_CullBatch_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <AABox.h>
+#include <ViewFrustum.h>
+
+namespace render {
+
+    // Item bounds laid out as a structure of arrays, so they can be culled 8 at a time.
+    // Like AABox, a bound is stored as its corner and scale.
+    class BoundsSoA {
+    public:
+        std::vector<float> cornerX;
+        std::vector<float> cornerY;
+        std::vector<float> cornerZ;
+        std::vector<float> scaleX;
+        std::vector<float> scaleY;
+        std::vector<float> scaleZ;
+
+        size_t size() const { return cornerX.size(); }
+
+        void reserve(size_t size);
+        void clear();
+        void push_back(const AABox& bound);
+    };
+
+    // Frustum and lod angle tests of a batch of bounds,
+    // giving the same answers as ViewFrustum::boxIntersectsFrustum and CullTest::lodAngleTest
+    class CullBatch {
+    public:
+        enum Tests : uint8_t {
+            FRUSTUM = 0x01,
+            LOD_ANGLE = 0x02,
+        };
+
+        enum Result : uint8_t {
+            VISIBLE = 0,
+            OUT_OF_VIEW,
+            TOO_SMALL,
+        };
+
+        CullBatch(const ViewFrustum& frustum, float lodAngleHalfTanSq);
+
+        // Write one Result per bound, the lod angle is only tested on the bounds in view
+        void cull(const BoundsSoA& bounds, uint8_t tests, std::vector<uint8_t>& results) const;
+
+        // The planes as { normal.x, normal.y, normal.z, d } followed by { eye.x, eye.y, eye.z, lodAngleHalfTanSq }
+        static const int NUM_PLANES = NUM_FRUSTUM_PLANES;
+        using Constants = float[NUM_PLANES + 1][4];
+
+    private:
+        Constants _constants;
+    };
+}
+
+#endif // hifi_render_CullBatch_h
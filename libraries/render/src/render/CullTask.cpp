@@ -71,6 +71,37 @@ bool CullTest::zoneOcclusionTest(const render::Item& item) {
     return item.passesZoneOcclusionTest(_containingZones);
 }
 
+bool CullTest::lodAngleTest(const RenderArgs* args, const AABox& bounds) {
+    // To decide if the bound should be rendered or not at the specified Args->lodAngle,
+    // we need to compute the apparent angle of the bound from the frustum origin,
+    // and compare it against the lodAngle, if it is greater or equal we should render the content of that bound.
+    // we abstract the bound as a sphere centered on the bound center and of radius half diagonal of the bound.
+
+    // Instead of comparing  angles, we are comparing the tangent of the half angle which are more efficient to compute:
+    // we are comparing the square of the half tangent apparent angle for the bound against the LODAngle Half tangent square
+    // if smaller, the bound is too small and we should NOT render it, return true otherwise.
+
+    // Tangent Adjacent side is eye to bound center vector length
+    auto pos = args->getViewFrustum().getPosition() - bounds.calcCenter();
+    auto halfTanAdjacentSq = glm::dot(pos, pos);
+
+    // Tangent Opposite side is the half length of the dimensions vector of the bound
+    auto dim = bounds.getDimensions();
+    auto halfTanOppositeSq = 0.25f * glm::dot(dim, dim);
+
+    // The test is:
+    // isVisible = halfTanSq >= lodHalfTanSq = (halfTanOppositeSq / halfTanAdjacentSq) >= lodHalfTanSq
+    // which we express as below to avoid division
+    // (halfTanOppositeSq) >= lodHalfTanSq * halfTanAdjacentSq
+    return (halfTanOppositeSq >= args->_lodAngleHalfTanSq * halfTanAdjacentSq);
+}
+
+bool CullTest::isLODAngleTest(const CullFunctor& functor) {
+    using CullFunction = bool(*)(const RenderArgs*, const AABox&);
+    auto function = functor.target<CullFunction>();
+    return function && (*function == &CullTest::lodAngleTest);
+}
+
 void FetchNonspatialItems::run(const RenderContextPointer& renderContext, const ItemFilter& filter, ItemBounds& outItems) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -259,55 +290,24 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                 }
             }
 
+            CullBatch batch(args->getViewFrustum(), args->_lodAngleHalfTanSq);
+
             // inside & subcell items: filter & distance cull
             {
                 PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
+                cullItems(renderContext, inSelection.insideSubcellItems, filter, batch, CullBatch::LOD_ANGLE, test, outItems);
             }
 
             // partial & fit items: filter & frustum cull
             {
                 PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
+                cullItems(renderContext, inSelection.partialItems, filter, batch, CullBatch::FRUSTUM, test, outItems);
             }
 
             // partial & subcell items:: filter & frutum cull & solidangle cull
             {
                 PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound) && test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
+                cullItems(renderContext, inSelection.partialSubcellItems, filter, batch, CullBatch::FRUSTUM | CullBatch::LOD_ANGLE, test, outItems);
             }
         }
     }
@@ -322,6 +322,54 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     std::static_pointer_cast<Config>(renderContext->jobConfig)->numItems = (int)outItems.size();
 }
 
+void CullSpatialSelection::cullItems(const RenderContextPointer& renderContext, const ItemIDs& inItems, const ItemFilter& filter,
+                                     const CullBatch& batch, uint8_t tests, CullTest& test, ItemBounds& outItems) {
+    RenderArgs* args = renderContext->args;
+    auto& scene = renderContext->_scene;
+
+    // Gather the bounds of the items passing the filter
+    _candidates.clear();
+    _candidateBounds.clear();
+    _candidates.reserve(inItems.size());
+    _candidateBounds.reserve(inItems.size());
+    for (auto id : inItems) {
+        auto& item = scene->getItem(id);
+        if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
+            _candidates.emplace_back(ItemBound(id, item.getBound(args)));
+            _candidateBounds.push_back(_candidates.back().bound);
+        }
+    }
+
+    // Cull them all at once, the solid angle test goes through the functor if it isn't the lod angle
+    bool functorTest = (tests & CullBatch::LOD_ANGLE) && !_batchLODAngle;
+    if (functorTest) {
+        tests = (uint8_t)(tests & ~CullBatch::LOD_ANGLE);
+    }
+    batch.cull(_candidateBounds, tests, _cullResults);
+
+    for (size_t i = 0; i < _candidates.size(); i++) {
+        const auto& itemBound = _candidates[i];
+        switch (_cullResults[i]) {
+            case CullBatch::OUT_OF_VIEW:
+                test._renderDetails._outOfView++;
+                continue;
+            case CullBatch::TOO_SMALL:
+                test._renderDetails._tooSmall++;
+                continue;
+            default:
+                break;
+        }
+        if (functorTest && !test.solidAngleTest(itemBound.bound)) {
+            continue;
+        }
+        outItems.emplace_back(itemBound);
+        auto& item = scene->getItem(itemBound.id);
+        if (item.getKey().isMetaCullGroup()) {
+            item.fetchMetaSubItemBounds(outItems, (*scene), args);
+        }
+    }
+}
+
 void CullShapeBounds::run(const RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -14,6 +14,7 @@
 
 #include "Engine.h"
 #include "ViewFrustum.h"
+#include "CullBatch.h"
 
 namespace render {
 
@@ -35,6 +36,10 @@ namespace render {
         bool solidAngleTest(const AABox& bound);
         bool zoneOcclusionTest(const render::Item& item);
 
+        // The default solid angle test, culling the bounds whose apparent size is under the args lod angle
+        static bool lodAngleTest(const RenderArgs* args, const AABox& bounds);
+        static bool isLODAngleTest(const CullFunctor& functor);
+
         static std::unordered_set<QUuid> _containingZones;
         static std::unordered_set<QUuid> _prevContainingZones;
     };
@@ -106,7 +111,8 @@ namespace render {
         CullSpatialSelection(CullFunctor cullFunctor, bool skipCulling, RenderDetails::Type type) :
             _cullFunctor(cullFunctor),
             _skipCulling(skipCulling),
-            _detailType(type) {}
+            _detailType(type),
+            _batchLODAngle(CullTest::isLODAngleTest(cullFunctor)) {}
 
         CullFunctor _cullFunctor;
         bool _skipCulling { false };
@@ -119,6 +125,18 @@ namespace render {
 
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext, const Inputs& inputs, ItemBounds& outItems);
+
+    protected:
+        // The lod angle test runs in the batch when the functor is CullTest::lodAngleTest, else through the functor
+        bool _batchLODAngle { false };
+
+        // Scratch buffers of the batch cull, kept between frames
+        ItemBounds _candidates;
+        BoundsSoA _candidateBounds;
+        std::vector<uint8_t> _cullResults;
+
+        void cullItems(const RenderContextPointer& renderContext, const ItemIDs& inItems, const ItemFilter& filter,
+                       const CullBatch& batch, uint8_t tests, CullTest& test, ItemBounds& outItems);
     };
 
     class CullShapeBounds {
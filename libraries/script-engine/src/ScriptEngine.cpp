@@ -223,11 +223,12 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
     BaseScriptEngine(),
     _context(context),
     _scriptContents(scriptContents),
-    _timerFunctionMap(),
     _fileNameString(fileNameString),
     _arrayBufferClass(new ArrayBufferClass(this)),
     _assetScriptingInterface(new AssetScriptingInterface(this))
 {
+    _timerClock.start();
+
     switch (_context) {
         case Context::CLIENT_SCRIPT:
             _type = Type::CLIENT;
@@ -1234,12 +1235,22 @@ void ScriptEngine::run() {
             std::chrono::milliseconds sleepFor =
                 std::chrono::duration_cast<std::chrono::milliseconds>(sleepUntil - clock::now());
             if (sleepFor > std::chrono::milliseconds(0)) {
-                QEventLoop loop;
-                QTimer timer;
-                timer.setSingleShot(true);
-                connect(&timer, SIGNAL(timeout()), &loop, SLOT(quit()));
-                timer.start(sleepFor.count());
-                loop.exec();
+                // wake up early for the script timers that come due before the next frame
+                do {
+                    sleepFor = std::min(sleepFor, getTimeToNextTimer());
+                    if (sleepFor > std::chrono::milliseconds(0)) {
+                        QEventLoop loop;
+                        QTimer timer;
+                        timer.setSingleShot(true);
+                        connect(&timer, SIGNAL(timeout()), &loop, SLOT(quit()));
+                        timer.start(sleepFor.count());
+                        loop.exec();
+                    } else {
+                        QCoreApplication::processEvents();
+                    }
+                    dispatchTimers();
+                    sleepFor = std::chrono::duration_cast<std::chrono::milliseconds>(sleepUntil - clock::now());
+                } while (sleepFor > std::chrono::milliseconds(0) && !_isFinished);
             } else {
                 QCoreApplication::processEvents();
             }
@@ -1279,6 +1290,12 @@ void ScriptEngine::run() {
             break;
         }
 
+        dispatchTimers();
+
+        if (_isFinished) {
+            break;
+        }
+
         if (!_isFinished && entityScriptingInterface->getEntityPacketSender()->serversExist()) {
             // release the queue of edit entity messages.
             entityScriptingInterface->getEntityPacketSender()->releaseQueuedMessages();
@@ -1349,32 +1366,31 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
-        qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
-        stopTimer(timer);
+    if (!_timers.empty()) {
+        qCDebug(scriptengine) << getFilename() << "stopAllTimers" << _timers.size();
     }
+    _timers.clear();
+    _entityTimers.clear();
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
-            continue;
-        }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
-    }
-    for (auto timer:toDelete) { // now reap 'em
-        stopTimer(timer);
+    auto timers = _entityTimers.take(entityID);
+    for (auto timer : timers) {
+        _timers.stop(timer);
     }
+}
 
+void ScriptEngine::forgetEntityTimer(const EntityItemID& entityID, ScriptTimerID timer) {
+    if (entityID.isNull()) {
+        return;
+    }
+    auto entityTimers = _entityTimers.find(entityID);
+    if (entityTimers != _entityTimers.end()) {
+        entityTimers->remove(timer);
+        if (entityTimers->isEmpty()) {
+            _entityTimers.erase(entityTimers);
+        }
+    }
 }
 
 void ScriptEngine::stop(bool marshal) {
@@ -1427,88 +1443,94 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
+// Fires, in one batch, all the timers that came due since the last call.
+void ScriptEngine::dispatchTimers() {
+    if (_timers.empty()) {
+        return;
+    }
+
     {
         QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
         if (!scriptEngines || scriptEngines->isStopped()) {
-            scriptWarningMessage("Script.timerFired() while shutting down is ignored... parent script:" + getFilename());
-            return; // bail early
+            return; // the timers are about to be stopped with the script
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
-
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
+    PROFILE_RANGE(script, __FUNCTION__);
+    auto preTimer = p_high_resolution_clock::now();
+    int fired = _timers.advance(getTimerTime(), [this](ScriptTimerID timer, const CallbackData& timerData) {
+        if (!_timers.isActive(timer)) {
+            // single shot timers are done once they fire
+            forgetEntityTimer(timerData.definingEntityIdentifier, timer);
+        }
+        if (_isFinished) {
+            return;
+        }
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+        } else {
+            qCWarning(scriptengine) << "dispatchTimers -- invalid function" << timerData.function.toVariant().toString();
+        }
+    });
+    if (fired > 0) {
         auto postTimer = p_high_resolution_clock::now();
         auto elapsed = (postTimer - preTimer);
         _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
     }
 }
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
-
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
+std::chrono::milliseconds ScriptEngine::getTimeToNextTimer() const {
+    uint64_t nextExpiry = _timers.nextExpiry();
+    if (nextExpiry == ScriptTimers::NO_EXPIRY) {
+        return std::chrono::milliseconds::max();
     }
+    uint64_t now = getTimerTime();
+    return std::chrono::milliseconds(nextExpiry > now ? (int64_t)(nextExpiry - now) : 0);
+}
 
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
-
-
+QScriptValue ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
     CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
+    ScriptTimerID timer = _timers.start(getTimerTime(), intervalMS, !isSingleShot, timerData);
+    if (!currentEntityIdentifier.isNull()) {
+        _entityTimers[currentEntityIdentifier].insert(timer);
+    }
 
-    newTimer->start(intervalMS);
-    return newTimer;
+    // timer ids stay below 2^53, so they are exact as javascript numbers
+    return QScriptValue((double)timer);
 }
 
-QObject* ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
+QScriptValue ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
     QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
     if (!scriptEngines || scriptEngines->isStopped()) {
         scriptWarningMessage("Script.setInterval() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return QScriptValue(QScriptValue::NullValue); // bail early
     }
 
     return setupTimerWithInterval(function, intervalMS, false);
 }
 
-QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
+QScriptValue ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
     if (!scriptEngines || scriptEngines->isStopped()) {
         scriptWarningMessage("Script.setTimeout() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return QScriptValue(QScriptValue::NullValue); // bail early
     }
 
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
-        delete timer;
-    } else {
-        qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
+void ScriptEngine::stopTimer(const QScriptValue& timer) {
+    // like in browsers, clearing a timer that already fired, or something that is not a timer, does nothing
+    if (!timer.isNumber() || timer.toNumber() < 1.0) {
+        return;
+    }
+    ScriptTimerID timerID = (ScriptTimerID)timer.toNumber();
+    const CallbackData* timerData = _timers.getPayload(timerID);
+    if (timerData) {
+        forgetEntityTimer(timerData->definingEntityIdentifier, timerID);
+        _timers.stop(timerID);
     }
 }
 
@@ -2101,6 +2123,13 @@ int ScriptEngine::getNumRunningEntityScripts() const {
     return sum;
 }
 
+QHash<EntityItemID, std::chrono::microseconds> ScriptEngine::takeEntityScriptExecutionTimes() {
+    QHash<EntityItemID, std::chrono::microseconds> times;
+    std::lock_guard<std::mutex> lock(_entityScriptExecutionTimesLock);
+    times.swap(_entityScriptExecutionTimes);
+    return times;
+}
+
 void ScriptEngine::setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details) {
     {
         QWriteLocker locker { &_entityScriptsLock };
@@ -2676,6 +2705,10 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     currentEntityIdentifier = entityID;
     currentSandboxURL = sandboxURL;
 
+    // only the outermost entity script is charged for the time
+    bool isExecutionTimed = !entityID.isNull() && oldIdentifier.isNull();
+    auto executionStart = isExecutionTimed ? p_high_resolution_clock::now() : p_high_resolution_clock::time_point();
+
 #if DEBUG_CURRENT_ENTITY
     QScriptValue oldData = this->globalObject().property("debugEntityID");
     this->globalObject().setProperty("debugEntityID", entityID.toScriptValue(this)); // Make the entityID available to javascript as a global.
@@ -2687,6 +2720,12 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     maybeEmitUncaughtException(!entityID.isNull() ? entityID.toString() : __FUNCTION__);
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
+
+    if (isExecutionTimed) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - executionStart);
+        std::lock_guard<std::mutex> lock(_entityScriptExecutionTimesLock);
+        _entityScriptExecutionTimes[entityID] += elapsed;
+    }
 }
 
 void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args) {
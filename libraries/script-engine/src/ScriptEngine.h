@@ -17,9 +17,12 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <chrono>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QSet>
@@ -39,6 +42,7 @@
 #include <EntityItemID.h>
 #include <EntitiesScriptEngineProvider.h>
 #include <EntityScriptUtils.h>
+#include <shared/TimerWheel.h>
 
 #include "PointerEvent.h"
 #include "ArrayBufferClass.h"
@@ -90,6 +94,9 @@ struct EntityScriptContentAvailable {
 
 typedef std::unordered_map<EntityItemID, EntityScriptContentAvailable> EntityScriptContentAvailableMap;
 
+using ScriptTimers = TimerWheel<CallbackData>;
+using ScriptTimerID = ScriptTimers::TimerID;
+
 typedef QList<CallbackData> CallbackList;
 typedef QHash<QString, CallbackList> RegisteredEventHandlers;
 
@@ -472,31 +479,31 @@ public:
      * @function Script.setInterval
      * @param {function} function - The function to call. This can be either the name of a function or an in-line definition.
      * @param {number} interval - The interval at which to call the function, in ms.
-     * @returns {object} A handle to the interval timer. This can be used in {@link Script.clearInterval}.
+     * @returns {number} A handle to the interval timer. This can be used in {@link Script.clearInterval}.
      * @example <caption>Print a message every second.</caption>
      * Script.setInterval(function () {
      *     print("Interval timer fired");
      * }, 1000);
     */
-    Q_INVOKABLE QObject* setInterval(const QScriptValue& function, int intervalMS);
+    Q_INVOKABLE QScriptValue setInterval(const QScriptValue& function, int intervalMS);
 
     /*@jsdoc
      * Calls a function once, after a delay.
      * @function Script.setTimeout
      * @param {function} function - The function to call. This can be either the name of a function or an in-line definition.
      * @param {number} timeout - The delay after which to call the function, in ms.
-     * @returns {object} A handle to the timeout timer. This can be used in {@link Script.clearTimeout}.
+     * @returns {number} A handle to the timeout timer. This can be used in {@link Script.clearTimeout}.
      * @example <caption>Print a message once, after a second.</caption>
      * Script.setTimeout(function () {
      *     print("Timeout timer fired");
      * }, 1000);
      */
-    Q_INVOKABLE QObject* setTimeout(const QScriptValue& function, int timeoutMS);
+    Q_INVOKABLE QScriptValue setTimeout(const QScriptValue& function, int timeoutMS);
 
     /*@jsdoc
      * Stops an interval timer set by {@link Script.setInterval|setInterval}.
      * @function Script.clearInterval
-     * @param {object} timer - The interval timer to stop.
+     * @param {number} timer - The interval timer to stop.
      * @example <caption>Stop an interval timer.</caption>
      * // Print a message every second.
      * var timer = Script.setInterval(function () {
@@ -509,12 +516,12 @@ public:
      *     Script.clearInterval(timer);
      * }, 10000);
      */
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(const QScriptValue& timer) { stopTimer(timer); }
 
     /*@jsdoc
      * Stops a timeout timer set by {@link Script.setTimeout|setTimeout}.
      * @function Script.clearTimeout
-     * @param {object} timer - The timeout timer to stop.
+     * @param {number} timer - The timeout timer to stop.
      * @example <caption>Stop a timeout timer.</caption>
      * // Print a message after two seconds.
      * var timer = Script.setTimeout(function () {
@@ -524,7 +531,7 @@ public:
      * // Uncomment the following line to stop the timer from firing.
      * //Script.clearTimeout(timer);
      */
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearTimeout(const QScriptValue& timer) { stopTimer(timer); }
 
     /*@jsdoc
      * Prints a message to the program log and emits {@link Script.printedMessage}.
@@ -691,6 +698,11 @@ public:
     void scriptPrintedMessage(const QString& message);
     void clearDebugLogWindow();
     int getNumRunningEntityScripts() const;
+
+    // Returns the time each entity script spent executing on this engine since the previous call, and resets it.
+    // Nested calls into other entity scripts count towards the script that made them.
+    QHash<EntityItemID, std::chrono::microseconds> takeEntityScriptExecutionTimes();
+
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
 
@@ -936,7 +948,9 @@ protected:
     Q_INVOKABLE QString _requireResolve(const QString& moduleId, const QString& relativeTo = QString());
 
     QString logException(const QScriptValue& exception);
-    void timerFired();
+    void dispatchTimers();
+    std::chrono::milliseconds getTimeToNextTimer() const;
+    uint64_t getTimerTime() const { return (uint64_t)_timerClock.elapsed(); }
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -944,8 +958,9 @@ protected:
     void setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details);
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
 
-    QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    QScriptValue setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
+    void stopTimer(const QScriptValue& timer);
+    void forgetEntityTimer(const EntityItemID& entityID, ScriptTimerID timer);
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -975,7 +990,11 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+    // setTimeout/setInterval timers, dispatched in batches from the run() loop.  The timers of entity scripts are
+    // also indexed by entity so unloading one does not have to visit the timers of all the others.
+    ScriptTimers _timers;
+    QHash<EntityItemID, QSet<ScriptTimerID>> _entityTimers;
+    QElapsedTimer _timerClock;
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
@@ -1005,6 +1024,9 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    std::mutex _entityScriptExecutionTimesLock;
+    QHash<EntityItemID, std::chrono::microseconds> _entityScriptExecutionTimes;
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
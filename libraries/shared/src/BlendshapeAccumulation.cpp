@@ -0,0 +1,55 @@
+//
+//  BlendshapeAccumulation.cpp
+//  libraries/shared/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlendshapeAccumulation.h"
+
+#include <cassert>
+
+static void accumulateBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, const int* indices,
+                                            const BlendshapeOffsetUnpacked* offsets, int size,
+                                            float vertexCoefficient, float normalCoefficient) {
+    for (int i = 0; i < size; ++i) {
+        auto& currentBlendshapeOffset = unpacked[indices[i]];
+        currentBlendshapeOffset.positionOffset += offsets[i].positionOffset * vertexCoefficient;
+        currentBlendshapeOffset.normalOffset += offsets[i].normalOffset * normalCoefficient;
+        currentBlendshapeOffset.tangentOffset += offsets[i].tangentOffset * normalCoefficient;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include <CPUDetect.h>
+
+void accumulateBlendshapeOffsets_AVX2(float (*unpacked)[9], const int* indices, const float (*offsets)[9], int size,
+                                      float vertexCoefficient, float normalCoefficient);
+
+static void accumulateBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, const int* indices,
+                                        const BlendshapeOffsetUnpacked* offsets, int size,
+                                        float vertexCoefficient, float normalCoefficient) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    if (_cpuSupportsAVX2) {
+        static_assert(sizeof(BlendshapeOffsetUnpacked) == 9 * sizeof(float), "struct BlendshapeOffsetUnpacked size doesn't match.");
+        accumulateBlendshapeOffsets_AVX2((float(*)[9])unpacked, indices, (const float(*)[9])offsets, size,
+                                         vertexCoefficient, normalCoefficient);
+    } else {
+        accumulateBlendshapeOffsets_ref(unpacked, indices, offsets, size, vertexCoefficient, normalCoefficient);
+    }
+}
+
+#else   // portable reference code
+static auto& accumulateBlendshapeOffsets = accumulateBlendshapeOffsets_ref;
+#endif
+
+void accumulateBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, const BlendshapeStream& stream,
+                                 float vertexCoefficient, float normalCoefficient) {
+    assert(stream.indices.size() == stream.offsets.size());
+    accumulateBlendshapeOffsets(unpacked, stream.indices.data(), stream.offsets.data(), (int)stream.indices.size(),
+                                vertexCoefficient, normalCoefficient);
+}
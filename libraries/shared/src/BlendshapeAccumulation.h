@@ -0,0 +1,28 @@
+//
+//  BlendshapeAccumulation.h
+//  libraries/shared/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BlendshapeAccumulation_h
+#define hifi_BlendshapeAccumulation_h
+
+#include <vector>
+
+#include "BlendshapeConstants.h"
+
+// A blendshape stored as two parallel streams: offsets[i] moves vertex indices[i].
+// Every offset has a tangent, zero when the source blendshape has none, so accumulation doesn't branch.
+struct BlendshapeStream {
+    std::vector<int> indices;
+    std::vector<BlendshapeOffsetUnpacked> offsets;
+};
+
+// For every entry of the stream, adds the position offset scaled by vertexCoefficient and the normal and tangent
+// offsets scaled by normalCoefficient to unpacked[index].  Uses AVX2 when the CPU supports it.
+void accumulateBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, const BlendshapeStream& stream,
+                                 float vertexCoefficient, float normalCoefficient);
+
+#endif // hifi_BlendshapeAccumulation_h
@@ -58,9 +58,15 @@ Duration::Duration(const QLoggingCategory& category,
                    const QVariantMap& baseArgs) :
     DurationBase(category, name) {
     if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
-        tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        if (baseArgs.empty()) {
+            // the common case has no args beyond the payload, so avoid building a QVariantMap
+            auto tracer = DependencyManager::get<tracing::Tracer>();
+            tracer->traceCompactEvent(_category, _name, tracing::DurationBegin, tracing::Tracer::now(), payload, true);
+        } else {
+            QVariantMap args = baseArgs;
+            args["nv_payload"] = QVariant::fromValue(payload);
+            tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        }
 
 #if defined(NSIGHT_TRACING)
         nvtxEventAttributes_t eventAttrib{ 0 };
@@ -38,6 +38,7 @@ SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
 
 SpatiallyNestable::~SpatiallyNestable() {
     forEachChild([&](SpatiallyNestablePointer object) {
+        object->worldTransformChanged();
         object->parentDeleted();
     });
 }
@@ -81,6 +82,10 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
         }
     });
 
+    if (parentChanged) {
+        worldTransformChanged();
+    }
+
     if (parentChanged && success && parent) {
         parent->recalculateChildCauterization();
     }
@@ -140,6 +145,7 @@ SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) cons
         parent->forgetChild(getThisPointer());
         _parentKnowsMe = false;
         _parent.reset();
+        worldTransformChanged();
     }
 
     // we have a _parentID but no parent pointer, or our parent pointer was to the wrong thing
@@ -155,6 +161,7 @@ SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) cons
 
     parent = _parent.lock();
     if (parent) {
+        worldTransformChanged();
 
         // it's possible for an entity with a parent of AVATAR_SELF_ID can be imported into a side-tree
         // such as the clipboard's.  if this is the case, we don't want the parent to consider this a
@@ -185,7 +192,10 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 }
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
-    _parentJointIndex = parentJointIndex;
+    if (_parentJointIndex != parentJointIndex) {
+        _parentJointIndex = parentJointIndex;
+        worldTransformChanged();
+    }
     bool success = false;
     auto parent = getParentPointer(success);
     if (success && parent) {
@@ -517,6 +527,7 @@ void SpatiallyNestable::setWorldTransform(const glm::vec3& position, const glm::
             }
         });
         if (changed) {
+            worldTransformChanged();
             locationChanged(false);
         }
     }
@@ -560,6 +571,9 @@ void SpatiallyNestable::setWorldPosition(const glm::vec3& position, bool& succes
             _translationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        worldTransformChanged();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -613,6 +627,9 @@ void SpatiallyNestable::setWorldOrientation(const glm::quat& orientation, bool&
             _rotationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        worldTransformChanged();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -748,14 +765,62 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
     Transform result;
+    // the generation is read before the transforms it covers, so a concurrent change leaves a stale cache entry
+    // that is never used rather than a wrong one
+    uint32_t generation = _worldTransformGeneration.load(std::memory_order_acquire);
+    bool isCached = false;
+    _worldTransformCacheLock.withReadLock([&] {
+        if (_cachedWorldTransformGeneration == generation) {
+            result = _cachedWorldTransform;
+            isCached = true;
+        }
+    });
+    if (isCached) {
+        success = true;
+        return result;
+    }
+
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+
+    if (success && canCacheWorldTransform(depth)) {
+        _worldTransformCacheLock.withWriteLock([&] {
+            _cachedWorldTransform = result;
+            _cachedWorldTransformGeneration = generation;
+        });
+    }
     return result;
 }
 
+// Only cache what every input of the world transform reports changes of through worldTransformChanged(): the
+// poses of the parent's joints and the parent's scale for its children are not tracked.  A parent that does not
+// know about this object would not tell it when it moves either.  The same goes for every link up the chain, as
+// an ancestor moved by a joint doesn't tell its descendants.  This is only walked when the cache missed.
+bool SpatiallyNestable::canCacheWorldTransform(int depth) const {
+    if (_parentJointIndex != INVALID_JOINT_INDEX || getScalesWithParent()) {
+        return false;
+    }
+    if (getParentID().isNull()) {
+        return true;
+    }
+    bool success;
+    SpatiallyNestablePointer parent = getParentPointer(success);
+    return _parentKnowsMe && success && parent && depth < MAX_PARENTING_CHAIN_SIZE &&
+        parent->canCacheWorldTransform(depth + 1);
+}
+
+void SpatiallyNestable::worldTransformChanged(int depth) const {
+    _worldTransformGeneration.fetch_add(1, std::memory_order_release);
+    if (depth < MAX_PARENTING_CHAIN_SIZE) {
+        forEachChild([&](const SpatiallyNestablePointer& child) {
+            child->worldTransformChanged(depth + 1);
+        });
+    }
+}
+
 const Transform SpatiallyNestable::getTransformWithOnlyLocalRotation(bool& success, int depth) const {
     Transform result;
     // return a world-space transform for this object's location
@@ -833,6 +898,7 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             }
         });
         if (changed) {
+            worldTransformChanged();
             locationChanged();
         }
     }
@@ -887,6 +953,9 @@ void SpatiallyNestable::setSNScale(const glm::vec3& scale, bool& success) {
             _scaleChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        worldTransformChanged();
+    }
     if (success && changed) {
         dimensionsChanged();
     }
@@ -919,6 +988,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     });
 
     if (changed) {
+        worldTransformChanged();
         locationChanged();
     }
 }
@@ -946,6 +1016,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
         }
     });
     if (changed) {
+        worldTransformChanged();
         locationChanged(tellPhysics);
     }
 }
@@ -973,6 +1044,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
         }
     });
     if (changed) {
+        worldTransformChanged();
         locationChanged();
     }
 }
@@ -1029,6 +1101,7 @@ void SpatiallyNestable::setLocalSNScale(const glm::vec3& scale) {
         }
     });
     if (changed) {
+        worldTransformChanged();
         dimensionsChanged();
     }
 }
@@ -1393,6 +1466,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     });
 
     if (changed) {
+        worldTransformChanged();
         locationChanged(false);
     }
 }
@@ -12,6 +12,8 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <atomic>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -230,6 +232,10 @@ protected:
     QUuid _id;
     mutable SpatiallyNestableWeakPointer _parent;
 
+    // Invalidates the cached world transform of this object and of its descendants.  Subclasses call it when
+    // something other than the local transforms changes what getTransform() returns.
+    void worldTransformChanged(int depth = 0) const;
+
     virtual void beParentOfChild(SpatiallyNestablePointer newChild) const;
     virtual void forgetChild(SpatiallyNestablePointer newChild) const;
     virtual void recalculateChildCauterization() const { }
@@ -267,6 +273,14 @@ private:
     bool _isDead { false };
     bool _queryAACubeIsPuffed { false };
 
+    // getTransform() keeps the last world transform it computed, valid as long as its generation is current.  The
+    // generation is bumped whenever this object or one of its ancestors moves or is reparented.
+    mutable std::atomic<uint32_t> _worldTransformGeneration { 1 };
+    mutable ReadWriteLockable _worldTransformCacheLock;
+    mutable Transform _cachedWorldTransform;
+    mutable uint32_t _cachedWorldTransformGeneration { 0 };
+
+    bool canCacheWorldTransform(int depth = 0) const;
     void breakParentingLoop() const;
 };
 
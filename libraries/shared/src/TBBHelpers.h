@@ -23,6 +23,7 @@
 #include <tbb/concurrent_vector.h>
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range2d.h>
+#include <tbb/task_group.h>
 #endif
 
 #ifdef _WIN32
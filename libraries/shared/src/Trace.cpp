@@ -36,10 +36,99 @@
 
 using namespace tracing;
 
+static const uint32_t RING_BUFFER_CAPACITY = 1 << 14;
+static const std::chrono::milliseconds FLUSH_INTERVAL { 50 };
+
+namespace tracing {
+
+// Lock-free single producer / single consumer ring of compact events.  The owning thread
+// is the only producer and the Tracer flush thread (or serialize) is the only consumer.
+// When the ring is full new events are dropped rather than blocking the traced thread.
+class TraceRingBuffer {
+public:
+    TraceRingBuffer() : _events(RING_BUFFER_CAPACITY) {}
+
+    bool push(const CompactTraceEvent& event) {
+        auto head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= RING_BUFFER_CAPACITY) {
+            return false;
+        }
+        _events[head & (RING_BUFFER_CAPACITY - 1)] = event;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void drainInto(std::vector<CompactTraceEvent>& events) {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        auto head = _head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            events.push_back(_events[tail & (RING_BUFFER_CAPACITY - 1)]);
+        }
+        _tail.store(tail, std::memory_order_release);
+    }
+
+    bool isEmpty() const {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<CompactTraceEvent> _events;
+    std::atomic<uint32_t> _head { 0 };
+    std::atomic<uint32_t> _tail { 0 };
+};
+
+}
+
+namespace {
+
+// Per thread tracing state.  The tracer ID guards against a Tracer being replaced
+// (DependencyManager::set) while the thread keeps its cached ring and name IDs.
+struct ThreadTraceState {
+    uint64_t tracerID { 0 };
+    int64_t threadID { 0 };
+    std::shared_ptr<TraceRingBuffer> ringBuffer;
+    QHash<QString, uint32_t> nameIDs;
+};
+
+thread_local ThreadTraceState threadTraceState;
+
+std::atomic<uint64_t> nextTracerID { 1 };
+
+void writeJsonString(QTextStream& out, const QString& string) {
+    out << '"';
+    for (const QChar& c : string) {
+        switch (c.unicode()) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (c.unicode() < 0x20) {
+                    out << QString("\\u%1").arg((int)c.unicode(), 4, 16, QChar('0'));
+                } else {
+                    out << c;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+}
+
 bool tracing::enabled() {
     return DependencyManager::get<Tracer>()->isEnabled();
 }
 
+Tracer::Tracer() : _instanceID(nextTracerID++) {
+}
+
+Tracer::~Tracer() {
+    _enabled = false;
+    stopFlushThread();
+}
+
 void Tracer::startTracing() {
     std::lock_guard<std::mutex> guard(_eventsMutex);
     if (_enabled) {
@@ -48,16 +137,143 @@ void Tracer::startTracing() {
     }
 
     _events.clear();
+    {
+        // discard anything left over in the rings from a previous capture
+        flushRingBuffers();
+        std::lock_guard<std::mutex> compactGuard(_compactEventsMutex);
+        _compactEvents.clear();
+    }
+    _droppedEvents = 0;
     _enabled = true;
+
+    std::lock_guard<std::mutex> flushGuard(_flushMutex);
+    if (!_flushThreadRunning) {
+        _flushThreadRunning = true;
+        _flushThread = std::thread([this] { flushLoop(); });
+    }
 }
 
 void Tracer::stopTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
-    if (!_enabled) {
-        qWarning() << "Cannot stop tracing, already disabled";
+    {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        if (!_enabled) {
+            qWarning() << "Cannot stop tracing, already disabled";
+            return;
+        }
+        _enabled = false;
+    }
+    stopFlushThread();
+    flushRingBuffers();
+}
+
+void Tracer::stopFlushThread() {
+    {
+        std::lock_guard<std::mutex> guard(_flushMutex);
+        if (!_flushThreadRunning) {
+            return;
+        }
+        _flushThreadRunning = false;
+    }
+    _flushCondition.notify_all();
+    if (_flushThread.joinable()) {
+        _flushThread.join();
+    }
+}
+
+void Tracer::flushLoop() {
+    std::unique_lock<std::mutex> lock(_flushMutex);
+    while (_flushThreadRunning) {
+        _flushCondition.wait_for(lock, FLUSH_INTERVAL);
+        lock.unlock();
+        flushRingBuffers();
+        lock.lock();
+    }
+}
+
+void Tracer::flushRingBuffers() {
+    std::lock_guard<std::mutex> ringGuard(_ringBuffersMutex);
+    std::lock_guard<std::mutex> compactGuard(_compactEventsMutex);
+    for (auto it = _ringBuffers.begin(); it != _ringBuffers.end();) {
+        (*it)->drainInto(_compactEvents);
+        // the ring of a thread that has exited is only referenced by us now
+        if (it->use_count() == 1 && (*it)->isEmpty()) {
+            it = _ringBuffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+uint32_t Tracer::internName(const QString& name) {
+    auto& state = threadTraceState;
+    auto cached = state.nameIDs.find(name);
+    if (cached != state.nameIDs.end()) {
+        return cached.value();
+    }
+
+    uint32_t nameID;
+    {
+        std::lock_guard<std::mutex> guard(_namesMutex);
+        auto it = _nameIDs.find(name);
+        if (it != _nameIDs.end()) {
+            nameID = it.value();
+        } else {
+            nameID = (uint32_t)_names.size();
+            _names.push_back(name);
+            _nameIDs.insert(name, nameID);
+        }
+    }
+    state.nameIDs.insert(name, nameID);
+    return nameID;
+}
+
+TraceRingBuffer& Tracer::getThreadRingBuffer() {
+    auto& state = threadTraceState;
+    if (state.tracerID != _instanceID) {
+        state.tracerID = _instanceID;
+        state.threadID = int64_t(QThread::currentThreadId());
+        state.nameIDs.clear();
+        state.ringBuffer = std::make_shared<TraceRingBuffer>();
+
+        std::lock_guard<std::mutex> guard(_ringBuffersMutex);
+        _ringBuffers.push_back(state.ringBuffer);
+    }
+    return *state.ringBuffer;
+}
+
+void Tracer::traceCompactEvent(const QLoggingCategory& category, const QString& name, EventType type,
+                               int64_t timestamp, uint64_t payload, bool hasPayload) {
+    if (!isEnabled()) {
         return;
     }
-    _enabled = false;
+
+    auto& ringBuffer = getThreadRingBuffer();
+    CompactTraceEvent event {
+        &category,
+        timestamp,
+        threadTraceState.threadID,
+        payload,
+        internName(name),
+        type,
+        hasPayload
+    };
+    if (!ringBuffer.push(event)) {
+        ++_droppedEvents;
+    }
+}
+
+void Tracer::writeCompactEventJson(QTextStream& out, const CompactTraceEvent& event, qint64 processID) const {
+    out << "{\"name\":";
+    writeJsonString(out, _names[event.nameID]);
+    out << ",\"cat\":\"" << event.category->categoryName() << "\"";
+    out << ",\"ph\":\"" << (char)event.type << "\"";
+    out << ",\"ts\":" << event.timestamp;
+    out << ",\"pid\":" << processID;
+    out << ",\"tid\":" << event.threadID;
+    if (event.hasPayload) {
+        out << ",\"args\":{\"nv_payload\":" << event.payload << "}";
+    }
+    out << '}';
 }
 
 void TraceEvent::writeJson(QTextStream& out) const {
@@ -121,6 +337,18 @@ void Tracer::serialize(const QString& filename) {
         }
     }
 
+    flushRingBuffers();
+    std::vector<CompactTraceEvent> currentCompactEvents;
+    {
+        std::lock_guard<std::mutex> guard(_compactEventsMutex);
+        currentCompactEvents.swap(_compactEvents);
+    }
+
+    auto droppedEvents = _droppedEvents.exchange(0);
+    if (droppedEvents > 0) {
+        qCWarning(shared) << "Tracer dropped" << droppedEvents << "events because a thread's ring buffer was full";
+    }
+
     // If we can't open a temp file for writing, fail early
     QByteArray data;
     {
@@ -135,6 +363,18 @@ void Tracer::serialize(const QString& filename) {
             }
             event.writeJson(out);
         }
+
+        // names are only appended, so holding the lock while writing keeps _names stable
+        std::lock_guard<std::mutex> guard(_namesMutex);
+        auto processID = QCoreApplication::applicationPid();
+        for (const auto& event : currentCompactEvents) {
+            if (first) {
+                first = false;
+            } else {
+                out << ",\n";
+            }
+            writeCompactEventJson(out, event, processID);
+        }
         out << "\n]";
     }
 
@@ -226,7 +466,7 @@ void Tracer::traceEvent(const QLoggingCategory& category,
 void Tracer::traceEvent(const QLoggingCategory& category, 
     const QString& name, EventType type, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
-    if (!_enabled && type != Metadata) {
+    if (!isEnabled() && type != Metadata) {
         return;
     }
 
@@ -236,7 +476,12 @@ void Tracer::traceEvent(const QLoggingCategory& category,
 void Tracer::traceEvent(const QLoggingCategory& category, 
     const QString& name, EventType type, int64_t timestamp, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
-    if (!_enabled && type != Metadata) {
+    if (!isEnabled() && type != Metadata) {
+        return;
+    }
+
+    if (type != Metadata && id.isEmpty() && args.empty() && extra.empty()) {
+        traceCompactEvent(category, name, type, timestamp);
         return;
     }
 
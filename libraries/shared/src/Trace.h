@@ -10,8 +10,14 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
@@ -76,8 +82,25 @@ struct TraceEvent {
     void writeJson(QTextStream& out) const;
 };
 
+// Fixed size event recorded on the hot path.  The name is interned by the Tracer,
+// so recording one of these never allocates or takes a lock.
+struct CompactTraceEvent {
+    const QLoggingCategory* category;
+    int64_t timestamp;
+    int64_t threadID;
+    uint64_t payload;
+    uint32_t nameID;
+    EventType type;
+    bool hasPayload;
+};
+
+class TraceRingBuffer;
+
 class Tracer : public Dependency {
 public:
+    Tracer();
+    ~Tracer();
+
     static int64_t now();
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
@@ -90,22 +113,52 @@ public:
         const QString& id = "", 
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
+    // Records an event without id, args or extra data into the calling thread's ring buffer.
+    // An optional payload is written out as the "nv_payload" argument.
+    void traceCompactEvent(const QLoggingCategory& category, const QString& name, EventType type,
+        int64_t timestamp, uint64_t payload = 0, bool hasPayload = false);
+
     void startTracing();
     void stopTracing();
     void serialize(const QString& file);
-    bool isEnabled() const { return _enabled; }
+    bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
 
 private:
+    uint32_t internName(const QString& name);
+    TraceRingBuffer& getThreadRingBuffer();
+    void flushRingBuffers();
+    void flushLoop();
+    void stopFlushThread();
+    void writeCompactEventJson(QTextStream& out, const CompactTraceEvent& event, qint64 processID) const;
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         qint64 timestamp, qint64 processID, qint64 threadID,
         const QString& id = "",
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
-    bool _enabled { false };
+    const uint64_t _instanceID;
+    std::atomic<bool> _enabled { false };
     std::list<TraceEvent> _events;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
+
+    // interned event names, only locked the first time a thread sees a name
+    std::mutex _namesMutex;
+    QHash<QString, uint32_t> _nameIDs;
+    std::vector<QString> _names;
+
+    // one single-producer ring per tracing thread, drained by the flush thread
+    std::mutex _ringBuffersMutex;
+    std::vector<std::shared_ptr<TraceRingBuffer>> _ringBuffers;
+    std::mutex _compactEventsMutex;
+    std::vector<CompactTraceEvent> _compactEvents;
+    std::atomic<uint64_t> _droppedEvents { 0 };
+
+    std::thread _flushThread;
+    std::mutex _flushMutex;
+    std::condition_variable _flushCondition;
+    bool _flushThreadRunning { false };
 };
 
 inline void traceEvent(const QLoggingCategory& category, int64_t timestamp, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
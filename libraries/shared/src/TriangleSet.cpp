@@ -11,25 +11,43 @@
 
 #include "TriangleSet.h"
 
+#include <algorithm>
+#include <cassert>
+
 #include "GLMHelpers.h"
 
-#include <list>
+// leaves hold at most this many triangles
+static const uint32_t MAX_LEAF_TRIANGLES = 4;
+static const int32_t EMPTY_CHILD = -1;
+// the tree is balanced, so each level pushes at most BVH_WIDTH - 1 extra entries and 2^32 triangles stay well below this
+static const int BVH_STACK_SIZE = 64;
 
 void TriangleSet::insert(const Triangle& t) {
     _isBalanced = false;
 
+    _trianglePositions.push_back((uint32_t)_triangles.size());
     _triangles.push_back(t);
     _bounds += t.v0;
     _bounds += t.v1;
     _bounds += t.v2;
 }
 
+void TriangleSet::setTriangle(size_t index, const Triangle& t) {
+    _triangles[_trianglePositions[index]] = t;
+    // grow the bounds right away so they stay conservative, refit() makes them tight again
+    _bounds += t.v0;
+    _bounds += t.v1;
+    _bounds += t.v2;
+    _needsRefit = true;
+}
+
 void TriangleSet::clear() {
     _triangles.clear();
+    _trianglePositions.clear();
+    _nodes.clear();
     _bounds.clear();
     _isBalanced = false;
-
-    _triangleTree.clear();
+    _needsRefit = false;
 }
 
 bool TriangleSet::convexHullContains(const glm::vec3& point) const {
@@ -52,424 +70,372 @@ bool TriangleSet::convexHullContains(const glm::vec3& point) const {
 void TriangleSet::debugDump() {
     qDebug() << __FUNCTION__;
     qDebug() << "bounds:" << getBounds();
-    qDebug() << "triangles:" << size() << "at top level....";
-    qDebug() << "----- _triangleTree -----";
-    _triangleTree.debugDump();
-}
-
-void TriangleSet::balanceTree() {
-    _triangleTree.reset(_bounds);
-
-    // insert all the triangles
-    for (size_t i = 0; i < _triangles.size(); i++) {
-        _triangleTree.insert(i);
+    qDebug() << "triangles:" << size();
+    qDebug() << "nodes:" << _nodes.size();
+    int leaves = 0;
+    for (const auto& node : _nodes) {
+        for (int i = 0; i < BVH_WIDTH; i++) {
+            if (node.count[i] > 0) {
+                leaves++;
+            }
+        }
     }
-
-    _isBalanced = true;
-
-#if WANT_DEBUGGING
-    debugDump();
-#endif
+    qDebug() << "leaves:" << leaves;
 }
 
-// With an octree: 8 ^ MAX_DEPTH = 4096 leaves
-//static const int MAX_DEPTH = 4;
-// With a k-d tree: 2 ^ MAX_DEPTH = 4096 leaves
-static const int MAX_DEPTH = 12;
-
-TriangleSet::TriangleTreeCell::TriangleTreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth) :
-    _allTriangles(allTriangles)
-{
-    reset(bounds, depth);
+AABox TriangleSet::BVHNode::getChildBounds(int child) const {
+    glm::vec3 minimum(minX[child], minY[child], minZ[child]);
+    glm::vec3 maximum(maxX[child], maxY[child], maxZ[child]);
+    return AABox(minimum, maximum - minimum);
 }
 
-void TriangleSet::TriangleTreeCell::clear() {
-    _population = 0;
-    _triangleIndices.clear();
-    _bounds.clear();
-    _children.first.reset();
-    _children.second.reset();
-}
+// Sorts the range so its first half has the smaller centroids along their longest axis, and returns the size of
+// that half.  Splitting at the median keeps the tree balanced whatever the triangles look like.
+static uint32_t splitRange(uint32_t first, uint32_t count, std::vector<uint32_t>& order, const std::vector<glm::vec3>& centroids) {
+    glm::vec3 minimum(FLT_MAX);
+    glm::vec3 maximum(-FLT_MAX);
+    for (uint32_t i = first; i < first + count; i++) {
+        minimum = glm::min(minimum, centroids[order[i]]);
+        maximum = glm::max(maximum, centroids[order[i]]);
+    }
+    glm::vec3 extent = maximum - minimum;
+    int axis = 0;
+    if (extent.y > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+        axis = 2;
+    }
 
-void TriangleSet::TriangleTreeCell::reset(const AABox& bounds, int depth) {
-    clear();
-    _bounds = bounds;
-    _depth = depth;
+    uint32_t half = count / 2;
+    std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+        [&](uint32_t left, uint32_t right) { return centroids[left][axis] < centroids[right][axis]; });
+    return half;
 }
 
-void TriangleSet::TriangleTreeCell::debugDump() {
-    qDebug() << __FUNCTION__;
-    qDebug() << "               bounds:" << getBounds();
-    qDebug() << "                depth:" << _depth;
-    qDebug() << "           population:" << _population << "this level or below"
-             << " ---- triangleIndices:" << _triangleIndices.size() << "in this cell";
-
+int32_t TriangleSet::buildNode(uint32_t first, uint32_t count, std::vector<uint32_t>& order, const std::vector<glm::vec3>& centroids) {
+    // split the range in two, then each half in two again, which gives the node up to four children
+    uint32_t childFirst[BVH_WIDTH];
+    uint32_t childCount[BVH_WIDTH];
     int numChildren = 0;
-    if (_children.first) {
+    auto addChild = [&](uint32_t rangeFirst, uint32_t rangeCount) {
+        childFirst[numChildren] = rangeFirst;
+        childCount[numChildren] = rangeCount;
         numChildren++;
-    } else if (_children.second) {
-        numChildren++;
-    }
-    qDebug() << "child cells:" << numChildren;
-    if (_depth < MAX_DEPTH) {
-        if (_children.first) {
-            qDebug() << "child: 0";
-            _children.first->debugDump();
-        }
-        if (_children.second) {
-            qDebug() << "child: 1";
-            _children.second->debugDump();
+    };
+    if (count <= MAX_LEAF_TRIANGLES) {
+        addChild(first, count);
+    } else {
+        uint32_t half = splitRange(first, count, order, centroids);
+        uint32_t halfFirst[2] = { first, first + half };
+        uint32_t halfCount[2] = { half, count - half };
+        for (int i = 0; i < 2; i++) {
+            if (halfCount[i] > MAX_LEAF_TRIANGLES) {
+                uint32_t quarter = splitRange(halfFirst[i], halfCount[i], order, centroids);
+                addChild(halfFirst[i], quarter);
+                addChild(halfFirst[i] + quarter, halfCount[i] - quarter);
+            } else {
+                addChild(halfFirst[i], halfCount[i]);
+            }
         }
     }
-}
 
-std::pair<AABox, AABox> TriangleSet::TriangleTreeCell::getTriangleTreeCellChildBounds() {
-    std::pair<AABox, AABox> toReturn;
-    int axis = 0;
-    // find biggest axis
-    glm::vec3 dimensions = _bounds.getDimensions();
-    for (int i = 0; i < 3; i++) {
-        if (dimensions[i] >= dimensions[(i + 1) % 3] && dimensions[i] >= dimensions[(i + 2) % 3]) {
-            axis = i;
-            break;
+    // the boxes are filled in by refit()
+    int32_t nodeIndex = (int32_t)_nodes.size();
+    _nodes.emplace_back();
+    for (int i = 0; i < BVH_WIDTH; i++) {
+        int32_t nodeFirst = EMPTY_CHILD;
+        uint32_t nodeCount = 0;
+        if (i < numChildren) {
+            if (childCount[i] <= MAX_LEAF_TRIANGLES) {
+                nodeFirst = (int32_t)childFirst[i];
+                nodeCount = childCount[i];
+            } else {
+                nodeFirst = buildNode(childFirst[i], childCount[i], order, centroids);
+            }
         }
+        // _nodes may have grown since, don't hold on to a reference
+        _nodes[nodeIndex].first[i] = nodeFirst;
+        _nodes[nodeIndex].count[i] = nodeCount;
     }
-
-    // The new boxes are half the size in the largest dimension
-    glm::vec3 newDimensions = dimensions;
-    newDimensions[axis] *= 0.5f;
-    toReturn.first.setBox(_bounds.getCorner(), newDimensions);
-    glm::vec3 offset = glm::vec3(0.0f);
-    offset[axis] = newDimensions[axis];
-    toReturn.second.setBox(_bounds.getCorner() + offset, newDimensions);
-    return toReturn;
+    return nodeIndex;
 }
 
-void TriangleSet::TriangleTreeCell::insert(size_t triangleIndex) {
-    _population++;
-
-    // if we're not yet at the max depth, then check which child the triangle fits in
-    if (_depth < MAX_DEPTH) {
-        const Triangle& triangle = _allTriangles[triangleIndex];
-        auto childBounds = getTriangleTreeCellChildBounds();
+void TriangleSet::balanceTree() {
+    _nodes.clear();
+
+    uint32_t numTriangles = (uint32_t)_triangles.size();
+    if (numTriangles > 0) {
+        std::vector<glm::vec3> centroids(numTriangles);
+        std::vector<uint32_t> order(numTriangles);
+        for (uint32_t i = 0; i < numTriangles; i++) {
+            const Triangle& triangle = _triangles[i];
+            centroids[i] = (triangle.v0 + triangle.v1 + triangle.v2) / 3.0f;
+            order[i] = i;
+        }
 
-        auto insertOperator = [&](const AABox& childBound, std::shared_ptr<TriangleTreeCell>& child) {
-            // if the child AABox would contain the triangle...
-            if (childBound.contains(triangle)) {
-                // if the child cell doesn't yet exist, create it...
-                if (!child) {
-                    child = std::make_shared<TriangleTreeCell>(_allTriangles, childBound, _depth + 1);
-                }
+        buildNode(0, numTriangles, order, centroids);
 
-                // insert the triangleIndex in the child cell
-                child->insert(triangleIndex);
-                return true;
-            }
-            return false;
-        };
-        if (insertOperator(childBounds.first, _children.first) || insertOperator(childBounds.second, _children.second)) {
-            return;
+        // store the triangles in leaf order, so every leaf reads one contiguous run
+        std::vector<Triangle> sortedTriangles(numTriangles);
+        std::vector<uint32_t> newPositions(numTriangles);
+        for (uint32_t i = 0; i < numTriangles; i++) {
+            sortedTriangles[i] = _triangles[order[i]];
+            newPositions[order[i]] = i;
+        }
+        _triangles.swap(sortedTriangles);
+        for (auto& position : _trianglePositions) {
+            position = newPositions[position];
         }
-    }
-    // either we're at max depth, or the triangle doesn't fit in one of our
-    // children and so we want to just record it here
-    _triangleIndices.push_back(triangleIndex);
-}
-
-bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection, float& distance,
-                                      BoxFace& face, Triangle& triangle, bool precision, bool allowBackface) {
-    if (!_isBalanced) {
-        balanceTree();
     }
 
-    float localDistance = distance;
-    int trianglesTouched = 0;
-    bool hit = _triangleTree.findRayIntersection(origin, direction, invDirection, localDistance, face, triangle, precision, trianglesTouched, allowBackface);
-    if (hit) {
-        distance = localDistance;
-    }
+    _isBalanced = true;
+    refit();
 
 #if WANT_DEBUGGING
-    if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleTree._population << "_triangles.size:" << _triangles.size();
-    }
+    debugDump();
 #endif
-    return hit;
 }
 
-// Determine of the given ray (origin/direction) in model space intersects with any triangles
-// in the set. If an intersection occurs, the distance and surface normal will be provided.
-bool TriangleSet::TriangleTreeCell::findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-                                                                  float& distance, BoxFace& face, Triangle& triangle, bool precision,
-                                                                  int& trianglesTouched, bool allowBackface) {
-    bool intersectedSomething = false;
-    float bestDistance = FLT_MAX;
-    Triangle bestTriangle;
-
-    if (precision) {
-        for (const auto& triangleIndex : _triangleIndices) {
-            const auto& thisTriangle = _allTriangles[triangleIndex];
-            float thisTriangleDistance;
-            trianglesTouched++;
-            if (findRayTriangleIntersection(origin, direction, thisTriangle, thisTriangleDistance, allowBackface)) {
-                if (thisTriangleDistance < bestDistance) {
-                    bestDistance = thisTriangleDistance;
-                    bestTriangle = thisTriangle;
-                    intersectedSomething = true;
+void TriangleSet::refit() {
+    // children always come after their parent, so walking the nodes backwards refits every child before its parent
+    for (int32_t i = (int32_t)_nodes.size() - 1; i >= 0; i--) {
+        BVHNode& node = _nodes[i];
+        for (int j = 0; j < BVH_WIDTH; j++) {
+            glm::vec3 minimum(FLT_MAX);
+            glm::vec3 maximum(-FLT_MAX);
+            if (node.count[j] > 0) {
+                for (uint32_t k = (uint32_t)node.first[j]; k < (uint32_t)node.first[j] + node.count[j]; k++) {
+                    const Triangle& triangle = _triangles[k];
+                    minimum = glm::min(minimum, glm::min(triangle.v0, glm::min(triangle.v1, triangle.v2)));
+                    maximum = glm::max(maximum, glm::max(triangle.v0, glm::max(triangle.v1, triangle.v2)));
+                }
+            } else if (node.first[j] != EMPTY_CHILD) {
+                // empty children have inverted boxes, which don't change the union
+                const BVHNode& child = _nodes[node.first[j]];
+                for (int k = 0; k < BVH_WIDTH; k++) {
+                    minimum = glm::min(minimum, glm::vec3(child.minX[k], child.minY[k], child.minZ[k]));
+                    maximum = glm::max(maximum, glm::vec3(child.maxX[k], child.maxY[k], child.maxZ[k]));
                 }
             }
+            node.minX[j] = minimum.x;
+            node.minY[j] = minimum.y;
+            node.minZ[j] = minimum.z;
+            node.maxX[j] = maximum.x;
+            node.maxY[j] = maximum.y;
+            node.maxZ[j] = maximum.z;
         }
-    } else {
-        intersectedSomething = true;
-        bestDistance = distance;
     }
 
-    if (intersectedSomething) {
-        distance = bestDistance;
-        triangle = bestTriangle;
+    if (!_nodes.empty()) {
+        const BVHNode& root = _nodes[0];
+        glm::vec3 minimum(FLT_MAX);
+        glm::vec3 maximum(-FLT_MAX);
+        for (int i = 0; i < BVH_WIDTH; i++) {
+            minimum = glm::min(minimum, glm::vec3(root.minX[i], root.minY[i], root.minZ[i]));
+            maximum = glm::max(maximum, glm::vec3(root.maxX[i], root.maxY[i], root.maxZ[i]));
+        }
+        _bounds.setBox(minimum, maximum - minimum);
     }
+    _needsRefit = false;
+}
 
-    return intersectedSomething;
+// Slab test of a ray against the four child boxes of a node at once.  Returns a mask of the children the ray enters
+// before maxDistance, and the distance at which it enters each of them, 0 when it starts inside.
+static int findRayNodeIntersections(const float* minX, const float* minY, const float* minZ,
+                                    const float* maxX, const float* maxY, const float* maxZ,
+                                    const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance, float* distances) {
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    __m128 originX = _mm_set1_ps(origin.x);
+    __m128 originY = _mm_set1_ps(origin.y);
+    __m128 originZ = _mm_set1_ps(origin.z);
+    __m128 invDirectionX = _mm_set1_ps(invDirection.x);
+    __m128 invDirectionY = _mm_set1_ps(invDirection.y);
+    __m128 invDirectionZ = _mm_set1_ps(invDirection.z);
+
+    __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minX), originX), invDirectionX);
+    __m128 t2x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxX), originX), invDirectionX);
+    __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minY), originY), invDirectionY);
+    __m128 t2y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxY), originY), invDirectionY);
+    __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minZ), originZ), invDirectionZ);
+    __m128 t2z = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxZ), originZ), invDirectionZ);
+
+    __m128 tmin = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1x, t2x), _mm_min_ps(t1y, t2y)),
+                             _mm_max_ps(_mm_min_ps(t1z, t2z), _mm_setzero_ps()));
+    __m128 tmax = _mm_min_ps(_mm_min_ps(_mm_max_ps(t1x, t2x), _mm_max_ps(t1y, t2y)),
+                             _mm_min_ps(_mm_max_ps(t1z, t2z), _mm_set1_ps(maxDistance)));
+    _mm_storeu_ps(distances, tmin);
+    return _mm_movemask_ps(_mm_cmple_ps(tmin, tmax));
+#else
+    int hits = 0;
+    for (int i = 0; i < 4; i++) {
+        float t1x = (minX[i] - origin.x) * invDirection.x;
+        float t2x = (maxX[i] - origin.x) * invDirection.x;
+        float t1y = (minY[i] - origin.y) * invDirection.y;
+        float t2y = (maxY[i] - origin.y) * invDirection.y;
+        float t1z = (minZ[i] - origin.z) * invDirection.z;
+        float t2z = (maxZ[i] - origin.z) * invDirection.z;
+        float tmin = std::max(std::max(std::min(t1x, t2x), std::min(t1y, t2y)), std::max(std::min(t1z, t2z), 0.0f));
+        float tmax = std::min(std::min(std::max(t1x, t2x), std::max(t1y, t2y)), std::min(std::max(t1z, t2z), maxDistance));
+        distances[i] = tmin;
+        if (tmin <= tmax) {
+            hits |= 1 << i;
+        }
+    }
+    return hits;
+#endif
 }
 
-bool TriangleSet::TriangleTreeCell::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
-                                                        float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-                                                        bool allowBackface) {
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
+template <typename NodeTest, typename TriangleTest, typename LeafBoundsTest>
+bool TriangleSet::findIntersection(const NodeTest& nodeTest, const TriangleTest& triangleTest, const LeafBoundsTest& leafBoundsTest,
+                                   bool precision, float& distance, BoxFace& face, Triangle& triangle, int& trianglesTouched) {
+    if (!_isBalanced) {
+        balanceTree();
+    } else if (_needsRefit) {
+        refit();
+    }
+    if (_nodes.empty()) {
+        return false;
     }
 
-    float bestLocalDistance = FLT_MAX;
-    BoxFace bestLocalFace;
-    Triangle bestLocalTriangle;
+    float bestDistance = FLT_MAX;
+    BoxFace bestFace = UNKNOWN_FACE;
+    Triangle bestTriangle;
     bool intersects = false;
 
-    // Check our local triangle set first
-    // The distance passed in here is the distance to our bounding box.  If !precision, that distance is used
-    {
-        float internalDistance = distance;
-        BoxFace internalFace { UNKNOWN_FACE };
-        Triangle internalTriangle;
-        if (findRayIntersectionInternal(origin, direction, internalDistance, internalFace, internalTriangle, precision, trianglesTouched, allowBackface)) {
-            bestLocalDistance = internalDistance;
-            bestLocalFace = internalFace;
-            bestLocalTriangle = internalTriangle;
-            intersects = true;
+    // nearest first traversal: children are pushed far to near and skipped once something closer was hit
+    BVHEntry stack[BVH_STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = { 0, 0, 0.0f };
+    while (stackSize > 0) {
+        BVHEntry entry = stack[--stackSize];
+        if (entry.distance > bestDistance) {
+            continue;
         }
-    }
-
-    // if we're not yet at the max depth, then check our children
-    if (_depth < MAX_DEPTH) {
-        std::list<SortedTriangleCell> sortedTriangleCells;
-        auto sortingOperator = [&](std::shared_ptr<TriangleTreeCell>& child) {
-            if (child) {
-                float priority = FLT_MAX;
-                if (child->getBounds().contains(origin)) {
-                    priority = 0.0f;
-                } else {
-                    float childBoundDistance = FLT_MAX;
-                    BoxFace childBoundFace;
-                    glm::vec3 childBoundNormal;
-                    if (child->getBounds().findRayIntersection(origin, direction, invDirection, childBoundDistance, childBoundFace, childBoundNormal)) {
-                        // We only need to add this cell if it's closer than the local triangle set intersection (if there was one)
-                        if (childBoundDistance < bestLocalDistance) {
-                            priority = childBoundDistance;
-                        }
-                    }
-                }
 
-                if (priority < FLT_MAX) {
-                    if (sortedTriangleCells.size() > 0 && priority < sortedTriangleCells.front().first) {
-                        sortedTriangleCells.emplace_front(priority, child);
-                    } else {
-                        sortedTriangleCells.emplace_back(priority, child);
-                    }
+        if (entry.count > 0) {
+            for (uint32_t i = (uint32_t)entry.first; i < (uint32_t)entry.first + entry.count; i++) {
+                float triangleDistance;
+                trianglesTouched++;
+                if (triangleTest(_triangles[i], triangleDistance) && triangleDistance < bestDistance) {
+                    bestDistance = triangleDistance;
+                    bestTriangle = _triangles[i];
+                    intersects = true;
                 }
             }
-        };
-        sortingOperator(_children.first);
-        sortingOperator(_children.second);
-
-        for (auto it = sortedTriangleCells.begin(); it != sortedTriangleCells.end(); ++it) {
-            const SortedTriangleCell& sortedTriangleCell = *it;
-            float childDistance = sortedTriangleCell.first;
-            // We can exit once childDistance > bestLocalDistance
-            if (childDistance > bestLocalDistance) {
-                break;
-            }
-            // If we're inside the child cell and !precision, we need the actual distance to the cell bounds
-            if (!precision && childDistance < EPSILON) {
-                BoxFace childBoundFace;
-                glm::vec3 childBoundNormal;
-                sortedTriangleCell.second->getBounds().findRayIntersection(origin, direction, invDirection, childDistance, childBoundFace, childBoundNormal);
+            continue;
+        }
+
+        const BVHNode& node = _nodes[entry.first];
+        float childDistances[BVH_WIDTH];
+        int hits = nodeTest(node, bestDistance, childDistances);
+
+        int sortedChildren[BVH_WIDTH];
+        int numSortedChildren = 0;
+        for (int i = 0; i < BVH_WIDTH; i++) {
+            if (!(hits & (1 << i)) || node.first[i] == EMPTY_CHILD) {
+                continue;
             }
-            BoxFace childFace;
-            Triangle childTriangle;
-            if (sortedTriangleCell.second->findRayIntersection(origin, direction, invDirection, childDistance, childFace, childTriangle, precision, trianglesTouched)) {
-                if (childDistance < bestLocalDistance) {
-                    bestLocalDistance = childDistance;
-                    bestLocalFace = childFace;
-                    bestLocalTriangle = childTriangle;
+            if (!precision && node.count[i] > 0) {
+                // without precision the boxes of the leaves stand in for their triangles
+                float boundsDistance;
+                BoxFace boundsFace;
+                if (leafBoundsTest(node.getChildBounds(i), boundsDistance, boundsFace) && boundsDistance < bestDistance) {
+                    bestDistance = boundsDistance;
+                    bestFace = boundsFace;
                     intersects = true;
-                    break;
                 }
+                continue;
             }
+            // insertion sort, farthest first
+            int j = numSortedChildren++;
+            while (j > 0 && childDistances[sortedChildren[j - 1]] < childDistances[i]) {
+                sortedChildren[j] = sortedChildren[j - 1];
+                j--;
+            }
+            sortedChildren[j] = i;
+        }
+
+        assert(stackSize + numSortedChildren <= BVH_STACK_SIZE);
+        for (int i = 0; i < numSortedChildren; i++) {
+            int child = sortedChildren[i];
+            stack[stackSize++] = { node.first[child], node.count[child], childDistances[child] };
         }
     }
 
     if (intersects) {
-        distance = bestLocalDistance;
-        face = bestLocalFace;
-        triangle = bestLocalTriangle;
+        distance = bestDistance;
+        face = bestFace;
+        triangle = bestTriangle;
     }
     return intersects;
 }
 
-bool TriangleSet::findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-                                           float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, bool allowBackface) {
-    if (!_isBalanced) {
-        balanceTree();
-    }
+bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection, float& distance,
+                                      BoxFace& face, Triangle& triangle, bool precision, bool allowBackface) {
+    auto nodeTest = [&](const BVHNode& node, float maxDistance, float* distances) {
+        return findRayNodeIntersections(node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ,
+                                        origin, invDirection, maxDistance, distances);
+    };
+    auto triangleTest = [&](const Triangle& thisTriangle, float& thisTriangleDistance) {
+        return findRayTriangleIntersection(origin, direction, thisTriangle, thisTriangleDistance, allowBackface);
+    };
+    auto leafBoundsTest = [&](const AABox& bounds, float& boundsDistance, BoxFace& boundsFace) {
+        glm::vec3 boundsNormal;
+        return bounds.findRayIntersection(origin, direction, invDirection, boundsDistance, boundsFace, boundsNormal);
+    };
 
-    float localDistance = parabolicDistance;
     int trianglesTouched = 0;
-    bool hit = _triangleTree.findParabolaIntersection(origin, velocity, acceleration, localDistance, face, triangle, precision, trianglesTouched, allowBackface);
-    if (hit) {
-        parabolicDistance = localDistance;
-    }
+    bool hit = findIntersection(nodeTest, triangleTest, leafBoundsTest, precision, distance, face, triangle, trianglesTouched);
 
 #if WANT_DEBUGGING
     if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleTree._population << "_triangles.size:" << _triangles.size();
+        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangles.size();
     }
 #endif
     return hit;
 }
 
-bool TriangleSet::TriangleTreeCell::findParabolaIntersectionInternal(const glm::vec3& origin, const glm::vec3& velocity,
-                                                                       const glm::vec3& acceleration, float& parabolicDistance,
-                                                                       BoxFace& face, Triangle& triangle, bool precision,
-                                                                       int& trianglesTouched, bool allowBackface) {
-    bool intersectedSomething = false;
-    float bestDistance = FLT_MAX;
-    Triangle bestTriangle;
-
-    if (precision) {
-        for (const auto& triangleIndex : _triangleIndices) {
-            const auto& thisTriangle = _allTriangles[triangleIndex];
-            float thisTriangleDistance;
-            trianglesTouched++;
-            if (findParabolaTriangleIntersection(origin, velocity, acceleration, thisTriangle, thisTriangleDistance, allowBackface)) {
-                if (thisTriangleDistance < bestDistance) {
-                    bestDistance = thisTriangleDistance;
-                    bestTriangle = thisTriangle;
-                    intersectedSomething = true;
-                }
+bool TriangleSet::findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
+                                           float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, bool allowBackface) {
+    // there is no cheap wide test for a parabola, so the children of a node are tested one at a time
+    auto nodeTest = [&](const BVHNode& node, float maxDistance, float* distances) {
+        int hits = 0;
+        for (int i = 0; i < BVH_WIDTH; i++) {
+            if (node.first[i] == EMPTY_CHILD) {
+                continue;
             }
-        }
-    } else {
-        intersectedSomething = true;
-        bestDistance = parabolicDistance;
-    }
-
-    if (intersectedSomething) {
-        parabolicDistance = bestDistance;
-        triangle = bestTriangle;
-    }
-
-    return intersectedSomething;
-}
-
-bool TriangleSet::TriangleTreeCell::findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity,
-                                                               const glm::vec3& acceleration, float& parabolicDistance,
-                                                               BoxFace& face, Triangle& triangle, bool precision,
-                                                               int& trianglesTouched, bool allowBackface) {
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
-    }
-
-    float bestLocalDistance = FLT_MAX;
-    BoxFace bestLocalFace;
-    Triangle bestLocalTriangle;
-    bool intersects = false;
-
-    // Check our local triangle set first
-    // The distance passed in here is the distance to our bounding box.  If !precision, that distance is used
-    {
-        float internalDistance = parabolicDistance;
-        BoxFace internalFace;
-        Triangle internalTriangle;
-        if (findParabolaIntersectionInternal(origin, velocity, acceleration, internalDistance, internalFace, internalTriangle, precision, trianglesTouched, allowBackface)) {
-            bestLocalDistance = internalDistance;
-            bestLocalFace = internalFace;
-            bestLocalTriangle = internalTriangle;
-            intersects = true;
-        }
-    }
-
-    // if we're not yet at the max depth, then check our children
-    if (_depth < MAX_DEPTH) {
-        std::list<SortedTriangleCell> sortedTriangleCells;
-        auto sortingOperator = [&](std::shared_ptr<TriangleTreeCell>& child) {
-            if (child) {
-                float priority = FLT_MAX;
-                if (child->getBounds().contains(origin)) {
-                    priority = 0.0f;
-                } else {
-                    float childBoundDistance = FLT_MAX;
-                    BoxFace childBoundFace;
-                    glm::vec3 childBoundNormal;
-                    if (child->getBounds().findParabolaIntersection(origin, velocity, acceleration, childBoundDistance, childBoundFace, childBoundNormal)) {
-                        // We only need to add this cell if it's closer than the local triangle set intersection (if there was one)
-                        if (childBoundDistance < bestLocalDistance) {
-                            priority = childBoundDistance;
-                        }
-                    }
+            AABox bounds = node.getChildBounds(i);
+            float childDistance = 0.0f;
+            if (!bounds.contains(origin)) {
+                BoxFace childFace;
+                glm::vec3 childNormal;
+                if (!bounds.findParabolaIntersection(origin, velocity, acceleration, childDistance, childFace, childNormal)) {
+                    continue;
                 }
-
-                if (priority < FLT_MAX) {
-                    if (sortedTriangleCells.size() > 0 && priority < sortedTriangleCells.front().first) {
-                        sortedTriangleCells.emplace_front(priority, child);
-                    } else {
-                        sortedTriangleCells.emplace_back(priority, child);
-                    }
-                }
-            }
-        };
-        sortingOperator(_children.first);
-        sortingOperator(_children.second);
-
-        for (auto it = sortedTriangleCells.begin(); it != sortedTriangleCells.end(); ++it) {
-            const SortedTriangleCell& sortedTriangleCell = *it;
-            float childDistance = sortedTriangleCell.first;
-            // We can exit once childDistance > bestLocalDistance
-            if (childDistance > bestLocalDistance) {
-                break;
             }
-            // If we're inside the child cell and !precision, we need the actual distance to the cell bounds
-            if (!precision && childDistance < EPSILON) {
-                BoxFace childBoundFace;
-                glm::vec3 childBoundNormal;
-                sortedTriangleCell.second->getBounds().findParabolaIntersection(origin, velocity, acceleration, childDistance, childBoundFace, childBoundNormal);
-            }
-            BoxFace childFace;
-            Triangle childTriangle;
-            if (sortedTriangleCell.second->findParabolaIntersection(origin, velocity, acceleration, childDistance, childFace, childTriangle, precision, trianglesTouched)) {
-                if (childDistance < bestLocalDistance) {
-                    bestLocalDistance = childDistance;
-                    bestLocalFace = childFace;
-                    bestLocalTriangle = childTriangle;
-                    intersects = true;
-                    break;
-                }
+            if (childDistance <= maxDistance) {
+                distances[i] = childDistance;
+                hits |= 1 << i;
             }
         }
-    }
+        return hits;
+    };
+    auto triangleTest = [&](const Triangle& thisTriangle, float& thisTriangleDistance) {
+        return findParabolaTriangleIntersection(origin, velocity, acceleration, thisTriangle, thisTriangleDistance, allowBackface);
+    };
+    auto leafBoundsTest = [&](const AABox& bounds, float& boundsDistance, BoxFace& boundsFace) {
+        glm::vec3 boundsNormal;
+        return bounds.findParabolaIntersection(origin, velocity, acceleration, boundsDistance, boundsFace, boundsNormal);
+    };
 
-    if (intersects) {
-        parabolicDistance = bestLocalDistance;
-        face = bestLocalFace;
-        triangle = bestLocalTriangle;
+    int trianglesTouched = 0;
+    bool hit = findIntersection(nodeTest, triangleTest, leafBoundsTest, precision, parabolicDistance, face, triangle, trianglesTouched);
+
+#if WANT_DEBUGGING
+    if (precision) {
+        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangles.size();
     }
-    return intersects;
+#endif
+    return hit;
 }
@@ -11,72 +11,57 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <vector>
-#include <memory>
 
 #include "AABox.h"
 #include "GeometryUtil.h"
 
 class TriangleSet {
 
-    class TriangleTreeCell {
-    public:
-        TriangleTreeCell(std::vector<Triangle>& allTriangles) : _allTriangles(allTriangles) {}
-        TriangleTreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth);
-
-        void insert(size_t triangleIndex);
-        void reset(const AABox& bounds, int depth = 0);
-        void clear();
-
-        bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
-            float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-        bool findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-            float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-
-        const AABox& getBounds() const { return _bounds; }
-
-        void debugDump();
-
-    protected:
-        // checks our internal list of triangles
-        bool findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-            float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-        bool findParabolaIntersectionInternal(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-            float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-
-        std::pair<AABox, AABox> getTriangleTreeCellChildBounds();
-
-        std::vector<Triangle>& _allTriangles;
-        std::pair<std::shared_ptr<TriangleTreeCell>, std::shared_ptr<TriangleTreeCell>> _children;
-        int _depth { 0 };
-        int _population { 0 };
-        AABox _bounds;
-        std::vector<size_t> _triangleIndices;
-
-        friend class TriangleSet;
+    // Bounding volume hierarchy over _triangles, flattened into _nodes in depth first order so a parent always comes
+    // before its children.  Each node holds the boxes of up to BVH_WIDTH children as a structure of arrays, so a ray
+    // is tested against all of them at once.  A child is either another node, or a leaf made of the count triangles
+    // starting at first in _triangles, which is sorted in leaf order when the tree is built.
+    static const int BVH_WIDTH = 4;
+
+    struct BVHNode {
+        float minX[BVH_WIDTH];
+        float minY[BVH_WIDTH];
+        float minZ[BVH_WIDTH];
+        float maxX[BVH_WIDTH];
+        float maxY[BVH_WIDTH];
+        float maxZ[BVH_WIDTH];
+        int32_t first[BVH_WIDTH];     // child node index, first triangle of a leaf, or EMPTY_CHILD
+        uint32_t count[BVH_WIDTH];    // number of triangles of a leaf, 0 for a child node
+
+        AABox getChildBounds(int child) const;
     };
 
-    using SortedTriangleCell = std::pair<float, std::shared_ptr<TriangleTreeCell>>;
+    struct BVHEntry {
+        int32_t first;
+        uint32_t count;
+        float distance;
+    };
 
 public:
-    TriangleSet() : _triangleTree(_triangles) {}
-
     void debugDump();
 
     void insert(const Triangle& t);
 
+    // Replaces the triangle that was inserted index-th.  The tree keeps its topology and only has its boxes refit
+    // on the next query, which is much cheaper than a rebuild for skinned or animated meshes.
+    void setTriangle(size_t index, const Triangle& t);
+
     bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
         float& distance, BoxFace& face, Triangle& triangle, bool precision, bool allowBackface = false);
     bool findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
         float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, bool allowBackface = false);
 
     void balanceTree();
+    void refit();
 
-    void reserve(size_t size) { _triangles.reserve(size); } // reserve space in the datastructure for size number of triangles
+    void reserve(size_t size) { _triangles.reserve(size); _trianglePositions.reserve(size); } // reserve space in the datastructure for size number of triangles
     size_t size() const { return _triangles.size(); }
     void clear();
 
@@ -87,8 +72,16 @@ public:
     const AABox& getBounds() const { return _bounds; }
 
 protected:
+    template <typename NodeTest, typename TriangleTest, typename LeafBoundsTest>
+    bool findIntersection(const NodeTest& nodeTest, const TriangleTest& triangleTest, const LeafBoundsTest& leafBoundsTest,
+        bool precision, float& distance, BoxFace& face, Triangle& triangle, int& trianglesTouched);
+
+    int32_t buildNode(uint32_t first, uint32_t count, std::vector<uint32_t>& order, const std::vector<glm::vec3>& centroids);
+
     bool _isBalanced { false };
+    bool _needsRefit { false };
     std::vector<Triangle> _triangles;
-    TriangleTreeCell _triangleTree;
+    std::vector<uint32_t> _trianglePositions; // position in _triangles of each triangle, in insertion order
+    std::vector<BVHNode> _nodes;
     AABox _bounds;
 };
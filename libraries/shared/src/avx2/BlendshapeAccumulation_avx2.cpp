@@ -0,0 +1,33 @@
+//
+//  BlendshapeAccumulation_avx2.cpp
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+void accumulateBlendshapeOffsets_AVX2(float (*unpacked)[9], const int* indices, const float (*offsets)[9], int size,
+                                      float vertexCoefficient, float normalCoefficient) {
+
+    // scales { px, py, pz, nx, ny, nz, tx, ty }, tz is done separately
+    const __m256 coefficients = _mm256_setr_ps(vertexCoefficient, vertexCoefficient, vertexCoefficient,
+                                               normalCoefficient, normalCoefficient, normalCoefficient,
+                                               normalCoefficient, normalCoefficient);
+    const __m128 tangentZCoefficient = _mm_set_ss(normalCoefficient);
+
+    // indices may repeat, so each entry is stored before the next one is loaded
+    for (int i = 0; i < size; i++) {
+        float* d = unpacked[indices[i]];
+        __m256 s = _mm256_loadu_ps(&offsets[i][0]);
+        __m128 z = _mm_load_ss(&offsets[i][8]);
+        _mm256_storeu_ps(d, _mm256_fmadd_ps(s, coefficients, _mm256_loadu_ps(d)));
+        _mm_store_ss(d + 8, _mm_fmadd_ss(z, tangentZCoefficient, _mm_load_ss(d + 8)));
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
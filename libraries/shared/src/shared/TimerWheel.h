@@ -0,0 +1,300 @@
+//
+//  TimerWheel.h
+//  libraries/shared/src/shared
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Hierarchical timer wheel with a resolution of one millisecond.
+// Starting and stopping a timer is O(1) and independent of the number of timers, which makes it suitable for hosts
+// that juggle thousands of short lived timers where one QTimer per timer would be too costly.
+// Timers only fire from advance(), which dispatches all the timers that came due since the previous call in one batch;
+// the owner decides when to call it, typically once per frame and whenever nextExpiry() is reached.
+// Time is an arbitrary monotonic millisecond counter chosen by the owner, as long as it never goes backwards.
+template <typename T>
+class TimerWheel {
+public:
+    // 0 is never a valid id.  Ids encode a slot and a generation, so a stale id never matches a newer timer.
+    using TimerID = uint64_t;
+    static const TimerID INVALID_TIMER = 0;
+
+    // an expiry time, or NO_EXPIRY when no timer is pending
+    static const uint64_t NO_EXPIRY = std::numeric_limits<uint64_t>::max();
+
+    explicit TimerWheel(uint64_t now = 0) : _currentTick(now) {
+        _slots.resize(NUM_SLOTS, NONE);
+    }
+
+    // Fires after delay milliseconds, then every delay milliseconds if repeat is set.  Timers started while advance()
+    // is dispatching fire at the earliest on the next tick, so a zero delay never fires within the same batch.
+    TimerID start(uint64_t now, int delay, bool repeat, T payload) {
+        int32_t index;
+        if (_freeList.empty()) {
+            index = (int32_t)_nodes.size();
+            _nodes.emplace_back();
+        } else {
+            index = _freeList.back();
+            _freeList.pop_back();
+        }
+        Node& node = _nodes[index];
+        node.generation++;
+        node.active = true;
+        node.interval = repeat ? (uint32_t)std::max(delay, 1) : 0;
+        node.expiry = now + (uint64_t)std::max(delay, 0);
+        node.payload = std::move(payload);
+        insert(index);
+        _size++;
+        return makeID(index, node.generation);
+    }
+
+    // returns false if the timer already fired (single shot) or was stopped.
+    bool stop(TimerID id) {
+        int32_t index = findNode(id);
+        if (index == NONE) {
+            return false;
+        }
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    bool isActive(TimerID id) const { return findNode(id) != NONE; }
+
+    const T* getPayload(TimerID id) const {
+        int32_t index = findNode(id);
+        return index == NONE ? nullptr : &_nodes[index].payload;
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    // Stops all timers.  F is called with the id and payload of each of them before it is released.
+    template <typename F>
+    void clear(F&& visitor) {
+        for (int32_t index = 0; index < (int32_t)_nodes.size(); index++) {
+            if (_nodes[index].active) {
+                visitor(makeID(index, _nodes[index].generation), _nodes[index].payload);
+                unlink(index);
+                release(index);
+            }
+        }
+    }
+    void clear() { clear([](TimerID, const T&) {}); }
+
+    // A lower bound of the time of the next timer to fire, exact when it is less than 256ms away.
+    uint64_t nextExpiry() const {
+        if (_size == 0) {
+            return NO_EXPIRY;
+        }
+        uint64_t result = NO_EXPIRY;
+        for (int level = 0; level < NUM_LEVELS; level++) {
+            int shift = levelShift(level);
+            int count = levelSlots(level);
+            uint64_t block = _currentTick >> shift;
+            // on level 0 the current slot was dispatched already, on the other levels it was cascaded
+            for (int offset = 1; offset <= count; offset++) {
+                if (_slots[slotIndex(level, (int)((block + offset) & (count - 1)))] != NONE) {
+                    result = std::min(result, (block + offset) << shift);
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    // Moves the wheel forward to now and calls fire(id, payload) for every timer that came due, in expiry order.
+    // fire may start and stop timers, including the ones still waiting in this batch.  Returns the number of
+    // timers fired.
+    template <typename F>
+    int advance(uint64_t now, F&& fire) {
+        // skip the stretch with nothing to fire or cascade in one step
+        uint64_t next = nextExpiry();
+        if (next > _currentTick + 1 && _currentTick < now) {
+            _currentTick = std::min(now, next - 1);
+        }
+        while (_currentTick < now) {
+            _currentTick++;
+            for (int level = NUM_LEVELS - 1; level > 0; level--) {
+                if ((_currentTick & ((1ULL << levelShift(level)) - 1)) == 0) {
+                    cascade(level, (int)((_currentTick >> levelShift(level)) & (levelSlots(level) - 1)));
+                }
+            }
+            collect(slotIndex(0, (int)(_currentTick & (LEVEL0_SLOTS - 1))));
+        }
+
+        int fired = 0;
+        for (size_t i = 0; i < _due.size(); i++) {
+            TimerID id = _due[i];
+            int32_t index = findNode(id);
+            if (index == NONE) {
+                // stopped by an earlier callback in this batch
+                continue;
+            }
+            Node& node = _nodes[index];
+            T payload = node.payload;
+            if (node.interval > 0) {
+                // stay on schedule, unless we fell so far behind that the next expiry already passed
+                node.expiry += node.interval;
+                if (node.expiry <= _currentTick) {
+                    node.expiry = _currentTick + node.interval;
+                }
+                insert(index);
+            } else {
+                release(index);
+            }
+            fire(id, payload);
+            fired++;
+        }
+        _due.clear();
+        return fired;
+    }
+
+    uint64_t getCurrentTime() const { return _currentTick; }
+
+private:
+    static const int32_t NONE = -1;
+    static const int LEVEL0_BITS = 8;
+    static const int LEVEL_BITS = 6;
+    static const int NUM_LEVELS = 4;
+    static const int LEVEL0_SLOTS = 1 << LEVEL0_BITS;
+    static const int LEVEL_SLOTS = 1 << LEVEL_BITS;
+    static const int NUM_SLOTS = LEVEL0_SLOTS + (NUM_LEVELS - 1) * LEVEL_SLOTS;
+    static const int GENERATION_SHIFT = 24;  // up to 16M concurrent timers, ids stay below 2^53 for javascript
+
+    struct Node {
+        uint64_t expiry { 0 };
+        uint32_t interval { 0 };   // 0 for single shot timers
+        uint32_t generation { 0 };
+        int32_t prev { NONE };
+        int32_t next { NONE };
+        int32_t slot { NONE };     // NONE while the timer is waiting in _due
+        bool active { false };
+        T payload;
+    };
+
+    static int levelShift(int level) { return level == 0 ? 0 : LEVEL0_BITS + (level - 1) * LEVEL_BITS; }
+    static int levelSlots(int level) { return level == 0 ? LEVEL0_SLOTS : LEVEL_SLOTS; }
+    static int slotIndex(int level, int slot) { return level == 0 ? slot : LEVEL0_SLOTS + (level - 1) * LEVEL_SLOTS + slot; }
+
+    static TimerID makeID(int32_t index, uint32_t generation) {
+        return ((TimerID)(generation & ((1U << 29) - 1)) << GENERATION_SHIFT) | (TimerID)(index + 1);
+    }
+
+    int32_t findNode(TimerID id) const {
+        int32_t index = (int32_t)(id & ((1ULL << GENERATION_SHIFT) - 1)) - 1;
+        if (index < 0 || index >= (int32_t)_nodes.size()) {
+            return NONE;
+        }
+        const Node& node = _nodes[index];
+        return (node.active && makeID(index, node.generation) == id) ? index : NONE;
+    }
+
+    // Files the timer in the slot of the finest level that can hold its expiry.  While cascading, the slot of the
+    // current tick is still to be collected, otherwise timers that are already due go to the next tick.
+    void insert(int32_t index, bool cascading = false) {
+        Node& node = _nodes[index];
+        int slot = NONE;
+        if (node.expiry <= _currentTick) {
+            uint64_t tick = cascading ? _currentTick : _currentTick + 1;
+            slot = slotIndex(0, (int)(tick & (LEVEL0_SLOTS - 1)));
+        } else {
+            for (int level = 0; level < NUM_LEVELS; level++) {
+                int shift = levelShift(level);
+                uint64_t blocks = (node.expiry >> shift) - (_currentTick >> shift);
+                if (blocks < (uint64_t)levelSlots(level)) {
+                    slot = slotIndex(level, (int)((node.expiry >> shift) & (levelSlots(level) - 1)));
+                    break;
+                }
+            }
+            if (slot == NONE) {
+                // beyond the range of the wheel, park it in the last slot of the top level and refile it from there
+                int shift = levelShift(NUM_LEVELS - 1);
+                slot = slotIndex(NUM_LEVELS - 1, (int)(((_currentTick >> shift) + LEVEL_SLOTS - 1) & (LEVEL_SLOTS - 1)));
+            }
+        }
+
+        node.slot = slot;
+        node.prev = NONE;
+        node.next = _slots[slot];
+        if (node.next != NONE) {
+            _nodes[node.next].prev = index;
+        }
+        _slots[slot] = index;
+    }
+
+    void unlink(int32_t index) {
+        Node& node = _nodes[index];
+        if (node.slot == NONE) {
+            return;
+        }
+        if (node.prev != NONE) {
+            _nodes[node.prev].next = node.next;
+        } else {
+            _slots[node.slot] = node.next;
+        }
+        if (node.next != NONE) {
+            _nodes[node.next].prev = node.prev;
+        }
+        node.slot = NONE;
+        node.prev = NONE;
+        node.next = NONE;
+    }
+
+    void release(int32_t index) {
+        Node& node = _nodes[index];
+        node.active = false;
+        node.payload = T();
+        _freeList.push_back(index);
+        _size--;
+    }
+
+    void cascade(int level, int slot) {
+        int32_t index = _slots[slotIndex(level, slot)];
+        _slots[slotIndex(level, slot)] = NONE;
+        while (index != NONE) {
+            int32_t next = _nodes[index].next;
+            insert(index, true);
+            index = next;
+        }
+    }
+
+    void collect(int slot) {
+        // the slot is a stack, reverse it so timers with the same expiry fire in the order they were started
+        size_t first = _due.size();
+        int32_t index = _slots[slot];
+        _slots[slot] = NONE;
+        while (index != NONE) {
+            Node& node = _nodes[index];
+            int32_t next = node.next;
+            node.slot = NONE;
+            node.prev = NONE;
+            node.next = NONE;
+            _due.push_back(makeID(index, node.generation));
+            index = next;
+        }
+        std::reverse(_due.begin() + first, _due.end());
+    }
+
+    std::vector<Node> _nodes;
+    std::vector<int32_t> _freeList;
+    std::vector<int32_t> _slots;
+    std::vector<TimerID> _due;
+    uint64_t _currentTick { 0 };
+    size_t _size { 0 };
+};
+
+template <typename T> const typename TimerWheel<T>::TimerID TimerWheel<T>::INVALID_TIMER;
+template <typename T> const uint64_t TimerWheel<T>::NO_EXPIRY;
+template <typename T> const int32_t TimerWheel<T>::NONE;
+
+#endif // hifi_TimerWheel_h
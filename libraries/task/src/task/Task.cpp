@@ -10,8 +10,76 @@
 //
 #include "Task.h"
 
+#include <unordered_set>
+
+#include <TBBHelpers.h>
+
 using namespace task;
 
+static void collectVaryingIDs(const Varying& varying, std::unordered_set<const void*>& ids) {
+    if (varying.isNull() || !ids.insert(varying.getID()).second) {
+        return;
+    }
+    for (uint8_t i = 0; i < varying.length(); i++) {
+        collectVaryingIDs(varying[i], ids);
+    }
+}
+
+JobGraph::JobGraph(const std::vector<Varying>& inputs, const std::vector<Varying>& outputs) :
+    _dependents(inputs.size()),
+    _numDependencies(inputs.size(), 0)
+{
+    assert(inputs.size() == outputs.size());
+
+    std::vector<std::unordered_set<const void*>> outputIDs(outputs.size());
+    for (size_t i = 0; i < outputs.size(); i++) {
+        collectVaryingIDs(outputs[i], outputIDs[i]);
+    }
+
+    for (size_t job = 0; job < inputs.size(); job++) {
+        std::unordered_set<const void*> inputIDs;
+        collectVaryingIDs(inputs[job], inputIDs);
+
+        // jobs can only consume the outputs of the jobs added before them
+        for (size_t producer = 0; producer < job; producer++) {
+            for (const auto& id : inputIDs) {
+                if (outputIDs[producer].count(id) > 0) {
+                    _dependents[producer].push_back(job);
+                    _numDependencies[job]++;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void JobGraph::run(const std::function<void(size_t)>& runJob) const {
+    const size_t numJobs = getNumJobs();
+    std::unique_ptr<std::atomic<uint32_t>[]> remainingDependencies(new std::atomic<uint32_t>[numJobs]);
+    for (size_t job = 0; job < numJobs; job++) {
+        remainingDependencies[job] = _numDependencies[job];
+    }
+
+    tbb::task_group group;
+    std::function<void(size_t)> spawn = [&](size_t job) {
+        group.run([&, job] {
+            runJob(job);
+            for (auto dependent : _dependents[job]) {
+                if (--remainingDependencies[dependent] == 0) {
+                    spawn(dependent);
+                }
+            }
+        });
+    };
+
+    for (size_t job = 0; job < numJobs; job++) {
+        if (_numDependencies[job] == 0) {
+            spawn(job);
+        }
+    }
+    group.wait();
+}
+
 JobContext::JobContext() {
 }
 
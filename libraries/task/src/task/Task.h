@@ -15,6 +15,8 @@
 #include "Config.h"
 #include "Varying.h"
 
+#include <atomic>
+#include <functional>
 #include <unordered_map>
 
 namespace task {
@@ -55,6 +57,11 @@ public:
     JobContext();
     virtual ~JobContext();
 
+    // Create a copy of this context for a job running concurrently with others in a parallel task.
+    // Returns nullptr when the context holds state that can't be shared between threads, in which case
+    // parallel tasks fall back to running their jobs in order.
+    virtual std::shared_ptr<JobContext> fork() const { return nullptr; }
+
     std::shared_ptr<JobConfig> jobConfig { nullptr };
 
     // Task flow control
@@ -64,6 +71,24 @@ protected:
 };
 using JobContextPointer = std::shared_ptr<JobContext>;
 
+// JobGraph holds the dependencies between the jobs of a task, inferred from the Varyings connecting them:
+// a job depends on every earlier job producing one of the Varyings (or sub Varyings) it takes as input.
+class JobGraph {
+public:
+    JobGraph(const std::vector<Varying>& inputs, const std::vector<Varying>& outputs);
+
+    size_t getNumJobs() const { return _numDependencies.size(); }
+    const std::vector<size_t>& getDependents(size_t job) const { return _dependents[job]; }
+    uint32_t getNumDependencies(size_t job) const { return _numDependencies[job]; }
+
+    // Call runJob once per job on the work-stealing pool, a job starts once all its dependencies completed.
+    void run(const std::function<void(size_t)>& runJob) const;
+
+private:
+    std::vector<std::vector<size_t>> _dependents;
+    std::vector<uint32_t> _numDependencies;
+};
+
 // The guts of a job
 class JobConcept {
 public:
@@ -256,6 +281,11 @@ public:
 
         TaskConcept(const std::string& name, const Varying& input, QConfigPointer config) : Concept(name, config), _input(input) {config->_isTask = true;}
 
+        // Run the jobs concurrently, only ordered by the dependencies between their input and output Varyings.
+        // Jobs of a parallel task must not share any other state, and the context must support fork().
+        void setParallel(bool parallel) { _isParallel = parallel; _jobGraph.reset(); }
+        bool isParallel() const { return _isParallel; }
+
         // Create a new job in the container's queue; returns the job's output
         template <class NT, class... NA> const Varying addJob(std::string name, const Varying& input, NA&&... args) {
             _jobs.emplace_back((NT::JobModel::create(name, input, std::forward<NA>(args)...)));
@@ -263,12 +293,30 @@ public:
             // Conect the child config to this task's config
             std::static_pointer_cast<JobConfig>(Concept::getConfiguration())->connectChildConfig(_jobs.back().getConfiguration(), name);
 
+            _jobGraph.reset();
             return _jobs.back().getOutput();
         }
         template <class NT, class... NA> const Varying addJob(std::string name, NA&&... args) {
             const auto input = Varying(typename NT::JobModel::Input());
             return addJob<NT>(name, input, std::forward<NA>(args)...);
         }
+
+    protected:
+        const JobGraph& getJobGraph() {
+            if (!_jobGraph) {
+                std::vector<Varying> inputs;
+                std::vector<Varying> outputs;
+                for (const auto& job : _jobs) {
+                    inputs.push_back(job.getInput());
+                    outputs.push_back(job.getOutput());
+                }
+                _jobGraph = std::make_shared<JobGraph>(inputs, outputs);
+            }
+            return *_jobGraph;
+        }
+
+        bool _isParallel { false };
+        std::shared_ptr<JobGraph> _jobGraph;
     };
 
     template <class T, class C = Config, class I = None, class O = None> class TaskModel : public TaskConcept {
@@ -330,6 +378,11 @@ public:
         void run(const ContextPointer& jobContext) override {
             auto config = std::static_pointer_cast<C>(Concept::_config);
             if (config->isEnabled()) {
+                if (TaskConcept::_isParallel && TaskConcept::_jobs.size() > 1 && jobContext->fork()) {
+                    runParallel(jobContext);
+                    return;
+                }
+
                 for (auto job : TaskConcept::_jobs) {
                     job.run(jobContext);
                     if (jobContext->taskFlow.doAbortTask()) {
@@ -339,6 +392,24 @@ public:
                 }
             }
         }
+
+    protected:
+        void runParallel(const ContextPointer& jobContext) {
+            // Once a job aborts the task, jobs that haven't started yet are skipped
+            std::atomic<bool> aborted { false };
+            auto& jobs = TaskConcept::_jobs;
+            TaskConcept::getJobGraph().run([&](size_t index) {
+                if (aborted) {
+                    return;
+                }
+                auto forkedContext = std::static_pointer_cast<Context>(jobContext->fork());
+                auto job = jobs[index];
+                job.run(forkedContext);
+                if (forkedContext->taskFlow.doAbortTask()) {
+                    aborted = true;
+                }
+            });
+        }
     };
     template <class T, class C = Config> using Model = TaskModel<T, C, None, None>;
     template <class T, class I, class C = Config> using ModelI = TaskModel<T, C, I, None>;
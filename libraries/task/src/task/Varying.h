@@ -19,6 +19,25 @@
 namespace task {
 class Varying;
 
+namespace detail {
+    // VaryingSetN and VaryingArray expose the Varyings they aggregate through length() and operator[]
+    template <class T>
+    auto subVarying(const T& data, uint8_t index, int) ->
+        typename std::enable_if<std::is_same<typename std::decay<decltype(data[index])>::type, Varying>::value &&
+                                std::is_integral<decltype(data.length())>::value, Varying>::type {
+        return data[index];
+    }
+    template <class T> Varying subVarying(const T&, uint8_t, long);
+
+    template <class T>
+    auto subVaryingLength(const T& data, int) ->
+        typename std::enable_if<std::is_same<typename std::decay<decltype(data[0])>::type, Varying>::value &&
+                                std::is_integral<decltype(data.length())>::value, uint8_t>::type {
+        return (uint8_t)data.length();
+    }
+    template <class T> uint8_t subVaryingLength(const T&, long) { return 0; }
+}
+
 
 // A varying piece of data, to be used as Job/Task I/O
 class Varying {
@@ -46,6 +65,9 @@ public:
 
     bool isNull() const { return _concept == nullptr; }
 
+    // Identifies the data held by this varying, all the copies of a Varying share the same ID
+    const void* getID() const { return _concept.get(); }
+
 protected:
     class Concept {
     public:
@@ -68,10 +90,10 @@ protected:
         virtual ~Model() = default;
 
         virtual Varying operator[] (uint8_t index) const override {
-            return Varying();
+            return detail::subVarying(_data, index, 0);
         }
         virtual uint8_t length() const override {
-            return 0;
+            return detail::subVaryingLength(_data, 0);
         }
 
         Data _data;
@@ -80,6 +102,8 @@ protected:
     std::shared_ptr<Concept> _concept;
 };
 
+template <class T> Varying detail::subVarying(const T&, uint8_t, long) { return Varying(); }
+
 template < typename T0, typename T1 >
 class VaryingSet2 : public std::pair<Varying, Varying> {
 public:
@@ -522,6 +546,8 @@ public:
         assert(list.size() == NUM);
         std::copy(list.begin(), list.end(), std::array<Varying, NUM>::begin());
     }
+
+    uint8_t length() const { return NUM; }
 };
 
 }
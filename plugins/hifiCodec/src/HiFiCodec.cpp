@@ -44,11 +44,16 @@ public:
         _encodedSize = (AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * sizeof(int16_t) * numChannels) / 4;  // codec reduces by 1/4th
     }
 
-    virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override {
+    using Encoder::encode;
+
+    virtual int encode(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) override {
         PerformanceTimer perfTimer("HiFiEncoder::encode");
 
-        encodedBuffer.resize(_encodedSize);
-        AudioEncoder::process((const int16_t*)decodedBuffer.constData(), (int16_t*)encodedBuffer.data(), AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        if (maxEncodedSize < _encodedSize) {
+            return 0;
+        }
+        AudioEncoder::process((const int16_t*)decodedBuffer, (int16_t*)encodedBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        return _encodedSize;
     }
 private:
     int _encodedSize;
@@ -60,20 +65,31 @@ public:
         _decodedSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * sizeof(int16_t) * numChannels;
     }
 
-    virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
+    using Decoder::decode;
+    using Decoder::lostFrame;
+
+    virtual int decode(const char* encodedBuffer, int encodedSize, char* decodedBuffer, int maxDecodedSize) override {
         PerformanceTimer perfTimer("HiFiEncoder::decode");
 
-        decodedBuffer.resize(_decodedSize);
-        AudioDecoder::process((const int16_t*)encodedBuffer.constData(), (int16_t*)decodedBuffer.data(), AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, true);
+        if (maxDecodedSize < _decodedSize) {
+            return 0;
+        }
+        AudioDecoder::process((const int16_t*)encodedBuffer, (int16_t*)decodedBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, true);
+        return _decodedSize;
     }
 
-    virtual void lostFrame(QByteArray& decodedBuffer) override {
+    virtual int lostFrame(char* decodedBuffer, int maxDecodedSize) override {
         PerformanceTimer perfTimer("HiFiEncoder::lostFrame");
 
-        decodedBuffer.resize(_decodedSize);
+        if (maxDecodedSize < _decodedSize) {
+            return 0;
+        }
         // this performs packet loss interpolation
-        AudioDecoder::process(nullptr, (int16_t*)decodedBuffer.data(), AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, false);
+        AudioDecoder::process(nullptr, (int16_t*)decodedBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, false);
+        return _decodedSize;
     }
+
+    virtual int getMaxDecodedSize() const override { return _decodedSize; }
 private:
     int _decodedSize;
 };
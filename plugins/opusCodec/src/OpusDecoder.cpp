@@ -43,6 +43,7 @@ AthenaOpusDecoder::AthenaOpusDecoder(int sampleRate, int numChannels) {
 
     _opusSampleRate = sampleRate;
     _opusNumChannels = numChannels;
+    _decodedSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * static_cast<int>(sizeof(int16_t)) * numChannels;
 
     _decoder = opus_decoder_create(sampleRate, numChannels, &error);
 
@@ -63,18 +64,19 @@ AthenaOpusDecoder::~AthenaOpusDecoder() {
 
 }
 
-void AthenaOpusDecoder::decode(const QByteArray &encodedBuffer, QByteArray &decodedBuffer) {
+int AthenaOpusDecoder::decode(const char* encodedBuffer, int encodedSize, char* decodedBuffer, int maxDecodedSize) {
     assert(_decoder);
     PerformanceTimer perfTimer("AthenaOpusDecoder::decode");
 
     // The audio system encodes and decodes always in fixed size chunks
-    int bufferSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * static_cast<int>(sizeof(int16_t))
-        * _opusNumChannels;
+    if (maxDecodedSize < _decodedSize) {
+        qCCritical(decoder) << "Decode buffer of " << maxDecodedSize << " bytes is too small, " << _decodedSize << " are needed";
+        return 0;
+    }
 
-    decodedBuffer.resize(bufferSize);
-    int bufferFrames = decodedBuffer.size() / _opusNumChannels / static_cast<int>(sizeof(opus_int16));
-    int decoded_frames = opus_decode(_decoder, reinterpret_cast<const unsigned char*>(encodedBuffer.data()),
-        encodedBuffer.length(), reinterpret_cast<opus_int16*>(decodedBuffer.data()), bufferFrames, 0);
+    int bufferFrames = _decodedSize / _opusNumChannels / static_cast<int>(sizeof(opus_int16));
+    int decoded_frames = opus_decode(_decoder, reinterpret_cast<const unsigned char*>(encodedBuffer),
+        encodedSize, reinterpret_cast<opus_int16*>(decodedBuffer), bufferFrames, 0);
 
     if (decoded_frames >= 0) {
 
@@ -83,7 +85,7 @@ void AthenaOpusDecoder::decode(const QByteArray &encodedBuffer, QByteArray &deco
                 << " were expected!";
 
             int start = decoded_frames * static_cast<int>(sizeof(int16_t)) * _opusNumChannels;
-            memset( &decodedBuffer.data()[start], 0, static_cast<size_t>(decodedBuffer.length() - start));
+            memset(&decodedBuffer[start], 0, static_cast<size_t>(_decodedSize - start));
         } else if (decoded_frames > bufferFrames) {
             // This should never happen
             qCCritical(decoder) << "Opus decoder returned " << decoded_frames << ", but only " << bufferFrames
@@ -91,22 +93,23 @@ void AthenaOpusDecoder::decode(const QByteArray &encodedBuffer, QByteArray &deco
         }
     } else {
         qCCritical(decoder) << "Failed to decode audio: " << error_to_string(decoded_frames);
-        decodedBuffer.fill('\0');
+        memset(decodedBuffer, 0, static_cast<size_t>(_decodedSize));
     }
-
+    return _decodedSize;
 }
 
-void AthenaOpusDecoder::lostFrame(QByteArray &decodedBuffer) {
+int AthenaOpusDecoder::lostFrame(char* decodedBuffer, int maxDecodedSize) {
     assert(_decoder);
 
     PerformanceTimer perfTimer("AthenaOpusDecoder::lostFrame");
 
-    int bufferSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * static_cast<int>(sizeof(int16_t))
-        * _opusNumChannels;
-    decodedBuffer.resize(bufferSize);
-    int bufferFrames = decodedBuffer.size() / _opusNumChannels / static_cast<int>(sizeof(opus_int16));
+    if (maxDecodedSize < _decodedSize) {
+        qCCritical(decoder) << "Decode buffer of " << maxDecodedSize << " bytes is too small, " << _decodedSize << " are needed";
+        return 0;
+    }
 
-    int decoded_frames = opus_decode(_decoder, nullptr, 0, reinterpret_cast<opus_int16*>(decodedBuffer.data()),
+    int bufferFrames = _decodedSize / _opusNumChannels / static_cast<int>(sizeof(opus_int16));
+    int decoded_frames = opus_decode(_decoder, nullptr, 0, reinterpret_cast<opus_int16*>(decodedBuffer),
         bufferFrames, 1);
 
     if (decoded_frames >= 0) {
@@ -116,7 +119,7 @@ void AthenaOpusDecoder::lostFrame(QByteArray &decodedBuffer) {
                 << " were expected!";
 
             int start = decoded_frames * static_cast<int>(sizeof(int16_t)) * _opusNumChannels;
-            memset( &decodedBuffer.data()[start], 0, static_cast<size_t>(decodedBuffer.length() - start));
+            memset(&decodedBuffer[start], 0, static_cast<size_t>(_decodedSize - start));
         } else if (decoded_frames > bufferFrames) {
             // This should never happen
             qCCritical(decoder) << "Opus decoder returned " << decoded_frames << ", but only " << bufferFrames
@@ -125,7 +128,7 @@ void AthenaOpusDecoder::lostFrame(QByteArray &decodedBuffer) {
 
     } else {
         qCCritical(decoder) << "Failed to decode lost frame: " << error_to_string(decoded_frames);
-        decodedBuffer.fill('\0');
+        memset(decodedBuffer, 0, static_cast<size_t>(_decodedSize));
     }
-
+    return _decodedSize;
 }
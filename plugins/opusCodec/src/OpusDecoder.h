@@ -22,8 +22,12 @@ public:
     ~AthenaOpusDecoder() override;
 
 
-    virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override;
-    virtual void lostFrame(QByteArray &decodedBuffer) override;
+    using Decoder::decode;
+    using Decoder::lostFrame;
+
+    virtual int decode(const char* encodedBuffer, int encodedSize, char* decodedBuffer, int maxDecodedSize) override;
+    virtual int lostFrame(char* decodedBuffer, int maxDecodedSize) override;
+    virtual int getMaxDecodedSize() const override { return _decodedSize; }
 
 
 private:
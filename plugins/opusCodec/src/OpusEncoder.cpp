@@ -67,26 +67,22 @@ AthenaOpusEncoder::~AthenaOpusEncoder() {
 
 
 
-void AthenaOpusEncoder::encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
+int AthenaOpusEncoder::encode(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) {
 
     PerformanceTimer perfTimer("AthenaOpusEncoder::encode");
     assert(_encoder);
 
-    encodedBuffer.resize(decodedBuffer.size());
-    int frameSize = decodedBuffer.length() / _opusChannels / static_cast<int>(sizeof(opus_int16));
+    int frameSize = decodedSize / _opusChannels / static_cast<int>(sizeof(opus_int16));
 
-    int bytes = opus_encode(_encoder, reinterpret_cast<const opus_int16*>(decodedBuffer.constData()), frameSize,
-        reinterpret_cast<unsigned char*>(encodedBuffer.data()), encodedBuffer.size() );
+    int bytes = opus_encode(_encoder, reinterpret_cast<const opus_int16*>(decodedBuffer), frameSize,
+        reinterpret_cast<unsigned char*>(encodedBuffer), maxEncodedSize);
 
-    if (bytes >= 0) {
-        encodedBuffer.resize(bytes);
-    } else {
-        encodedBuffer.resize(0);
-
-        qCWarning(encoder) << "Error when encoding " << decodedBuffer.length() << " bytes of audio: "
+    if (bytes < 0) {
+        qCWarning(encoder) << "Error when encoding " << decodedSize << " bytes of audio: "
             << errorToString(bytes);
+        return 0;
     }
-
+    return bytes;
 }
 
 int AthenaOpusEncoder::getComplexity() const {
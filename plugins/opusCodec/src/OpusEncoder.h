@@ -20,7 +20,8 @@ public:
     AthenaOpusEncoder(int sampleRate, int numChannels);
     ~AthenaOpusEncoder() override;
 
-    virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override;
+    using Encoder::encode;
+    virtual int encode(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) override;
 
 
     int getComplexity() const;
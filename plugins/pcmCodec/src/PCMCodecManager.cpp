@@ -12,6 +12,9 @@
 #include "PCMCodecManager.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QtEndian>
+
+#include <zlib.h>
 
 #include <PerfStat.h>
 
@@ -92,3 +95,43 @@ void zLibCodec::releaseDecoder(Decoder* decoder) {
     // do nothing... it wasn't allocated
 }
 
+
+// qCompress format: the uncompressed size as a big-endian 32 bit integer, then the zlib stream
+static const int ZLIB_HEADER_SIZE = 4;
+
+int zLibCodec::getMaxEncodedSize(int decodedSize) const {
+    return ZLIB_HEADER_SIZE + (int)compressBound((uLong)decodedSize);
+}
+
+int zLibCodec::encode(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) {
+    if (maxEncodedSize < getMaxEncodedSize(decodedSize)) {
+        return 0;
+    }
+    qToBigEndian<quint32>((quint32)decodedSize, encodedBuffer);
+
+    uLongf compressedSize = (uLongf)(maxEncodedSize - ZLIB_HEADER_SIZE);
+    int result = compress2((Bytef*)encodedBuffer + ZLIB_HEADER_SIZE, &compressedSize,
+                           (const Bytef*)decodedBuffer, (uLong)decodedSize, Z_DEFAULT_COMPRESSION);
+    if (result != Z_OK) {
+        return 0;
+    }
+    return ZLIB_HEADER_SIZE + (int)compressedSize;
+}
+
+int zLibCodec::decode(const char* encodedBuffer, int encodedSize, char* decodedBuffer, int maxDecodedSize) {
+    if (encodedSize <= ZLIB_HEADER_SIZE) {
+        return 0;
+    }
+    quint32 expectedSize = qFromBigEndian<quint32>(encodedBuffer);
+    if (expectedSize > (quint32)maxDecodedSize) {
+        return 0;
+    }
+
+    uLongf decodedSize = (uLongf)expectedSize;
+    int result = uncompress((Bytef*)decodedBuffer, &decodedSize,
+                            (const Bytef*)encodedBuffer + ZLIB_HEADER_SIZE, (uLong)(encodedSize - ZLIB_HEADER_SIZE));
+    if (result != Z_OK) {
+        return 0;
+    }
+    return (int)decodedSize;
+}
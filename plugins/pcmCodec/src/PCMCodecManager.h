@@ -12,9 +12,13 @@
 #ifndef hifi__PCMCodecManager_h
 #define hifi__PCMCodecManager_h
 
+#include <algorithm>
+
 #include <plugins/CodecPlugin.h>
 #include <AudioConstants.h>
 
+const int PCM_CODEC_MAX_DECODED_SIZE = AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC * AudioConstants::SAMPLE_SIZE;
+
 class PCMCodec : public CodecPlugin, public Encoder, public Decoder {
     Q_OBJECT
 
@@ -36,19 +40,31 @@ public:
     virtual void releaseEncoder(Encoder* encoder) override;
     virtual void releaseDecoder(Decoder* decoder) override;
 
-    virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override {
-        encodedBuffer = decodedBuffer;
+    using Encoder::encode;
+    using Decoder::decode;
+    using Decoder::lostFrame;
+
+    virtual int encode(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) override {
+        int size = std::min(decodedSize, maxEncodedSize);
+        memcpy(encodedBuffer, decodedBuffer, size);
+        return size;
     }
 
-    virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
-        decodedBuffer = encodedBuffer;
+    virtual int decode(const char* encodedBuffer, int encodedSize, char* decodedBuffer, int maxDecodedSize) override {
+        int size = std::min(encodedSize, maxDecodedSize);
+        memcpy(decodedBuffer, encodedBuffer, size);
+        return size;
     }
 
-    virtual void lostFrame(QByteArray& decodedBuffer) override {
-        decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-        memset(decodedBuffer.data(), 0, decodedBuffer.size());
+    virtual int lostFrame(char* decodedBuffer, int maxDecodedSize) override {
+        int size = std::min(AudioConstants::NETWORK_FRAME_BYTES_STEREO, maxDecodedSize);
+        memset(decodedBuffer, 0, size);
+        return size;
     }
 
+    // the same instance decodes every stream, up to ambisonic ones
+    virtual int getMaxDecodedSize() const override { return PCM_CODEC_MAX_DECODED_SIZE; }
+
 private:
     static const char* NAME;
 };
@@ -74,19 +90,24 @@ public:
     virtual void releaseEncoder(Encoder* encoder) override;
     virtual void releaseDecoder(Decoder* decoder) override;
 
-    virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override {
-        encodedBuffer = qCompress(decodedBuffer);
-    }
+    using Encoder::encode;
+    using Decoder::decode;
+    using Decoder::lostFrame;
 
-    virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
-        decodedBuffer = qUncompress(encodedBuffer);
-    }
+    // Same format as qCompress/qUncompress, without their allocations
+    virtual int encode(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) override;
+    virtual int getMaxEncodedSize(int decodedSize) const override;
 
-    virtual void lostFrame(QByteArray& decodedBuffer) override {
-        decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-        memset(decodedBuffer.data(), 0, decodedBuffer.size());
+    virtual int decode(const char* encodedBuffer, int encodedSize, char* decodedBuffer, int maxDecodedSize) override;
+
+    virtual int lostFrame(char* decodedBuffer, int maxDecodedSize) override {
+        int size = std::min(AudioConstants::NETWORK_FRAME_BYTES_STEREO, maxDecodedSize);
+        memset(decodedBuffer, 0, size);
+        return size;
     }
 
+    virtual int getMaxDecodedSize() const override { return PCM_CODEC_MAX_DECODED_SIZE; }
+
 private:
     static const char* NAME;
 };
@@ -10,6 +10,8 @@
 #include "AnimTests.h"
 #include <AnimNodeLoader.h>
 #include <AnimClip.h>
+#include <AnimSkeleton.h>
+#include <CompressedAnimation.h>
 #include <AnimBlendLinear.h>
 #include <AnimationLogging.h>
 #include <AnimVariant.h>
@@ -158,6 +160,141 @@ void AnimTests::testClipEvaulateWithVars() {
     QVERIFY(clip._loopFlag == loopFlag2);
 }
 
+static AnimSkeleton::Pointer makeRetargetTestSkeleton(float hipsHeight) {
+    std::vector<HFMJoint> joints;
+    HFMJoint joint;
+    joint.isSkeletonJoint = true;
+
+    joint.name = "Hips";
+    joint.parentIndex = -1;
+    joint.translation = glm::vec3(0.0f, hipsHeight, 0.0f);
+    joints.push_back(joint);
+
+    joint.name = "LeftUpLeg";
+    joint.parentIndex = 0;
+    joint.translation = glm::vec3(0.1f, 0.0f, 0.0f);
+    joints.push_back(joint);
+
+    joint.name = "RightUpLeg";
+    joint.parentIndex = 0;
+    joint.translation = glm::vec3(-0.1f, 0.0f, 0.0f);
+    joints.push_back(joint);
+
+    return std::make_shared<AnimSkeleton>(joints, QMap<int, glm::quat>());
+}
+
+void AnimTests::testRetargetedAnimationSharing() {
+    auto animCache = DependencyManager::get<AnimationCache>();
+    int initialCount = animCache->getNumRetargetedAnimations();
+
+    // each rig in a crowd builds its own skeleton from the same avatar model
+    const int NUM_RIGS = 100;
+    std::vector<AnimSkeleton::Pointer> skeletons;
+    for (int i = 0; i < NUM_RIGS; i++) {
+        skeletons.push_back(makeRetargetTestSkeleton(1.0f));
+        QCOMPARE(skeletons[i]->getHash(), skeletons[0]->getHash());
+    }
+    QVERIFY(makeRetargetTestSkeleton(0.9f)->getHash() != skeletons[0]->getHash());
+
+    QString url = "file:///retargetTest.fbx";
+    std::vector<std::shared_ptr<AnimClip>> clips;
+    for (int i = 0; i < NUM_RIGS; i++) {
+        auto clip = std::make_shared<AnimClip>("clip", url, 0.0f, 10.0f, 1.0f, true, false, AnimBlendType_Normal, "", 0.0f);
+        clip->setSkeleton(skeletons[i]);
+        clips.push_back(clip);
+    }
+
+    // the first rig to finish loading retargets the animation, everyone else shares it.
+    auto key = clips[0]->getRetargetKey(false);
+    QVERIFY(!animCache->getRetargetedAnimation(key));
+    AnimationCache::PoseTrack poses(10, skeletons[0]->getRelativeDefaultPoses());
+    clips[0]->_anim = animCache->addRetargetedAnimation(key, poses);
+    for (int i = 1; i < NUM_RIGS; i++) {
+        clips[i]->_anim = animCache->getRetargetedAnimation(clips[i]->getRetargetKey(false));
+        QVERIFY(clips[i]->_anim == clips[0]->_anim);
+    }
+    QCOMPARE(animCache->getNumRetargetedAnimations(), initialCount + 1);
+
+    // mirrored frames are shared too, under their own key.
+    for (auto& clip : clips) {
+        clip->buildMirrorAnim();
+        QVERIFY(clip->_mirrorAnim == clips[0]->_mirrorAnim);
+    }
+    QVERIFY(clips[0]->_mirrorAnim != clips[0]->_anim);
+    QCOMPARE(animCache->getNumRetargetedAnimations(), initialCount + 2);
+
+    // additive clips bake against a base animation and must not share the normal track.
+    AnimClip additiveClip("additive", url, 0.0f, 10.0f, 1.0f, true, false, AnimBlendType_AddRelative, url, 0.0f);
+    additiveClip.setSkeleton(skeletons[0]);
+    QVERIFY(!animCache->getRetargetedAnimation(additiveClip.getRetargetKey(false)));
+
+    // once the last rig goes away the tracks are released.
+    clips.clear();
+    QCOMPARE(animCache->getNumRetargetedAnimations(), initialCount);
+}
+
+void AnimTests::testCompressedAnimationRoundTrip() {
+    // a 10 second clip of a 60 joint skeleton: most joints hold still, the hips move, limbs swing
+    // and a few joints carry mocap-like jitter that keyframe reduction can't remove.
+    const int NUM_FRAMES = 300;
+    const int NUM_JOINTS = 60;
+    const float PI = (float)M_PI;
+    AnimationCache::PoseTrack poses(NUM_FRAMES, AnimPoseVec(NUM_JOINTS));
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        float t = (float)frame / 30.0f;
+        for (int joint = 0; joint < NUM_JOINTS; joint++) {
+            glm::vec3 axis = glm::normalize(glm::vec3(1.0f, (float)(joint % 3), (float)(joint % 5) + 0.5f));
+            glm::quat rotation;
+            glm::vec3 translation(0.0f, 0.1f * (float)joint, 0.0f);
+            if (joint == 0) {
+                translation += glm::vec3(0.5f * t, 0.05f * sinf(2.0f * PI * t), 0.0f);
+                rotation = glm::angleAxis(0.1f * sinf(PI * t), axis);
+            } else if (joint < 20) {
+                rotation = glm::angleAxis(0.8f * sinf(PI * t + (float)joint), axis);
+            } else if (joint < 23) {
+                rotation = glm::angleAxis(0.01f * sinf(37.0f * t * (float)joint), axis);
+            } else {
+                rotation = glm::angleAxis(0.3f * (float)joint / (float)NUM_JOINTS, axis);
+            }
+            poses[frame][joint] = AnimPose(glm::vec3(1.0f), rotation, translation);
+        }
+    }
+
+    CompressedAnimation compressed(poses);
+    QCOMPARE(compressed.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(compressed.getNumJoints(), NUM_JOINTS);
+
+    // quantization adds a little on top of the keyframe reduction tolerance.
+    const float ROTATION_EPSILON = CompressedAnimation::ROTATION_TOLERANCE + 0.001f;
+    const float TRANSLATION_EPSILON = CompressedAnimation::TRANSLATION_TOLERANCE + TEST_EPSILON;
+    AnimPoseVec sampled;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        compressed.sampleFrame(frame, sampled);
+        QCOMPARE((int)sampled.size(), NUM_JOINTS);
+        for (int joint = 0; joint < NUM_JOINTS; joint++) {
+            const AnimPose& expected = poses[frame][joint];
+            float angle = 2.0f * acosf(std::min(fabsf(glm::dot(sampled[joint].rot(), expected.rot())), 1.0f));
+            QVERIFY(angle <= ROTATION_EPSILON);
+            QVERIFY(glm::length(sampled[joint].trans() - expected.trans()) <= TRANSLATION_EPSILON);
+            QVERIFY(glm::length(sampled[joint].scale() - expected.scale()) <= TEST_EPSILON);
+        }
+    }
+
+    size_t uncompressedSize = NUM_FRAMES * NUM_JOINTS * sizeof(AnimPose);
+    QVERIFY(compressed.getMemorySize() * 10 <= uncompressedSize);
+
+    // quantized rotations survive a round trip through every smallest-three case, including negated quaternions.
+    for (int i = 0; i < 4; i++) {
+        glm::quat rotation(0.1f, 0.2f, -0.3f, 0.4f);
+        rotation[i] = -2.0f;
+        rotation = glm::normalize(rotation);
+        glm::quat result = CompressedAnimation::dequantize(CompressedAnimation::quantize(rotation));
+        QVERIFY(fabsf(glm::dot(result, rotation)) > 1.0f - TEST_EPSILON);
+        result = CompressedAnimation::dequantize(CompressedAnimation::quantize(-rotation));
+        QVERIFY(fabsf(glm::dot(result, rotation)) > 1.0f - TEST_EPSILON);
+    }
+}
+
 void AnimTests::testLoader() {
     auto url = QUrl("https://gist.githubusercontent.com/hyperlogic/756e6b7018c96c9778dba4ffb959c3c7/raw/4b37f10c9d2636608916208ba7b415c1a3f842ff/test.json");
     // NOTE: This will warn about missing "test01.fbx", "test02.fbx", etc. if the resource loading code doesn't handle relative pathnames!
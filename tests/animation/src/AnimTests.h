@@ -23,6 +23,8 @@ private slots:
     void testClipInternalState();
     void testClipEvaulate();
     void testClipEvaulateWithVars();
+    void testRetargetedAnimationSharing();
+    void testCompressedAnimationRoundTrip();
     void testLoader();
     void testVariant();
     void testAccumulateTime();
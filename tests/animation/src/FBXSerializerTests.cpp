@@ -0,0 +1,238 @@
+//
+//  FBXSerializerTests.cpp
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXSerializerTests.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QtEndian>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+#include <FBX.h>
+#include <FBXSerializer.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(FBXSerializerTests)
+
+// Writes a binary FBX 7.4 file (32 bit node offsets) holding a single Geometry: a grid of quads, with its vertices and
+// polygon indices as 'd' and 'i' arrays, parented to a Model.
+class BinaryFBXWriter {
+public:
+    BinaryFBXWriter(bool compressArrays) : _compressArrays(compressArrays) {
+        _data.append(FBX_BINARY_PROLOG);
+        _data.append(FBX_BINARY_PROLOG2);
+        appendValue<quint32>(7400);
+    }
+
+    void beginNode(const char* name) {
+        _nodeStarts.push_back(_data.size());
+        appendValue<quint32>(0); // end offset, filled in by endNode()
+        appendValue<quint32>(0); // property count
+        appendValue<quint32>(0); // property list length
+        quint8 nameLength = (quint8)strlen(name);
+        appendValue<quint8>(nameLength);
+        _data.append(name, nameLength);
+        _hasChildren.push_back(false);
+    }
+
+    void endNode() {
+        if (_hasChildren.back()) {
+            _data.append(QByteArray(13, '\0'));
+        }
+        int start = _nodeStarts.back();
+        _nodeStarts.pop_back();
+        _hasChildren.pop_back();
+        qToLittleEndian<quint32>(_data.size(), (uchar*)_data.data() + start);
+        if (!_hasChildren.empty()) {
+            _hasChildren.back() = true;
+        }
+    }
+
+    void addInt64(qint64 value) {
+        beginProperty('L');
+        appendValue<qint64>(value);
+    }
+
+    void addString(const QByteArray& value) {
+        beginProperty('S');
+        appendValue<quint32>(value.size());
+        _data.append(value);
+    }
+
+    template<class T>
+    void addArray(char type, const QVector<T>& values) {
+        beginProperty(type);
+        QByteArray bytes((const char*)values.constData(), values.size() * (int)sizeof(T));
+        appendValue<quint32>(values.size());
+        if (_compressArrays) {
+            // qCompress prefixes the zlib stream with the uncompressed size, which FBX doesn't have
+            QByteArray compressed = qCompress(bytes).mid(sizeof(quint32));
+            appendValue<quint32>(FBX_PROPERTY_COMPRESSED_FLAG);
+            appendValue<quint32>(compressed.size());
+            _data.append(compressed);
+        } else {
+            appendValue<quint32>(0);
+            appendValue<quint32>(bytes.size());
+            _data.append(bytes);
+        }
+    }
+
+    QByteArray finish() {
+        _data.append(QByteArray(13, '\0'));
+        return _data;
+    }
+
+private:
+    template<class T>
+    void appendValue(T value) {
+        char bytes[sizeof(T)];
+        qToLittleEndian<T>(value, (uchar*)bytes);
+        _data.append(bytes, sizeof(T));
+    }
+
+    void beginProperty(char type) {
+        // bump the property count of the node being written
+        uchar* count = (uchar*)_data.data() + _nodeStarts.back() + sizeof(quint32);
+        qToLittleEndian<quint32>(qFromLittleEndian<quint32>(count) + 1, count);
+        _data.append(type);
+    }
+
+    QByteArray _data;
+    std::vector<int> _nodeStarts;
+    std::vector<bool> _hasChildren;
+    bool _compressArrays;
+};
+
+static QByteArray makeGridFBX(int side, bool compressArrays) {
+    QVector<double> vertices;
+    vertices.reserve(side * side * 3);
+    for (int z = 0; z < side; z++) {
+        for (int x = 0; x < side; x++) {
+            vertices << x << 0.0 << z;
+        }
+    }
+    QVector<qint32> polygonIndices;
+    polygonIndices.reserve((side - 1) * (side - 1) * 4);
+    for (int z = 0; z < side - 1; z++) {
+        for (int x = 0; x < side - 1; x++) {
+            int corner = z * side + x;
+            // the last index of each polygon is stored as its one's complement
+            polygonIndices << corner << corner + side << corner + side + 1 << ~(corner + 1);
+        }
+    }
+
+    const qint64 GEOMETRY_ID = 1000;
+    const qint64 MODEL_ID = 2000;
+    BinaryFBXWriter writer(compressArrays);
+    writer.beginNode("Objects");
+    {
+        writer.beginNode("Geometry");
+        writer.addInt64(GEOMETRY_ID);
+        writer.addString("Geometry::grid");
+        writer.addString("Mesh");
+        writer.beginNode("Vertices");
+        writer.addArray('d', vertices);
+        writer.endNode();
+        writer.beginNode("PolygonVertexIndex");
+        writer.addArray('i', polygonIndices);
+        writer.endNode();
+        writer.endNode();
+
+        writer.beginNode("Model");
+        writer.addInt64(MODEL_ID);
+        writer.addString("Model::grid");
+        writer.addString("Mesh");
+        writer.endNode();
+    }
+    writer.endNode();
+    writer.beginNode("Connections");
+    {
+        writer.beginNode("C");
+        writer.addString("OO");
+        writer.addInt64(GEOMETRY_ID);
+        writer.addInt64(MODEL_ID);
+        writer.endNode();
+        writer.beginNode("C");
+        writer.addString("OO");
+        writer.addInt64(MODEL_ID);
+        writer.addInt64(0);
+        writer.endNode();
+    }
+    writer.endNode();
+    return writer.finish();
+}
+
+void FBXSerializerTests::testBinaryMesh() {
+    const int SIDE = 8;
+    HFMModel::Pointer hfmModel = FBXSerializer().read(makeGridFBX(SIDE, false), hifi::VariantHash());
+    QVERIFY(hfmModel);
+    QCOMPARE(hfmModel->meshes.size(), 1);
+
+    const HFMMesh& mesh = hfmModel->meshes[0];
+    QCOMPARE(mesh.vertices.size(), SIDE * SIDE);
+    QCOMPARE(mesh.parts.size(), 1);
+    QCOMPARE(mesh.parts[0].quadIndices.size(), (SIDE - 1) * (SIDE - 1) * 4);
+    QVERIFY(mesh.vertices.contains(glm::vec3(SIDE - 1, 0.0f, SIDE - 1)));
+}
+
+void FBXSerializerTests::testCompressedArraysMatchRaw() {
+    const int SIDE = 32;
+    HFMModel::Pointer raw = FBXSerializer().read(makeGridFBX(SIDE, false), hifi::VariantHash());
+    HFMModel::Pointer compressed = FBXSerializer().read(makeGridFBX(SIDE, true), hifi::VariantHash());
+    QVERIFY(raw && compressed);
+    QCOMPARE(compressed->meshes.size(), raw->meshes.size());
+    QCOMPARE(compressed->meshes[0].vertices, raw->meshes[0].vertices);
+    QCOMPARE(compressed->meshes[0].parts[0].quadIndices, raw->meshes[0].parts[0].quadIndices);
+}
+
+#ifdef MANUAL_TEST
+// the high water mark of the process memory, in bytes
+static quint64 getPeakMemoryUsage() {
+#if defined(Q_OS_WIN)
+    MemoryInfo info;
+    return getMemoryInfo(info) ? info.processPeakUsedMemoryBytes : 0;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef Q_OS_MAC
+    return (quint64)usage.ru_maxrss;
+#else
+    return (quint64)usage.ru_maxrss * 1024;
+#endif
+#else
+    return 0;
+#endif
+}
+
+void FBXSerializerTests::benchmarkBinaryParse() {
+    // The peak memory is how much the process high water mark grows while parsing, so the sizes go from smallest
+    // to largest: a smaller file parsed after a larger one wouldn't show any growth.
+    const int NUM_PARSES = 5;
+    for (int side : { 128, 512, 1024 }) {
+        for (bool compressArrays : { false, true }) {
+            QByteArray data = makeGridFBX(side, compressArrays);
+            quint64 peakBefore = getPeakMemoryUsage();
+            quint64 totalTime = 0;
+            for (int i = 0; i < NUM_PARSES; i++) {
+                QElapsedTimer timer;
+                timer.start();
+                HFMModel::Pointer hfmModel = FBXSerializer().read(data, hifi::VariantHash());
+                totalTime += timer.nsecsElapsed();
+                QVERIFY(hfmModel && hfmModel->meshes.size() == 1);
+            }
+            quint64 peakGrowth = getPeakMemoryUsage() - peakBefore;
+            qDebug() << side * side << "vertices," << (compressArrays ? "compressed" : "raw") << "arrays,"
+                << data.size() / BYTES_PER_KILOBYTE << "KB:"
+                << (float)totalTime / (float)(NUM_PARSES * NSECS_PER_MSEC) << "msec/parse,"
+                << "peak memory +" << peakGrowth / BYTES_PER_KILOBYTE << "KB";
+        }
+    }
+}
+#endif // MANUAL_TEST
@@ -0,0 +1,25 @@
+//
+//  FBXSerializerTests.h
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXSerializerTests_h
+#define hifi_FBXSerializerTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class FBXSerializerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testBinaryMesh();
+    void testCompressedArraysMatchRaw();
+#ifdef MANUAL_TEST
+    void benchmarkBinaryParse();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_FBXSerializerTests_h
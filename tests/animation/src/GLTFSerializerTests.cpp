@@ -0,0 +1,286 @@
+//
+//  GLTFSerializerTests.cpp
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GLTFSerializerTests.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
+
+#include <tbb/task_arena.h>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <GLTFSerializer.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <ResourceManager.h>
+#include <ResourceRequestObserver.h>
+#include <StatTracker.h>
+
+QTEST_MAIN(GLTFSerializerTests)
+
+static const int GLTF_FLOAT = 5126;
+static const int GLTF_UNSIGNED_INT = 5125;
+
+// A glTF scene of several grid meshes, each one with positions, normals, texture coordinates and indices in accessors
+// of their own.  It is written either as a GLB, with every mesh in its BIN chunk, or as a .gltf with one external .bin
+// file per mesh.
+class GLTFGridScene {
+public:
+    GLTFGridScene(int numMeshes, int side) : _numMeshes(numMeshes), _side(side) {
+        QByteArray mesh;
+        for (int z = 0; z < side; z++) {
+            for (int x = 0; x < side; x++) {
+                appendFloats(mesh, { (float)x, 0.0f, (float)z });
+            }
+        }
+        for (int i = 0; i < side * side; i++) {
+            appendFloats(mesh, { 0.0f, 1.0f, 0.0f });
+        }
+        for (int z = 0; z < side; z++) {
+            for (int x = 0; x < side; x++) {
+                appendFloats(mesh, { (float)x / (float)side, (float)z / (float)side });
+            }
+        }
+        for (int z = 0; z < side - 1; z++) {
+            for (int x = 0; x < side - 1; x++) {
+                quint32 corner = z * side + x;
+                for (quint32 index : { corner, corner + side, corner + 1, corner + 1, corner + side, corner + side + 1 }) {
+                    appendValue<quint32>(mesh, index);
+                }
+            }
+        }
+        _meshData = mesh;
+    }
+
+    int getNumVertices() const { return _side * _side; }
+
+    QByteArray toGLB() const {
+        QByteArray binary;
+        for (int i = 0; i < _numMeshes; i++) {
+            binary.append(_meshData);
+        }
+        QByteArray json = QJsonDocument(toJSON(true)).toJson(QJsonDocument::Compact);
+        padTo4(json, ' ');
+        padTo4(binary, '\0');
+
+        const quint32 GLB_MAGIC = 0x46546C67;  // "glTF"
+        const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;
+        const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;
+        QByteArray glb;
+        appendValue<quint32>(glb, GLB_MAGIC);
+        appendValue<quint32>(glb, 2);
+        appendValue<quint32>(glb, 12 + 8 + json.size() + 8 + binary.size());
+        appendValue<quint32>(glb, json.size());
+        appendValue<quint32>(glb, GLB_CHUNK_TYPE_JSON);
+        glb.append(json);
+        appendValue<quint32>(glb, binary.size());
+        appendValue<quint32>(glb, GLB_CHUNK_TYPE_BIN);
+        glb.append(binary);
+        return glb;
+    }
+
+    // writes the .bin files in the directory and answers the .gltf
+    QByteArray toGLTF(const QString& directory) const {
+        for (int i = 0; i < _numMeshes; i++) {
+            QFile file(directory + "/" + getBufferName(i));
+            if (!file.open(QIODevice::WriteOnly) || file.write(_meshData) != _meshData.size()) {
+                return QByteArray();
+            }
+        }
+        return QJsonDocument(toJSON(false)).toJson(QJsonDocument::Compact);
+    }
+
+private:
+    static QString getBufferName(int meshIndex) { return QString("mesh%1.bin").arg(meshIndex); }
+
+    QJsonObject toJSON(bool singleBuffer) const {
+        const int numVertices = getNumVertices();
+        const int numIndices = (_side - 1) * (_side - 1) * 6;
+        struct Attribute {
+            const char* name;
+            const char* type;
+            int count;
+            int componentSize;
+            int numComponents;
+            int componentType;
+        };
+        const Attribute ATTRIBUTES[] = {
+            { "POSITION", "VEC3", numVertices, 4, 3, GLTF_FLOAT },
+            { "NORMAL", "VEC3", numVertices, 4, 3, GLTF_FLOAT },
+            { "TEXCOORD_0", "VEC2", numVertices, 4, 2, GLTF_FLOAT },
+            { nullptr, "SCALAR", numIndices, 4, 1, GLTF_UNSIGNED_INT }
+        };
+
+        QJsonArray buffers;
+        QJsonArray bufferViews;
+        QJsonArray accessors;
+        QJsonArray meshes;
+        QJsonArray nodes;
+        QJsonArray sceneNodes;
+        for (int i = 0; i < _numMeshes; i++) {
+            int bufferIndex = singleBuffer ? 0 : i;
+            int offset = singleBuffer ? i * _meshData.size() : 0;
+            if (!singleBuffer || i == 0) {
+                QJsonObject buffer { { "byteLength", singleBuffer ? _numMeshes * _meshData.size() : _meshData.size() } };
+                if (!singleBuffer) {
+                    buffer["uri"] = getBufferName(i);
+                }
+                buffers.append(buffer);
+            }
+
+            QJsonObject attributes;
+            QJsonObject primitive;
+            for (const auto& attribute : ATTRIBUTES) {
+                int byteLength = attribute.count * attribute.componentSize * attribute.numComponents;
+                bufferViews.append(QJsonObject {
+                    { "buffer", bufferIndex }, { "byteOffset", offset }, { "byteLength", byteLength }
+                });
+                offset += byteLength;
+                accessors.append(QJsonObject {
+                    { "bufferView", bufferViews.size() - 1 }, { "componentType", attribute.componentType },
+                    { "count", attribute.count }, { "type", attribute.type }
+                });
+                if (attribute.name) {
+                    attributes[attribute.name] = accessors.size() - 1;
+                } else {
+                    primitive["indices"] = accessors.size() - 1;
+                }
+            }
+            primitive["attributes"] = attributes;
+            meshes.append(QJsonObject { { "primitives", QJsonArray { primitive } } });
+            nodes.append(QJsonObject { { "mesh", i }, { "translation", QJsonArray { i * _side, 0, 0 } } });
+            sceneNodes.append(i);
+        }
+
+        return QJsonObject {
+            { "asset", QJsonObject { { "version", "2.0" } } },
+            { "scene", 0 },
+            { "scenes", QJsonArray { QJsonObject { { "nodes", sceneNodes } } } },
+            { "nodes", nodes },
+            { "meshes", meshes },
+            { "accessors", accessors },
+            { "bufferViews", bufferViews },
+            { "buffers", buffers }
+        };
+    }
+
+    template<class T>
+    static void appendValue(QByteArray& data, T value) {
+        char bytes[sizeof(T)];
+        qToLittleEndian<T>(value, (uchar*)bytes);
+        data.append(bytes, sizeof(T));
+    }
+
+    static void appendFloats(QByteArray& data, std::initializer_list<float> values) {
+        for (float value : values) {
+            appendValue<float>(data, value);
+        }
+    }
+
+    static void padTo4(QByteArray& data, char padding) {
+        while (data.size() % 4) {
+            data.append(padding);
+        }
+    }
+
+    int _numMeshes;
+    int _side;
+    QByteArray _meshData;
+};
+
+void GLTFSerializerTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<ResourceRequestObserver>();
+    DependencyManager::set<StatTracker>();
+}
+
+void GLTFSerializerTests::cleanupTestCase() {
+    DependencyManager::get<ResourceManager>()->cleanup();
+}
+
+void GLTFSerializerTests::testGLBMeshes() {
+    const int NUM_MESHES = 4;
+    GLTFGridScene scene(NUM_MESHES, 8);
+    HFMModel::Pointer hfmModel = GLTFSerializer().read(scene.toGLB(), hifi::VariantHash(), hifi::URL("file:///grid.glb"));
+    QVERIFY(hfmModel);
+    QCOMPARE(hfmModel->meshes.size(), NUM_MESHES);
+    for (const HFMMesh& mesh : hfmModel->meshes) {
+        QCOMPARE(mesh.vertices.size(), scene.getNumVertices());
+        QCOMPARE(mesh.normals.size(), scene.getNumVertices());
+        QCOMPARE(mesh.parts.size(), 1);
+    }
+}
+
+void GLTFSerializerTests::testExternalBuffersMatchGLB() {
+    const int NUM_MESHES = 4;
+    GLTFGridScene scene(NUM_MESHES, 16);
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QByteArray gltf = scene.toGLTF(directory.path());
+    QVERIFY(!gltf.isEmpty());
+
+    HFMModel::Pointer glbModel = GLTFSerializer().read(scene.toGLB(), hifi::VariantHash(), hifi::URL("file:///grid.glb"));
+    HFMModel::Pointer gltfModel = GLTFSerializer().read(gltf, hifi::VariantHash(),
+                                                        hifi::URL::fromLocalFile(directory.filePath("grid.gltf")));
+    QVERIFY(glbModel && gltfModel);
+    QCOMPARE(gltfModel->meshes.size(), glbModel->meshes.size());
+    for (int i = 0; i < glbModel->meshes.size(); i++) {
+        QCOMPARE(gltfModel->meshes[i].vertices, glbModel->meshes[i].vertices);
+        QCOMPARE(gltfModel->meshes[i].parts[0].triangleIndices, glbModel->meshes[i].parts[0].triangleIndices);
+    }
+}
+
+#ifdef MANUAL_TEST
+// Loads the same scenes with the accessors decoded on a single thread and on all of them, as a GLB and with one
+// external .bin per mesh fetched through the ResourceManager.  Only the CPU side is timed: nothing is uploaded.
+void GLTFSerializerTests::benchmarkLoad() {
+    const int NUM_LOADS = 5;
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    for (int numMeshes : { 16, 64 }) {
+        for (int side : { 64, 256 }) {
+            GLTFGridScene scene(numMeshes, side);
+            QByteArray glb = scene.toGLB();
+            QByteArray gltf = scene.toGLTF(directory.path());
+            QVERIFY(!gltf.isEmpty());
+            hifi::URL gltfURL = hifi::URL::fromLocalFile(directory.filePath("grid.gltf"));
+
+            for (int numThreads : { 1, tbb::task_arena::automatic }) {
+                tbb::task_arena arena(numThreads);
+                quint64 glbTime = 0;
+                quint64 gltfTime = 0;
+                for (int i = 0; i < NUM_LOADS; i++) {
+                    arena.execute([&] {
+                        QElapsedTimer timer;
+                        timer.start();
+                        HFMModel::Pointer glbModel = GLTFSerializer().read(glb, hifi::VariantHash(), hifi::URL("file:///grid.glb"));
+                        glbTime += timer.nsecsElapsed();
+
+                        timer.restart();
+                        HFMModel::Pointer gltfModel = GLTFSerializer().read(gltf, hifi::VariantHash(), gltfURL);
+                        gltfTime += timer.nsecsElapsed();
+                        QVERIFY(glbModel && gltfModel);
+                    });
+                }
+                qDebug() << numMeshes << "meshes of" << scene.getNumVertices() << "vertices,"
+                    << (numThreads == 1 ? "1 thread:" : "all threads:")
+                    << "glb" << (float)glbTime / (float)(NUM_LOADS * NSECS_PER_MSEC) << "msec/load,"
+                    << "gltf with external buffers" << (float)gltfTime / (float)(NUM_LOADS * NSECS_PER_MSEC) << "msec/load";
+            }
+        }
+    }
+}
+#endif // MANUAL_TEST
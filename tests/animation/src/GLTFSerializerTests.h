@@ -0,0 +1,27 @@
+//
+//  GLTFSerializerTests.h
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GLTFSerializerTests_h
+#define hifi_GLTFSerializerTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class GLTFSerializerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testGLBMeshes();
+    void testExternalBuffersMatchGLB();
+#ifdef MANUAL_TEST
+    void benchmarkLoad();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_GLTFSerializerTests_h
@@ -0,0 +1,338 @@
+//
+//  RigTests.cpp
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RigTests.h"
+
+#include <glm/gtx/transform.hpp>
+
+#include <Rig.h>
+#include <AnimationCache.h>
+#include <NodeList.h>
+#include <AddressManager.h>
+#include <AccountManager.h>
+#include <ResourceManager.h>
+#include <ResourceRequestObserver.h>
+#include <StatTracker.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(RigTests)
+
+const float TEST_EPSILON = 0.0001f;
+const float FRAME_TIME = 1.0f / 60.0f;
+
+struct JointDesc {
+    const char* name;
+    int parentIndex;
+    glm::vec3 translation;
+};
+
+// a small humanoid with the joint names the default avatar anim graph expects.
+static const JointDesc HUMANOID_JOINTS[] = {
+    { "Hips", -1, { 0.0f, 1.0f, 0.0f } },
+    { "Spine", 0, { 0.0f, 0.1f, 0.0f } },
+    { "Spine1", 1, { 0.0f, 0.1f, 0.0f } },
+    { "Spine2", 2, { 0.0f, 0.1f, 0.0f } },
+    { "Neck", 3, { 0.0f, 0.15f, 0.0f } },
+    { "Head", 4, { 0.0f, 0.1f, 0.0f } },
+    { "LeftEye", 5, { 0.03f, 0.08f, 0.08f } },
+    { "RightEye", 5, { -0.03f, 0.08f, 0.08f } },
+    { "LeftShoulder", 3, { 0.05f, 0.1f, 0.0f } },
+    { "LeftArm", 8, { 0.1f, 0.0f, 0.0f } },
+    { "LeftForeArm", 9, { 0.25f, 0.0f, 0.0f } },
+    { "LeftHand", 10, { 0.25f, 0.0f, 0.0f } },
+    { "RightShoulder", 3, { -0.05f, 0.1f, 0.0f } },
+    { "RightArm", 12, { -0.1f, 0.0f, 0.0f } },
+    { "RightForeArm", 13, { -0.25f, 0.0f, 0.0f } },
+    { "RightHand", 14, { -0.25f, 0.0f, 0.0f } },
+    { "LeftUpLeg", 0, { 0.1f, -0.05f, 0.0f } },
+    { "LeftLeg", 16, { 0.0f, -0.45f, 0.0f } },
+    { "LeftFoot", 17, { 0.0f, -0.45f, 0.0f } },
+    { "LeftToeBase", 18, { 0.0f, -0.05f, 0.1f } },
+    { "RightUpLeg", 0, { -0.1f, -0.05f, 0.0f } },
+    { "RightLeg", 20, { 0.0f, -0.45f, 0.0f } },
+    { "RightFoot", 21, { 0.0f, -0.45f, 0.0f } },
+    { "RightToeBase", 22, { 0.0f, -0.05f, 0.1f } }
+};
+
+static void makeHumanoid(HFMModel& hfmModel) {
+    for (auto& desc : HUMANOID_JOINTS) {
+        HFMJoint joint;
+        joint.name = desc.name;
+        joint.parentIndex = desc.parentIndex;
+        joint.distanceToParent = glm::length(desc.translation);
+        joint.translation = desc.translation;
+        joint.preTransform = glm::mat4();
+        joint.preRotation = glm::quat();
+        joint.rotation = glm::quat();
+        joint.postRotation = glm::quat();
+        joint.postTransform = glm::mat4();
+        joint.rotationMin = glm::vec3(-PI);
+        joint.rotationMax = glm::vec3(PI);
+        joint.inverseDefaultRotation = glm::quat();
+        joint.inverseBindRotation = glm::quat();
+        joint.isSkeletonJoint = true;
+
+        glm::mat4 parentTransform = joint.parentIndex >= 0 ? hfmModel.joints[joint.parentIndex].transform : glm::mat4();
+        joint.transform = parentTransform * glm::translate(joint.translation);
+        joint.bindTransform = joint.transform;
+        hfmModel.joints.push_back(joint);
+    }
+}
+
+static QString getInterfaceResourcesPath() {
+    QFileInfo file(__FILE__);
+    return QDir::cleanPath(file.absolutePath() + "/../../../interface/resources");
+}
+
+static QTemporaryDir* animGraphDir { nullptr };
+static QUrl animGraphUrl;
+static std::vector<AnimationPointer> animGraphClips;
+
+// The default avatar graph: state machines, blends, overlays, IK and flow.  Its clips are qrc resources of interface,
+// so the graph is copied with its clips pointed at the same files in interface/resources, which load here.
+static bool makeAnimGraph() {
+    QFile source(getInterfaceResourcesPath() + "/avatar/avatar-animation.json");
+    if (!source.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QString graph = QString::fromUtf8(source.readAll());
+    QString animationsUrl = QUrl::fromLocalFile(getInterfaceResourcesPath() + "/avatar/animations/").toString();
+    graph.replace("qrc:///avatar/animations/", animationsUrl);
+
+    animGraphDir = new QTemporaryDir();
+    QFile file(animGraphDir->filePath("avatar-animation.json"));
+    if (!animGraphDir->isValid() || !file.open(QIODevice::WriteOnly) || file.write(graph.toUtf8()) < 0) {
+        return false;
+    }
+    animGraphUrl = QUrl::fromLocalFile(file.fileName());
+
+    // load every clip up front and keep it in the cache, so the rigs play them from their first frame
+    QSet<QString> clipUrls;
+    QRegularExpression urlExpression("\"url\"\\s*:\\s*\"([^\"]+)\"");
+    auto matches = urlExpression.globalMatch(graph);
+    while (matches.hasNext()) {
+        clipUrls.insert(matches.next().captured(1));
+    }
+    auto animationCache = DependencyManager::get<AnimationCache>();
+    for (auto& url : clipUrls) {
+        animGraphClips.push_back(animationCache->getAnimation(QUrl(url)));
+    }
+
+    const quint64 LOAD_TIMEOUT = 60 * USECS_PER_SECOND;
+    quint64 start = usecTimestampNow();
+    while (usecTimestampNow() - start < LOAD_TIMEOUT) {
+        bool isDone = true;
+        for (auto& clip : animGraphClips) {
+            isDone = isDone && (clip->isLoaded() || clip->isFailed());
+        }
+        if (isDone) {
+            break;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    for (auto& clip : animGraphClips) {
+        if (!clip->isLoaded()) {
+            qWarning() << "Failed to load" << clip->getURL();
+            return false;
+        }
+    }
+    return !animGraphClips.empty();
+}
+
+// motion of one crowd member, as recorded by an avatar walking a loop around the origin.
+struct RecordedFrame {
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::quat rotation;
+};
+
+static std::vector<RecordedFrame> recordWalk(int numFrames, float phase) {
+    std::vector<RecordedFrame> frames;
+    frames.reserve(numFrames);
+    const float RADIUS = 5.0f;
+    for (int i = 0; i < numFrames; i++) {
+        // walk, stop, then turn in place, so the state machine visits several states.
+        float t = (float)i * FRAME_TIME;
+        float speed = (i % 240) < 160 ? 1.4f : 0.0f;
+        float angle = phase + speed * t / RADIUS;
+        RecordedFrame frame;
+        frame.position = glm::vec3(RADIUS * cosf(angle), 0.0f, RADIUS * sinf(angle));
+        frame.velocity = speed * glm::vec3(-sinf(angle), 0.0f, cosf(angle));
+        frame.rotation = glm::angleAxis(-angle, Vectors::UNIT_Y);
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+class Crowd {
+public:
+    Crowd(int numRigs, int numFrames) {
+        HFMModel hfmModel;
+        makeHumanoid(hfmModel);
+
+        QEventLoop loop;
+        int numPending = numRigs;
+        for (int i = 0; i < numRigs; i++) {
+            auto rig = std::make_shared<Rig>();
+            rig->initJointStates(hfmModel, glm::mat4());
+            QObject::connect(rig.get(), &Rig::onLoadComplete, &loop, [&] { if (--numPending == 0) { loop.quit(); } });
+            QObject::connect(rig.get(), &Rig::onLoadFailed, &loop, [&] { if (--numPending == 0) { loop.quit(); } });
+            rig->initAnimGraph(animGraphUrl);
+            _rigs.push_back(rig);
+            _recordings.push_back(recordWalk(numFrames, (float)i * TWO_PI / (float)numRigs));
+        }
+        const int LOAD_TIMEOUT = 5000;
+        QTimer::singleShot(LOAD_TIMEOUT, &loop, SLOT(quit()));
+        loop.exec();
+    }
+
+    bool isLoaded() const {
+        for (auto& rig : _rigs) {
+            if (!rig->getAnimNode()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void replayFrame(int frame) {
+        for (size_t i = 0; i < _rigs.size(); i++) {
+            const RecordedFrame& input = _recordings[i][frame];
+            _rigs[i]->computeMotionAnimationState(FRAME_TIME, input.position, input.velocity, input.rotation,
+                                                  Rig::CharacterControllerState::Ground, 1.0f);
+        }
+    }
+
+    void updateSerial() {
+        for (auto& rig : _rigs) {
+            rig->updateAnimations(FRAME_TIME, glm::mat4(), glm::mat4());
+        }
+    }
+
+    // the local rotations of every joint of every rig
+    std::vector<glm::quat> getRotations() const {
+        std::vector<glm::quat> rotations;
+        for (auto& rig : _rigs) {
+            for (int j = 0; j < rig->getJointStateCount(); j++) {
+                rotations.push_back(rig->getJointPose(j).rot());
+            }
+        }
+        return rotations;
+    }
+
+    void updateBatched() {
+        std::vector<Rig::AnimationUpdate> updates;
+        updates.reserve(_rigs.size());
+        for (auto& rig : _rigs) {
+            updates.push_back({ rig.get(), FRAME_TIME, glm::mat4(), glm::mat4() });
+        }
+        Rig::updateAnimations(updates);
+    }
+
+    std::vector<std::shared_ptr<Rig>> _rigs;
+    std::vector<std::vector<RecordedFrame>> _recordings;
+};
+
+void RigTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<AnimationCache>();
+    DependencyManager::set<ResourceRequestObserver>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<StatTracker>();
+
+    QVERIFY(makeAnimGraph());
+}
+
+void RigTests::cleanupTestCase() {
+    animGraphClips.clear();
+    delete animGraphDir;
+    animGraphDir = nullptr;
+    DependencyManager::get<ResourceManager>()->cleanup();
+}
+
+// the largest angle between the rotations of the same joints
+static float getMaxAngle(const std::vector<glm::quat>& a, const std::vector<glm::quat>& b) {
+    float maxAngle = 0.0f;
+    for (size_t i = 0; i < a.size() && i < b.size(); i++) {
+        maxAngle = std::max(maxAngle, fabsf(glm::angle(glm::normalize(glm::inverse(a[i]) * b[i]))));
+    }
+    return maxAngle;
+}
+
+void RigTests::testBatchedUpdateMatchesSerial() {
+    const int NUM_RIGS = 16;
+    const int NUM_FRAMES = 300;
+    Crowd serial(NUM_RIGS, NUM_FRAMES);
+    Crowd batched(NUM_RIGS, NUM_FRAMES);
+    QVERIFY(serial.isLoaded());
+    QVERIFY(batched.isLoaded());
+
+    const int FIRST_SAMPLED_FRAME = NUM_FRAMES / 3;
+    std::vector<glm::quat> bindRotations = serial.getRotations();
+    std::vector<glm::quat> sampledRotations;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        serial.replayFrame(frame);
+        serial.updateSerial();
+        batched.replayFrame(frame);
+        batched.updateBatched();
+        if (frame == FIRST_SAMPLED_FRAME) {
+            sampledRotations = serial.getRotations();
+        }
+    }
+
+    // the clips drive the joints away from the bind pose, and keep moving them, so there is something to compare
+    const float MIN_ANGLE = 0.05f;
+    std::vector<glm::quat> lastRotations = serial.getRotations();
+    QVERIFY(getMaxAngle(bindRotations, lastRotations) > MIN_ANGLE);
+    QVERIFY(getMaxAngle(sampledRotations, lastRotations) > MIN_ANGLE);
+
+    for (int i = 0; i < NUM_RIGS; i++) {
+        int numJoints = serial._rigs[i]->getJointStateCount();
+        QCOMPARE(batched._rigs[i]->getJointStateCount(), numJoints);
+        for (int j = 0; j < numJoints; j++) {
+            AnimPose expected = serial._rigs[i]->getJointPose(j);
+            AnimPose actual = batched._rigs[i]->getJointPose(j);
+            QCOMPARE_WITH_ABS_ERROR(actual.trans(), expected.trans(), TEST_EPSILON);
+            QCOMPARE_QUATS(actual.rot(), expected.rot(), TEST_EPSILON);
+        }
+    }
+}
+
+#ifdef MANUAL_TEST
+void RigTests::benchmarkCrowd() {
+    const int NUM_FRAMES = 600;
+    for (int numRigs : { 10, 100, 400 }) {
+        Crowd crowd(numRigs, NUM_FRAMES);
+        QVERIFY(crowd.isLoaded());
+
+        uint64_t serialTime = 0;
+        uint64_t batchedTime = 0;
+        for (int frame = 0; frame < NUM_FRAMES; frame++) {
+            crowd.replayFrame(frame);
+            uint64_t start = usecTimestampNow();
+            if (frame % 2) {
+                crowd.updateBatched();
+                batchedTime += usecTimestampNow() - start;
+            } else {
+                crowd.updateSerial();
+                serialTime += usecTimestampNow() - start;
+            }
+        }
+        qDebug() << numRigs << "rigs:"
+            << "serial" << (float)serialTime / (float)(NUM_FRAMES / 2) << "usec/frame,"
+            << "batched" << (float)batchedTime / (float)(NUM_FRAMES / 2) << "usec/frame";
+    }
+}
+#endif // MANUAL_TEST
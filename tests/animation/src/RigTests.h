@@ -0,0 +1,26 @@
+//
+//  RigTests.h
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RigTests_h
+#define hifi_RigTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class RigTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testBatchedUpdateMatchesSerial();
+#ifdef MANUAL_TEST
+    void benchmarkCrowd();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_RigTests_h
@@ -0,0 +1,247 @@
+//
+//  CodecAllocationTests.cpp
+//  tests/audio/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CodecAllocationTests.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <AudioConstants.h>
+#include <InboundAudioStream.h>
+#include <plugins/CodecPlugin.h>
+
+QTEST_MAIN(CodecAllocationTests)
+
+// Count the heap allocations made by this process while counting is enabled
+static std::atomic<bool> countAllocations { false };
+static std::atomic<int> numAllocations { 0 };
+
+static void countAllocation() {
+    if (countAllocations.load(std::memory_order_relaxed)) {
+        numAllocations++;
+    }
+}
+
+#if defined(__GLIBC__)
+
+// Count at the malloc level, which QByteArray and the codec libraries allocate through as well as operator new
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+
+void* malloc(size_t size) __THROW {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) __THROW {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) __THROW {
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+}
+
+#else
+
+// malloc can't be interposed here, so only operator new is counted: the tests also check that the buffers they reuse
+// keep their storage, which catches the QByteArray allocations
+void* operator new(std::size_t size) {
+    countAllocation();
+    void* pointer = std::malloc(size ? size : 1);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+#endif
+
+class AllocationCounter {
+public:
+    AllocationCounter() { numAllocations = 0; countAllocations = true; }
+    ~AllocationCounter() { countAllocations = false; }
+    int count() const { return numAllocations; }
+};
+
+// Halves the samples on encode and doubles them back on decode, so the data goes through the codec
+class TestCodec : public CodecPlugin, public Encoder, public Decoder {
+public:
+    const QString getName() const override { return "test"; }
+    bool isSupported() const override { return true; }
+
+    Encoder* createEncoder(int sampleRate, int numChannels) override { _numChannels = numChannels; return this; }
+    Decoder* createDecoder(int sampleRate, int numChannels) override { _numChannels = numChannels; return this; }
+    void releaseEncoder(Encoder* encoder) override {}
+    void releaseDecoder(Decoder* decoder) override {}
+
+    using Encoder::encode;
+    using Decoder::decode;
+    using Decoder::lostFrame;
+
+    int encode(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) override {
+        int numSamples = std::min(decodedSize, maxEncodedSize) / AudioConstants::SAMPLE_SIZE;
+        for (int i = 0; i < numSamples; i++) {
+            ((int16_t*)encodedBuffer)[i] = ((const int16_t*)decodedBuffer)[i] / 2;
+        }
+        return numSamples * AudioConstants::SAMPLE_SIZE;
+    }
+
+    int decode(const char* encodedBuffer, int encodedSize, char* decodedBuffer, int maxDecodedSize) override {
+        int numSamples = std::min(encodedSize, maxDecodedSize) / AudioConstants::SAMPLE_SIZE;
+        for (int i = 0; i < numSamples; i++) {
+            ((int16_t*)decodedBuffer)[i] = ((const int16_t*)encodedBuffer)[i] * 2;
+        }
+        return numSamples * AudioConstants::SAMPLE_SIZE;
+    }
+
+    int lostFrame(char* decodedBuffer, int maxDecodedSize) override {
+        int size = std::min(getMaxDecodedSize(), maxDecodedSize);
+        memset(decodedBuffer, 0, size);
+        return size;
+    }
+
+    int getMaxDecodedSize() const override { return AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * _numChannels; }
+
+private:
+    int _numChannels { AudioConstants::MONO };
+};
+
+// Exposes the packet handling of the stream
+class TestInboundAudioStream : public InboundAudioStream {
+public:
+    TestInboundAudioStream() :
+        InboundAudioStream(AudioConstants::MONO, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, 10, -1) {}
+
+    using InboundAudioStream::parseAudioData;
+    using InboundAudioStream::lostAudioData;
+
+    const char* getDecodedBufferData() const { return _decodedBuffer.data(); }
+    size_t getDecodedBufferCapacity() const { return _decodedBuffer.capacity(); }
+};
+
+static QByteArray makeFrame(int numSamples) {
+    QByteArray frame(numSamples * AudioConstants::SAMPLE_SIZE, 0);
+    for (int i = 0; i < numSamples; i++) {
+        ((int16_t*)frame.data())[i] = (int16_t)(i * 2);
+    }
+    return frame;
+}
+
+void CodecAllocationTests::testByteArrayAdapter() {
+    TestCodec codec;
+    Encoder* encoder = codec.createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    Decoder* decoder = codec.createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+
+    QByteArray frame = makeFrame(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+    QByteArray encoded;
+    QByteArray decoded;
+    encoder->encode(frame, encoded);
+    decoder->decode(encoded, decoded);
+    QCOMPARE(encoded.size(), frame.size());
+    QCOMPARE(decoded, frame);
+
+    decoder->lostFrame(decoded);
+    QCOMPARE(decoded.size(), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+    QCOMPARE(decoded, QByteArray(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0));
+}
+
+void CodecAllocationTests::testByteArrayAdapterReusesBuffers() {
+    TestCodec codec;
+    Encoder* encoder = codec.createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    Decoder* decoder = codec.createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+
+    // what Agent and AudioClient do every frame: encode and decode into QByteArrays they keep
+    QByteArray frame = makeFrame(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+    QByteArray encoded;
+    QByteArray decoded;
+    encoder->encode(frame, encoded);
+    decoder->decode(encoded, decoded);
+    const char* encodedData = encoded.constData();
+    const char* decodedData = decoded.constData();
+
+    {
+        AllocationCounter counter;
+        for (int i = 0; i < 100; i++) {
+            encoder->encode(frame, encoded);
+            decoder->decode(encoded, decoded);
+            decoder->lostFrame(decoded);
+        }
+        QCOMPARE(counter.count(), 0);
+    }
+    QVERIFY(encoded.constData() == encodedData);
+    QVERIFY(decoded.constData() == decodedData);
+    QCOMPARE(decoded.size(), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+}
+
+void CodecAllocationTests::testEncodeDoesNotAllocate() {
+    TestCodec codec;
+    Encoder* encoder = codec.createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+
+    // what the mixer does for every listener: encode the mix into a buffer owned by the listener data
+    int16_t mix[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] = { 0 };
+    std::vector<char> encodedBuffer(encoder->getMaxEncodedSize(AudioConstants::NETWORK_FRAME_BYTES_STEREO));
+
+    AllocationCounter counter;
+    for (int frame = 0; frame < 100; frame++) {
+        int encodedSize = encoder->encode((const char*)mix, AudioConstants::NETWORK_FRAME_BYTES_STEREO,
+                                          encodedBuffer.data(), (int)encodedBuffer.size());
+        QVERIFY(encodedSize > 0);
+    }
+    QCOMPARE(counter.count(), 0);
+}
+
+void CodecAllocationTests::testInboundStreamDoesNotAllocate() {
+    auto codec = std::make_shared<TestCodec>();
+    TestInboundAudioStream stream;
+    stream.setupCodec(codec, codec->getName(), AudioConstants::MONO);
+
+    QByteArray packet;
+    codec->encode(makeFrame(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL), packet);
+
+    // warm up, then every frame must be decoded without touching the heap
+    stream.parseAudioData(packet);
+    const char* decodedData = stream.getDecodedBufferData();
+    size_t decodedCapacity = stream.getDecodedBufferCapacity();
+    {
+        AllocationCounter counter;
+        for (int frame = 0; frame < 100; frame++) {
+            stream.parseAudioData(packet);
+            stream.lostAudioData(1);
+            stream.clearBuffer();
+        }
+        QCOMPARE(counter.count(), 0);
+    }
+    QVERIFY(stream.getDecodedBufferData() == decodedData);
+    QCOMPARE(stream.getDecodedBufferCapacity(), decodedCapacity);
+
+    // without a codec the packets go straight to the ring buffer
+    stream.cleanupCodec();
+    {
+        AllocationCounter counter;
+        for (int frame = 0; frame < 100; frame++) {
+            stream.parseAudioData(packet);
+            stream.lostAudioData(1);
+            stream.clearBuffer();
+        }
+        QCOMPARE(counter.count(), 0);
+    }
+}
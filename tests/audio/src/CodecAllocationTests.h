@@ -0,0 +1,23 @@
+//
+//  CodecAllocationTests.h
+//  tests/audio/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CodecAllocationTests_h
+#define hifi_CodecAllocationTests_h
+
+#include <QtTest/QtTest>
+
+class CodecAllocationTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testByteArrayAdapter();
+    void testByteArrayAdapterReusesBuffers();
+    void testEncodeDoesNotAllocate();
+    void testInboundStreamDoesNotAllocate();
+};
+
+#endif // hifi_CodecAllocationTests_h
@@ -0,0 +1,200 @@
+//
+//  PolyVoxChunkedMeshTests.cpp
+//  tests/entities-renderer/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunkedMeshTests.h"
+
+#include <iostream>
+#include <memory>
+
+#include <PolyVoxChunkedMesh.h>
+#include <SharedUtil.h>
+
+#include <test-utils/QTestExtensions.h>
+
+#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
+#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
+
+QTEST_MAIN(PolyVoxChunkedMeshTests)
+
+using Volume = PolyVoxChunkedMesh::Volume;
+using Vertex = PolyVoxChunkedMesh::Vertex;
+using Extractor = PolyVoxChunkedMesh::Extractor;
+
+const uint8_t SOLID = 255;
+
+// a non-edged volume of size^3 user voxels, allocated as RenderablePolyVoxEntityItem does
+static std::unique_ptr<Volume> makeTerrain(int size) {
+    std::unique_ptr<Volume> volume(new Volume(PolyVox::Region(PolyVox::Vector3DInt32(0, 0, 0),
+                                                              PolyVox::Vector3DInt32(size, size, size))));
+    volume->setBorderValue(SOLID);
+    for (int z = 0; z < size; z++) {
+        for (int x = 0; x < size; x++) {
+            int height = (int)(size * (0.5f + 0.2f * sinf(x * 0.1f) * cosf(z * 0.13f)));
+            for (int y = 0; y < height; y++) {
+                volume->setVoxelAt(x, y, z, SOLID);
+            }
+        }
+    }
+    return volume;
+}
+
+static void setSphere(Volume& volume, PolyVoxChunkedMesh& chunkedMesh, const glm::ivec3& center, int radius, uint8_t value) {
+    for (int z = center.z - radius; z <= center.z + radius; z++) {
+        for (int y = center.y - radius; y <= center.y + radius; y++) {
+            for (int x = center.x - radius; x <= center.x + radius; x++) {
+                glm::ivec3 voxel(x, y, z);
+                if (glm::distance(glm::vec3(voxel), glm::vec3(center)) <= radius &&
+                    glm::all(glm::greaterThanEqual(voxel, glm::ivec3(0))) &&
+                    glm::all(glm::lessThan(voxel, glm::ivec3(volume.getWidth(), volume.getHeight(), volume.getDepth()))) &&
+                    volume.getVoxelAt(x, y, z) != value) {
+                    volume.setVoxelAt(x, y, z, value);
+                    chunkedMesh.markVoxelChanged(voxel);
+                }
+            }
+        }
+    }
+}
+
+static glm::ivec3 randomVoxel(int size) {
+    return glm::ivec3(rand() % size, rand() % size, rand() % size);
+}
+
+static float surfaceArea(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    auto toVec3 = [](const Vertex& vertex) {
+        PolyVox::Vector3DFloat position = vertex.getPosition();
+        return glm::vec3(position.getX(), position.getY(), position.getZ());
+    };
+    float area = 0.0f;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        glm::vec3 p0 = toVec3(vertices[indices[i]]);
+        glm::vec3 p1 = toVec3(vertices[indices[i + 1]]);
+        glm::vec3 p2 = toVec3(vertices[indices[i + 2]]);
+        area += 0.5f * glm::length(glm::cross(p1 - p0, p2 - p0));
+    }
+    return area;
+}
+
+static void extractWholeVolume(Volume& volume, Extractor extractor, PolyVox::SurfaceMesh<Vertex>& mesh) {
+    if (extractor == Extractor::MARCHING_CUBES) {
+        PolyVox::MarchingCubesSurfaceExtractor<Volume> surfaceExtractor(&volume, volume.getEnclosingRegion(), &mesh);
+        surfaceExtractor.execute();
+    } else {
+        PolyVox::CubicSurfaceExtractorWithNormals<Volume> surfaceExtractor(&volume, volume.getEnclosingRegion(), &mesh);
+        surfaceExtractor.execute();
+    }
+}
+
+void PolyVoxChunkedMeshTests::testMatchesWholeVolume() {
+    // not a multiple of the chunk size, so the last chunks are partial
+    const int SIZE = 2 * PolyVoxChunkedMesh::CHUNK_SIZE + 7;
+    auto volume = makeTerrain(SIZE);
+
+    for (auto extractor : { Extractor::MARCHING_CUBES, Extractor::CUBIC }) {
+        PolyVox::SurfaceMesh<Vertex> wholeMesh;
+        extractWholeVolume(*volume, extractor, wholeMesh);
+
+        PolyVoxChunkedMesh chunkedMesh;
+        chunkedMesh.extract(volume.get(), extractor);
+        QCOMPARE(chunkedMesh.getNumChunks(), 27);
+        QCOMPARE(chunkedMesh.getNumChunksExtracted(), 27);
+
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        chunkedMesh.getMesh(vertices, indices);
+
+        // chunks may duplicate the vertices on their shared faces, but emit exactly the same triangles
+        QCOMPARE(indices.size(), wholeMesh.getIndices().size());
+        float wholeArea = surfaceArea(wholeMesh.getRawVertexData(), wholeMesh.getIndices());
+        QVERIFY(wholeArea > 0.0f);
+        QCOMPARE_WITH_ABS_ERROR(surfaceArea(vertices, indices), wholeArea, wholeArea * 1.0e-4f);
+    }
+}
+
+void PolyVoxChunkedMeshTests::testIncrementalMatchesFull() {
+    const int SIZE = 64;
+    const int NUM_EDITS = 20;
+    auto volume = makeTerrain(SIZE);
+
+    for (auto extractor : { Extractor::MARCHING_CUBES, Extractor::CUBIC }) {
+        PolyVoxChunkedMesh incrementalMesh;
+        incrementalMesh.extract(volume.get(), extractor);
+
+        for (int edit = 0; edit < NUM_EDITS; edit++) {
+            // include voxels on chunk boundaries, which are read by several chunks
+            glm::ivec3 center = edit % 2 ? randomVoxel(SIZE) : glm::ivec3(PolyVoxChunkedMesh::CHUNK_SIZE * (1 + edit % 3));
+            setSphere(*volume, incrementalMesh, center, 1 + edit % 4, edit % 3 ? SOLID : 0);
+            incrementalMesh.extract(volume.get(), extractor);
+            QVERIFY(incrementalMesh.getNumChunksExtracted() < incrementalMesh.getNumChunks());
+        }
+
+        PolyVoxChunkedMesh fullMesh;
+        fullMesh.extract(volume.get(), extractor);
+
+        std::vector<Vertex> incrementalVertices;
+        std::vector<uint32_t> incrementalIndices;
+        incrementalMesh.getMesh(incrementalVertices, incrementalIndices);
+        std::vector<Vertex> fullVertices;
+        std::vector<uint32_t> fullIndices;
+        fullMesh.getMesh(fullVertices, fullIndices);
+
+        QCOMPARE(incrementalIndices, fullIndices);
+        QCOMPARE(incrementalVertices.size(), fullVertices.size());
+        for (size_t i = 0; i < fullVertices.size(); i++) {
+            QVERIFY(incrementalVertices[i].getPosition() == fullVertices[i].getPosition());
+            QVERIFY(incrementalVertices[i].getNormal() == fullVertices[i].getNormal());
+        }
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void PolyVoxChunkedMeshTests::benchmarkEditLatency() {
+    const int SIZE = 128;
+    const int NUM_EDITS = 50;
+    const int EDIT_RADIUS = 3;
+    auto volume = makeTerrain(SIZE);
+
+    for (auto extractor : { Extractor::MARCHING_CUBES, Extractor::CUBIC }) {
+        PolyVoxChunkedMesh chunkedMesh;
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+
+        uint64_t startTime = usecTimestampNow();
+        chunkedMesh.extract(volume.get(), extractor);
+        chunkedMesh.getMesh(vertices, indices);
+        uint64_t firstUsec = usecTimestampNow() - startTime;
+
+        // each edit is followed by the work recomputeMesh does before building the gpu buffers
+        uint64_t wholeUsec = 0;
+        uint64_t chunkedUsec = 0;
+        int numChunksExtracted = 0;
+        for (int edit = 0; edit < NUM_EDITS; edit++) {
+            setSphere(*volume, chunkedMesh, randomVoxel(SIZE), EDIT_RADIUS, edit % 2 ? SOLID : 0);
+
+            startTime = usecTimestampNow();
+            chunkedMesh.extract(volume.get(), extractor);
+            chunkedMesh.getMesh(vertices, indices);
+            chunkedUsec += usecTimestampNow() - startTime;
+            numChunksExtracted += chunkedMesh.getNumChunksExtracted();
+
+            startTime = usecTimestampNow();
+            PolyVox::SurfaceMesh<Vertex> wholeMesh;
+            extractWholeVolume(*volume, extractor, wholeMesh);
+            wholeUsec += usecTimestampNow() - startTime;
+        }
+
+        std::cout << (extractor == Extractor::MARCHING_CUBES ? "marching cubes" : "cubic") << ", " << SIZE << "^3 voxels, "
+                  << indices.size() / 3 << " triangles" << std::endl;
+        std::cout << "    first extraction:   " << firstUsec << " usec" << std::endl;
+        std::cout << "    whole volume edit:  " << wholeUsec / NUM_EDITS << " usec" << std::endl;
+        std::cout << "    chunked edit:       " << chunkedUsec / NUM_EDITS << " usec, "
+                  << (float)numChunksExtracted / NUM_EDITS << " of " << chunkedMesh.getNumChunks() << " chunks" << std::endl;
+    }
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,27 @@
+//
+//  PolyVoxChunkedMeshTests.h
+//  tests/entities-renderer/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunkedMeshTests_h
+#define hifi_PolyVoxChunkedMeshTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class PolyVoxChunkedMeshTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testMatchesWholeVolume();
+    void testIncrementalMatchesFull();
+#ifdef MANUAL_TEST
+    void benchmarkEditLatency();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_PolyVoxChunkedMeshTests_h
@@ -147,6 +147,141 @@ void KtxTests::testKtxSerialization() {
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
 }
 
+static gpu::TexturePointer createTestTexture() {
+    const QString TEST_IMAGE = getRootPath() + "/scripts/developer/tests/cube_texture.png";
+    QImage image(TEST_IMAGE);
+    std::atomic<bool> abortSignal { false };
+    return image::TextureUsage::process2DTextureColorFromImage(std::move(image), TEST_IMAGE.toStdString(), true, gpu::BackendTarget::GL45, true, abortSignal);
+}
+
+static bool writeKtxFile(const ktx::KTXUniquePointer& ktxMemory, QTemporaryFile& outFile) {
+    const auto& ktxStorage = ktxMemory->getStorage();
+    if (!outFile.open()) {
+        return false;
+    }
+    outFile.write((const char*)ktxStorage->data(), ktxStorage->size());
+    outFile.close();
+    return true;
+}
+
+void KtxTests::testKtxMappedMipAccess() {
+    gpu::TexturePointer testTexture = createTestTexture();
+    QVERIFY(testTexture);
+    auto ktxMemory = gpu::Texture::serialize(*testTexture, glm::ivec2(testTexture->getWidth(), testTexture->getHeight()));
+    QVERIFY(ktxMemory.get());
+
+    const int NUM_FILES = 4;
+    std::vector<std::unique_ptr<QTemporaryFile>> files;
+    std::vector<gpu::TexturePointer> textures;
+    for (int i = 0; i < NUM_FILES; ++i) {
+        files.emplace_back(new QTemporaryFile());
+        QVERIFY(writeKtxFile(ktxMemory, *files.back()));
+        auto texture = gpu::Texture::unserialize(files.back()->fileName().toStdString()).first;
+        QVERIFY(texture);
+        textures.push_back(texture);
+    }
+
+    // A budget of one byte keeps a single file mapped at a time, the faces already handed out must stay valid
+    gpu::Texture::KtxStorage::setMappedKtxFilesBudget(1);
+    std::vector<gpu::Texture::PixelsPointer> faces;
+    for (const auto& texture : textures) {
+        for (uint16 level = texture->minAvailableMipLevel(); level < texture->getNumMips(); ++level) {
+            auto face = texture->accessStoredMipFace(level);
+            QVERIFY(face);
+            const auto& image = ktxMemory->_images[level];
+            QCOMPARE(face->size(), (size_t)image._faceSize);
+            QVERIFY(0 == memcmp(face->data(), image._faceBytes[0], face->size()));
+            faces.push_back(face);
+        }
+        QVERIFY(gpu::Texture::KtxStorage::getMappedKtxFilesCount() <= 1);
+    }
+    for (size_t i = 0; i < faces.size(); ++i) {
+        QVERIFY(faces[i]->data() != nullptr);
+    }
+    QVERIFY(0 == memcmp(faces.front()->data(), ktxMemory->_images[textures.front()->minAvailableMipLevel()]._faceBytes[0], faces.front()->size()));
+
+    // Released storages leave the table
+    faces.clear();
+    textures.clear();
+    QCOMPARE(gpu::Texture::KtxStorage::getMappedKtxFilesCount(), (size_t)0);
+    QCOMPARE(gpu::Texture::KtxStorage::getMappedKtxFilesSize(), (size_t)0);
+    gpu::Texture::KtxStorage::setMappedKtxFilesBudget(0);
+}
+
+void KtxTests::benchmarkKtxMipStreaming() {
+    // Streams the mips of a set of KTX backed textures the way the texture transfer engine does, smallest mips first
+    gpu::TexturePointer testTexture = createTestTexture();
+    QVERIFY(testTexture);
+    auto ktxMemory = gpu::Texture::serialize(*testTexture, glm::ivec2(testTexture->getWidth(), testTexture->getHeight()));
+    QVERIFY(ktxMemory.get());
+
+    const int NUM_TEXTURES = 64;
+    std::vector<std::unique_ptr<QTemporaryFile>> files;
+    std::vector<gpu::TexturePointer> textures;
+    for (int i = 0; i < NUM_TEXTURES; ++i) {
+        files.emplace_back(new QTemporaryFile());
+        QVERIFY(writeKtxFile(ktxMemory, *files.back()));
+        textures.push_back(gpu::Texture::unserialize(files.back()->fileName().toStdString()).first);
+        QVERIFY(textures.back());
+    }
+
+    size_t bytes = 0;
+    QBENCHMARK {
+        for (const auto& texture : textures) {
+            for (int level = texture->getNumMips() - 1; level >= (int)texture->minAvailableMipLevel(); --level) {
+                auto face = texture->accessStoredMipFace((uint16)level);
+                bytes += face->size();
+            }
+        }
+    }
+    QVERIFY(bytes > 0);
+}
+
+#ifdef MANUAL_TEST
+void KtxTests::benchmarkTextureProcessing() {
+    // Mips, faces and compression blocks are processed in parallel, report the throughput of each format for a
+    // range of thread budgets
+    const int IMAGE_SIZE = 2048;
+    QImage sourceImage(IMAGE_SIZE, IMAGE_SIZE, QImage::Format_ARGB32);
+    for (int y = 0; y < IMAGE_SIZE; ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(sourceImage.scanLine(y));
+        for (int x = 0; x < IMAGE_SIZE; ++x) {
+            line[x] = qRgba((x * 7) ^ y, (y * 3) + x, (x * y) >> 4, (x + y) & 0xFF);
+        }
+    }
+
+    struct Format {
+        const char* name;
+        image::TextureUsage::Type type;
+        QImage image;
+    };
+    const std::vector<Format> formats {
+        { "color BC1", image::TextureUsage::ALBEDO_TEXTURE, sourceImage.convertToFormat(QImage::Format_RGB32) },
+        { "color+alpha BC3", image::TextureUsage::ALBEDO_TEXTURE, sourceImage },
+        { "normal BC5", image::TextureUsage::NORMAL_TEXTURE, sourceImage },
+        { "grayscale BC4", image::TextureUsage::METALLIC_TEXTURE, sourceImage },
+        { "skybox HDR", image::TextureUsage::SKY_TEXTURE, sourceImage.scaled(IMAGE_SIZE, IMAGE_SIZE / 2) },
+    };
+
+    std::atomic<bool> abortSignal { false };
+    for (int numThreads : { 1, 2, 4, 0 }) {
+        image::setProcessingThreadBudget(numThreads);
+        for (const auto& format : formats) {
+            auto loader = image::TextureUsage::getTextureLoaderForType(format.type);
+            QElapsedTimer timer;
+            timer.start();
+            auto texture = loader(image::Image(format.image), format.name, true, gpu::BackendTarget::GL45, abortSignal);
+            auto elapsed = timer.nsecsElapsed();
+            QVERIFY(texture);
+            double megapixels = (double)format.image.width() * format.image.height() / 1.0e6;
+            qDebug() << format.name << "threads" << image::getProcessingThreadBudget() << ":"
+                     << megapixels / (elapsed / 1.0e9) << "MP/s";
+        }
+    }
+    image::setProcessingThreadBudget(0);
+}
+#endif
+
 #if 0
 
 static const QString TEST_FOLDER { "H:/ktx_cacheold" };
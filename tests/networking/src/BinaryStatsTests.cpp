@@ -0,0 +1,135 @@
+//
+//  BinaryStatsTests.cpp
+//  tests/networking/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BinaryStatsTests.h"
+
+#include <QtCore/QJsonArray>
+
+#include <BinaryStats.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+QTEST_MAIN(BinaryStatsTests)
+
+void BinaryStatsTests::roundTripTest() {
+    QUuid nodeID = QUuid::createUuid();
+    QString displayName = QString::fromUtf8("caf\xc3\xa9 \xe2\x9c\x93");
+
+    BinaryStatsWriter stats;
+    stats.add("threads", 4);
+    stats.add("throttling_ratio", 0.25f);
+    stats.add("useDynamicJitterBuffers", true);
+    stats.add("upstream", "mic unknown");
+    stats.addUsecTime("min_gap", (quint64)1500);
+    stats.addUsecTime("avg_gap", 2250.5f);
+
+    stats.beginObject("z_listeners");
+    stats.beginObject(nodeID);
+    stats.add("$username", nodeID);
+    stats.add("display_name", displayName);
+    stats.add("display_name", "ENTITY SERVER");
+    stats.beginArray("injectors");
+    stats.beginObject(nullptr);
+    stats.add("inj.desired", 3);
+    stats.end();
+    stats.add(nullptr, 7);
+    stats.end();
+    stats.end();
+    stats.end();
+
+    QVERIFY(!stats.hasOverflowed());
+
+    QJsonObject json = binaryStatsToJSON(stats.toByteArray());
+    QCOMPARE(json["threads"].toInt(), 4);
+    QCOMPARE(json["throttling_ratio"].toDouble(), 0.25);
+    QCOMPARE(json["useDynamicJitterBuffers"].toBool(), true);
+    QCOMPARE(json["upstream"].toString(), QString("mic unknown"));
+    QCOMPARE(json["min_gap"].toString(), formatUsecTime((quint64)1500));
+    QCOMPARE(json["avg_gap"].toString(), formatUsecTime(2250.5f));
+
+    QString uuidString = uuidStringWithoutCurlyBraces(nodeID);
+    QJsonObject listener = json["z_listeners"].toObject()[uuidString].toObject();
+    QCOMPARE(listener["$username"].toString(), uuidString);
+    QCOMPARE(listener["display_name"].toString(), QString("ENTITY SERVER"));
+
+    QJsonArray injectors = listener["injectors"].toArray();
+    QCOMPARE(injectors.size(), 2);
+    QCOMPARE(injectors[0].toObject()["inj.desired"].toInt(), 3);
+    QCOMPARE(injectors[1].toInt(), 7);
+
+    // the same writer is reused for every packet
+    stats.reset();
+    QVERIFY(stats.isEmpty());
+    stats.add("display_name", displayName);
+    QCOMPARE(binaryStatsToJSON(stats.toByteArray()), QJsonObject({ { "display_name", displayName } }));
+}
+
+void BinaryStatsTests::jsonTest() {
+    QJsonObject object {
+        { "name", "asset-server" },
+        { "ratio", 1.5 },
+        { "enabled", false },
+        { "nothing", QJsonValue() },
+        { "nested", QJsonObject { { "count", 12 }, { "list", QJsonArray { 1, "two", QJsonObject { { "three", 3 } } } } } }
+    };
+
+    BinaryStatsWriter stats;
+    stats.addJSON(object);
+    QCOMPARE(binaryStatsToJSON(stats.toByteArray()), object);
+}
+
+void BinaryStatsTests::stringTableTest() {
+    BinaryStatsWriter stats;
+    stats.beginObject("first");
+    stats.add("outbound_kbps", 1);
+    stats.add("name", "outbound_kbps");
+    stats.end();
+    int size = stats.getSize();
+
+    // strings already in the table only cost an entry
+    stats.beginObject("second");
+    stats.add("outbound_kbps", 2);
+    stats.add("name", QString("outbound_kbps"));
+    stats.end();
+    QCOMPARE(stats.getSize() - size, (int)(3 * sizeof(BinaryStatsEntry) + sizeof(uint16_t) + strlen("second")));
+
+    // enough keys to make the table grow
+    const int NUM_KEYS = 1000;
+    stats.beginObject("keys");
+    for (int i = 0; i < NUM_KEYS; ++i) {
+        stats.add(QString::number(i), i);
+    }
+    stats.end();
+
+    QJsonObject keys = binaryStatsToJSON(stats.toByteArray())["keys"].toObject();
+    QCOMPARE(keys.size(), NUM_KEYS);
+    for (int i = 0; i < NUM_KEYS; ++i) {
+        QCOMPARE(keys[QString::number(i)].toInt(), i);
+    }
+}
+
+void BinaryStatsTests::invalidDataTest() {
+    BinaryStatsWriter stats;
+    stats.beginObject("object");
+    stats.add("value", 1);
+    stats.end();
+    QByteArray data = stats.toByteArray();
+
+    QVERIFY(binaryStatsToJSON(QByteArray()).isEmpty());
+    QVERIFY(binaryStatsToJSON(data.left(data.size() - 1)).isEmpty());
+    QVERIFY(binaryStatsToJSON(data + '\0').isEmpty());
+
+    // a member pointing at a parent that comes after it
+    QByteArray badParent = data;
+    BinaryStatsEntry entry;
+    int lastEntry = badParent.size() - (int)sizeof(entry);
+    memcpy(&entry, badParent.constData() + lastEntry, sizeof(entry));
+    entry.parent = 1;
+    memcpy(badParent.data() + lastEntry, &entry, sizeof(entry));
+    QVERIFY(binaryStatsToJSON(badParent).isEmpty());
+}
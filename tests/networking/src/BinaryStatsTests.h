@@ -0,0 +1,23 @@
+//
+//  BinaryStatsTests.h
+//  tests/networking/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BinaryStatsTests_h
+#define hifi_BinaryStatsTests_h
+
+#include <QtTest/QtTest>
+
+class BinaryStatsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTripTest();
+    void jsonTest();
+    void stringTableTest();
+    void invalidDataTest();
+};
+
+#endif // hifi_BinaryStatsTests_h
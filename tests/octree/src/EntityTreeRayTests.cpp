@@ -0,0 +1,170 @@
+//
+//  EntityTreeRayTests.cpp
+//  tests/octree/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeRayTests.h"
+
+#include <iostream>
+#include <vector>
+
+#include <glm/gtc/random.hpp>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <SharedUtil.h>
+
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(EntityTreeRayTests)
+
+// as many picks as a busy client runs in one frame: lasers, stylus and mouse of the user, plus script picks
+static const int NUM_PICKS = 200;
+static const float DISTANCE_EPSILON = 0.0001f;
+
+static PickFilter makeFilter(bool visible) {
+    return PickFilter(PickFilter::getBitMask(PickFilter::LOCAL_ENTITIES) |
+        PickFilter::getBitMask(visible ? PickFilter::VISIBLE : PickFilter::INVISIBLE) |
+        PickFilter::getBitMask(PickFilter::COLLIDABLE) | PickFilter::getBitMask(PickFilter::NONCOLLIDABLE) |
+        PickFilter::getBitMask(PickFilter::COARSE));
+}
+
+// a room full of boxes, about a tenth of them invisible
+static EntityTreePointer makeTree(int count, QVector<EntityItemID>& entityIDs) {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    for (int i = 0; i < count; ++i) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setEntityHostType(entity::HostType::LOCAL);
+        properties.setPosition(glm::linearRand(glm::vec3(-50.0f, 0.0f, -50.0f), glm::vec3(50.0f, 10.0f, 50.0f)));
+        properties.setDimensions(glm::linearRand(glm::vec3(0.2f), glm::vec3(3.0f)));
+        properties.setVisible(i % 10 != 0);
+        EntityItemID entityID(QUuid::createUuid());
+        if (tree->addEntity(entityID, properties)) {
+            entityIDs.push_back(entityID);
+        }
+    }
+    return tree;
+}
+
+// picks coming from a few hands and heads in the room, each in its own direction
+static std::vector<RayPacketQuery> makeRays(int count) {
+    std::vector<RayPacketQuery> rays(count);
+    for (int i = 0; i < count; ++i) {
+        glm::vec3 eye = glm::vec3((float)(i % 5) * 10.0f - 20.0f, 1.7f, (float)((i / 5) % 5) * 10.0f - 20.0f);
+        rays[i].origin = eye + glm::linearRand(glm::vec3(-0.5f), glm::vec3(0.5f));
+        rays[i].direction = glm::normalize(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+        rays[i].searchFilter = makeFilter(true);
+    }
+    return rays;
+}
+
+static void compareWithSingleRays(const EntityTreePointer& tree, std::vector<RayPacketQuery>& rays) {
+    tree->evalRayIntersections(rays, Octree::Lock);
+    for (const auto& ray : rays) {
+        OctreeElementPointer element;
+        float distance;
+        BoxFace face;
+        glm::vec3 surfaceNormal;
+        QVariantMap extraInfo;
+        EntityItemID entityID = tree->evalRayIntersection(ray.origin, ray.direction, ray.entityIdsToInclude,
+            ray.entityIdsToDiscard, ray.searchFilter, element, distance, face, surfaceNormal, extraInfo, Octree::Lock);
+        QCOMPARE(ray.entityID.isNull(), entityID.isNull());
+        if (!entityID.isNull()) {
+            // a single ray stops at the first child element with a hit, a packet ray only skips the elements that
+            // start beyond its hit, so it can only find a closer one
+            QVERIFY(ray.distance <= distance + DISTANCE_EPSILON);
+        }
+    }
+}
+
+void EntityTreeRayTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+}
+
+void EntityTreeRayTests::rayPacketTest() {
+    QVector<EntityItemID> entityIDs;
+    EntityTreePointer tree = makeTree(1000, entityIDs);
+    QVERIFY(!entityIDs.empty());
+
+    std::vector<RayPacketQuery> rays = makeRays(NUM_PICKS);
+    compareWithSingleRays(tree, rays);
+
+    // the queries are reset on every call
+    compareWithSingleRays(tree, rays);
+
+    // an empty packet does nothing
+    std::vector<RayPacketQuery> noRays;
+    tree->evalRayIntersections(noRays, Octree::Lock);
+}
+
+void EntityTreeRayTests::rayPacketFilterTest() {
+    QVector<EntityItemID> entityIDs;
+    EntityTreePointer tree = makeTree(500, entityIDs);
+
+    // rays of the same packet with different filters and lists must not see each other's results
+    std::vector<RayPacketQuery> rays = makeRays(NUM_PICKS);
+    for (int i = 0; i < NUM_PICKS; ++i) {
+        switch (i % 4) {
+            case 1:
+                rays[i].searchFilter = makeFilter(false);
+                break;
+            case 2:
+                rays[i].entityIdsToInclude = entityIDs.mid(0, entityIDs.size() / 2);
+                break;
+            case 3:
+                rays[i].entityIdsToDiscard = entityIDs.mid(entityIDs.size() / 2);
+                break;
+            default:
+                break;
+        }
+    }
+    compareWithSingleRays(tree, rays);
+}
+
+#ifdef MANUAL_TEST
+
+void EntityTreeRayTests::benchmark() {
+    const int NUM_ENTITIES = 20000;
+    const int NUM_FRAMES = 500;
+
+    QVector<EntityItemID> entityIDs;
+    EntityTreePointer tree = makeTree(NUM_ENTITIES, entityIDs);
+    std::vector<RayPacketQuery> rays = makeRays(NUM_PICKS);
+
+    uint64_t startTime = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        for (const auto& ray : rays) {
+            OctreeElementPointer element;
+            float distance;
+            BoxFace face;
+            glm::vec3 surfaceNormal;
+            QVariantMap extraInfo;
+            tree->evalRayIntersection(ray.origin, ray.direction, ray.entityIdsToInclude, ray.entityIdsToDiscard,
+                ray.searchFilter, element, distance, face, surfaceNormal, extraInfo, Octree::Lock);
+        }
+    }
+    uint64_t singleUsec = usecTimestampNow() - startTime;
+
+    startTime = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        tree->evalRayIntersections(rays, Octree::Lock);
+    }
+    uint64_t packetUsec = usecTimestampNow() - startTime;
+
+    std::cout << entityIDs.size() << " entities, " << NUM_PICKS << " picks per frame" << std::endl;
+    std::cout << "one by one: " << (float)singleUsec / NUM_FRAMES << " usec per frame" << std::endl;
+    std::cout << "packets:    " << (float)packetUsec / NUM_FRAMES << " usec per frame" << std::endl;
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,27 @@
+//
+//  EntityTreeRayTests.h
+//  tests/octree/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeRayTests_h
+#define hifi_EntityTreeRayTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class EntityTreeRayTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void rayPacketTest();
+    void rayPacketFilterTest();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_EntityTreeRayTests_h
@@ -119,10 +119,66 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+void testIndexedFormat() {
+    static const QString SECOND_TEST_NAME = "com.highfidelity.recording.Test2";
+    FrameType secondFrameType = Frame::registerFrameType(SECOND_TEST_NAME);
+
+    // enough frames for several blocks, with slowly changing data so most of them get XOR encoded
+    auto writeClip = Clip::newClip();
+    const int NUM_FRAMES = 5000;
+    QByteArray data(200, 0);
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        data[i % data.size()] = (char)i;
+        FrameType type = (i % 3 == 0) ? secondFrameType : TEST_FRAME_TYPE;
+        // the second type has frames of varying size
+        QByteArray frameData = (type == secondFrameType) ? data.left(100 + i % 50) : data;
+        // frames are 10ms apart
+        writeClip->addFrame(std::make_shared<Frame>(type, (float)(i * 10), frameData));
+    }
+    QVERIFY(writeClip->frameCount() == NUM_FRAMES);
+
+    QByteArray buffer = Clip::toBuffer(writeClip);
+    QVERIFY(buffer.size() < NUM_FRAMES * data.size() / 4);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QString fileName = file.fileName();
+    file.close();
+    Clip::toFile(fileName, writeClip);
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == NUM_FRAMES);
+    QVERIFY(readClip->duration() == writeClip->duration());
+
+    readClip->seek(0);
+    writeClip->seek(0);
+    size_t count = 0;
+    for (auto readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(); readFrame && writeFrame;
+        readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(), ++count) {
+        QVERIFY(readFrame->type == writeFrame->type);
+        QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+        QVERIFY(readFrame->data == writeFrame->data);
+    }
+    QVERIFY(count == NUM_FRAMES);
+
+    // seeking backwards and forwards decodes the right block
+    for (float position : { 30.0f, 2.5f, 49.99f, 0.0f, 17.123f }) {
+        readClip->seek(position);
+        writeClip->seek(position);
+        QVERIFY(readClip->position() == writeClip->position());
+        auto readFrame = readClip->nextFrame();
+        auto writeFrame = writeClip->nextFrame();
+        QVERIFY(readFrame && writeFrame);
+        QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+        QVERIFY(readFrame->data == writeFrame->data);
+    }
+}
+
 int main(int, const char**) {
     setupHifiApplication("Recording Test");
 
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testIndexedFormat();
 }
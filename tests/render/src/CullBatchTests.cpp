@@ -0,0 +1,147 @@
+//
+//  CullBatchTests.cpp
+//  tests/render/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullBatchTests.h"
+
+#include <iostream>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+#include <render/CullTask.h>
+
+QTEST_MAIN(CullBatchTests)
+
+const float WORLD_WIDTH = 1000.0f;
+const float MAX_BOX_SIZE = 20.0f;
+const float LOD_ANGLE_HALF_TAN = 0.01f;
+
+static float randomFloat() {
+    return (float)rand() / (float)RAND_MAX;
+}
+
+static ViewFrustum makeFrustum() {
+    ViewFrustum frustum;
+    frustum.setProjection(glm::perspective(PI / 2.0f, 16.0f / 9.0f, 0.1f, 0.5f * WORLD_WIDTH));
+    frustum.setPosition(glm::vec3(12.3f, 4.56f, 89.7f));
+    frustum.setOrientation(glm::angleAxis(PI / 7.0f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))));
+    frustum.calculate();
+    return frustum;
+}
+
+static void generateBoxes(size_t numBoxes, std::vector<AABox>& boxes, render::BoundsSoA& bounds) {
+    boxes.reserve(numBoxes);
+    bounds.reserve(numBoxes);
+    for (size_t i = 0; i < numBoxes; ++i) {
+        glm::vec3 corner = WORLD_WIDTH * (glm::vec3(randomFloat(), randomFloat(), randomFloat()) - 0.5f);
+        glm::vec3 size = MAX_BOX_SIZE * glm::vec3(randomFloat(), randomFloat(), randomFloat());
+        boxes.push_back(AABox(corner, size));
+        bounds.push_back(boxes.back());
+    }
+}
+
+void CullBatchTests::testFrustum() {
+    // odd size to exercise the remainder of the 8-wide kernel
+    const size_t NUM_BOXES = 10003;
+    std::vector<AABox> boxes;
+    render::BoundsSoA bounds;
+    generateBoxes(NUM_BOXES, boxes, bounds);
+
+    ViewFrustum frustum = makeFrustum();
+    render::CullBatch batch(frustum, LOD_ANGLE_HALF_TAN * LOD_ANGLE_HALF_TAN);
+    std::vector<uint8_t> results;
+    batch.cull(bounds, render::CullBatch::FRUSTUM, results);
+    QCOMPARE(results.size(), NUM_BOXES);
+
+    size_t numInView = 0;
+    for (size_t i = 0; i < NUM_BOXES; ++i) {
+        bool inView = frustum.boxIntersectsFrustum(boxes[i]);
+        QCOMPARE(results[i] == render::CullBatch::VISIBLE, inView);
+        numInView += inView ? 1 : 0;
+    }
+    // make sure the test covers both cases
+    QVERIFY(numInView > 0 && numInView < NUM_BOXES);
+}
+
+void CullBatchTests::testLODAngle() {
+    const size_t NUM_BOXES = 10003;
+    std::vector<AABox> boxes;
+    render::BoundsSoA bounds;
+    generateBoxes(NUM_BOXES, boxes, bounds);
+
+    ViewFrustum frustum = makeFrustum();
+    RenderArgs args(nullptr, 1.0f, 0, LOD_ANGLE_HALF_TAN);
+    args.setViewFrustum(frustum);
+
+    render::CullBatch batch(frustum, args._lodAngleHalfTanSq);
+    std::vector<uint8_t> results;
+    batch.cull(bounds, render::CullBatch::FRUSTUM | render::CullBatch::LOD_ANGLE, results);
+
+    size_t numTooSmall = 0;
+    for (size_t i = 0; i < NUM_BOXES; ++i) {
+        uint8_t expected = render::CullBatch::VISIBLE;
+        if (!frustum.boxIntersectsFrustum(boxes[i])) {
+            expected = render::CullBatch::OUT_OF_VIEW;
+        } else if (!render::CullTest::lodAngleTest(&args, boxes[i])) {
+            expected = render::CullBatch::TOO_SMALL;
+            numTooSmall++;
+        }
+        QCOMPARE(results[i], expected);
+    }
+    QVERIFY(numTooSmall > 0);
+
+    QVERIFY(render::CullTest::isLODAngleTest(render::CullTest::lodAngleTest));
+    QVERIFY(!render::CullTest::isLODAngleTest([](const RenderArgs*, const AABox&) { return true; }));
+}
+
+#ifdef MANUAL_TEST
+
+void CullBatchTests::benchmark() {
+    const size_t NUM_ITEMS = 500000;
+    const int NUM_FRAMES = 20;
+    std::vector<AABox> boxes;
+    render::BoundsSoA bounds;
+    generateBoxes(NUM_ITEMS, boxes, bounds);
+
+    ViewFrustum frustum = makeFrustum();
+    RenderArgs args(nullptr, 1.0f, 0, LOD_ANGLE_HALF_TAN);
+    args.setViewFrustum(frustum);
+
+    // one box at a time, as CullTest does
+    size_t numVisible = 0;
+    uint64_t startTime = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        numVisible = 0;
+        for (const auto& box : boxes) {
+            if (args.getViewFrustum().boxIntersectsFrustum(box) && render::CullTest::lodAngleTest(&args, box)) {
+                numVisible++;
+            }
+        }
+    }
+    uint64_t scalarUsec = (usecTimestampNow() - startTime) / NUM_FRAMES;
+
+    // all at once
+    size_t numBatchVisible = 0;
+    std::vector<uint8_t> results;
+    startTime = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        render::CullBatch batch(args.getViewFrustum(), args._lodAngleHalfTanSq);
+        batch.cull(bounds, render::CullBatch::FRUSTUM | render::CullBatch::LOD_ANGLE, results);
+        numBatchVisible = std::count(results.begin(), results.end(), (uint8_t)render::CullBatch::VISIBLE);
+    }
+    uint64_t batchUsec = (usecTimestampNow() - startTime) / NUM_FRAMES;
+
+    QCOMPARE(numBatchVisible, numVisible);
+    std::cout << "culling " << NUM_ITEMS << " items, " << numVisible << " visible" << std::endl;
+    std::cout << "    scalar: " << scalarUsec << " usec/frame" << std::endl;
+    std::cout << "    batch:  " << batchUsec << " usec/frame" << std::endl;
+}
+
+#endif // MANUAL_TEST
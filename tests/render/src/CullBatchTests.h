@@ -0,0 +1,27 @@
+//
+//  CullBatchTests.h
+//  tests/render/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_CullBatchTests_h
+#define hifi_render_CullBatchTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class CullBatchTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testFrustum();
+    void testLODAngle();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_render_CullBatchTests_h
@@ -0,0 +1,138 @@
+//
+//  BlendshapeAccumulationTests.cpp
+//  tests/shared/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlendshapeAccumulationTests.h"
+
+#include <iostream>
+#include <vector>
+
+#include <glm/gtc/random.hpp>
+
+#include <BlendshapeAccumulation.h>
+#include <SharedUtil.h>
+#include <StreamUtils.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(BlendshapeAccumulationTests)
+
+// a blendshape as stored by hfm::Blendshape, tangents may be missing
+struct SourceBlendshape {
+    std::vector<int> indices;
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> tangents;
+};
+
+static SourceBlendshape makeBlendshape(int numVertices, int numIndices, bool hasTangents) {
+    SourceBlendshape blendshape;
+    for (int i = 0; i < numIndices; ++i) {
+        blendshape.indices.push_back(rand() % numVertices);
+        blendshape.vertices.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+        blendshape.normals.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+        if (hasTangents) {
+            blendshape.tangents.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+        }
+    }
+    return blendshape;
+}
+
+static BlendshapeStream makeStream(const SourceBlendshape& blendshape) {
+    BlendshapeStream stream;
+    stream.indices = blendshape.indices;
+    for (size_t j = 0; j < blendshape.indices.size(); ++j) {
+        glm::vec3 tangent = j < blendshape.tangents.size() ? blendshape.tangents[j] : glm::vec3(0.0f);
+        stream.offsets.push_back({ blendshape.vertices[j], blendshape.normals[j], tangent });
+    }
+    return stream;
+}
+
+// the per element loop Model's Blender used before streams
+static void accumulateBlendshape(std::vector<BlendshapeOffsetUnpacked>& unpacked, const SourceBlendshape& blendshape,
+                                 float vertexCoefficient, float normalCoefficient) {
+    for (size_t j = 0; j < blendshape.indices.size(); ++j) {
+        auto& currentBlendshapeOffset = unpacked[blendshape.indices[j]];
+        currentBlendshapeOffset.positionOffset += blendshape.vertices[j] * vertexCoefficient;
+        currentBlendshapeOffset.normalOffset += blendshape.normals[j] * normalCoefficient;
+        if (j < blendshape.tangents.size()) {
+            currentBlendshapeOffset.tangentOffset += blendshape.tangents[j] * normalCoefficient;
+        }
+    }
+}
+
+void BlendshapeAccumulationTests::testAccumulate() {
+    const int NUM_VERTICES = 1000;
+    const int NUM_BLENDSHAPES = 8;
+    const float EPSILON = 1.0e-5f;
+
+    for (int numIndices = 0; numIndices < 2 * NUM_VERTICES; numIndices += 97) {
+        std::vector<BlendshapeOffsetUnpacked> expected(NUM_VERTICES, { glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f) });
+        std::vector<BlendshapeOffsetUnpacked> actual = expected;
+
+        // more indices than vertices, so they repeat within a blendshape
+        for (int i = 0; i < NUM_BLENDSHAPES; ++i) {
+            SourceBlendshape blendshape = makeBlendshape(NUM_VERTICES, numIndices, i % 2 == 0);
+            float vertexCoefficient = glm::linearRand(0.0f, 1.0f);
+            float normalCoefficient = vertexCoefficient * 0.01f;
+            accumulateBlendshape(expected, blendshape, vertexCoefficient, normalCoefficient);
+            accumulateBlendshapeOffsets(actual.data(), makeStream(blendshape), vertexCoefficient, normalCoefficient);
+        }
+
+        for (int i = 0; i < NUM_VERTICES; ++i) {
+            QCOMPARE_WITH_ABS_ERROR(actual[i].positionOffset, expected[i].positionOffset, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(actual[i].normalOffset, expected[i].normalOffset, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(actual[i].tangentOffset, expected[i].tangentOffset, EPSILON);
+        }
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void BlendshapeAccumulationTests::benchmark() {
+    // roughly a face mesh with ARKit style blendshapes
+    const int NUM_VERTICES = 20000;
+    const int NUM_BLENDSHAPES = 52;
+    const int NUM_INDICES = 4000;
+    const int NUM_BLENDS = 200;
+
+    std::vector<SourceBlendshape> blendshapes;
+    std::vector<BlendshapeStream> streams;
+    std::vector<float> coefficients;
+    for (int i = 0; i < NUM_BLENDSHAPES; ++i) {
+        blendshapes.push_back(makeBlendshape(NUM_VERTICES, NUM_INDICES, true));
+        streams.push_back(makeStream(blendshapes.back()));
+        coefficients.push_back(glm::linearRand(0.0f, 1.0f));
+    }
+    std::vector<BlendshapeOffsetUnpacked> unpacked(NUM_VERTICES);
+    const double NUM_BLENDED_VERTICES = (double)NUM_BLENDS * NUM_BLENDSHAPES * NUM_INDICES;
+
+    uint64_t startTime = usecTimestampNow();
+    for (int blend = 0; blend < NUM_BLENDS; ++blend) {
+        memset(unpacked.data(), 0, NUM_VERTICES * sizeof(BlendshapeOffsetUnpacked));
+        for (int i = 0; i < NUM_BLENDSHAPES; ++i) {
+            accumulateBlendshape(unpacked, blendshapes[i], coefficients[i], coefficients[i] * 0.01f);
+        }
+    }
+    uint64_t elementUsec = usecTimestampNow() - startTime;
+
+    startTime = usecTimestampNow();
+    for (int blend = 0; blend < NUM_BLENDS; ++blend) {
+        memset(unpacked.data(), 0, NUM_VERTICES * sizeof(BlendshapeOffsetUnpacked));
+        for (int i = 0; i < NUM_BLENDSHAPES; ++i) {
+            accumulateBlendshapeOffsets(unpacked.data(), streams[i], coefficients[i], coefficients[i] * 0.01f);
+        }
+    }
+    uint64_t streamUsec = usecTimestampNow() - startTime;
+
+    std::cout << "accumulating " << NUM_BLENDS << " blends of " << NUM_BLENDSHAPES << " blendshapes" << std::endl;
+    std::cout << "    per element: " << NUM_BLENDED_VERTICES / elementUsec << " M vertices/sec" << std::endl;
+    std::cout << "    streams:     " << NUM_BLENDED_VERTICES / streamUsec << " M vertices/sec" << std::endl;
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,25 @@
+//
+//  BlendshapeAccumulationTests.h
+//  tests/shared/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BlendshapeAccumulationTests_h
+#define hifi_BlendshapeAccumulationTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class BlendshapeAccumulationTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testAccumulate();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_BlendshapeAccumulationTests_h
@@ -0,0 +1,231 @@
+//
+//  SpatiallyNestableTests.cpp
+//  tests/shared/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatiallyNestableTests.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <DependencyManager.h>
+#include <GLMHelpers.h>
+#include <SharedUtil.h>
+#include <SpatialParentFinder.h>
+#include <SpatiallyNestable.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(SpatiallyNestableTests)
+
+const float EPSILON = 0.0001f;
+
+class TestNestable : public SpatiallyNestable {
+public:
+    TestNestable() : SpatiallyNestable(NestableType::Entity, QUuid::createUuid()) { }
+
+    // the pose of joint 0 and the scale for children, which are not change tracked
+    glm::vec3 jointTranslation { 0.0f };
+    glm::vec3 childScale { 1.0f };
+    bool scalesWithParent { false };
+
+    glm::vec3 getAbsoluteJointTranslationInObjectFrame(int index) const override {
+        return index == 0 ? jointTranslation : glm::vec3(0.0f);
+    }
+    glm::vec3 scaleForChildren() const override { return childScale; }
+    bool getScalesWithParent() const override { return scalesWithParent; }
+};
+
+using TestNestablePointer = std::shared_ptr<TestNestable>;
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    SpatiallyNestableWeakPointer find(QUuid parentID, bool& success, SpatialParentTree* entityTree = nullptr) const override {
+        auto iter = nestables.find(parentID);
+        success = iter != nestables.end();
+        return success ? iter.value() : SpatiallyNestableWeakPointer();
+    }
+
+    QHash<QUuid, SpatiallyNestableWeakPointer> nestables;
+};
+
+static TestParentFinder* parentFinder { nullptr };
+
+static TestNestablePointer makeNestable(const SpatiallyNestablePointer& parent = nullptr) {
+    auto nestable = std::make_shared<TestNestable>();
+    parentFinder->nestables[nestable->getID()] = nestable;
+    if (parent) {
+        nestable->setParentID(parent->getID());
+    }
+    return nestable;
+}
+
+void SpatiallyNestableTests::initTestCase() {
+    parentFinder = static_cast<TestParentFinder*>(DependencyManager::set<SpatialParentFinder, TestParentFinder>().data());
+}
+
+void SpatiallyNestableTests::cleanupTestCase() {
+    parentFinder = nullptr;
+    DependencyManager::destroy<SpatialParentFinder>();
+}
+
+void SpatiallyNestableTests::parentMoveTest() {
+    auto root = makeNestable();
+    auto middle = makeNestable(root);
+    auto leaf = makeNestable(middle);
+    middle->setLocalPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    leaf->setLocalPosition(glm::vec3(0.0f, 0.0f, 1.0f));
+
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), glm::vec3(0.0f, 1.0f, 1.0f), EPSILON);
+    // served from the cache this time
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), glm::vec3(0.0f, 1.0f, 1.0f), EPSILON);
+
+    root->setWorldPosition(glm::vec3(10.0f, 0.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), glm::vec3(10.0f, 1.0f, 1.0f), EPSILON);
+
+    root->setWorldOrientation(glm::angleAxis(PI_OVER_TWO, Vectors::UNIT_Y));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), glm::vec3(11.0f, 1.0f, 0.0f), EPSILON);
+    QCOMPARE_QUATS(leaf->getWorldOrientation(), glm::angleAxis(PI_OVER_TWO, Vectors::UNIT_Y), EPSILON);
+
+    middle->setLocalPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), glm::vec3(11.0f, 2.0f, 0.0f), EPSILON);
+
+    // moving a leaf doesn't disturb its ancestors
+    leaf->setWorldPosition(glm::vec3(0.0f, 0.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getWorldPosition(), glm::vec3(0.0f, 0.0f, 0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(middle->getWorldPosition(), glm::vec3(10.0f, 2.0f, 0.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::reparentTest() {
+    auto first = makeNestable();
+    auto second = makeNestable();
+    auto child = makeNestable(first);
+    first->setWorldPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    second->setWorldPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+    child->setLocalPosition(glm::vec3(0.0f, 0.0f, 3.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(1.0f, 0.0f, 3.0f), EPSILON);
+
+    child->setParentID(second->getID());
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(0.0f, 2.0f, 3.0f), EPSILON);
+
+    // the old parent no longer moves the child
+    first->setWorldPosition(glm::vec3(5.0f, 0.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(0.0f, 2.0f, 3.0f), EPSILON);
+    second->setWorldPosition(glm::vec3(0.0f, 4.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(0.0f, 4.0f, 3.0f), EPSILON);
+
+    child->setParentID(QUuid());
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(0.0f, 0.0f, 3.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::jointParentTest() {
+    auto parent = makeNestable();
+    auto child = makeNestable(parent);
+    child->setParentJointIndex(0);
+    child->setLocalPosition(glm::vec3(0.0f, 0.0f, 1.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(0.0f, 0.0f, 1.0f), EPSILON);
+
+    // joints move without telling their children, so these are never cached
+    parent->jointTranslation = glm::vec3(0.0f, 1.0f, 0.0f);
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(0.0f, 1.0f, 1.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::jointGrandparentTest() {
+    auto avatar = makeNestable();
+    auto attachment = makeNestable(avatar);
+    auto grandchild = makeNestable(attachment);
+    attachment->setParentJointIndex(0);
+    attachment->setLocalPosition(glm::vec3(0.0f, 0.0f, 1.0f));
+    grandchild->setLocalPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(1.0f, 0.0f, 1.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(1.0f, 0.0f, 1.0f), EPSILON);
+
+    // the joint moves the attachment, and with it the grandchild, without telling either of them
+    avatar->jointTranslation = glm::vec3(0.0f, 1.0f, 0.0f);
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(1.0f, 1.0f, 1.0f), EPSILON);
+    avatar->jointTranslation = glm::vec3(0.0f, 2.0f, 0.0f);
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(1.0f, 2.0f, 1.0f), EPSILON);
+
+    // once detached from the joint, the chain is cached again and still follows its moves
+    attachment->setParentJointIndex(INVALID_JOINT_INDEX);
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(1.0f, 0.0f, 1.0f), EPSILON);
+    avatar->setWorldPosition(glm::vec3(0.0f, 0.0f, 5.0f));
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(1.0f, 0.0f, 6.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::scalingGrandparentTest() {
+    auto avatar = makeNestable();
+    auto attachment = makeNestable(avatar);
+    auto grandchild = makeNestable(attachment);
+    attachment->scalesWithParent = true;
+    attachment->setLocalPosition(glm::vec3(0.0f, 0.0f, 1.0f));
+    grandchild->setLocalPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(1.0f, 0.0f, 1.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(1.0f, 0.0f, 1.0f), EPSILON);
+
+    // the avatar's scale stretches the attachment's frame, without telling it or the grandchild
+    avatar->childScale = glm::vec3(2.0f);
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(2.0f, 0.0f, 2.0f), EPSILON);
+}
+
+#ifdef MANUAL_TEST
+
+void SpatiallyNestableTests::benchmark() {
+    const int NUM_CHAINS = 1000;
+    const int CHAIN_DEPTH = 10;
+    const int NUM_FRAMES = 100;
+
+    std::vector<TestNestablePointer> nestables;
+    std::vector<TestNestablePointer> roots;
+    std::vector<TestNestablePointer> leaves;
+    for (int i = 0; i < NUM_CHAINS; ++i) {
+        TestNestablePointer nestable;
+        for (int depth = 0; depth < CHAIN_DEPTH; ++depth) {
+            nestable = makeNestable(nestable);
+            nestable->setLocalPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+            nestables.push_back(nestable);
+            if (depth == 0) {
+                roots.push_back(nestable);
+            }
+        }
+        leaves.push_back(nestable);
+    }
+
+    // every nestable reads its world transform once per frame, as the render and physics updates do
+    auto readAll = [&] {
+        glm::vec3 sum(0.0f);
+        for (auto& nestable : nestables) {
+            sum += nestable->getWorldPosition();
+        }
+        return sum;
+    };
+    readAll();
+
+    uint64_t startTime = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        readAll();
+    }
+    uint64_t staticUsec = usecTimestampNow() - startTime;
+
+    // one chain in ten moves every frame
+    startTime = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        for (int i = frame % 10; i < NUM_CHAINS; i += 10) {
+            roots[i]->setWorldPosition(glm::vec3((float)frame, 0.0f, 0.0f));
+        }
+        readAll();
+    }
+    uint64_t movingUsec = usecTimestampNow() - startTime;
+
+    std::cout << "reading the world transforms of " << nestables.size() << " nestables in " << NUM_CHAINS
+        << " chains " << CHAIN_DEPTH << " deep" << std::endl;
+    std::cout << "    static:          " << (double)staticUsec / NUM_FRAMES << " usec/frame" << std::endl;
+    std::cout << "    10% roots moving: " << (double)movingUsec / NUM_FRAMES << " usec/frame" << std::endl;
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,31 @@
+//
+//  SpatiallyNestableTests.h
+//  tests/shared/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SpatiallyNestableTests_h
+#define hifi_SpatiallyNestableTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class SpatiallyNestableTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void parentMoveTest();
+    void reparentTest();
+    void jointParentTest();
+    void jointGrandparentTest();
+    void scalingGrandparentTest();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_SpatiallyNestableTests_h
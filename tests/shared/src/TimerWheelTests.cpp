@@ -0,0 +1,153 @@
+//
+// TimerWheelTests.cpp
+// tests/shared/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <shared/TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using Wheel = TimerWheel<int>;
+
+void TimerWheelTests::singleShotTest() {
+    Wheel wheel(1000);
+    auto timer = wheel.start(1000, 10, false, 42);
+    QVERIFY(timer != Wheel::INVALID_TIMER);
+    QCOMPARE(wheel.size(), (size_t)1);
+
+    std::vector<int> fired;
+    auto record = [&](Wheel::TimerID, int value) { fired.push_back(value); };
+    QCOMPARE(wheel.advance(1009, record), 0);
+    QCOMPARE(wheel.advance(1010, record), 1);
+    QCOMPARE(fired, std::vector<int>({ 42 }));
+    QVERIFY(!wheel.isActive(timer));
+    QVERIFY(wheel.empty());
+
+    // a zero delay fires on the next call
+    wheel.start(1010, 0, false, 7);
+    QCOMPARE(wheel.advance(1011, record), 1);
+    QCOMPARE(fired.back(), 7);
+}
+
+void TimerWheelTests::orderTest() {
+    Wheel wheel;
+    wheel.start(0, 30, false, 3);
+    wheel.start(0, 10, false, 1);
+    wheel.start(0, 20, false, 2);
+    wheel.start(0, 10, false, 11);
+
+    std::vector<int> fired;
+    wheel.advance(100, [&](Wheel::TimerID, int value) { fired.push_back(value); });
+    QCOMPARE(fired, std::vector<int>({ 1, 11, 2, 3 }));
+}
+
+void TimerWheelTests::stopTest() {
+    Wheel wheel;
+    auto first = wheel.start(0, 10, false, 1);
+    auto second = wheel.start(0, 10, false, 2);
+    QVERIFY(wheel.stop(first));
+    QVERIFY(!wheel.stop(first));
+    QCOMPARE(wheel.size(), (size_t)1);
+
+    // the slot of the stopped timer is reused, but its id stays stale
+    auto third = wheel.start(0, 10, false, 3);
+    QVERIFY(third != first);
+    QVERIFY(!wheel.isActive(first));
+    QVERIFY(wheel.isActive(second));
+    QCOMPARE(*wheel.getPayload(third), 3);
+
+    std::vector<int> fired;
+    wheel.advance(10, [&](Wheel::TimerID, int value) { fired.push_back(value); });
+    QCOMPARE(fired, std::vector<int>({ 2, 3 }));
+
+    wheel.start(10, 10, false, 4);
+    wheel.clear();
+    QVERIFY(wheel.empty());
+    QCOMPARE(wheel.advance(100, [&](Wheel::TimerID, int value) { fired.push_back(value); }), 0);
+}
+
+void TimerWheelTests::repeatTest() {
+    Wheel wheel;
+    auto timer = wheel.start(0, 16, true, 1);
+
+    int count = 0;
+    auto record = [&](Wheel::TimerID, int) { count++; };
+    for (uint64_t now = 1; now <= 160; now++) {
+        wheel.advance(now, record);
+    }
+    QCOMPARE(count, 10);
+    QVERIFY(wheel.isActive(timer));
+
+    // falling behind fires once and then resumes the interval from the current time
+    count = 0;
+    wheel.advance(1000, record);
+    QCOMPARE(count, 1);
+    wheel.advance(1015, record);
+    QCOMPARE(count, 1);
+    wheel.advance(1016, record);
+    QCOMPARE(count, 2);
+}
+
+void TimerWheelTests::longDelayTest() {
+    // delays that go through every level of the wheel, and one beyond its range
+    const std::vector<int> delays = { 1, 255, 256, 257, 16383, 16384, 16385, 1048575, 1048576, 1048577,
+        67108863, 67108864, 67108865, 200000000 };
+    const uint64_t START = 123456789;
+    Wheel wheel(START);
+    for (size_t i = 0; i < delays.size(); i++) {
+        wheel.start(START, delays[i], false, (int)i);
+    }
+
+    std::vector<uint64_t> firedAt(delays.size(), 0);
+    uint64_t now = START;
+    while (!wheel.empty()) {
+        // jump straight to the next possible expiry, so each timer is seen on the tick it comes due
+        now = std::max(now + 1, wheel.nextExpiry());
+        wheel.advance(now, [&](Wheel::TimerID, int index) { firedAt[index] = wheel.getCurrentTime(); });
+    }
+    for (size_t i = 0; i < delays.size(); i++) {
+        QCOMPARE(firedAt[i], START + delays[i]);
+    }
+}
+
+void TimerWheelTests::stopDuringDispatchTest() {
+    Wheel wheel;
+    Wheel::TimerID second = Wheel::INVALID_TIMER;
+    std::vector<int> fired;
+    wheel.start(0, 5, false, 1);
+    second = wheel.start(0, 5, false, 2);
+    wheel.advance(5, [&](Wheel::TimerID, int value) {
+        fired.push_back(value);
+        if (value == 1) {
+            QVERIFY(wheel.stop(second));
+            // started from a callback, fires on the next call at the earliest
+            wheel.start(wheel.getCurrentTime(), 0, false, 3);
+        }
+    });
+    QCOMPARE(fired, std::vector<int>({ 1 }));
+    wheel.advance(6, [&](Wheel::TimerID, int value) { fired.push_back(value); });
+    QCOMPARE(fired, std::vector<int>({ 1, 3 }));
+}
+
+void TimerWheelTests::nextExpiryTest() {
+    Wheel wheel;
+    QCOMPARE(wheel.nextExpiry(), Wheel::NO_EXPIRY);
+    wheel.start(0, 100, false, 1);
+    QCOMPARE(wheel.nextExpiry(), (uint64_t)100);
+
+    // beyond the first level the result is a lower bound
+    auto far = wheel.start(0, 100000, false, 2);
+    wheel.advance(100, [](Wheel::TimerID, int) {});
+    QVERIFY(wheel.nextExpiry() <= (uint64_t)100000);
+    QVERIFY(wheel.nextExpiry() > (uint64_t)100);
+    QVERIFY(wheel.stop(far));
+    QCOMPARE(wheel.nextExpiry(), Wheel::NO_EXPIRY);
+}
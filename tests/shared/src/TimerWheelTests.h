@@ -0,0 +1,26 @@
+//
+// TimerWheelTests.h
+// tests/shared/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheelTests_h
+#define hifi_TimerWheelTests_h
+
+#include <QtTest/QtTest>
+
+class TimerWheelTests : public QObject {
+    Q_OBJECT
+private slots:
+    void singleShotTest();
+    void orderTest();
+    void stopTest();
+    void repeatTest();
+    void longDelayTest();
+    void stopDuringDispatchTest();
+    void nextExpiryTest();
+};
+
+#endif // hifi_TimerWheelTests_h
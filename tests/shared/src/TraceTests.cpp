@@ -8,8 +8,14 @@
 
 #include "TraceTests.h"
 
+#include <thread>
+#include <vector>
+
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTemporaryDir>
 
 #include <Profile.h>
 
@@ -45,3 +51,54 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+void TraceTests::testCompactEventsFromThreads() {
+    const int NUM_THREADS = 4;
+    const int EVENTS_PER_THREAD = 5000;
+    const QString EVENT_NAME = "ThreadEvent";
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startTracing();
+    {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            threads.emplace_back([&] {
+                for (int j = 0; j < EVENTS_PER_THREAD; ++j) {
+                    tracing::traceEvent(trace_test(), EVENT_NAME, tracing::DurationBegin);
+                    tracing::traceEvent(trace_test(), EVENT_NAME, tracing::DurationEnd);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    tracer->stopTracing();
+
+    QTemporaryDir outputDir;
+    QVERIFY(outputDir.isValid());
+    QString outputFile = outputDir.filePath("compactTrace.json");
+    tracer->serialize(outputFile);
+
+    QFile file(outputFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    auto document = QJsonDocument::fromJson(file.readAll(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QVERIFY(document.isArray());
+
+    int numBegin = 0;
+    int numEnd = 0;
+    for (const auto& value : document.array()) {
+        auto event = value.toObject();
+        if (event["name"].toString() == EVENT_NAME) {
+            if (event["ph"].toString() == "B") {
+                ++numBegin;
+            } else if (event["ph"].toString() == "E") {
+                ++numEnd;
+            }
+        }
+    }
+    QCOMPARE(numBegin, NUM_THREADS * EVENTS_PER_THREAD);
+    QCOMPARE(numEnd, NUM_THREADS * EVENTS_PER_THREAD);
+}
@@ -15,6 +15,7 @@ class TraceTests : public QObject {
     Q_OBJECT
 private slots:
     void testTraceSerialization();
+    void testCompactEventsFromThreads();
 };
 
 #endif // hifi_TraceTests_h
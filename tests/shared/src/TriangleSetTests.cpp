@@ -0,0 +1,235 @@
+//
+//  TriangleSetTests.cpp
+//  tests/shared/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleSetTests.h"
+
+#include <iostream>
+#include <vector>
+
+#include <glm/gtc/random.hpp>
+
+#include <TriangleSet.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(TriangleSetTests)
+
+static const int NUM_QUERIES = 1000;
+
+static Triangle makeTriangle(const glm::vec3& center, float size) {
+    return Triangle { center + glm::linearRand(glm::vec3(-size), glm::vec3(size)),
+                      center + glm::linearRand(glm::vec3(-size), glm::vec3(size)),
+                      center + glm::linearRand(glm::vec3(-size), glm::vec3(size)) };
+}
+
+// a soup of small random triangles in a 20m cube
+static void makeTriangleSoup(int count, TriangleSet& triangleSet, std::vector<Triangle>& triangles) {
+    for (int i = 0; i < count; ++i) {
+        triangles.push_back(makeTriangle(glm::linearRand(glm::vec3(-10.0f), glm::vec3(10.0f)), 0.5f));
+        triangleSet.insert(triangles.back());
+    }
+}
+
+static bool findBruteForceRayIntersection(const std::vector<Triangle>& triangles, const glm::vec3& origin,
+                                          const glm::vec3& direction, float& distance) {
+    bool hit = false;
+    distance = FLT_MAX;
+    for (const auto& triangle : triangles) {
+        float triangleDistance;
+        if (findRayTriangleIntersection(origin, direction, triangle, triangleDistance) && triangleDistance < distance) {
+            distance = triangleDistance;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+static void compareRays(TriangleSet& triangleSet, const std::vector<Triangle>& triangles) {
+    int hits = 0;
+    for (int i = 0; i < NUM_QUERIES; ++i) {
+        glm::vec3 origin = glm::linearRand(glm::vec3(-15.0f), glm::vec3(15.0f));
+        glm::vec3 direction = glm::sphericalRand(1.0f);
+
+        float expectedDistance;
+        bool expectedHit = findBruteForceRayIntersection(triangles, origin, direction, expectedDistance);
+
+        float distance = FLT_MAX;
+        BoxFace face;
+        Triangle triangle;
+        bool hit = triangleSet.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, true);
+        QCOMPARE(hit, expectedHit);
+        if (hit) {
+            QCOMPARE_WITH_ABS_ERROR(distance, expectedDistance, EPSILON);
+            float triangleDistance;
+            QVERIFY(findRayTriangleIntersection(origin, direction, triangle, triangleDistance));
+            hits++;
+        }
+    }
+    // make sure the rays actually exercise the tree
+    QVERIFY(hits > NUM_QUERIES / 10);
+}
+
+void TriangleSetTests::emptyTest() {
+    TriangleSet triangleSet;
+    float distance = FLT_MAX;
+    BoxFace face;
+    Triangle triangle;
+    glm::vec3 direction(0.0f, 0.0f, 1.0f);
+    QVERIFY(!triangleSet.findRayIntersection(glm::vec3(0.0f), direction, 1.0f / direction, distance, face, triangle, true));
+
+    // a single leaf under the root
+    triangleSet.insert(Triangle { glm::vec3(-1.0f, -1.0f, 5.0f), glm::vec3(1.0f, -1.0f, 5.0f), glm::vec3(0.0f, 1.0f, 5.0f) });
+    QVERIFY(triangleSet.findRayIntersection(glm::vec3(0.0f), direction, 1.0f / direction, distance, face, triangle, true));
+    QCOMPARE_WITH_ABS_ERROR(distance, 5.0f, EPSILON);
+
+    triangleSet.clear();
+    QVERIFY(!triangleSet.findRayIntersection(glm::vec3(0.0f), direction, 1.0f / direction, distance, face, triangle, true));
+}
+
+void TriangleSetTests::rayTest() {
+    for (int count : { 3, 17, 5000 }) {
+        TriangleSet triangleSet;
+        std::vector<Triangle> triangles;
+        makeTriangleSoup(count, triangleSet, triangles);
+        compareRays(triangleSet, triangles);
+
+        // triangles inserted after a query rebuild the tree
+        makeTriangleSoup(count, triangleSet, triangles);
+        compareRays(triangleSet, triangles);
+    }
+}
+
+void TriangleSetTests::parabolaTest() {
+    TriangleSet triangleSet;
+    std::vector<Triangle> triangles;
+    makeTriangleSoup(5000, triangleSet, triangles);
+    const glm::vec3 acceleration(0.0f, -9.8f, 0.0f);
+
+    for (int i = 0; i < NUM_QUERIES; ++i) {
+        glm::vec3 origin = glm::linearRand(glm::vec3(-15.0f), glm::vec3(15.0f));
+        glm::vec3 velocity = glm::sphericalRand(5.0f);
+
+        bool expectedHit = false;
+        float expectedDistance = FLT_MAX;
+        for (const auto& triangle : triangles) {
+            float triangleDistance;
+            if (findParabolaTriangleIntersection(origin, velocity, acceleration, triangle, triangleDistance) &&
+                triangleDistance < expectedDistance) {
+                expectedDistance = triangleDistance;
+                expectedHit = true;
+            }
+        }
+
+        float distance = FLT_MAX;
+        BoxFace face;
+        Triangle triangle;
+        bool hit = triangleSet.findParabolaIntersection(origin, velocity, acceleration, distance, face, triangle, true);
+        QCOMPARE(hit, expectedHit);
+        if (hit) {
+            QCOMPARE_WITH_ABS_ERROR(distance, expectedDistance, EPSILON);
+        }
+    }
+}
+
+void TriangleSetTests::refitTest() {
+    TriangleSet triangleSet;
+    std::vector<Triangle> triangles;
+    makeTriangleSoup(5000, triangleSet, triangles);
+    compareRays(triangleSet, triangles);
+
+    // move and stretch every triangle, as skinning would, without changing the topology of the tree
+    for (int frame = 0; frame < 3; ++frame) {
+        glm::vec3 offset = glm::linearRand(glm::vec3(-2.0f), glm::vec3(2.0f));
+        for (size_t i = 0; i < triangles.size(); ++i) {
+            Triangle& triangle = triangles[i];
+            triangle = Triangle { triangle.v0 + offset, triangle.v1 + offset, triangle.v2 * 1.05f };
+            triangleSet.setTriangle(i, triangle);
+        }
+        compareRays(triangleSet, triangles);
+
+        AABox bounds;
+        for (const auto& triangle : triangles) {
+            bounds += triangle.v0;
+            bounds += triangle.v1;
+            bounds += triangle.v2;
+        }
+        QCOMPARE_WITH_ABS_ERROR(triangleSet.getBounds().getCorner(), bounds.getCorner(), 0.001f);
+        QCOMPARE_WITH_ABS_ERROR(triangleSet.getBounds().getDimensions(), bounds.getDimensions(), 0.001f);
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void TriangleSetTests::benchmark() {
+    // a bumpy 708 x 708 quad terrain, about a million triangles, picked from above as a laser pointer would
+    const int GRID_SIZE = 708;
+    const int NUM_RAYS = 1000000;
+    const int NUM_PARABOLAS = 100000;
+
+    TriangleSet triangleSet;
+    triangleSet.reserve(2 * GRID_SIZE * GRID_SIZE);
+    auto vertex = [](int x, int z) {
+        return glm::vec3((float)x, 2.0f * sinf(0.1f * x) * cosf(0.13f * z), (float)z);
+    };
+    for (int x = 0; x < GRID_SIZE; ++x) {
+        for (int z = 0; z < GRID_SIZE; ++z) {
+            triangleSet.insert(Triangle { vertex(x, z), vertex(x + 1, z), vertex(x, z + 1) });
+            triangleSet.insert(Triangle { vertex(x + 1, z), vertex(x + 1, z + 1), vertex(x, z + 1) });
+        }
+    }
+
+    uint64_t startTime = usecTimestampNow();
+    triangleSet.balanceTree();
+    uint64_t buildUsec = usecTimestampNow() - startTime;
+
+    std::vector<glm::vec3> origins;
+    std::vector<glm::vec3> directions;
+    for (int i = 0; i < NUM_RAYS; ++i) {
+        origins.push_back(glm::vec3(glm::linearRand(0.0f, (float)GRID_SIZE), 20.0f, glm::linearRand(0.0f, (float)GRID_SIZE)));
+        directions.push_back(glm::normalize(glm::vec3(glm::linearRand(-1.0f, 1.0f), -1.0f, glm::linearRand(-1.0f, 1.0f))));
+    }
+
+    int hits = 0;
+    startTime = usecTimestampNow();
+    for (int i = 0; i < NUM_RAYS; ++i) {
+        float distance = FLT_MAX;
+        BoxFace face;
+        Triangle triangle;
+        if (triangleSet.findRayIntersection(origins[i], directions[i], 1.0f / directions[i], distance, face, triangle, true)) {
+            hits++;
+        }
+    }
+    uint64_t rayUsec = usecTimestampNow() - startTime;
+
+    int parabolaHits = 0;
+    const glm::vec3 acceleration(0.0f, -9.8f, 0.0f);
+    startTime = usecTimestampNow();
+    for (int i = 0; i < NUM_PARABOLAS; ++i) {
+        float distance = FLT_MAX;
+        BoxFace face;
+        Triangle triangle;
+        if (triangleSet.findParabolaIntersection(origins[i], 10.0f * directions[i], acceleration, distance, face, triangle, true)) {
+            parabolaHits++;
+        }
+    }
+    uint64_t parabolaUsec = usecTimestampNow() - startTime;
+
+    startTime = usecTimestampNow();
+    triangleSet.refit();
+    uint64_t refitUsec = usecTimestampNow() - startTime;
+
+    std::cout << "picking against " << triangleSet.size() << " triangles" << std::endl;
+    std::cout << "    build:     " << buildUsec / USECS_PER_MSEC << " msec, refit: " << refitUsec / USECS_PER_MSEC << " msec" << std::endl;
+    std::cout << "    rays:      " << (double)NUM_RAYS * USECS_PER_SECOND / rayUsec << " /sec, " << hits << " hits" << std::endl;
+    std::cout << "    parabolas: " << (double)NUM_PARABOLAS * USECS_PER_SECOND / parabolaUsec << " /sec, " << parabolaHits << " hits" << std::endl;
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,28 @@
+//
+//  TriangleSetTests.h
+//  tests/shared/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TriangleSetTests_h
+#define hifi_TriangleSetTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class TriangleSetTests : public QObject {
+    Q_OBJECT
+private slots:
+    void emptyTest();
+    void rayTest();
+    void parabolaTest();
+    void refitTest();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_TriangleSetTests_h
@@ -0,0 +1,149 @@
+//
+//  TaskTests.cpp
+//  tests/task/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TaskTests.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <task/Task.h>
+
+QTEST_MAIN(TaskTests)
+
+Q_LOGGING_CATEGORY(trace_test_task, "trace.test.task")
+
+namespace test {
+
+    // Records the order in which jobs start and finish
+    class Timeline {
+    public:
+        void record(const std::string& event) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _events.push_back(event);
+        }
+        int indexOf(const std::string& event) const {
+            auto it = std::find(_events.begin(), _events.end(), event);
+            return it == _events.end() ? -1 : (int)(it - _events.begin());
+        }
+        size_t size() const { return _events.size(); }
+    private:
+        std::mutex _mutex;
+        std::vector<std::string> _events;
+    };
+
+    class TestContext : public task::JobContext {
+    public:
+        TestContext(const std::shared_ptr<Timeline>& timeline, bool forkable) : _timeline(timeline), _forkable(forkable) {}
+
+        std::shared_ptr<task::JobContext> fork() const override {
+            return _forkable ? std::make_shared<TestContext>(*this) : nullptr;
+        }
+
+        std::shared_ptr<Timeline> _timeline;
+        bool _forkable;
+    };
+    using TestContextPointer = std::shared_ptr<TestContext>;
+
+    Task_DeclareCategoryTimeProfilerClass(TestTimeProfiler, trace_test_task);
+    Task_DeclareTypeAliases(TestContext, TestTimeProfiler)
+
+    // Sleeps for a bit, then outputs its input plus one
+    class Step {
+    public:
+        using JobModel = Job::ModelIO<Step, int, int>;
+
+        Step(const std::string& name = std::string()) : _name(name) {}
+
+        void run(const TestContextPointer& context, const int& input, int& output) {
+            context->_timeline->record("start " + _name);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            output = input + 1;
+            context->_timeline->record("end " + _name);
+        }
+
+        std::string _name;
+    };
+
+    // Sums the outputs of two steps
+    class Join {
+    public:
+        using Input = VaryingSet2<int, int>;
+        using JobModel = Job::ModelIO<Join, Input, int>;
+
+        void run(const TestContextPointer& context, const Input& input, int& output) {
+            context->_timeline->record("start join");
+            output = input.get0() + input.get1();
+            context->_timeline->record("end join");
+        }
+    };
+
+    // Diamond: a -> (b, c) -> join
+    class DiamondTask {
+    public:
+        using JobModel = Task::ModelIO<DiamondTask, int, int>;
+
+        void build(JobModel& task, const Varying& input, Varying& output, bool parallel) {
+            task.setParallel(parallel);
+            const auto a = task.addJob<Step>("A", input, std::string("a"));
+            const auto b = task.addJob<Step>("B", a, std::string("b"));
+            const auto c = task.addJob<Step>("C", a, std::string("c"));
+            output = task.addJob<Join>("Join", Join::Input(b, c).asVarying());
+        }
+    };
+}
+
+void TaskTests::testJobGraphDependencies() {
+    task::Varying input(0);
+    task::Varying a(1), b(2), c(3), d(4);
+    task::VaryingSet2<int, int> bc(b, c);
+
+    // job 0: input -> a, job 1: a -> b, job 2: a -> c, job 3: (b, c) -> d, job 4: input -> unused
+    task::JobGraph graph({ input, a, a, bc.asVarying(), input }, { a, b, c, d, task::Varying(5) });
+
+    QCOMPARE(graph.getNumJobs(), (size_t)5);
+    QCOMPARE(graph.getNumDependencies(0), (uint32_t)0);
+    QCOMPARE(graph.getNumDependencies(1), (uint32_t)1);
+    QCOMPARE(graph.getNumDependencies(2), (uint32_t)1);
+    QCOMPARE(graph.getNumDependencies(3), (uint32_t)2);
+    QCOMPARE(graph.getNumDependencies(4), (uint32_t)0);
+    QCOMPARE(graph.getDependents(0).size(), (size_t)2);
+
+    std::atomic<int> numRun { 0 };
+    graph.run([&](size_t) { numRun++; });
+    QCOMPARE(numRun.load(), 5);
+}
+
+void TaskTests::testParallelTaskOrdering() {
+    auto timeline = std::make_shared<test::Timeline>();
+    auto context = std::make_shared<test::TestContext>(timeline, true);
+    test::Engine engine(test::DiamondTask::JobModel::create("Diamond", task::Varying(0), true), context);
+    engine.feedInput<int>(1);
+    engine.run();
+
+    QCOMPARE(engine.getOutput().get<int>(), 6);
+    QCOMPARE(timeline->size(), (size_t)8);
+    QVERIFY(timeline->indexOf("end a") < timeline->indexOf("start b"));
+    QVERIFY(timeline->indexOf("end a") < timeline->indexOf("start c"));
+    QVERIFY(timeline->indexOf("end b") < timeline->indexOf("start join"));
+    QVERIFY(timeline->indexOf("end c") < timeline->indexOf("start join"));
+}
+
+void TaskTests::testSerialFallback() {
+    // a context that can't be forked runs the jobs in the order they were added
+    auto timeline = std::make_shared<test::Timeline>();
+    auto context = std::make_shared<test::TestContext>(timeline, false);
+    test::Engine engine(test::DiamondTask::JobModel::create("Diamond", task::Varying(0), true), context);
+    engine.feedInput<int>(1);
+    engine.run();
+
+    QCOMPARE(engine.getOutput().get<int>(), 6);
+    QCOMPARE(timeline->indexOf("end b"), timeline->indexOf("start b") + 1);
+    QCOMPARE(timeline->indexOf("start c"), timeline->indexOf("end b") + 1);
+}
@@ -0,0 +1,23 @@
+//
+//  TaskTests.h
+//  tests/task/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_task_TaskTests_h
+#define hifi_task_TaskTests_h
+
+#include <QtTest/QtTest>
+
+class TaskTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testJobGraphDependencies();
+    void testParallelTaskOrdering();
+    void testSerialFallback();
+};
+
+#endif // hifi_task_TaskTests_h
@@ -0,0 +1,75 @@
+//
+//  CrowdAvatar.cpp
+//  tools/crowd-client/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CrowdAvatar.h"
+
+#include <QtCore/QDebug>
+
+#include <AvatarTraits.h>
+
+QByteArray CrowdAvatar::toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) {
+    _globalPosition = getWorldPosition();
+    return AvatarData::toByteArrayStateful(dataDetail, dropFaceTracking);
+}
+
+std::unique_ptr<NLPacket> CrowdAvatar::createAvatarDataPacket(bool sendAll) {
+    // same encoding and fallbacks as AvatarData::sendAvatarDataPacket
+    bool cullSmallData = !sendAll && (randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO);
+    auto dataDetail = cullSmallData ? SendAllData : CullSmallData;
+    QByteArray avatarByteArray = toByteArrayStateful(dataDetail);
+
+    int maximumByteArraySize = NLPacket::maxPayloadSize(PacketType::AvatarData) - sizeof(AvatarDataSequenceNumber);
+
+    if (avatarByteArray.size() > maximumByteArraySize) {
+        avatarByteArray = toByteArrayStateful(dataDetail, true);
+
+        if (avatarByteArray.size() > maximumByteArraySize) {
+            avatarByteArray = toByteArrayStateful(MinimumData, true);
+
+            if (avatarByteArray.size() > maximumByteArraySize) {
+                qWarning() << "toByteArrayStateful() MinimumData resulted in very large buffer:" << avatarByteArray.size();
+                return nullptr;
+            }
+        }
+    }
+
+    doneEncoding(cullSmallData);
+
+    auto avatarPacket = NLPacket::create(PacketType::AvatarData, avatarByteArray.size() + sizeof(_sequenceNumber));
+    avatarPacket->writePrimitive(_sequenceNumber++);
+    avatarPacket->write(avatarByteArray);
+    return avatarPacket;
+}
+
+std::unique_ptr<NLPacket> CrowdAvatar::createIdentityPacket() {
+    if (_identityDataChanged) {
+        // if the identity data has changed, push the sequence number forwards
+        ++_identitySequenceNumber;
+        _identityDataChanged = false;
+    }
+
+    // sent as a single packet rather than a reliable list: a reliable connection runs its send queue on a thread of
+    // its own, which a process hosting hundreds of bots can't afford, so the session resends it instead
+    QByteArray identityData = identityByteArray();
+    auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, identityData.size());
+    identityPacket->write(identityData);
+    return identityPacket;
+}
+
+std::unique_ptr<NLPacket> CrowdAvatar::createTraitsPacket() {
+    // the mixer ignores traits whose version it has already seen, so resending an unchanged skeleton is free
+    if (_traitVersion == AvatarTraits::DEFAULT_TRAIT_VERSION || getSkeletonModelURL() != _sentSkeletonModelURL) {
+        _sentSkeletonModelURL = getSkeletonModelURL();
+        ++_traitVersion;
+    }
+
+    auto traitsPacket = NLPacket::create(PacketType::SetAvatarTraits);
+    traitsPacket->writePrimitive(_traitVersion);
+    AvatarTraits::packTrait(AvatarTraits::SkeletonModelURL, *traitsPacket, *this);
+    return traitsPacket;
+}
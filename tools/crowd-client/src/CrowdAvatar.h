@@ -0,0 +1,33 @@
+//
+//  CrowdAvatar.h
+//  tools/crowd-client/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CrowdAvatar_h
+#define hifi_CrowdAvatar_h
+
+#include <AvatarData.h>
+#include <NLPacket.h>
+
+// The avatar of a crowd bot.  It has no rig or animation, all joints come from the recording being played, and it
+// doesn't send anything itself: a process hosts many bots, so its session builds the packets and sends them on that
+// bot's own socket.  AvatarData::sendAvatarDataPacket can't be used for that, its sequence number is process wide.
+class CrowdAvatar : public AvatarData {
+    Q_OBJECT
+public:
+    QByteArray toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking = false) override;
+
+    std::unique_ptr<NLPacket> createAvatarDataPacket(bool sendAll);
+    std::unique_ptr<NLPacket> createIdentityPacket();
+    std::unique_ptr<NLPacket> createTraitsPacket();
+
+private:
+    AvatarDataSequenceNumber _sequenceNumber { 0 };
+    AvatarTraits::TraitVersion _traitVersion { AvatarTraits::DEFAULT_TRAIT_VERSION };
+    QUrl _sentSkeletonModelURL;
+};
+
+#endif // hifi_CrowdAvatar_h
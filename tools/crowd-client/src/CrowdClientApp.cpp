@@ -0,0 +1,241 @@
+//
+//  CrowdClientApp.cpp
+//  tools/crowd-client/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CrowdClientApp.h"
+
+#include <cmath>
+#include <iostream>
+
+#include <QCommandLineParser>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+
+#include <AudioConstants.h>
+#include <DomainHandler.h>
+#include <NetworkLogging.h>
+#include <SharedLogging.h>
+#include <SharedUtil.h>
+#include <shared/NetworkUtils.h>
+
+static const int DEFAULT_REPORT_INTERVAL_SECS = 5;
+static const float DEFAULT_SPACING_METERS = 2.0f;
+
+CrowdClientApp::CrowdClientApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless crowd bots: play back recordings as avatar and audio streams");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption verboseOutput("v", "verbose output");
+    parser.addOption(verboseOutput);
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address, host[:port]", "127.0.0.1");
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption recordingOption("recording",
+        "recording (.hfr) to play back, looped; give it more than once to hand the recordings out in turn", "path");
+    parser.addOption(recordingOption);
+
+    const QCommandLineOption botsOption("bots", "number of bots to run in this process", "1");
+    parser.addOption(botsOption);
+
+    const QCommandLineOption nameOption("name", "prefix of the bot names in reports", "name");
+    parser.addOption(nameOption);
+
+    const QCommandLineOption positionOption("position", "center of the grid the bots play their recordings at", "x,y,z");
+    parser.addOption(positionOption);
+
+    const QCommandLineOption spacingOption("spacing", "meters between the bots of the grid",
+                                           QString::number(DEFAULT_SPACING_METERS));
+    parser.addOption(spacingOption);
+
+    const QCommandLineOption reportIntervalOption("report-interval", "seconds between reports",
+                                                  QString::number(DEFAULT_REPORT_INTERVAL_SECS));
+    parser.addOption(reportIntervalOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to run before exiting, 0 runs until killed", "0");
+    parser.addOption(durationOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption) || !parser.isSet(recordingOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _verbose = parser.isSet(verboseOutput);
+    if (!_verbose) {
+        QLoggingCategory::setFilterRules("qt.network.ssl.warning=false");
+
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtWarningMsg, false);
+
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtWarningMsg, false);
+    }
+
+    QString domainServerAddress = parser.isSet(domainAddressOption) ? parser.value(domainAddressOption) : "127.0.0.1";
+    QString domainServerHost = domainServerAddress.section(':', 0, 0);
+    quint16 domainServerPort = DEFAULT_DOMAIN_SERVER_PORT;
+    if (domainServerAddress.contains(':')) {
+        domainServerPort = (quint16)domainServerAddress.section(':', 1, 1).toUInt();
+    }
+    SockAddr domainServer(SocketType::UDP, domainServerHost, domainServerPort, true);
+    if (domainServer.getAddress().isNull()) {
+        qCritical() << "Unable to resolve domain-server address" << domainServerAddress;
+        QTimer::singleShot(0, this, [this] { finish(1); });
+        return;
+    }
+
+    // the bots tell the domain-server where the mixers can reach them, without STUN that's a local address
+    QHostAddress localAddress = domainServer.getAddress().isLoopback() ? QHostAddress(QHostAddress::LocalHost)
+                                                                       : getGuessedLocalAddress();
+
+    // every bot playing a recording shares its frames, each has its own cursor
+    std::vector<std::shared_ptr<const CrowdRecording>> recordings;
+    for (const QString& recordingPath : parser.values(recordingOption)) {
+        auto recording = CrowdRecording::fromFile(recordingPath);
+        if (!recording) {
+            qCritical() << "Unable to load recording" << recordingPath;
+            QTimer::singleShot(0, this, [this] { finish(1); });
+            return;
+        }
+        recordings.push_back(recording);
+    }
+
+    int numBots = std::max(parser.value(botsOption).toInt(), 1);
+    QString namePrefix = parser.isSet(nameOption) ? parser.value(nameOption) : QString("crowd-%1").arg(applicationPid());
+
+    glm::vec3 center;
+    if (parser.isSet(positionOption)) {
+        QStringList coordinates = parser.value(positionOption).split(",");
+        if (coordinates.size() == 3) {
+            center = glm::vec3(coordinates[0].toFloat(), coordinates[1].toFloat(), coordinates[2].toFloat());
+        } else {
+            qWarning() << "--position should be followed by x,y,z";
+        }
+    }
+    float spacing = parser.value(spacingOption).toFloat();
+    int columns = (int)std::ceil(std::sqrt((float)numBots));
+    float gridOffset = (float)(columns - 1) / 2.0f;
+
+    _packetThread.setObjectName("Crowd Packet Thread");
+    _packetThread.start();
+
+    // the sessions are created on the packet thread, so their sockets and timers belong to it
+    _updateTimer = new QTimer();
+    _updateTimer->setTimerType(Qt::PreciseTimer);
+    _updateTimer->moveToThread(&_packetThread);
+    QMetaObject::invokeMethod(_updateTimer, [&] {
+        for (int i = 0; i < numBots; i++) {
+            glm::vec3 position = center + spacing * glm::vec3((float)(i % columns) - gridOffset, 0.0f,
+                                                              (float)(i / columns) - gridOffset);
+            QString name = numBots > 1 ? QString("%1-%2").arg(namePrefix).arg(i) : namePrefix;
+            auto session = new CrowdSession(name, domainServer, localAddress, recordings[i % recordings.size()],
+                                            position, _latencyTracker, _verbose);
+            session->setParent(_updateTimer);
+            session->start();
+            _sessions.push_back(session);
+        }
+
+        connect(_updateTimer, &QTimer::timeout, _updateTimer, [this] { update(); });
+        _updateTimer->start((int)(AudioConstants::NETWORK_FRAME_USECS / USECS_PER_MSEC));
+    }, Qt::BlockingQueuedConnection);
+
+    int reportIntervalSecs = parser.value(reportIntervalOption).toInt();
+    connect(&_reportTimer, &QTimer::timeout, this, [this] {
+        if (_updateTimer) {
+            QMetaObject::invokeMethod(_updateTimer, [this] { report(); });
+        }
+    });
+    _reportTimer.start(std::max(reportIntervalSecs, 1) * (int)MSECS_PER_SECOND);
+
+    int durationSecs = parser.value(durationOption).toInt();
+    if (durationSecs > 0) {
+        QTimer::singleShot(durationSecs * (int)MSECS_PER_SECOND, this, [this] { finish(0); });
+    }
+
+    _uptime.start();
+}
+
+CrowdClientApp::~CrowdClientApp() {
+    _packetThread.quit();
+    _packetThread.wait();
+}
+
+void CrowdClientApp::update() {
+    quint64 now = usecTimestampNow();
+    for (auto session : _sessions) {
+        session->update(now);
+    }
+}
+
+void CrowdClientApp::report() {
+    double uptime = (double)_uptime.elapsed() / (double)MSECS_PER_SECOND;
+
+    int connected = 0;
+    CrowdSession::ArrivalStats audio;
+    CrowdSession::ArrivalStats avatar;
+    for (auto session : _sessions) {
+        QJsonObject json = session->report();
+        json["uptime"] = uptime;
+        std::cout << QJsonDocument(json).toJson(QJsonDocument::Compact).constData() << std::endl;
+
+        connected += session->isConnected() ? 1 : 0;
+        for (auto stats : { std::make_pair(&audio, &session->getAudioStats()),
+                            std::make_pair(&avatar, &session->getAvatarStats()) }) {
+            stats.first->gaps.update(stats.second->gaps);
+            stats.first->latency.update(stats.second->latency);
+            stats.first->pingMs.update(stats.second->pingMs);
+            stats.first->packets += stats.second->packets;
+            stats.first->bytes += stats.second->bytes;
+            stats.first->late += stats.second->late;
+            stats.first->sent += stats.second->sent;
+        }
+        session->resetStats();
+    }
+
+    QJsonObject crowd;
+    crowd["crowd"] = (int)_sessions.size();
+    crowd["connected"] = connected;
+    crowd["uptime"] = uptime;
+    crowd["audio"] = audio.toJson();
+    crowd["avatar"] = avatar.toJson();
+    std::cout << QJsonDocument(crowd).toJson(QJsonDocument::Compact).constData() << std::endl;
+}
+
+void CrowdClientApp::finish(int exitCode) {
+    _reportTimer.stop();
+
+    if (_updateTimer) {
+        // the timer is the context of this call, it's deleted on the packet thread once the call has returned
+        QMetaObject::invokeMethod(_updateTimer, [this] {
+            _updateTimer->stop();
+            for (auto session : _sessions) {
+                session->stop();
+            }
+            _sessions.clear();
+            _updateTimer->deleteLater();
+        }, Qt::BlockingQueuedConnection);
+        _updateTimer = nullptr;
+    }
+    // the thread deletes the timer and its sessions as it finishes
+    _packetThread.quit();
+    _packetThread.wait();
+
+    QCoreApplication::exit(exitCode);
+}
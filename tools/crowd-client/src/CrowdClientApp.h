@@ -0,0 +1,49 @@
+//
+//  CrowdClientApp.h
+//  tools/crowd-client/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CrowdClientApp_h
+#define hifi_CrowdClientApp_h
+
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QTimer>
+
+#include "CrowdSession.h"
+
+// Headless load-test bots: each one an avatar and an audio stream driven by a looping .hfr recording.
+// Unlike an Agent assignment a bot has no script engine, entity tree or codecs, audio is sent as raw PCM, and one
+// process hosts many of them: every bot has its own socket and session but they all run on a single packet thread,
+// which a timer wakes at the audio frame rate.  Every report interval it prints one JSON line per bot with the
+// arrival statistics and latencies of the packets it received from the mixers, then one line for the whole crowd.
+class CrowdClientApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    CrowdClientApp(int argc, char* argv[]);
+    ~CrowdClientApp();
+
+private:
+    void update();
+    void report();
+    void finish(int exitCode);
+
+    bool _verbose { false };
+
+    QThread _packetThread;
+    // lives on the packet thread, so does everything it owns
+    QTimer* _updateTimer { nullptr };
+    std::vector<CrowdSession*> _sessions;
+    CrowdLatencyTracker _latencyTracker;
+
+    QTimer _reportTimer;
+    QElapsedTimer _uptime;
+};
+
+#endif // hifi_CrowdClientApp_h
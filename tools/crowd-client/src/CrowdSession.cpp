@@ -0,0 +1,726 @@
+//
+//  CrowdSession.cpp
+//  tools/crowd-client/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CrowdSession.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDebug>
+
+#include <AudioConstants.h>
+#include <AvatarTraits.h>
+#include <DomainHandler.h>
+#include <FingerprintUtils.h>
+#include <LimitedNodeList.h>
+#include <NetworkPeer.h>
+#include <NodeList.h>
+#include <NodePermissions.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <Transform.h>
+#include <ViewFrustum.h>
+#include <recording/Clip.h>
+#include <shared/ConicalViewFrustum.h>
+#include <udt/PacketHeaders.h>
+#include <udt/Socket.h>
+
+static const int KEEPALIVE_PING_INTERVAL_MSECS = 1000;
+static const int AVATAR_QUERY_INTERVAL_MSECS = 1000;
+
+// identity and traits go out unreliably, resend them in case the first ones were lost
+static const int IDENTITY_RESEND_INTERVAL_MSECS = 5000;
+
+// the avatar mixer broadcasts to each agent at 45Hz
+static const quint64 AVATAR_MIXER_BROADCAST_INTERVAL_USECS = USECS_PER_SECOND / 45;
+
+// how many of its last positions are kept for each avatar, enough for the mixer to be a second behind
+static const size_t MAX_SENT_POSITIONS = 64;
+
+std::shared_ptr<const CrowdRecording> CrowdRecording::fromFile(const QString& filePath) {
+    auto clip = recording::Clip::fromFile(filePath);
+    if (!clip) {
+        return nullptr;
+    }
+
+    auto recording = std::make_shared<CrowdRecording>();
+    recording->name = clip->getName();
+    recording->frames.reserve(clip->frameCount());
+    clip->seekFrameTime(0);
+    for (auto frame = clip->nextFrame(); frame; frame = clip->nextFrame()) {
+        recording->frames.push_back(frame);
+    }
+    recording->duration = (recording::Frame::Time)(clip->duration() * MSECS_PER_SECOND);
+    if (recording->frames.empty() || recording->duration == 0) {
+        return nullptr;
+    }
+    return recording;
+}
+
+void CrowdLatencyTracker::positionSent(const QUuid& avatarID, const glm::vec3& position, quint64 sendTime) {
+    auto& sentPositions = _sentPositions[avatarID];
+    sentPositions.push_back({ position, sendTime });
+    if (sentPositions.size() > MAX_SENT_POSITIONS) {
+        sentPositions.pop_front();
+    }
+}
+
+quint64 CrowdLatencyTracker::getSendTime(const QUuid& avatarID, const glm::vec3& position) const {
+    auto it = _sentPositions.find(avatarID);
+    if (it == _sentPositions.end()) {
+        return 0;
+    }
+
+    // the mixer forwards the positions bit for bit, look for the latest send of this one
+    for (auto sent = it->second.rbegin(); sent != it->second.rend(); ++sent) {
+        if (sent->position == position) {
+            return sent->time;
+        }
+    }
+    return 0;
+}
+
+void CrowdLatencyTracker::removeAvatar(const QUuid& avatarID) {
+    _sentPositions.erase(avatarID);
+}
+
+void CrowdSession::ArrivalStats::received(int packetBytes, quint64 now) {
+    if (lastArrival != 0) {
+        quint64 gap = now - lastArrival;
+        gaps.update(gap);
+        if (gap > lateThreshold) {
+            late++;
+        }
+    }
+    lastArrival = now;
+    packets++;
+    bytes += packetBytes;
+}
+
+void CrowdSession::ArrivalStats::reset() {
+    gaps.reset();
+    latency.reset();
+    pingMs.reset();
+    packets = 0;
+    bytes = 0;
+    late = 0;
+    sent = 0;
+}
+
+QJsonObject CrowdSession::ArrivalStats::toJson() const {
+    QJsonObject json;
+    json["sent"] = sent;
+    json["packets"] = packets;
+    json["bytes"] = bytes;
+    json["late"] = late;
+    if (gaps.getSamples() > 0) {
+        json["gapAvgMs"] = gaps.getAverage() / (double)USECS_PER_MSEC;
+        json["gapMinMs"] = (double)gaps.getMin() / (double)USECS_PER_MSEC;
+        json["gapMaxMs"] = (double)gaps.getMax() / (double)USECS_PER_MSEC;
+    }
+    if (latency.getSamples() > 0) {
+        json["latencySamples"] = latency.getSamples();
+        json["latencyAvgMs"] = latency.getAverage() / (double)USECS_PER_MSEC;
+        json["latencyMinMs"] = (double)latency.getMin() / (double)USECS_PER_MSEC;
+        json["latencyMaxMs"] = (double)latency.getMax() / (double)USECS_PER_MSEC;
+    }
+    json["pingMs"] = pingMs.getSamples() > 0 ? pingMs.getAverage() : -1.0;
+    return json;
+}
+
+CrowdSession::CrowdSession(const QString& name, const SockAddr& domainServer, const QHostAddress& localAddress,
+                           std::shared_ptr<const CrowdRecording> recording, const glm::vec3& position,
+                           CrowdLatencyTracker& latencyTracker, bool verbose) :
+    _name(name),
+    _verbose(verbose),
+    _latencyTracker(latencyTracker),
+    _domainServer(domainServer),
+    _localAddress(localAddress),
+    _recording(recording)
+{
+    auto basis = std::make_shared<Transform>();
+    basis->setTranslation(position);
+    _avatar.setRecordingBasis(basis);
+
+    _audioStats.lateThreshold = 2 * AudioConstants::NETWORK_FRAME_USECS;
+    _avatarStats.lateThreshold = 2 * AVATAR_MIXER_BROADCAST_INTERVAL_USECS;
+}
+
+CrowdSession::~CrowdSession() {
+    _latencyTracker.removeAvatar(_sessionUUID);
+}
+
+void CrowdSession::start() {
+    _socket = new udt::Socket(this);
+    _socket->bind(SocketType::UDP, QHostAddress::AnyIPv4);
+    _localSockAddr = SockAddr(SocketType::UDP, _localAddress, _socket->localPort(SocketType::UDP));
+
+    _socket->setPacketFilterOperator([this](const udt::Packet& packet) {
+        // only the versions this build speaks, the same check as LimitedNodeList::packetVersionMatch
+        PacketType type = NLPacket::typeInHeader(packet);
+        if (NLPacket::versionInHeader(packet) != versionForPacketType(type)) {
+            if (type == PacketType::DomainList || type == PacketType::DomainConnectionDenied) {
+                qWarning() << _name << "packet version mismatch with the domain-server";
+            }
+            return false;
+        }
+        return true;
+    });
+    _socket->setPacketHandler([this](std::unique_ptr<udt::Packet> packet) { handlePacket(std::move(packet)); });
+    _socket->setMessageHandler([this](std::unique_ptr<udt::Packet> packet) { handleMessagePacket(std::move(packet)); });
+
+    _loopStart = usecTimestampNow();
+}
+
+void CrowdSession::stop() {
+    if (_socket && _isConnected) {
+        auto disconnectPacket = NLPacket::create(PacketType::DomainDisconnectRequest, 0);
+        sendToDomainServer(*disconnectPacket);
+    }
+    resetDomainConnection();
+}
+
+void CrowdSession::update(quint64 now) {
+    if (now >= _nextDomainCheckIn) {
+        sendDomainServerCheckIn(now);
+        _nextDomainCheckIn = now + DOMAIN_SERVER_CHECK_IN_MSECS * USECS_PER_MSEC;
+    }
+
+    playRecording(now);
+
+    if (_audioMixer) {
+        pingMixer(*_audioMixer, now);
+        if (_audioMixer->activeSocket) {
+            sendAudio();
+        }
+    }
+
+    if (_avatarMixer) {
+        pingMixer(*_avatarMixer, now);
+        if (_avatarMixer->activeSocket) {
+            if (now >= _nextIdentitySend) {
+                sendIdentityAndTraits();
+                _nextIdentitySend = now + IDENTITY_RESEND_INTERVAL_MSECS * USECS_PER_MSEC;
+            }
+            if (now >= _nextAvatarSend) {
+                sendAvatarData(now, false);
+                _nextAvatarSend = now + MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS;
+            }
+            if (now >= _nextAvatarQuery) {
+                queryAvatars();
+                _nextAvatarQuery = now + AVATAR_QUERY_INTERVAL_MSECS * USECS_PER_MSEC;
+            }
+        }
+    }
+}
+
+void CrowdSession::handlePacket(std::unique_ptr<udt::Packet> packet) {
+    auto nlPacket = NLPacket::fromBase(std::move(packet));
+    ReceivedMessage message(*nlPacket);
+    processMessage(message);
+}
+
+void CrowdSession::handleMessagePacket(std::unique_ptr<udt::Packet> packet) {
+    // put the packets of a message back together, the way PacketReceiver::handleVerifiedMessagePacket does
+    auto nlPacket = NLPacket::fromBase(std::move(packet));
+    auto key = std::make_pair(nlPacket->getSenderSockAddr(), nlPacket->getMessageNumber());
+
+    auto it = _pendingMessages.find(key);
+    if (it == _pendingMessages.end()) {
+        std::unique_ptr<ReceivedMessage> message { new ReceivedMessage(*nlPacket) };
+        if (message->isComplete()) {
+            processMessage(*message);
+        } else {
+            _pendingMessages.emplace(key, std::move(message));
+        }
+    } else {
+        it->second->appendPacket(*nlPacket);
+        if (it->second->isComplete()) {
+            auto message = std::move(it->second);
+            _pendingMessages.erase(it);
+            processMessage(*message);
+        }
+    }
+}
+
+void CrowdSession::processMessage(ReceivedMessage& message) {
+    quint64 now = usecTimestampNow();
+
+    switch (message.getType()) {
+        case PacketType::DomainList:
+            processDomainList(message);
+            return;
+        case PacketType::DomainServerAddedNode: {
+            QDataStream packetStream(message.getMessage());
+            processAddedNode(packetStream);
+            return;
+        }
+        case PacketType::DomainServerRemovedNode:
+            processRemovedNode(message);
+            return;
+        case PacketType::DomainConnectionDenied:
+            processConnectionDenied(message);
+            return;
+        default:
+            break;
+    }
+
+    Mixer* mixer = mixerForMessage(message);
+    if (!mixer) {
+        return;
+    }
+
+    switch (message.getType()) {
+        case PacketType::Ping:
+            processPing(message, *mixer);
+            break;
+        case PacketType::PingReply:
+            processPingReply(message, *mixer);
+            break;
+        case PacketType::MixedAudio:
+        case PacketType::SilentAudioFrame:
+            processMixedAudio(message, now);
+            break;
+        case PacketType::BulkAvatarData:
+            processBulkAvatarData(message, now);
+            break;
+        case PacketType::BulkAvatarTraits:
+            processBulkAvatarTraits(message);
+            break;
+        case PacketType::SelectedAudioFormat: {
+            QString selectedCodecName = message.readString();
+            if (!selectedCodecName.isEmpty()) {
+                qWarning() << _name << "audio mixer selected codec" << selectedCodecName << "that was not offered, sending PCM";
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+CrowdSession::Mixer* CrowdSession::mixerForMessage(const ReceivedMessage& message) {
+    NLPacket::LocalID sourceID = message.getSourceID();
+    if (_audioMixer && _audioMixer->localID == sourceID) {
+        return _audioMixer.get();
+    }
+    if (_avatarMixer && _avatarMixer->localID == sourceID) {
+        return _avatarMixer.get();
+    }
+    return nullptr;
+}
+
+void CrowdSession::sendDomainServerCheckIn(quint64 now) {
+    if (_wasRefused) {
+        return;
+    }
+
+    if (_checkInsSinceLastReply >= MAX_SILENT_DOMAIN_SERVER_CHECK_INS && _isConnected) {
+        qWarning() << _name << "lost the domain-server, reconnecting";
+        resetDomainConnection();
+    }
+
+    // the layout of NodeList::sendDomainServerCheckIn, without ICE, metaverse account or system info
+    PacketType packetType = _isConnected ? PacketType::DomainListRequest : PacketType::DomainConnectRequest;
+    auto domainPacket = NLPacket::create(packetType);
+    QDataStream packetStream(domainPacket.get());
+
+    if (packetType == PacketType::DomainConnectRequest) {
+        packetStream << QUuid();
+
+        QByteArray protocolVersionSig = protocolVersionsSignature();
+        packetStream.writeBytes(protocolVersionSig.constData(), protocolVersionSig.size());
+
+        packetStream << QString() << FingerprintUtils::getMachineFingerprint() << QByteArray();
+        packetStream << LimitedNodeList::ConnectReason::Connect << (quint64)0;
+    }
+
+    packetStream << now;
+
+    // we have no public address of our own, the local one stands for both
+    NodeSet nodeTypesOfInterest { NodeType::AudioMixer, NodeType::AvatarMixer };
+    packetStream << (NodeType_t)NodeType::Agent << _localSockAddr.getType() << _localSockAddr
+        << _localSockAddr.getType() << _localSockAddr << nodeTypesOfInterest.values();
+    packetStream << QString();
+
+    if (packetType == PacketType::DomainConnectRequest) {
+        // anonymous, no username or signature
+        packetStream << QString() << QString("");
+    }
+
+    sendToDomainServer(*domainPacket);
+    _checkInsSinceLastReply++;
+}
+
+void CrowdSession::processDomainList(ReceivedMessage& message) {
+    QDataStream packetStream(message.getMessage());
+    NodeList::DomainListHeader header;
+    NodeList::readDomainListHeader(packetStream, header);
+    const QUuid& newUUID = header.sessionUUID;
+    NLPacket::LocalID newLocalID = header.sessionLocalID;
+
+    _checkInsSinceLastReply = 0;
+
+    if (_isConnected && (newUUID != _sessionUUID || newLocalID != _sessionLocalID)) {
+        qWarning() << _name << "session changed while connected to the domain-server";
+        resetDomainConnection();
+    }
+
+    if (!_isConnected) {
+        _isConnected = true;
+        _sessionUUID = newUUID;
+        _sessionLocalID = newLocalID;
+        _avatar.setSessionUUID(newUUID);
+        if (_verbose) {
+            qDebug() << _name << "connected to the domain-server as" << newUUID;
+        }
+    }
+    _isAuthenticated = header.isAuthenticated;
+
+    while (!packetStream.atEnd()) {
+        processAddedNode(packetStream);
+    }
+}
+
+void CrowdSession::processAddedNode(QDataStream& packetStream) {
+    LimitedNodeList::NewNodeInfo info;
+    NodeList::readNodeFromPacketStream(packetStream, info);
+    NodeType_t type = (NodeType_t)info.type;
+    const QUuid& uuid = info.uuid;
+    SockAddr& publicSocket = info.publicSocket;
+
+    if (packetStream.status() != QDataStream::Ok) {
+        return;
+    }
+
+    std::unique_ptr<Mixer>* slot = type == NodeType::AudioMixer ? &_audioMixer
+        : type == NodeType::AvatarMixer ? &_avatarMixer : nullptr;
+    if (!slot || (*slot && (*slot)->uuid == uuid)) {
+        return;
+    }
+
+    // if the public socket address is 0 then it's reachable at the same IP as the domain server
+    if (publicSocket.getAddress().isNull()) {
+        publicSocket.setAddress(_domainServer.getAddress());
+    }
+
+    slot->reset(new Mixer());
+    Mixer& mixer = **slot;
+    mixer.type = type;
+    mixer.uuid = uuid;
+    mixer.localID = info.sessionLocalID;
+    mixer.publicSocket = publicSocket;
+    mixer.localSocket = info.localSocket;
+    mixer.authenticateHash.setKey(info.connectionSecretUUID);
+
+    if (_verbose) {
+        qDebug() << _name << "added" << NodeType::getNodeTypeName(type) << publicSocket << info.localSocket;
+    }
+}
+
+void CrowdSession::processRemovedNode(ReceivedMessage& message) {
+    QUuid nodeUUID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    for (auto mixer : { &_audioMixer, &_avatarMixer }) {
+        if (*mixer && (*mixer)->uuid == nodeUUID) {
+            if (_verbose) {
+                qDebug() << _name << "killed" << NodeType::getNodeTypeName((*mixer)->type);
+            }
+            ((*mixer)->type == NodeType::AudioMixer ? _audioStats : _avatarStats).lastArrival = 0;
+            mixer->reset();
+        }
+    }
+}
+
+void CrowdSession::processConnectionDenied(ReceivedMessage& message) {
+    uint8_t reasonCode;
+    quint16 reasonSize;
+    message.readPrimitive(&reasonCode);
+    message.readPrimitive(&reasonSize);
+    QString reasonMessage = QString::fromUtf8(message.readWithoutCopy(reasonSize));
+
+    // without credentials, retrying wouldn't get us in
+    qWarning() << _name << "domain connection refused:" << reasonMessage;
+    _wasRefused = true;
+}
+
+void CrowdSession::pingMixer(Mixer& mixer, quint64 now) {
+    // punch until one of the mixer's sockets answers, then keep the connection alive
+    quint64 interval = (mixer.activeSocket ? KEEPALIVE_PING_INTERVAL_MSECS : UDP_PUNCH_PING_INTERVAL_MS) * USECS_PER_MSEC;
+    if (now - mixer.lastPingSent < interval) {
+        return;
+    }
+    mixer.lastPingSent = now;
+
+    // every domain session is a new node to the mixer, so a bot only ever uses the first connection ID
+    auto sendPing = [&](PingType_t pingType, const SockAddr& sockAddr) {
+        auto pingPacket = LimitedNodeList::constructPingPacket(pingType, INITIAL_CONNECTION_ID);
+        sendToMixer(*pingPacket, mixer, sockAddr);
+    };
+
+    if (mixer.activeSocket) {
+        sendPing(PingType::Agnostic, *mixer.activeSocket);
+    } else {
+        sendPing(PingType::Local, mixer.localSocket);
+        sendPing(PingType::Public, mixer.publicSocket);
+    }
+}
+
+void CrowdSession::processPing(ReceivedMessage& message, Mixer& mixer) {
+    // our reply is what activates our socket on the mixer's side
+    auto replyPacket = LimitedNodeList::constructPingReplyPacket(message);
+    sendToMixer(*replyPacket, mixer, message.getSenderSockAddr());
+}
+
+void CrowdSession::processPingReply(ReceivedMessage& message, Mixer& mixer) {
+    PingType_t pingType;
+    quint64 ourOriginalTime;
+    message.readPrimitive(&pingType);
+    message.readPrimitive(&ourOriginalTime);
+
+    float pingMs = (float)(usecTimestampNow() - ourOriginalTime) / (float)USECS_PER_MSEC;
+    (mixer.type == NodeType::AudioMixer ? _audioStats : _avatarStats).pingMs.update(pingMs);
+
+    if (!mixer.activeSocket) {
+        if (pingType == PingType::Local) {
+            mixer.activeSocket = &mixer.localSocket;
+        } else if (pingType == PingType::Public) {
+            mixer.activeSocket = &mixer.publicSocket;
+        }
+        if (mixer.activeSocket) {
+            mixerActivated(mixer);
+        }
+    }
+}
+
+void CrowdSession::mixerActivated(Mixer& mixer) {
+    if (_verbose) {
+        qDebug() << _name << "activated" << NodeType::getNodeTypeName(mixer.type) << *mixer.activeSocket;
+    }
+
+    if (mixer.type == NodeType::AudioMixer) {
+        // offer no codecs, so the mixer exchanges raw PCM with us and no encoding cost is spent on the bot side
+        auto negotiateFormatPacket = NLPacket::create(PacketType::NegotiateAudioFormat);
+        negotiateFormatPacket->writePrimitive((quint8)0);
+        sendToMixer(*negotiateFormatPacket, mixer);
+    } else {
+        // make sure the new mixer gets our identity, traits and all of our avatar data
+        _avatar.markIdentityDataChanged();
+        sendIdentityAndTraits();
+        _nextIdentitySend = usecTimestampNow() + IDENTITY_RESEND_INTERVAL_MSECS * USECS_PER_MSEC;
+        sendAvatarData(usecTimestampNow(), true);
+    }
+}
+
+void CrowdSession::playRecording(quint64 now) {
+    using namespace recording;
+    static const FrameType AVATAR_FRAME_TYPE = Frame::registerFrameType(AvatarData::FRAME_NAME);
+    static const FrameType AUDIO_FRAME_TYPE = Frame::registerFrameType(AudioConstants::getAudioFrameName());
+
+    const auto& frames = _recording->frames;
+    quint64 loopLength = (quint64)_recording->duration * USECS_PER_MSEC;
+
+    while (true) {
+        if (_nextFrame == frames.size()) {
+            _nextFrame = 0;
+            _loopStart += loopLength;
+        }
+
+        const auto& frame = frames[_nextFrame];
+        if (_loopStart + (quint64)frame->timeOffset * USECS_PER_MSEC > now) {
+            break;
+        }
+
+        if (frame->type == AVATAR_FRAME_TYPE) {
+            AvatarData::fromFrame(frame->data, _avatar);
+        } else if (frame->type == AUDIO_FRAME_TYPE) {
+            _pendingAudio = frame->data;
+        }
+        _nextFrame++;
+    }
+}
+
+void CrowdSession::sendAudio() {
+    // send the last recorded frame if one was played since the last tick, silence otherwise, so the mixer
+    // keeps this bot's stream alive and keeps sending it mixes
+    bool silentFrame = _pendingAudio.isEmpty();
+    auto audioPacket = NLPacket::create(silentFrame ? PacketType::SilentAudioFrame : PacketType::MicrophoneAudioNoEcho);
+
+    audioPacket->writePrimitive(_audioSequenceNumber++);
+    audioPacket->writeString(QString());
+    if (silentFrame) {
+        audioPacket->writePrimitive((quint16)AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    } else {
+        // recorded audio is mono
+        audioPacket->writePrimitive((quint8)0);
+    }
+
+    audioPacket->writePrimitive(_avatar.getWorldPosition());
+    audioPacket->writePrimitive(_avatar.getHeadOrientation());
+    audioPacket->writePrimitive(_avatar.getWorldPosition());
+    audioPacket->writePrimitive(glm::vec3(0));
+
+    if (!silentFrame) {
+        audioPacket->write(_pendingAudio.left(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL));
+        _pendingAudio.clear();
+    }
+
+    sendToMixer(*audioPacket, *_audioMixer);
+    _audioStats.sent++;
+}
+
+void CrowdSession::sendAvatarData(quint64 now, bool sendAll) {
+    auto avatarPacket = _avatar.createAvatarDataPacket(sendAll);
+    if (!avatarPacket) {
+        return;
+    }
+    sendToMixer(*avatarPacket, *_avatarMixer);
+    _avatarStats.sent++;
+
+    // only new positions are tracked, a receiver seeing one that hasn't changed can't tell which send it came from
+    glm::vec3 position = _avatar.getWorldPosition();
+    if (position != _lastSentPosition) {
+        _lastSentPosition = position;
+        _latencyTracker.positionSent(_sessionUUID, position, now);
+    }
+}
+
+void CrowdSession::sendIdentityAndTraits() {
+    sendToMixer(*_avatar.createIdentityPacket(), *_avatarMixer);
+    sendToMixer(*_avatar.createTraitsPacket(), *_avatarMixer);
+}
+
+void CrowdSession::queryAvatars() {
+    ViewFrustum view;
+    view.setPosition(_avatar.getWorldPosition());
+    view.setOrientation(_avatar.getHeadOrientation());
+    view.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, DEFAULT_ASPECT_RATIO, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+    view.calculate();
+    ConicalViewFrustum conicalView { view };
+
+    auto avatarPacket = NLPacket::create(PacketType::AvatarQuery);
+    auto destinationBuffer = reinterpret_cast<unsigned char*>(avatarPacket->getPayload());
+    auto bufferStart = destinationBuffer;
+
+    uint8_t numFrustums = 1;
+    memcpy(destinationBuffer, &numFrustums, sizeof(numFrustums));
+    destinationBuffer += sizeof(numFrustums);
+
+    destinationBuffer += conicalView.serialize(destinationBuffer);
+
+    avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
+
+    sendToMixer(*avatarPacket, *_avatarMixer);
+}
+
+void CrowdSession::processMixedAudio(ReceivedMessage& message, quint64 now) {
+    _audioStats.received(message.getSize(), now);
+
+    quint16 sequence;
+    if (message.getBytesLeftToRead() < (qint64)sizeof(sequence)) {
+        return;
+    }
+    message.readPrimitive(&sequence);
+
+    // The mixer sends a frame every NETWORK_FRAME_USECS, so a frame's arrival time minus its sequence number times the
+    // frame length is its transit time plus a constant.  The frame with the shortest transit sets the constant, the
+    // latency of the others is how much later than that they arrived.
+    if (_mixedAudioFrames < 0) {
+        _mixedAudioFrames = 0;
+    } else {
+        _mixedAudioFrames += (qint16)(sequence - _lastMixedAudioSequence);
+    }
+    _lastMixedAudioSequence = sequence;
+
+    qint64 frameTime = (qint64)now - _mixedAudioFrames * AudioConstants::NETWORK_FRAME_USECS;
+    if (_mixedAudioBaseTime == 0 || frameTime < _mixedAudioBaseTime) {
+        _mixedAudioBaseTime = frameTime;
+    }
+    _audioStats.latency.update((quint64)(frameTime - _mixedAudioBaseTime));
+}
+
+void CrowdSession::processBulkAvatarData(ReceivedMessage& message, quint64 now) {
+    _avatarStats.received(message.getSize(), now);
+
+    // Each avatar in the packet starts with its session UUID, its flags and, when it's flagged, its global position.
+    // The length of its data is only known once all of it is parsed, so only the first one is looked at.
+    const int MIN_HEADER_SIZE = NUM_BYTES_RFC4122_UUID + sizeof(AvatarDataPacket::HasFlags) + sizeof(glm::vec3);
+    if (message.getBytesLeftToRead() < MIN_HEADER_SIZE) {
+        return;
+    }
+
+    QUuid avatarID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    AvatarDataPacket::HasFlags flags;
+    message.readPrimitive(&flags);
+    if (!(flags & AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION)) {
+        return;
+    }
+    glm::vec3 position;
+    message.readPrimitive(&position);
+
+    quint64 sendTime = _latencyTracker.getSendTime(avatarID, position);
+    if (sendTime != 0 && sendTime <= now) {
+        _avatarStats.latency.update(now - sendTime);
+    }
+}
+
+void CrowdSession::processBulkAvatarTraits(ReceivedMessage& message) {
+    // acknowledge the traits like AvatarHashMap does, otherwise the mixer keeps resending them
+    AvatarTraits::TraitMessageSequence seq;
+    if (message.getBytesLeftToRead() < (qint64)sizeof(seq)) {
+        return;
+    }
+    message.readPrimitive(&seq);
+
+    auto traitsAckPacket = NLPacket::create(PacketType::BulkAvatarTraitsAck, sizeof(AvatarTraits::TraitMessageSequence));
+    traitsAckPacket->writePrimitive(seq);
+    sendToMixer(*traitsAckPacket, *_avatarMixer);
+}
+
+qint64 CrowdSession::sendToDomainServer(NLPacket& packet) {
+    LimitedNodeList::fillPacketHeader(packet, _sessionLocalID, nullptr);
+    return _socket->writePacket(packet, _domainServer);
+}
+
+qint64 CrowdSession::sendToMixer(NLPacket& packet, Mixer& mixer, const SockAddr& sockAddr) {
+    LimitedNodeList::fillPacketHeader(packet, _sessionLocalID, _isAuthenticated ? &mixer.authenticateHash : nullptr);
+    return _socket->writePacket(packet, sockAddr);
+}
+
+qint64 CrowdSession::sendToMixer(NLPacket& packet, Mixer& mixer) {
+    return mixer.activeSocket ? sendToMixer(packet, mixer, *mixer.activeSocket) : 0;
+}
+
+void CrowdSession::resetDomainConnection() {
+    _latencyTracker.removeAvatar(_sessionUUID);
+
+    _isConnected = false;
+    _isAuthenticated = false;
+    _sessionUUID = QUuid();
+    _sessionLocalID = NLPacket::NULL_LOCAL_ID;
+    _checkInsSinceLastReply = 0;
+    _audioMixer.reset();
+    _avatarMixer.reset();
+    _pendingMessages.clear();
+    _audioStats.lastArrival = 0;
+    _avatarStats.lastArrival = 0;
+    _mixedAudioFrames = -1;
+    _mixedAudioBaseTime = 0;
+    _lastSentPosition = glm::vec3();
+}
+
+QJsonObject CrowdSession::report() const {
+    QJsonObject json;
+    json["bot"] = _name;
+    json["connected"] = _isConnected;
+    json["audio"] = _audioStats.toJson();
+    json["avatar"] = _avatarStats.toJson();
+    return json;
+}
+
+void CrowdSession::resetStats() {
+    _audioStats.reset();
+    _avatarStats.reset();
+}
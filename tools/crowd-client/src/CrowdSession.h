@@ -0,0 +1,191 @@
+//
+//  CrowdSession.h
+//  tools/crowd-client/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CrowdSession_h
+#define hifi_CrowdSession_h
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+
+#include <glm/glm.hpp>
+
+#include <HMACAuth.h>
+#include <MovingMinMaxAvg.h>
+#include <NodeType.h>
+#include <PacketReceiver.h>
+#include <ReceivedMessage.h>
+#include <SockAddr.h>
+#include <UUIDHasher.h>
+#include <recording/Frame.h>
+#include <udt/Packet.h>
+
+#include "CrowdAvatar.h"
+
+namespace udt {
+    class Socket;
+}
+
+// A recording loaded once and shared, read only, by every bot playing it.  Each bot keeps its own cursor in it.
+struct CrowdRecording {
+    static std::shared_ptr<const CrowdRecording> fromFile(const QString& filePath);
+
+    QString name;
+    std::vector<recording::FrameConstPointer> frames;
+    recording::Frame::Time duration { 0 };  // milliseconds
+};
+
+// The times at which the bots sent their avatar positions, so that the bots receiving them back from the avatar mixer
+// can tell how long the mixer took to forward them.  Only used on the packet thread, which all the sessions share.
+class CrowdLatencyTracker {
+public:
+    void positionSent(const QUuid& avatarID, const glm::vec3& position, quint64 sendTime);
+    // 0 if the position isn't one of the last ones the avatar sent
+    quint64 getSendTime(const QUuid& avatarID, const glm::vec3& position) const;
+    void removeAvatar(const QUuid& avatarID);
+
+private:
+    struct SentPosition {
+        glm::vec3 position;
+        quint64 time;
+    };
+
+    std::unordered_map<QUuid, std::deque<SentPosition>, UUIDHasher> _sentPositions;
+};
+
+// One bot: its own UDP socket, domain-server session, avatar mixer and audio mixer connections, avatar and recording
+// cursor.  It does what NodeList does for a single client (check-ins, node list, pings, socket activation, packet
+// signing) for just the two mixers a bot talks to, so that a process can host as many bots as its packet thread keeps
+// up with: NodeList and its DomainHandler are process-wide singletons holding one session.  The packets themselves are
+// read and written by the static helpers NodeList and LimitedNodeList use, only the session state is the bot's own.
+// There is no STUN or ICE: the domain-server and the mixers have to be reachable directly.
+// Every call happens on the packet thread.
+class CrowdSession : public QObject {
+    Q_OBJECT
+public:
+    CrowdSession(const QString& name, const SockAddr& domainServer, const QHostAddress& localAddress,
+                 std::shared_ptr<const CrowdRecording> recording, const glm::vec3& position,
+                 CrowdLatencyTracker& latencyTracker, bool verbose);
+    ~CrowdSession();
+
+    const QString& getName() const { return _name; }
+
+    void start();
+    // called at the audio frame rate, sends whatever is due
+    void update(quint64 now);
+    void stop();
+
+    struct ArrivalStats {
+        void received(int bytes, quint64 now);
+        void reset();
+        QJsonObject toJson() const;
+
+        quint64 lastArrival { 0 };
+        MinMaxAvg<quint64> gaps;     // usecs between packets
+        MinMaxAvg<quint64> latency;  // usecs, see the receive handlers
+        MinMaxAvg<float> pingMs;
+        int packets { 0 };
+        qint64 bytes { 0 };
+        int late { 0 };              // gaps longer than twice the expected interval
+        quint64 lateThreshold { 0 };
+        int sent { 0 };
+    };
+
+    bool isConnected() const { return _isConnected; }
+    const ArrivalStats& getAudioStats() const { return _audioStats; }
+    const ArrivalStats& getAvatarStats() const { return _avatarStats; }
+    QJsonObject report() const;
+    void resetStats();
+
+private:
+    struct Mixer {
+        NodeType_t type;
+        QUuid uuid;
+        NLPacket::LocalID localID { NLPacket::NULL_LOCAL_ID };
+        SockAddr publicSocket;
+        SockAddr localSocket;
+        const SockAddr* activeSocket { nullptr };
+        HMACAuth authenticateHash;
+        quint64 lastPingSent { 0 };
+    };
+
+    void handlePacket(std::unique_ptr<udt::Packet> packet);
+    void handleMessagePacket(std::unique_ptr<udt::Packet> packet);
+    void processMessage(ReceivedMessage& message);
+
+    void processDomainList(ReceivedMessage& message);
+    void processAddedNode(QDataStream& packetStream);
+    void processRemovedNode(ReceivedMessage& message);
+    void processConnectionDenied(ReceivedMessage& message);
+    void processPing(ReceivedMessage& message, Mixer& mixer);
+    void processPingReply(ReceivedMessage& message, Mixer& mixer);
+    void processMixedAudio(ReceivedMessage& message, quint64 now);
+    void processBulkAvatarData(ReceivedMessage& message, quint64 now);
+    void processBulkAvatarTraits(ReceivedMessage& message);
+
+    void sendDomainServerCheckIn(quint64 now);
+    void pingMixer(Mixer& mixer, quint64 now);
+    void mixerActivated(Mixer& mixer);
+    void playRecording(quint64 now);
+    void sendAudio();
+    void sendAvatarData(quint64 now, bool sendAll);
+    void sendIdentityAndTraits();
+    void queryAvatars();
+
+    qint64 sendToDomainServer(NLPacket& packet);
+    qint64 sendToMixer(NLPacket& packet, Mixer& mixer, const SockAddr& sockAddr);
+    qint64 sendToMixer(NLPacket& packet, Mixer& mixer);
+    Mixer* mixerForMessage(const ReceivedMessage& message);
+    void resetDomainConnection();
+
+    QString _name;
+    bool _verbose;
+    CrowdLatencyTracker& _latencyTracker;
+
+    udt::Socket* _socket { nullptr };
+    SockAddr _domainServer;
+    SockAddr _localSockAddr;
+    QHostAddress _localAddress;
+
+    bool _isConnected { false };
+    bool _isAuthenticated { false };
+    bool _wasRefused { false };
+    QUuid _sessionUUID;
+    NLPacket::LocalID _sessionLocalID { NLPacket::NULL_LOCAL_ID };
+    int _checkInsSinceLastReply { 0 };
+    quint64 _nextDomainCheckIn { 0 };
+
+    std::unique_ptr<Mixer> _audioMixer;
+    std::unique_ptr<Mixer> _avatarMixer;
+    std::unordered_map<std::pair<SockAddr, udt::Packet::MessageNumber>, std::unique_ptr<ReceivedMessage>> _pendingMessages;
+
+    CrowdAvatar _avatar;
+    std::shared_ptr<const CrowdRecording> _recording;
+    size_t _nextFrame { 0 };
+    quint64 _loopStart { 0 };
+    QByteArray _pendingAudio;
+    glm::vec3 _lastSentPosition;
+
+    quint16 _audioSequenceNumber { 0 };
+    quint64 _nextAvatarSend { 0 };
+    quint64 _nextIdentitySend { 0 };
+    quint64 _nextAvatarQuery { 0 };
+
+    quint16 _lastMixedAudioSequence { 0 };
+    qint64 _mixedAudioFrames { -1 };   // frames the mixer has sent since the first one we got, sequence numbers unwrapped
+    qint64 _mixedAudioBaseTime { 0 };  // usecs, arrival time of frame 0 if it had the shortest transit seen
+
+    ArrivalStats _audioStats;
+    ArrivalStats _avatarStats;
+};
+
+#endif // hifi_CrowdSession_h
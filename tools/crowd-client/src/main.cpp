@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/crowd-client/src
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+
+#include <SharedUtil.h>
+#include <SettingHandle.h>
+
+#include "CrowdClientApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Crowd Client");
+
+    Setting::init();
+
+    CrowdClientApp app(argc, argv);
+    return app.exec();
+}
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+#
+#  crowd-harness.py
+#  tools
+#
+#  Launches N crowd bots against a domain, each playing back one of the given .hfr recordings as its own avatar and
+#  audio session, and aggregates the reports they print.  A crowd-client process hosts many bots, each with its own
+#  socket and domain session on the process' shared packet thread, so the bots are split over a few processes
+#  (--processes) rather than started one per process.
+#
+#  Distributed under the Apache License, Version 2.0.
+#  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+#
+
+import argparse
+import json
+import math
+import os
+import signal
+import subprocess
+import sys
+import threading
+import time
+
+
+class CrowdProcess:
+    def __init__(self, command, logFile):
+        self.reports = {}
+        self.lock = threading.Lock()
+        self.process = subprocess.Popen(command, stdout=subprocess.PIPE, stderr=logFile, universal_newlines=True)
+        self.reader = threading.Thread(target=self.read, daemon=True)
+        self.reader.start()
+
+    def read(self):
+        for line in self.process.stdout:
+            line = line.strip()
+            if not line.startswith('{'):
+                continue
+            try:
+                report = json.loads(line)
+            except ValueError:
+                continue
+            # the process' own aggregate is recomputed over all processes here
+            if 'bot' not in report:
+                continue
+            with self.lock:
+                self.reports[report['bot']] = report
+
+    def takeReports(self):
+        with self.lock:
+            reports = list(self.reports.values())
+            self.reports = {}
+        return reports
+
+    def terminate(self):
+        if self.process.poll() is None:
+            self.process.send_signal(signal.SIGTERM)
+
+    def wait(self):
+        try:
+            self.process.wait(timeout=10)
+        except subprocess.TimeoutExpired:
+            self.process.kill()
+
+
+def percentile(values, fraction):
+    if not values:
+        return None
+    values = sorted(values)
+    return values[min(len(values) - 1, int(math.ceil(fraction * len(values))) - 1)]
+
+
+def summarize(reports, stream):
+    streams = [report[stream] for report in reports]
+    gaps = [s['gapAvgMs'] for s in streams if 'gapAvgMs' in s]
+    maxGaps = [s['gapMaxMs'] for s in streams if 'gapMaxMs' in s]
+    latencies = [s['latencyAvgMs'] for s in streams if 'latencyAvgMs' in s]
+    maxLatencies = [s['latencyMaxMs'] for s in streams if 'latencyMaxMs' in s]
+    pings = [s['pingMs'] for s in streams if s.get('pingMs', -1) >= 0]
+    return {
+        'receiving': len(gaps),
+        'packets': sum(s['packets'] for s in streams),
+        'late': sum(s['late'] for s in streams),
+        'gapAvgMs': sum(gaps) / len(gaps) if gaps else None,
+        'gapMaxMs': max(maxGaps) if maxGaps else None,
+        'latencyP50Ms': percentile(latencies, 0.5),
+        'latencyP95Ms': percentile(latencies, 0.95),
+        'latencyMaxMs': max(maxLatencies) if maxLatencies else None,
+        'pingP50Ms': percentile(pings, 0.5),
+        'pingP95Ms': percentile(pings, 0.95),
+        'pingMaxMs': max(pings) if pings else None
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Play back recordings as N independent avatar and audio sessions '
+                                                 'against a domain and report per-bot packet latency and arrival statistics.')
+    parser.add_argument('recordings', nargs='+', help='.hfr recordings, assigned to the bots in turn')
+    parser.add_argument('--build-dir', required=True, help='CMake build directory containing tools/crowd-client')
+    parser.add_argument('--domain', default='127.0.0.1', help='domain-server address, host[:port]')
+    parser.add_argument('--bots', type=int, default=10, help='number of bots')
+    parser.add_argument('--processes', type=int, default=1, help='crowd-client processes the bots are split over')
+    parser.add_argument('--spacing', type=float, default=2.0, help='meters between bots, which are laid out on grids')
+    parser.add_argument('--report-interval', type=int, default=5, help='seconds between reports')
+    parser.add_argument('--duration', type=int, default=0, help='seconds to run before shutting down (0 runs until interrupted)')
+    parser.add_argument('--output', default=None, help='append every per-bot report to this JSON lines file')
+    parser.add_argument('--log', default=os.devnull, help='file receiving the bots\' log output')
+    args = parser.parse_args()
+
+    crowdClient = os.path.join(args.build_dir, 'tools', 'crowd-client', 'crowd-client')
+    numProcesses = max(1, min(args.processes, args.bots))
+    logFile = open(args.log, 'w')
+    output = open(args.output, 'a') if args.output else None
+
+    processes = []
+    try:
+        for index in range(numProcesses):
+            numBots = args.bots // numProcesses + (1 if index < args.bots % numProcesses else 0)
+            # each process lays its bots out on a grid of its own, put the grids side by side
+            gridSize = int(math.ceil(math.sqrt(numBots)))
+            x = index * (gridSize + 1) * args.spacing
+            command = [crowdClient,
+                       '-d', args.domain,
+                       '--bots', str(numBots),
+                       '--name', 'bot-{}'.format(index),
+                       '--position', '{},{},{}'.format(x, 0.0, 0.0),
+                       '--spacing', str(args.spacing),
+                       '--report-interval', str(args.report_interval)]
+            for recording in args.recordings:
+                command += ['--recording', recording]
+            processes.append(CrowdProcess(command, logFile))
+
+        print('Started {} bots in {} processes against {}'.format(args.bots, numProcesses, args.domain))
+
+        start = time.time()
+        while args.duration == 0 or time.time() - start < args.duration:
+            time.sleep(args.report_interval)
+
+            exited = [process for process in processes if process.process.poll() is not None]
+            reports = [report for process in processes for report in process.takeReports()]
+            if output:
+                for report in reports:
+                    output.write(json.dumps(report) + '\n')
+                output.flush()
+
+            summary = {
+                'elapsed': round(time.time() - start, 1),
+                'reporting': len(reports),
+                'connected': sum(1 for report in reports if report.get('connected')),
+                'exitedProcesses': len(exited),
+                'audio': summarize(reports, 'audio'),
+                'avatar': summarize(reports, 'avatar')
+            }
+            print(json.dumps(summary))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        for process in processes:
+            process.terminate()
+        for process in processes:
+            process.wait()
+        if output:
+            output.close()
+        logFile.close()
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
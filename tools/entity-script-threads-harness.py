@@ -0,0 +1,258 @@
+#!/usr/bin/env python3
+#
+#  entity-script-threads-harness.py
+#  tools
+#
+#  Launches a local domain with an entity server and an entity script server, seeded with entities that each run a
+#  server entity script, and changes the entity script server's number of script engine threads through the
+#  domain-server settings. After each change it checks that every entity's script is loaded again on the new engines.
+#
+#  Distributed under the Apache License, Version 2.0.
+#  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+#
+
+import argparse
+import gzip
+import http.server
+import json
+import os
+import re
+import signal
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+import urllib.request
+import uuid
+
+ENTITY_SCRIPT_SERVER_TYPE = 5
+ENTITY_SERVER_TYPE = 6
+
+DOMAIN_UDP_OFFSET = 2
+DOMAIN_HTTP_OFFSET = 0
+DOMAIN_HTTPS_OFFSET = 1
+DOMAIN_DTLS_OFFSET = 3
+DOMAIN_WS_OFFSET = 4
+DOMAIN_EXPORTER_OFFSET = 5
+DOMAIN_METADATA_EXPORTER_OFFSET = 6
+SCRIPT_HTTP_OFFSET = 10
+
+# EntityVersion::TextAlignment, older content is converted when it is loaded
+ENTITIES_FILE_VERSION = 58
+
+LOADED_MARKER = 'entity-script-threads-harness loaded'
+SERVER_SCRIPT = '''(function() {
+    this.preload = function(entityID) {
+        print("%s " + entityID);
+    };
+});
+''' % LOADED_MARKER
+
+THREADS_MESSAGE = re.compile(r'Entity scripts run on (\d+) script engine threads')
+RELOAD_MESSAGE = re.compile(r'Reloading (\d+) entity scripts on the new script engines')
+LOADED_MESSAGE = re.compile(re.escape(LOADED_MARKER) + r' \{?([0-9a-fA-F-]{36})\}?')
+
+
+class ScriptHandler(http.server.BaseHTTPRequestHandler):
+    def do_GET(self):
+        body = SERVER_SCRIPT.encode('utf-8')
+        self.send_response(200)
+        self.send_header('Content-Type', 'application/javascript')
+        self.send_header('Content-Length', str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def log_message(self, format, *args):
+        pass
+
+
+class Domain:
+    def __init__(self, basePort, workDir):
+        self.basePort = basePort
+        self.workDir = workDir
+        self.logDir = os.path.join(workDir, 'logs')
+        self.processes = []
+        os.makedirs(self.logDir, exist_ok=True)
+
+    def port(self, offset):
+        return self.basePort + offset
+
+    def environment(self):
+        env = dict(os.environ)
+        # isolate the settings, keys and content of the domain from any other one on this machine
+        env['HOME'] = self.workDir
+        env['XDG_CONFIG_HOME'] = os.path.join(self.workDir, 'config')
+        env['XDG_DATA_HOME'] = os.path.join(self.workDir, 'data')
+        env['HIFI_DOMAIN_SERVER_PORT'] = str(self.port(DOMAIN_UDP_OFFSET))
+        env['HIFI_DOMAIN_SERVER_HTTP_PORT'] = str(self.port(DOMAIN_HTTP_OFFSET))
+        env['HIFI_DOMAIN_SERVER_HTTPS_PORT'] = str(self.port(DOMAIN_HTTPS_OFFSET))
+        env['HIFI_DOMAIN_SERVER_DTLS_PORT'] = str(self.port(DOMAIN_DTLS_OFFSET))
+        env['VIRCADIA_DOMAIN_SERVER_WS_PORT'] = str(self.port(DOMAIN_WS_OFFSET))
+        env['VIRCADIA_DOMAIN_SERVER_EXPORTER_PORT'] = str(self.port(DOMAIN_EXPORTER_OFFSET))
+        env['VIRCADIA_DOMAIN_SERVER_METADATA_EXPORTER_PORT'] = str(self.port(DOMAIN_METADATA_EXPORTER_OFFSET))
+        return env
+
+    def writeEntities(self, numEntities, scriptURL):
+        entities = []
+        for i in range(numEntities):
+            entities.append({
+                'id': '{' + str(uuid.uuid4()) + '}',
+                'type': 'Box',
+                'name': 'entity-script-threads-harness {}'.format(i),
+                'position': { 'x': (i % 10) * 2.0, 'y': 0.0, 'z': (i // 10) * 2.0 },
+                'dimensions': { 'x': 1.0, 'y': 1.0, 'z': 1.0 },
+                'serverScripts': scriptURL
+            })
+        content = {
+            'Version': ENTITIES_FILE_VERSION,
+            'DataVersion': 0,
+            'Id': '{' + str(uuid.uuid4()) + '}',
+            'Entities': entities
+        }
+        entitiesPath = os.path.join(self.workDir, 'models.json.gz')
+        with gzip.open(entitiesPath, 'wt') as entitiesFile:
+            json.dump(content, entitiesFile)
+        return entitiesPath, set(entity['id'].strip('{}').lower() for entity in entities)
+
+    def writeConfig(self, entitiesPath, numThreads):
+        config = {
+            'metaverse': { 'local_port': self.port(DOMAIN_UDP_OFFSET) },
+            'entity_server_settings': { 'persistFilePath': entitiesPath },
+            'entity_script_server': { 'auto_threads': False, 'num_threads': str(numThreads) }
+        }
+        configPath = os.path.join(self.workDir, 'config.json')
+        with open(configPath, 'w') as configFile:
+            json.dump(config, configFile, indent=2)
+        return configPath
+
+    def launch(self, args, configPath):
+        env = self.environment()
+        domainServer = os.path.join(args.build_dir, 'domain-server', 'domain-server')
+        self.spawn([domainServer, '--user-config', configPath], env, os.path.join(self.logDir, 'domain-server.log'))
+
+        assignmentClient = os.path.join(args.build_dir, 'assignment-client', 'assignment-client')
+        for assignmentType in (ENTITY_SERVER_TYPE, ENTITY_SCRIPT_SERVER_TYPE):
+            self.spawn([assignmentClient,
+                        '-t', str(assignmentType),
+                        '-a', '127.0.0.1',
+                        '--server-port', str(self.port(DOMAIN_UDP_OFFSET)),
+                        '--disable-domain-port-auto-discovery'],
+                       env, self.assignmentLogPath(assignmentType))
+
+    def assignmentLogPath(self, assignmentType):
+        return os.path.join(self.logDir, 'assignment-client-{}.log'.format(assignmentType))
+
+    def spawn(self, command, env, logPath):
+        logFile = open(logPath, 'w')
+        print(' '.join(command))
+        self.processes.append(subprocess.Popen(command, env=env, stdout=logFile, stderr=subprocess.STDOUT))
+
+    def postSettings(self, settings):
+        request = urllib.request.Request('http://127.0.0.1:{}/settings.json'.format(self.port(DOMAIN_HTTP_OFFSET)),
+                                         data=json.dumps(settings).encode('utf-8'),
+                                         headers={ 'Content-Type': 'application/json' })
+        with urllib.request.urlopen(request, timeout=10) as response:
+            return response.status == 200
+
+    def checkProcesses(self):
+        for process in self.processes:
+            if process.poll() is not None:
+                raise RuntimeError('process {} exited with {}'.format(process.args[0], process.returncode))
+
+    def terminate(self):
+        for process in self.processes:
+            if process.poll() is None:
+                process.send_signal(signal.SIGTERM)
+        for process in self.processes:
+            try:
+                process.wait(timeout=10)
+            except subprocess.TimeoutExpired:
+                process.kill()
+
+
+def readLog(path):
+    with open(path, errors='replace') as logFile:
+        return logFile.read()
+
+
+def waitForScripts(domain, numThreads, logOffset, entityIDs, timeout):
+    # Waits for the entity script server to get the setting of numThreads engines after logOffset in its log, then for
+    # every entity's script to be loaded after that. Returns the log offset to start from next time and whether the
+    # scripts were reloaded in place, on engines restarted by the running assignment.
+    logPath = domain.assignmentLogPath(ENTITY_SCRIPT_SERVER_TYPE)
+    deadline = time.time() + timeout
+    switchOffset = None
+    while time.time() < deadline:
+        domain.checkProcesses()
+        log = readLog(logPath)
+        if switchOffset is None:
+            for match in THREADS_MESSAGE.finditer(log, logOffset):
+                if int(match.group(1)) == numThreads:
+                    switchOffset = match.end()
+                    break
+        if switchOffset is not None:
+            loaded = set(match.group(1).lower() for match in LOADED_MESSAGE.finditer(log, switchOffset))
+            if entityIDs <= loaded:
+                reloaded = any(int(match.group(1)) > 0 for match in RELOAD_MESSAGE.finditer(log, switchOffset))
+                return len(log), reloaded
+        time.sleep(0.5)
+
+    if switchOffset is None:
+        raise RuntimeError('the entity script server never got the setting of {} threads'.format(numThreads))
+    log = readLog(logPath)
+    loaded = set(match.group(1).lower() for match in LOADED_MESSAGE.finditer(log, switchOffset))
+    raise RuntimeError('{} of {} entity scripts loaded on {} threads'.format(len(entityIDs & loaded), len(entityIDs),
+                                                                             numThreads))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Check that every server entity script is loaded again after the '
+                                                 'entity script server changes its number of script engine threads.')
+    parser.add_argument('--build-dir', required=True, help='CMake build directory containing domain-server and assignment-client')
+    parser.add_argument('--entities', type=int, default=50, help='number of entities running a server script')
+    parser.add_argument('--threads', type=int, nargs='+', default=[4, 1, 2],
+                        help='thread counts to switch through, the first one is the initial setting')
+    parser.add_argument('--base-port', type=int, default=42000, help='first port used by the harness')
+    parser.add_argument('--work-dir', default=None, help='directory for the domain settings, content and logs')
+    parser.add_argument('--timeout', type=int, default=120, help='seconds to wait for the scripts after each change')
+    args = parser.parse_args()
+
+    workDir = args.work_dir or tempfile.mkdtemp(prefix='entity-script-threads-harness-')
+    domain = Domain(args.base_port, workDir)
+
+    scriptServer = http.server.HTTPServer(('127.0.0.1', domain.port(SCRIPT_HTTP_OFFSET)), ScriptHandler)
+    threading.Thread(target=scriptServer.serve_forever, daemon=True).start()
+    scriptURL = 'http://127.0.0.1:{}/server-script.js'.format(domain.port(SCRIPT_HTTP_OFFSET))
+
+    entitiesPath, entityIDs = domain.writeEntities(args.entities, scriptURL)
+    configPath = domain.writeConfig(entitiesPath, args.threads[0])
+
+    logOffset = 0
+    try:
+        domain.launch(args, configPath)
+        print('Harness running in {}'.format(workDir))
+
+        for index, numThreads in enumerate(args.threads):
+            if index > 0:
+                domain.postSettings({ 'entity_script_server': { 'num_threads': str(numThreads) } })
+            start = time.time()
+            logOffset, reloaded = waitForScripts(domain, numThreads, logOffset, entityIDs, args.timeout)
+            print('{} threads: all {} entity scripts loaded after {:.1f}s{}'.format(
+                numThreads, len(entityIDs), time.time() - start,
+                ', reloaded in place' if reloaded else ', loaded as the entities arrived'))
+    except RuntimeError as error:
+        print('FAILED: {}'.format(error))
+        print('Logs are in {}'.format(domain.logDir))
+        return 1
+    except KeyboardInterrupt:
+        return 1
+    finally:
+        domain.terminate()
+        scriptServer.shutdown()
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
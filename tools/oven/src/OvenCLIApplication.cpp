@@ -17,6 +17,7 @@
 #include <iostream>
 
 #include <image/TextureProcessing.h>
+#include <model-baker/MeshBakeCache.h>
 #include <TextureBaker.h>
 
 #include "BakerCLI.h"
@@ -25,6 +26,8 @@ static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_MESH_CACHE_PARAMETER = "mesh-cache";
+static const QString CLI_TEXTURE_THREADS_PARAMETER = "texture-threads";
 
 QUrl OvenCLIApplication::_inputUrlParameter;
 QUrl OvenCLIApplication::_outputUrlParameter;
@@ -47,7 +50,9 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_MESH_CACHE_PARAMETER, "Directory caching baked meshes, shared between bakes to skip unchanged meshes.", "directory" },
+        { CLI_TEXTURE_THREADS_PARAMETER, "Threads shared by all the textures being processed. [default: one per core]", "count" }
     });
 
     auto versionOption = parser.addVersionOption();
@@ -91,4 +96,12 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         qDebug() << "Disabling texture compression";
         TextureBaker::setCompressionEnabled(false);
     }
+
+    if (parser.isSet(CLI_MESH_CACHE_PARAMETER)) {
+        baker::MeshBakeCache::setDirectory(QDir::fromNativeSeparators(parser.value(CLI_MESH_CACHE_PARAMETER)));
+    }
+
+    if (parser.isSet(CLI_TEXTURE_THREADS_PARAMETER)) {
+        image::setProcessingThreadBudget(parser.value(CLI_TEXTURE_THREADS_PARAMETER).toInt());
+    }
 }
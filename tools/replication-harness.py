@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+#
+#  replication-harness.py
+#  tools
+#
+#  Launches one upstream domain and several downstream domains on the local machine, each with its own
+#  domain-server and audio/avatar mixers, wired together through the "broadcasting" replication settings.
+#  Every agent connected to the upstream domain is replicated to the downstream mixers, so clients can
+#  be spread across the downstream domains to exercise hierarchical mixing without extra hosts.
+#
+#  Distributed under the Apache License, Version 2.0.
+#  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+#
+
+import argparse
+import json
+import os
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+
+AUDIO_MIXER_TYPE = 0
+AVATAR_MIXER_TYPE = 1
+
+# each domain gets a block of ports starting at BASE_PORT + index * PORT_STRIDE
+PORT_STRIDE = 20
+DOMAIN_UDP_OFFSET = 2
+DOMAIN_HTTP_OFFSET = 0
+DOMAIN_HTTPS_OFFSET = 1
+DOMAIN_DTLS_OFFSET = 3
+DOMAIN_WS_OFFSET = 4
+DOMAIN_EXPORTER_OFFSET = 5
+DOMAIN_METADATA_EXPORTER_OFFSET = 6
+AUDIO_MIXER_OFFSET = 10
+AVATAR_MIXER_OFFSET = 11
+
+
+class Domain:
+    def __init__(self, name, index, basePort, workDir):
+        self.name = name
+        self.index = index
+        self.basePort = basePort + index * PORT_STRIDE
+        self.workDir = os.path.join(workDir, name)
+        self.processes = []
+        os.makedirs(self.workDir, exist_ok=True)
+
+    def port(self, offset):
+        return self.basePort + offset
+
+    def environment(self):
+        env = dict(os.environ)
+        # isolate settings, keys and content of each domain from the others
+        env['HOME'] = self.workDir
+        env['XDG_CONFIG_HOME'] = os.path.join(self.workDir, 'config')
+        env['XDG_DATA_HOME'] = os.path.join(self.workDir, 'data')
+        env['HIFI_DOMAIN_SERVER_PORT'] = str(self.port(DOMAIN_UDP_OFFSET))
+        env['HIFI_DOMAIN_SERVER_HTTP_PORT'] = str(self.port(DOMAIN_HTTP_OFFSET))
+        env['HIFI_DOMAIN_SERVER_HTTPS_PORT'] = str(self.port(DOMAIN_HTTPS_OFFSET))
+        env['HIFI_DOMAIN_SERVER_DTLS_PORT'] = str(self.port(DOMAIN_DTLS_OFFSET))
+        env['VIRCADIA_DOMAIN_SERVER_WS_PORT'] = str(self.port(DOMAIN_WS_OFFSET))
+        env['VIRCADIA_DOMAIN_SERVER_EXPORTER_PORT'] = str(self.port(DOMAIN_EXPORTER_OFFSET))
+        env['VIRCADIA_DOMAIN_SERVER_METADATA_EXPORTER_PORT'] = str(self.port(DOMAIN_METADATA_EXPORTER_OFFSET))
+        return env
+
+    def writeConfig(self, broadcasting):
+        config = {
+            'metaverse': { 'local_port': self.port(DOMAIN_UDP_OFFSET) },
+            'broadcasting': broadcasting
+        }
+        configPath = os.path.join(self.workDir, 'config.json')
+        with open(configPath, 'w') as configFile:
+            json.dump(config, configFile, indent=2)
+        return configPath
+
+    def mixerServer(self, offset, serverType):
+        return { 'address': '127.0.0.1', 'port': str(self.port(offset)), 'server_type': serverType }
+
+    def launch(self, args, configPath):
+        env = self.environment()
+        logDir = os.path.join(self.workDir, 'logs')
+        os.makedirs(logDir, exist_ok=True)
+
+        domainServer = os.path.join(args.build_dir, 'domain-server', 'domain-server')
+        self.spawn([domainServer, '--user-config', configPath], env, os.path.join(logDir, 'domain-server.log'))
+
+        assignmentClient = os.path.join(args.build_dir, 'assignment-client', 'assignment-client')
+        for mixerType, offset in ((AUDIO_MIXER_TYPE, AUDIO_MIXER_OFFSET), (AVATAR_MIXER_TYPE, AVATAR_MIXER_OFFSET)):
+            self.spawn([assignmentClient,
+                        '-t', str(mixerType),
+                        '-p', str(self.port(offset)),
+                        '-a', '127.0.0.1',
+                        '--server-port', str(self.port(DOMAIN_UDP_OFFSET)),
+                        '--disable-domain-port-auto-discovery'],
+                       env, os.path.join(logDir, 'assignment-client-{}.log'.format(mixerType)))
+
+    def spawn(self, command, env, logPath):
+        logFile = open(logPath, 'w')
+        print('[{}] {}'.format(self.name, ' '.join(command)))
+        self.processes.append(subprocess.Popen(command, env=env, stdout=logFile, stderr=subprocess.STDOUT))
+
+    def terminate(self):
+        for process in self.processes:
+            if process.poll() is None:
+                process.send_signal(signal.SIGTERM)
+        for process in self.processes:
+            try:
+                process.wait(timeout=10)
+            except subprocess.TimeoutExpired:
+                process.kill()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run an upstream domain and N downstream domains on one machine, '
+                                                 'replicating every upstream agent to the downstream mixers.')
+    parser.add_argument('--build-dir', required=True, help='CMake build directory containing domain-server and assignment-client')
+    parser.add_argument('--downstream', type=int, default=2, help='number of downstream domains')
+    parser.add_argument('--base-port', type=int, default=41000, help='first port used by the harness')
+    parser.add_argument('--work-dir', default=None, help='directory for per-domain settings and logs')
+    parser.add_argument('--duration', type=int, default=0, help='seconds to run before shutting down (0 runs until interrupted)')
+    args = parser.parse_args()
+
+    workDir = args.work_dir or tempfile.mkdtemp(prefix='replication-harness-')
+    upstream = Domain('upstream', 0, args.base_port, workDir)
+    downstreams = [Domain('downstream-{}'.format(i), i + 1, args.base_port, workDir) for i in range(args.downstream)]
+
+    # the upstream domain forwards all of its agents to every downstream mixer
+    upstreamConfig = upstream.writeConfig({
+        'broadcast_all_users': True,
+        'users': [],
+        'downstream_servers': [server for domain in downstreams for server in (
+            domain.mixerServer(AUDIO_MIXER_OFFSET, 'Audio Mixer'),
+            domain.mixerServer(AVATAR_MIXER_OFFSET, 'Avatar Mixer'))]
+    })
+
+    # each downstream domain accepts replicated streams from the upstream mixers
+    downstreamConfigs = [domain.writeConfig({
+        'upstream_servers': [
+            upstream.mixerServer(AUDIO_MIXER_OFFSET, 'Audio Mixer'),
+            upstream.mixerServer(AVATAR_MIXER_OFFSET, 'Avatar Mixer')]
+    }) for domain in downstreams]
+
+    domains = [upstream] + downstreams
+    try:
+        upstream.launch(args, upstreamConfig)
+        for domain, configPath in zip(downstreams, downstreamConfigs):
+            domain.launch(args, configPath)
+
+        print('Harness running in {}'.format(workDir))
+        for domain in domains:
+            print('  {}: domain UDP port {}, HTTP port {}'.format(domain.name, domain.port(DOMAIN_UDP_OFFSET),
+                                                                  domain.port(DOMAIN_HTTP_OFFSET)))
+
+        start = time.time()
+        while args.duration == 0 or time.time() - start < args.duration:
+            for domain in domains:
+                for process in domain.processes:
+                    if process.poll() is not None:
+                        print('[{}] process {} exited with {}'.format(domain.name, process.args[0], process.returncode))
+                        return 1
+            time.sleep(1)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        for domain in domains:
+            domain.terminate()
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())